@@ -0,0 +1,468 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+// Standalone benchmark driver for BLAS++.
+// Unlike the tester, it doesn't check results; it times each routine over
+// many iterations after warmup and reports min, median, 95th percentile,
+// mean, and standard deviation, as a table, CSV, or JSON.
+
+#include "bench.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+
+#include <unistd.h>
+
+#ifdef __linux__
+    #include <sched.h>
+#endif
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+namespace bench {
+
+// -----------------------------------------------------------------------------
+/// Evicts the caches by writing and reading a buffer larger than the
+/// last level cache.
+void flush_cache( int64_t cache_mib )
+{
+    static std::vector<char> buffer;
+    size_t size = cache_mib * 1024 * 1024;
+    if (buffer.size() != size)
+        buffer.resize( size );
+    volatile char* p = buffer.data();
+    for (size_t i = 0; i < size; i += 64)
+        p[ i ] += 1;
+}
+
+//------------------------------------------------------------------------------
+// Routines, by group. "all" runs all of them; "blas1", etc. run a group.
+const std::vector<std::string> blas1_routines = {
+    "asum", "axpy", "copy", "dot", "dotu", "iamax", "nrm2", "rot", "scal",
+    "swap"
+};
+
+const std::vector<std::string> blas2_routines = {
+    "gemv", "ger", "geru", "hemv", "her", "her2", "symv", "syr", "syr2",
+    "trmv", "trsv"
+};
+
+const std::vector<std::string> blas3_routines = {
+    "gemm", "hemm", "herk", "her2k", "symm", "syrk", "syr2k", "trmm", "trsm"
+};
+
+const std::vector<std::string> batch_routines = {
+    "batch-gemm", "batch-hemm", "batch-herk", "batch-her2k", "batch-symm",
+    "batch-syrk", "batch-syr2k", "batch-trmm", "batch-trsm"
+};
+
+// fixed-size blas::fixed routines, and the runtime routines on small sizes
+const std::vector<std::string> fixed_routines = {
+    "fixed-gemm", "small-gemm", "fixed-gemv", "small-gemv",
+    "fixed-trsv", "small-trsv"
+};
+
+// -----------------------------------------------------------------------------
+/// Appends routine, or the routines in group (blas1, blas2, blas3, batch,
+/// fixed, all), to routines.
+void add_routines( std::string const& arg, std::vector<std::string>& routines )
+{
+    bool group = false;
+    for (auto const& item : { std::make_pair( "blas1", &blas1_routines ),
+                              std::make_pair( "blas2", &blas2_routines ),
+                              std::make_pair( "blas3", &blas3_routines ),
+                              std::make_pair( "batch", &batch_routines ),
+                              std::make_pair( "fixed", &fixed_routines ) }) {
+        if (arg == "all" || arg == item.first) {
+            routines.insert( routines.end(), item.second->begin(),
+                             item.second->end() );
+            group = true;
+        }
+    }
+    if (! group)
+        routines.push_back( arg );
+}
+
+// -----------------------------------------------------------------------------
+typedef bool (*Bench)( Options const& opts, std::string const& routine,
+                       char type, Dims dims, Result& result );
+
+/// @return benchmark function for routine's group, or null if unknown.
+Bench find_bench( std::string const& routine )
+{
+    for (auto const& item : { std::make_pair( &blas1_routines, bench_blas1 ),
+                              std::make_pair( &blas2_routines, bench_blas2 ),
+                              std::make_pair( &blas3_routines, bench_blas3 ),
+                              std::make_pair( &batch_routines, bench_batch ),
+                              std::make_pair( &fixed_routines, bench_fixed ) }) {
+        for (auto const& name : *item.first) {
+            if (name == routine)
+                return item.second;
+        }
+    }
+    return nullptr;
+}
+
+// -----------------------------------------------------------------------------
+void usage()
+{
+    printf(
+"Usage: bench [options] routine [...]\n"
+"Routines: a routine name (e.g., gemm, batch-gemm), a group\n"
+"    (blas1, blas2, blas3, batch, fixed), or all.\n"
+"    fixed-gemm, etc. use blas::fixed on a batch of n-by-n problems,\n"
+"    n in 2, 3, 4, 5, 6, 8; small-gemm, etc. use runtime routines on them.\n"
+"Options:\n"
+"    --type      s,d,c,z       data types (default d)\n"
+"    --dim       list          sizes: n, m x n, or m x n x k, comma separated,\n"
+"                              with ranges start:stop:step,\n"
+"                              e.g., 100:1000:100 or 500x100:1000x200:100\n"
+"                              (default 100:1000:100)\n"
+"    --warmup    n             untimed calls before timing (default 3)\n"
+"    --iters     n             timed calls (default 20)\n"
+"    --cache     hot|cold      cold flushes cache before each call (default hot)\n"
+"    --cache-size MiB          size of buffer used to flush cache (default 64)\n"
+"    --pin                     pin OpenMP threads to cores (Linux)\n"
+"    --threads   n             number of OpenMP threads\n"
+"    --batch     n             batch count for batch routines (default 100)\n"
+"    --layout    c|r           column or row major (default c)\n"
+"    --format    table|csv|json  output format (default table)\n" );
+}
+
+// -----------------------------------------------------------------------------
+/// Parses one dimension triple "m", "mxn", or "mxnxk". Missing n, k
+/// default to m and n, respectively.
+Dims parse_dims( std::string const& str )
+{
+    Dims d = { 0, 0, 0 };
+    int len = 0;
+    long long m, n, k;
+    const char* s = str.c_str();
+    if (sscanf( s, "%lldx%lldx%lld%n", &m, &n, &k, &len ) == 3
+        && s[ len ] == '\0') {
+        d = Dims { m, n, k };
+    }
+    else if (sscanf( s, "%lldx%lld%n", &m, &n, &len ) == 2
+             && s[ len ] == '\0') {
+        d = Dims { m, n, n };
+    }
+    else if (sscanf( s, "%lld%n", &m, &len ) == 1 && s[ len ] == '\0') {
+        d = Dims { m, m, m };
+    }
+    else {
+        throw std::runtime_error( "invalid dimension: " + str );
+    }
+    if (d.m < 0 || d.n < 0 || d.k < 0)
+        throw std::runtime_error( "negative dimension: " + str );
+    return d;
+}
+
+// -----------------------------------------------------------------------------
+/// Parses comma separated list of dimensions and ranges start:stop:step.
+/// In a range, each of m, n, k is incremented by step until any exceeds
+/// its stop.
+void parse_dim_list( std::string const& str, std::vector<Dims>& dims )
+{
+    size_t begin = 0;
+    while (begin <= str.size()) {
+        size_t end = str.find( ',', begin );
+        if (end == std::string::npos)
+            end = str.size();
+        std::string item = str.substr( begin, end - begin );
+        size_t c1 = item.find( ':' );
+        if (c1 == std::string::npos) {
+            dims.push_back( parse_dims( item ) );
+        }
+        else {
+            size_t c2 = item.find( ':', c1 + 1 );
+            Dims start = parse_dims( item.substr( 0, c1 ) );
+            Dims stop  = parse_dims( item.substr(
+                c1 + 1, c2 == std::string::npos ? c2 : c2 - c1 - 1 ) );
+            int64_t step = 1;
+            if (c2 != std::string::npos)
+                step = atoll( item.substr( c2 + 1 ).c_str() );
+            if (step <= 0)
+                throw std::runtime_error( "invalid step: " + item );
+            for (Dims d = start;
+                 d.m <= stop.m && d.n <= stop.n && d.k <= stop.k;
+                 d.m += step, d.n += step, d.k += step)
+            {
+                dims.push_back( d );
+            }
+        }
+        begin = end + 1;
+    }
+}
+
+// -----------------------------------------------------------------------------
+/// Pins each OpenMP thread to one core, round robin over the cores
+/// in the process's affinity mask. Threads created by the vendor BLAS
+/// outside OpenMP are not affected; use its own settings or
+/// OMP_PROC_BIND / OMP_PLACES.
+/// @return true on success.
+bool pin_threads()
+{
+    #if defined( __linux__ )
+        cpu_set_t mask;
+        if (sched_getaffinity( 0, sizeof(mask), &mask ) != 0)
+            return false;
+        std::vector<int> cpus;
+        for (int i = 0; i < CPU_SETSIZE; ++i) {
+            if (CPU_ISSET( i, &mask ))
+                cpus.push_back( i );
+        }
+        if (cpus.empty())
+            return false;
+
+        bool ok = true;
+        #pragma omp parallel reduction(&&: ok)
+        {
+            int tid = 0;
+            #ifdef _OPENMP
+                tid = omp_get_thread_num();
+            #endif
+            cpu_set_t set;
+            CPU_ZERO( &set );
+            CPU_SET( cpus[ tid % cpus.size() ], &set );
+            ok = (sched_setaffinity( 0, sizeof(set), &set ) == 0);
+        }
+        return ok;
+    #else
+        return false;
+    #endif
+}
+
+// -----------------------------------------------------------------------------
+int num_threads()
+{
+    #ifdef _OPENMP
+        return omp_get_max_threads();
+    #else
+        return 1;
+    #endif
+}
+
+// -----------------------------------------------------------------------------
+void print_header( Options const& opts )
+{
+    if (opts.format == "csv") {
+        printf( "routine,type,m,n,k,batch,iters,min,median,p95,mean,stddev,"
+                "gflop,gbyte,gflops,gbytes\n" );
+    }
+    else if (opts.format == "json") {
+        char host[ 256 ] = "";
+        gethostname( host, sizeof(host) );
+        host[ sizeof(host) - 1 ] = '\0';
+        time_t now = time( nullptr );
+        char date[ 64 ];
+        strftime( date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime( &now ) );
+        printf( "{\n"
+                "  \"host\": \"%s\",\n"
+                "  \"date\": \"%s\",\n"
+                "  \"blaspp_version\": %d,\n"
+                "  \"threads\": %d,\n"
+                "  \"pinned\": %s,\n"
+                "  \"cache\": \"%s\",\n"
+                "  \"cache_mib\": %lld,\n"
+                "  \"warmup\": %lld,\n"
+                "  \"iters\": %lld,\n"
+                "  \"layout\": \"%c\",\n"
+                "  \"results\": [",
+                host, date, blas::blaspp_version(), num_threads(),
+                opts.pin ? "true" : "false", opts.cold ? "cold" : "hot",
+                (long long) opts.cache_mib, (long long) opts.warmup,
+                (long long) opts.iters, blas::layout2char( opts.layout ) );
+    }
+    else {
+        printf( "%d threads%s, %s cache, %lld warmup, %lld iters; "
+                "times in usec\n\n",
+                num_threads(), opts.pin ? " (pinned)" : "",
+                opts.cold ? "cold" : "hot",
+                (long long) opts.warmup, (long long) opts.iters );
+        printf( "%-12s  %4s  %6s  %6s  %6s  %6s  %10s  %10s  %10s  %10s  "
+                "%10s  %9s  %9s\n",
+                "routine", "type", "m", "n", "k", "batch",
+                "min", "median", "p95", "mean", "stddev",
+                "Gflop/s", "Gbyte/s" );
+    }
+}
+
+// -----------------------------------------------------------------------------
+/// Prints one result. Gflop/s and Gbyte/s use the median time.
+void print_result( Options const& opts, Result const& r, bool first )
+{
+    double gflops = (r.median > 0 ? r.gflop / r.median : 0);
+    double gbytes = (r.median > 0 ? r.gbyte / r.median : 0);
+    if (opts.format == "csv") {
+        printf( "%s,%c,%lld,%lld,%lld,%lld,%lld,"
+                "%.6e,%.6e,%.6e,%.6e,%.6e,%.6e,%.6e,%.6e,%.6e\n",
+                r.routine.c_str(), r.type,
+                (long long) r.dims.m, (long long) r.dims.n,
+                (long long) r.dims.k, (long long) r.batch, (long long) r.iters,
+                r.min, r.median, r.p95, r.mean, r.stddev,
+                r.gflop, r.gbyte, gflops, gbytes );
+    }
+    else if (opts.format == "json") {
+        printf( "%s\n    {\"routine\": \"%s\", \"type\": \"%c\", "
+                "\"m\": %lld, \"n\": %lld, \"k\": %lld, \"batch\": %lld, "
+                "\"iters\": %lld, "
+                "\"min\": %.6e, \"median\": %.6e, \"p95\": %.6e, "
+                "\"mean\": %.6e, \"stddev\": %.6e, "
+                "\"gflop\": %.6e, \"gbyte\": %.6e, "
+                "\"gflops\": %.6e, \"gbytes\": %.6e}",
+                first ? "" : ",",
+                r.routine.c_str(), r.type,
+                (long long) r.dims.m, (long long) r.dims.n,
+                (long long) r.dims.k, (long long) r.batch, (long long) r.iters,
+                r.min, r.median, r.p95, r.mean, r.stddev,
+                r.gflop, r.gbyte, gflops, gbytes );
+    }
+    else {
+        printf( "%-12s  %4c  %6lld  %6lld  %6lld  %6lld  %10.2f  %10.2f  "
+                "%10.2f  %10.2f  %10.2f  %9.3f  %9.3f\n",
+                r.routine.c_str(), r.type,
+                (long long) r.dims.m, (long long) r.dims.n,
+                (long long) r.dims.k, (long long) r.batch,
+                r.min * 1e6, r.median * 1e6, r.p95 * 1e6,
+                r.mean * 1e6, r.stddev * 1e6, gflops, gbytes );
+    }
+    fflush( stdout );
+}
+
+// -----------------------------------------------------------------------------
+void print_footer( Options const& opts )
+{
+    if (opts.format == "json")
+        printf( "\n  ]\n}\n" );
+}
+
+}  // namespace bench
+
+// -----------------------------------------------------------------------------
+int main( int argc, char** argv )
+{
+    using namespace bench;
+
+    Options opts;
+    std::vector<std::string> routines;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[ i ];
+            // Options taking a value.
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc)
+                    throw std::runtime_error( "missing value for " + arg );
+                return argv[ ++i ];
+            };
+            if (arg == "-h" || arg == "--help") {
+                usage();
+                return 0;
+            }
+            else if (arg == "--type") {
+                opts.types.clear();
+                for (char c : value()) {
+                    if (c == 's' || c == 'd' || c == 'c' || c == 'z')
+                        opts.types.push_back( c );
+                    else if (c != ',')
+                        throw std::runtime_error( "invalid type: " + arg );
+                }
+            }
+            else if (arg == "--dim")
+                parse_dim_list( value(), opts.dims );
+            else if (arg == "--warmup")
+                opts.warmup = std::max( atoll( value().c_str() ), 0LL );
+            else if (arg == "--iters")
+                opts.iters = std::max( atoll( value().c_str() ), 1LL );
+            else if (arg == "--cache") {
+                std::string v = value();
+                if (v != "hot" && v != "cold")
+                    throw std::runtime_error( "invalid --cache: " + v );
+                opts.cold = (v == "cold");
+            }
+            else if (arg == "--cache-size")
+                opts.cache_mib = std::max( atoll( value().c_str() ), 1LL );
+            else if (arg == "--pin")
+                opts.pin = true;
+            else if (arg == "--threads")
+                opts.threads = atoll( value().c_str() );
+            else if (arg == "--batch")
+                opts.batch = std::max( atoll( value().c_str() ), 1LL );
+            else if (arg == "--layout")
+                opts.layout = blas::char2layout( toupper( value()[ 0 ] ) );
+            else if (arg == "--format") {
+                opts.format = value();
+                if (opts.format != "table" && opts.format != "csv"
+                    && opts.format != "json")
+                    throw std::runtime_error( "invalid --format: "
+                                              + opts.format );
+            }
+            else if (arg[ 0 ] == '-')
+                throw std::runtime_error( "unknown option: " + arg );
+            else
+                add_routines( arg, routines );
+        }
+    }
+    catch (std::exception const& ex) {
+        fprintf( stderr, "Error: %s\n", ex.what() );
+        usage();
+        return 1;
+    }
+    if (routines.empty()) {
+        usage();
+        return 1;
+    }
+    if (opts.dims.empty())
+        parse_dim_list( "100:1000:100", opts.dims );
+
+    #ifdef _OPENMP
+        if (opts.threads > 0)
+            omp_set_num_threads( opts.threads );
+    #endif
+    if (opts.pin && ! pin_threads()) {
+        fprintf( stderr, "Warning: could not pin threads\n" );
+        opts.pin = false;
+    }
+
+    int status = 0;
+    bool first = true;
+    print_header( opts );
+    for (auto const& routine : routines) {
+        Bench bench = find_bench( routine );
+        if (bench == nullptr) {
+            fprintf( stderr, "Error: unknown routine: %s\n", routine.c_str() );
+            status = 1;
+            continue;
+        }
+        for (char type : opts.types) {
+            for (auto const& dims : opts.dims) {
+                Result result;
+                result.routine = routine;
+                result.type    = type;
+                result.batch   = 1;
+                try {
+                    // Routine not available for this type (e.g., complex
+                    // symv) is skipped.
+                    if (! bench( opts, routine, type, dims, result ))
+                        break;
+                }
+                catch (std::exception const& ex) {
+                    fprintf( stderr, "Error: %s %c: %s\n",
+                             routine.c_str(), type, ex.what() );
+                    status = 1;
+                    continue;
+                }
+                print_result( opts, result, first );
+                first = false;
+            }
+        }
+    }
+    print_footer( opts );
+    return status;
+}
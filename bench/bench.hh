@@ -0,0 +1,150 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BENCH_HH
+#define BENCH_HH
+
+#include "blas.hh"
+#include "blas/flops.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+// -----------------------------------------------------------------------------
+/// Dimensions of one benchmark point. Level 1 routines use n;
+/// Level 2 use m, n; Level 3 use m, n, k as applicable.
+struct Dims
+{
+    int64_t m, n, k;
+};
+
+// -----------------------------------------------------------------------------
+/// Benchmark settings, from the command line.
+struct Options
+{
+    std::vector<char> types      = { 'd' };
+    std::vector<Dims> dims;
+    int64_t           warmup     = 3;
+    int64_t           iters      = 20;
+    bool              cold       = false;  // flush cache before each iter
+    int64_t           cache_mib  = 64;     // size of flush buffer
+    bool              pin        = false;
+    int64_t           threads    = 0;      // 0 = default
+    int64_t           batch      = 100;
+    blas::Layout      layout     = blas::Layout::ColMajor;
+    std::string       format     = "table";
+};
+
+// -----------------------------------------------------------------------------
+/// Timing statistics of one benchmark point, in seconds.
+struct Result
+{
+    std::string routine;
+    char        type;
+    Dims        dims;
+    int64_t     batch;
+    int64_t     iters;
+    double      min, median, p95, mean, stddev;
+    double      gflop;  // per call
+    double      gbyte;  // per call
+};
+
+void flush_cache( int64_t cache_mib );
+
+// -----------------------------------------------------------------------------
+/// Calls `call` opts.warmup times untimed, then opts.iters times timed,
+/// flushing the cache before each timed call if opts.cold is set.
+/// Fills in timing statistics of result.
+template <typename Call>
+void time_call( Options const& opts, Call&& call, Result& result )
+{
+    for (int64_t i = 0; i < opts.warmup; ++i)
+        call();
+
+    std::vector<double> times( opts.iters );
+    for (int64_t i = 0; i < opts.iters; ++i) {
+        if (opts.cold)
+            flush_cache( opts.cache_mib );
+        auto start = std::chrono::steady_clock::now();
+        call();
+        std::chrono::duration<double> time
+            = std::chrono::steady_clock::now() - start;
+        times[ i ] = time.count();
+    }
+
+    std::sort( times.begin(), times.end() );
+    int64_t n = opts.iters;
+    double sum = 0;
+    for (double t : times)
+        sum += t;
+    double mean = sum / n;
+    double var = 0;
+    for (double t : times)
+        var += (t - mean) * (t - mean);
+
+    result.iters  = n;
+    result.min    = times[ 0 ];
+    result.median = (n % 2 == 1 ? times[ n/2 ]
+                                : 0.5 * (times[ n/2 - 1 ] + times[ n/2 ]));
+    result.p95    = times[ std::max( int64_t( std::ceil( 0.95 * n ) ) - 1,
+                                     int64_t( 0 ) ) ];
+    result.mean   = mean;
+    result.stddev = (n > 1 ? std::sqrt( var / (n - 1) ) : 0);
+}
+
+// -----------------------------------------------------------------------------
+/// Fills x with pseudo-random values in [-0.5, 0.5), deterministic per seed.
+template <typename T>
+void randomize( std::vector<T>& x, uint64_t seed )
+{
+    typedef blas::real_type<T> real_t;
+    uint64_t state = seed * 6364136223846793005ull + 1442695040888963407ull;
+    auto next = [&state]() {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        return real_t( (state >> 11) * (1.0 / 9007199254740992.0) - 0.5 );
+    };
+    for (auto& xi : x) {
+        real_t re = next();
+        real_t im = next();
+        xi = blas::make_scalar<T>( re, im );
+    }
+}
+
+// -----------------------------------------------------------------------------
+/// Adds n to the diagonal of the n-by-n matrix A, so triangular solves
+/// are well conditioned.
+template <typename T>
+void make_diag_dominant( int64_t n, std::vector<T>& A, int64_t lda )
+{
+    for (int64_t i = 0; i < n; ++i)
+        A[ i + i*lda ] += blas::real_type<T>( n );
+}
+
+// -----------------------------------------------------------------------------
+// Each returns false if routine isn't in that group or doesn't exist for the
+// type; otherwise runs the benchmark and fills in result.
+bool bench_blas1( Options const& opts, std::string const& routine,
+                  char type, Dims dims, Result& result );
+
+bool bench_blas2( Options const& opts, std::string const& routine,
+                  char type, Dims dims, Result& result );
+
+bool bench_blas3( Options const& opts, std::string const& routine,
+                  char type, Dims dims, Result& result );
+
+bool bench_batch( Options const& opts, std::string const& routine,
+                  char type, Dims dims, Result& result );
+
+bool bench_fixed( Options const& opts, std::string const& routine,
+                  char type, Dims dims, Result& result );
+
+}  // namespace bench
+
+#endif        //  #ifndef BENCH_HH
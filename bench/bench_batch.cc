@@ -0,0 +1,197 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "bench.hh"
+
+namespace bench {
+
+// -----------------------------------------------------------------------------
+/// Batch Level 3 BLAS benchmarks, using the fixed-size interface:
+/// opts.batch independent problems with the same dimensions and options
+/// as the corresponding Level 3 benchmark in bench_blas3.cc.
+/// Gflop and Gbyte are totals over the batch.
+template <typename T>
+bool run_batch( Options const& opts, std::string const& routine,
+                Dims dims, Result& result )
+{
+    using blas::Gflop;
+    using blas::Gbyte;
+    using blas::Op;
+    using blas::Side;
+    using blas::Uplo;
+    using blas::Diag;
+    typedef blas::real_type<T> real_t;
+
+    const std::string prefix = "batch-";
+    if (routine.compare( 0, prefix.size(), prefix ) != 0)
+        return false;
+    std::string name = routine.substr( prefix.size() );
+
+    blas::Layout layout = opts.layout;
+    bool col = (layout == blas::Layout::ColMajor);
+    size_t batch = opts.batch;
+    int64_t m = dims.m, n = dims.n, k = dims.k;
+
+    // Allocates batch rows-by-cols matrices in layout, contiguously,
+    // setting pointers and returning the leading dimension.
+    auto alloc = [col, batch]( std::vector<T>& M, std::vector<T*>& Mptr,
+                               int64_t rows, int64_t cols, uint64_t seed ) {
+        int64_t ld = std::max( col ? rows : cols, int64_t( 1 ) );
+        int64_t size = ld * (col ? cols : rows);
+        M.resize( size * batch );
+        randomize( M, seed );
+        Mptr.resize( batch );
+        for (size_t i = 0; i < batch; ++i)
+            Mptr[ i ] = &M[ i * size ];
+        return ld;
+    };
+    std::vector<T> A, B, C;
+    std::vector<T*> Aptr, Bptr, Cptr;
+    std::vector<int64_t> info( batch );
+
+    std::vector<T> alpha( 1, blas::make_scalar<T>( 1.5, 0.5 ) );
+    std::vector<T> beta ( 1, blas::make_scalar<T>( 0.5, 0.25 ) );
+    std::vector<real_t> alpha_r( 1, 1.5 );
+    std::vector<real_t> beta_r ( 1, 0.5 );
+    std::vector<Op>   notrans( 1, Op::NoTrans );
+    std::vector<Side> left   ( 1, Side::Left );
+    std::vector<Uplo> lower  ( 1, Uplo::Lower );
+    std::vector<Diag> nonunit( 1, Diag::NonUnit );
+    std::vector<int64_t> vm( 1, m ), vn( 1, n ), vk( 1, k );
+
+    if (name == "gemm") {
+        std::vector<int64_t> lda( 1, alloc( A, Aptr, m, k, 1 ) );
+        std::vector<int64_t> ldb( 1, alloc( B, Bptr, k, n, 2 ) );
+        std::vector<int64_t> ldc( 1, alloc( C, Cptr, m, n, 3 ) );
+        time_call( opts, [&]() {
+            blas::batch::gemm( layout, notrans, notrans, vm, vn, vk,
+                               alpha, Aptr, lda, Bptr, ldb,
+                               beta, Cptr, ldc, batch, info );
+        }, result );
+        result.gflop = Gflop< T >::gemm( m, n, k );
+        result.gbyte = Gbyte< T >::gemm( m, n, k );
+    }
+    else if (name == "hemm" || name == "symm") {
+        std::vector<int64_t> lda( 1, alloc( A, Aptr, m, m, 1 ) );
+        std::vector<int64_t> ldb( 1, alloc( B, Bptr, m, n, 2 ) );
+        std::vector<int64_t> ldc( 1, alloc( C, Cptr, m, n, 3 ) );
+        if (name == "hemm") {
+            time_call( opts, [&]() {
+                blas::batch::hemm( layout, left, lower, vm, vn,
+                                   alpha, Aptr, lda, Bptr, ldb,
+                                   beta, Cptr, ldc, batch, info );
+            }, result );
+        }
+        else {
+            time_call( opts, [&]() {
+                blas::batch::symm( layout, left, lower, vm, vn,
+                                   alpha, Aptr, lda, Bptr, ldb,
+                                   beta, Cptr, ldc, batch, info );
+            }, result );
+        }
+        result.gflop = Gflop< T >::hemm( Side::Left, m, n );
+        result.gbyte = Gbyte< T >::hemm( Side::Left, m, n );
+        k = 0;
+    }
+    else if (name == "herk" || name == "syrk") {
+        std::vector<int64_t> lda( 1, alloc( A, Aptr, n, k, 1 ) );
+        std::vector<int64_t> ldc( 1, alloc( C, Cptr, n, n, 3 ) );
+        if (name == "herk") {
+            time_call( opts, [&]() {
+                blas::batch::herk( layout, lower, notrans, vn, vk,
+                                   alpha_r, Aptr, lda, beta_r, Cptr, ldc,
+                                   batch, info );
+            }, result );
+        }
+        else {
+            time_call( opts, [&]() {
+                blas::batch::syrk( layout, lower, notrans, vn, vk,
+                                   alpha, Aptr, lda, beta, Cptr, ldc,
+                                   batch, info );
+            }, result );
+        }
+        result.gflop = Gflop< T >::herk( n, k );
+        result.gbyte = Gbyte< T >::herk( n, k );
+        m = 0;
+    }
+    else if (name == "her2k" || name == "syr2k") {
+        std::vector<int64_t> lda( 1, alloc( A, Aptr, n, k, 1 ) );
+        std::vector<int64_t> ldb( 1, alloc( B, Bptr, n, k, 2 ) );
+        std::vector<int64_t> ldc( 1, alloc( C, Cptr, n, n, 3 ) );
+        if (name == "her2k") {
+            time_call( opts, [&]() {
+                blas::batch::her2k( layout, lower, notrans, vn, vk,
+                                    alpha, Aptr, lda, Bptr, ldb,
+                                    beta_r, Cptr, ldc, batch, info );
+            }, result );
+        }
+        else {
+            time_call( opts, [&]() {
+                blas::batch::syr2k( layout, lower, notrans, vn, vk,
+                                    alpha, Aptr, lda, Bptr, ldb,
+                                    beta, Cptr, ldc, batch, info );
+            }, result );
+        }
+        result.gflop = Gflop< T >::her2k( n, k );
+        result.gbyte = Gbyte< T >::her2k( n, k );
+        m = 0;
+    }
+    else if (name == "trmm" || name == "trsm") {
+        std::vector<int64_t> lda( 1, alloc( A, Aptr, m, m, 1 ) );
+        std::vector<int64_t> ldb( 1, alloc( B, Bptr, m, n, 2 ) );
+        if (name == "trmm") {
+            time_call( opts, [&]() {
+                blas::batch::trmm( layout, left, lower, notrans, nonunit,
+                                   vm, vn, alpha, Aptr, lda, Bptr, ldb,
+                                   batch, info );
+            }, result );
+        }
+        else {
+            int64_t size = A.size() / batch;
+            for (size_t i = 0; i < batch; ++i) {
+                for (int64_t j = 0; j < m; ++j)
+                    A[ i*size + j + j*lda[0] ] += real_t( m );
+            }
+            time_call( opts, [&]() {
+                blas::batch::trsm( layout, left, lower, notrans, nonunit,
+                                   vm, vn, alpha, Aptr, lda, Bptr, ldb,
+                                   batch, info );
+            }, result );
+        }
+        result.gflop = Gflop< T >::trmm( Side::Left, m, n );
+        result.gbyte = Gbyte< T >::trmm( Side::Left, m, n );
+        k = 0;
+    }
+    else {
+        return false;
+    }
+    result.gflop *= batch;
+    result.gbyte *= batch;
+    result.dims  = Dims { m, n, k };
+    result.batch = batch;
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+bool bench_batch( Options const& opts, std::string const& routine,
+                  char type, Dims dims, Result& result )
+{
+    switch (type) {
+        case 's':
+            return run_batch< float >( opts, routine, dims, result );
+        case 'd':
+            return run_batch< double >( opts, routine, dims, result );
+        case 'c':
+            return run_batch< std::complex<float> >(
+                opts, routine, dims, result );
+        case 'z':
+            return run_batch< std::complex<double> >(
+                opts, routine, dims, result );
+        default:
+            return false;
+    }
+}
+
+}  // namespace bench
@@ -0,0 +1,121 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "bench.hh"
+
+namespace bench {
+
+// -----------------------------------------------------------------------------
+/// Level 1 BLAS benchmarks on vectors of length dims.n, unit stride.
+template <typename T>
+bool run_blas1( Options const& opts, std::string const& routine,
+                Dims dims, Result& result )
+{
+    using blas::Gflop;
+    using blas::Gbyte;
+    typedef blas::real_type<T> real_t;
+
+    int64_t n = dims.n;
+    std::vector<T> x( n ), y( n );
+    randomize( x, 1 );
+    randomize( y, 2 );
+    T alpha = blas::make_scalar<T>( 1.5, 0.5 );
+    volatile real_t sink = 0;
+
+    if (routine == "asum") {
+        time_call( opts, [&]() { sink = blas::asum( n, x.data(), 1 ); },
+                   result );
+        result.gflop = Gflop< T >::asum( n );
+        result.gbyte = Gbyte< T >::asum( n );
+    }
+    else if (routine == "axpy") {
+        time_call( opts, [&]() {
+            blas::axpy( n, alpha, x.data(), 1, y.data(), 1 );
+        }, result );
+        result.gflop = Gflop< T >::axpy( n );
+        result.gbyte = Gbyte< T >::axpy( n );
+    }
+    else if (routine == "copy") {
+        time_call( opts, [&]() { blas::copy( n, x.data(), 1, y.data(), 1 ); },
+                   result );
+        result.gflop = Gflop< T >::copy( n );
+        result.gbyte = Gbyte< T >::copy( n );
+    }
+    else if (routine == "dot") {
+        time_call( opts, [&]() {
+            sink = std::real( blas::dot( n, x.data(), 1, y.data(), 1 ) );
+        }, result );
+        result.gflop = Gflop< T >::dot( n );
+        result.gbyte = Gbyte< T >::dot( n );
+    }
+    else if (routine == "dotu") {
+        time_call( opts, [&]() {
+            sink = std::real( blas::dotu( n, x.data(), 1, y.data(), 1 ) );
+        }, result );
+        result.gflop = Gflop< T >::dot( n );
+        result.gbyte = Gbyte< T >::dot( n );
+    }
+    else if (routine == "iamax") {
+        time_call( opts, [&]() { sink = blas::iamax( n, x.data(), 1 ); },
+                   result );
+        result.gflop = Gflop< T >::iamax( n );
+        result.gbyte = Gbyte< T >::iamax( n );
+    }
+    else if (routine == "nrm2") {
+        time_call( opts, [&]() { sink = blas::nrm2( n, x.data(), 1 ); },
+                   result );
+        result.gflop = Gflop< T >::nrm2( n );
+        result.gbyte = Gbyte< T >::nrm2( n );
+    }
+    else if (routine == "rot") {
+        real_t c = 0.6;
+        real_t s = 0.8;
+        time_call( opts, [&]() {
+            blas::rot( n, x.data(), 1, y.data(), 1, c, s );
+        }, result );
+        // 2 muls + 1 add per entry of x and y; reads and writes x and y.
+        result.gflop = 6. * n * 1e-9 * (blas::is_complex<T>::value ? 2 : 1);
+        result.gbyte = Gbyte< T >::swap( n );
+    }
+    else if (routine == "scal") {
+        time_call( opts, [&]() { blas::scal( n, alpha, x.data(), 1 ); },
+                   result );
+        result.gflop = Gflop< T >::scal( n );
+        result.gbyte = Gbyte< T >::scal( n );
+    }
+    else if (routine == "swap") {
+        time_call( opts, [&]() { blas::swap( n, x.data(), 1, y.data(), 1 ); },
+                   result );
+        result.gflop = Gflop< T >::swap( n );
+        result.gbyte = Gbyte< T >::swap( n );
+    }
+    else {
+        return false;
+    }
+    result.dims = Dims { 0, n, 0 };
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+bool bench_blas1( Options const& opts, std::string const& routine,
+                  char type, Dims dims, Result& result )
+{
+    switch (type) {
+        case 's':
+            return run_blas1< float >( opts, routine, dims, result );
+        case 'd':
+            return run_blas1< double >( opts, routine, dims, result );
+        case 'c':
+            return run_blas1< std::complex<float> >(
+                opts, routine, dims, result );
+        case 'z':
+            return run_blas1< std::complex<double> >(
+                opts, routine, dims, result );
+        default:
+            return false;
+    }
+}
+
+}  // namespace bench
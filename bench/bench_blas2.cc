@@ -0,0 +1,188 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "bench.hh"
+
+namespace bench {
+
+// -----------------------------------------------------------------------------
+/// Level 2 BLAS benchmarks. General routines use an m-by-n matrix;
+/// Hermitian, symmetric, and triangular routines use an n-by-n matrix.
+/// Uses NoTrans, Lower, NonUnit.
+template <typename T>
+bool run_blas2( Options const& opts, std::string const& routine,
+                Dims dims, Result& result )
+{
+    using blas::Gflop;
+    using blas::Gbyte;
+    using blas::Op;
+    using blas::Uplo;
+    using blas::Diag;
+    typedef blas::real_type<T> real_t;
+
+    const bool general = (routine == "gemv" || routine == "ger"
+                          || routine == "geru");
+
+    blas::Layout layout = opts.layout;
+    int64_t m = (general ? dims.m : dims.n);
+    int64_t n = dims.n;
+    int64_t lda = (layout == blas::Layout::ColMajor ? m : n);
+    lda = std::max( lda, int64_t( 1 ) );
+    std::vector<T> A( lda * (layout == blas::Layout::ColMajor ? n : m) );
+    std::vector<T> x( std::max( m, n ) ), y( std::max( m, n ) );
+    randomize( A, 1 );
+    randomize( x, 2 );
+    randomize( y, 3 );
+    T alpha = blas::make_scalar<T>( 1.5, 0.5 );
+    T beta  = blas::make_scalar<T>( 0.5, 0.25 );
+    real_t alpha_r = 1.5;
+
+    if (routine == "gemv") {
+        time_call( opts, [&]() {
+            blas::gemv( layout, Op::NoTrans, m, n, alpha, A.data(), lda,
+                        x.data(), 1, beta, y.data(), 1 );
+        }, result );
+        result.gflop = Gflop< T >::gemv( m, n );
+        result.gbyte = Gbyte< T >::gemv( m, n );
+    }
+    else if (routine == "ger") {
+        time_call( opts, [&]() {
+            blas::ger( layout, m, n, alpha, x.data(), 1, y.data(), 1,
+                       A.data(), lda );
+        }, result );
+        result.gflop = Gflop< T >::ger( m, n );
+        result.gbyte = Gbyte< T >::ger( m, n );
+    }
+    else if (routine == "geru") {
+        time_call( opts, [&]() {
+            blas::geru( layout, m, n, alpha, x.data(), 1, y.data(), 1,
+                        A.data(), lda );
+        }, result );
+        result.gflop = Gflop< T >::ger( m, n );
+        result.gbyte = Gbyte< T >::ger( m, n );
+    }
+    else if (routine == "hemv") {
+        time_call( opts, [&]() {
+            blas::hemv( layout, Uplo::Lower, n, alpha, A.data(), lda,
+                        x.data(), 1, beta, y.data(), 1 );
+        }, result );
+        result.gflop = Gflop< T >::hemv( n );
+        result.gbyte = Gbyte< T >::hemv( n );
+    }
+    else if (routine == "her") {
+        time_call( opts, [&]() {
+            blas::her( layout, Uplo::Lower, n, alpha_r, x.data(), 1,
+                       A.data(), lda );
+        }, result );
+        result.gflop = Gflop< T >::her( n );
+        result.gbyte = Gbyte< T >::her( n );
+    }
+    else if (routine == "her2") {
+        time_call( opts, [&]() {
+            blas::her2( layout, Uplo::Lower, n, alpha, x.data(), 1,
+                        y.data(), 1, A.data(), lda );
+        }, result );
+        result.gflop = Gflop< T >::her2( n );
+        result.gbyte = Gbyte< T >::her2( n );
+    }
+    else if (routine == "syr2") {
+        time_call( opts, [&]() {
+            blas::syr2( layout, Uplo::Lower, n, alpha, x.data(), 1,
+                        y.data(), 1, A.data(), lda );
+        }, result );
+        result.gflop = Gflop< T >::syr2( n );
+        result.gbyte = Gbyte< T >::syr2( n );
+    }
+    else if (routine == "trmv") {
+        time_call( opts, [&]() {
+            blas::trmv( layout, Uplo::Lower, Op::NoTrans, Diag::NonUnit, n,
+                        A.data(), lda, x.data(), 1 );
+        }, result );
+        result.gflop = Gflop< T >::trmv( n );
+        result.gbyte = Gbyte< T >::trmv( n );
+    }
+    else if (routine == "trsv") {
+        make_diag_dominant( n, A, lda );
+        time_call( opts, [&]() {
+            blas::trsv( layout, Uplo::Lower, Op::NoTrans, Diag::NonUnit, n,
+                        A.data(), lda, x.data(), 1 );
+        }, result );
+        result.gflop = Gflop< T >::trsv( n );
+        result.gbyte = Gbyte< T >::trsv( n );
+    }
+    else {
+        return false;
+    }
+    result.dims = Dims { m, n, 0 };
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+/// Level 2 BLAS benchmarks that BLAS++ provides only for real types:
+/// symv and syr, on an n-by-n matrix.
+template <typename T>
+bool run_blas2_real( Options const& opts, std::string const& routine,
+                     Dims dims, Result& result )
+{
+    using blas::Gflop;
+    using blas::Gbyte;
+    using blas::Uplo;
+
+    blas::Layout layout = opts.layout;
+    int64_t n = dims.n;
+    int64_t lda = std::max( n, int64_t( 1 ) );
+    std::vector<T> A( lda * n ), x( n ), y( n );
+    randomize( A, 1 );
+    randomize( x, 2 );
+    randomize( y, 3 );
+    T alpha = 1.5;
+    T beta  = 0.5;
+
+    if (routine == "symv") {
+        time_call( opts, [&]() {
+            blas::symv( layout, Uplo::Lower, n, alpha, A.data(), lda,
+                        x.data(), 1, beta, y.data(), 1 );
+        }, result );
+        result.gflop = Gflop< T >::symv( n );
+        result.gbyte = Gbyte< T >::symv( n );
+    }
+    else if (routine == "syr") {
+        time_call( opts, [&]() {
+            blas::syr( layout, Uplo::Lower, n, alpha, x.data(), 1,
+                       A.data(), lda );
+        }, result );
+        result.gflop = Gflop< T >::syr( n );
+        result.gbyte = Gbyte< T >::syr( n );
+    }
+    else {
+        return false;
+    }
+    result.dims = Dims { n, n, 0 };
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+bool bench_blas2( Options const& opts, std::string const& routine,
+                  char type, Dims dims, Result& result )
+{
+    switch (type) {
+        case 's':
+            return run_blas2< float >( opts, routine, dims, result )
+                || run_blas2_real< float >( opts, routine, dims, result );
+        case 'd':
+            return run_blas2< double >( opts, routine, dims, result )
+                || run_blas2_real< double >( opts, routine, dims, result );
+        case 'c':
+            return run_blas2< std::complex<float> >(
+                opts, routine, dims, result );
+        case 'z':
+            return run_blas2< std::complex<double> >(
+                opts, routine, dims, result );
+        default:
+            return false;
+    }
+}
+
+}  // namespace bench
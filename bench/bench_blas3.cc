@@ -0,0 +1,170 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "bench.hh"
+
+namespace bench {
+
+// -----------------------------------------------------------------------------
+/// Level 3 BLAS benchmarks. gemm is C = AB with A m-by-k, B k-by-n;
+/// hemm, symm, trmm, trsm use Left side with an m-by-m A and m-by-n B;
+/// herk, syrk, her2k, syr2k use an n-by-k A (and B).
+/// Uses NoTrans, Lower, NonUnit. Matrices are stored column-major sized;
+/// with RowMajor layout the leading dimensions are swapped.
+template <typename T>
+bool run_blas3( Options const& opts, std::string const& routine,
+                Dims dims, Result& result )
+{
+    using blas::Gflop;
+    using blas::Gbyte;
+    using blas::Op;
+    using blas::Side;
+    using blas::Uplo;
+    using blas::Diag;
+    typedef blas::real_type<T> real_t;
+
+    blas::Layout layout = opts.layout;
+    bool col = (layout == blas::Layout::ColMajor);
+    int64_t m = dims.m, n = dims.n, k = dims.k;
+    T alpha = blas::make_scalar<T>( 1.5, 0.5 );
+    T beta  = blas::make_scalar<T>( 0.5, 0.25 );
+    real_t alpha_r = 1.5;
+    real_t beta_r  = 0.5;
+
+    // Allocates rows-by-cols matrix in layout, returning its leading dim.
+    auto alloc = [col]( std::vector<T>& M, int64_t rows, int64_t cols,
+                        uint64_t seed ) {
+        int64_t ld = std::max( col ? rows : cols, int64_t( 1 ) );
+        M.resize( ld * (col ? cols : rows) );
+        randomize( M, seed );
+        return ld;
+    };
+    std::vector<T> A, B, C;
+
+    if (routine == "gemm") {
+        int64_t lda = alloc( A, m, k, 1 );
+        int64_t ldb = alloc( B, k, n, 2 );
+        int64_t ldc = alloc( C, m, n, 3 );
+        time_call( opts, [&]() {
+            blas::gemm( layout, Op::NoTrans, Op::NoTrans, m, n, k,
+                        alpha, A.data(), lda, B.data(), ldb,
+                        beta, C.data(), ldc );
+        }, result );
+        result.gflop = Gflop< T >::gemm( m, n, k );
+        result.gbyte = Gbyte< T >::gemm( m, n, k );
+    }
+    else if (routine == "hemm" || routine == "symm") {
+        int64_t lda = alloc( A, m, m, 1 );
+        int64_t ldb = alloc( B, m, n, 2 );
+        int64_t ldc = alloc( C, m, n, 3 );
+        if (routine == "hemm") {
+            time_call( opts, [&]() {
+                blas::hemm( layout, Side::Left, Uplo::Lower, m, n,
+                            alpha, A.data(), lda, B.data(), ldb,
+                            beta, C.data(), ldc );
+            }, result );
+        }
+        else {
+            time_call( opts, [&]() {
+                blas::symm( layout, Side::Left, Uplo::Lower, m, n,
+                            alpha, A.data(), lda, B.data(), ldb,
+                            beta, C.data(), ldc );
+            }, result );
+        }
+        result.gflop = Gflop< T >::hemm( Side::Left, m, n );
+        result.gbyte = Gbyte< T >::hemm( Side::Left, m, n );
+        k = 0;
+    }
+    else if (routine == "herk" || routine == "syrk") {
+        int64_t lda = alloc( A, n, k, 1 );
+        int64_t ldc = alloc( C, n, n, 3 );
+        if (routine == "herk") {
+            time_call( opts, [&]() {
+                blas::herk( layout, Uplo::Lower, Op::NoTrans, n, k,
+                            alpha_r, A.data(), lda, beta_r, C.data(), ldc );
+            }, result );
+        }
+        else {
+            time_call( opts, [&]() {
+                blas::syrk( layout, Uplo::Lower, Op::NoTrans, n, k,
+                            alpha, A.data(), lda, beta, C.data(), ldc );
+            }, result );
+        }
+        result.gflop = Gflop< T >::herk( n, k );
+        result.gbyte = Gbyte< T >::herk( n, k );
+        m = 0;
+    }
+    else if (routine == "her2k" || routine == "syr2k") {
+        int64_t lda = alloc( A, n, k, 1 );
+        int64_t ldb = alloc( B, n, k, 2 );
+        int64_t ldc = alloc( C, n, n, 3 );
+        if (routine == "her2k") {
+            time_call( opts, [&]() {
+                blas::her2k( layout, Uplo::Lower, Op::NoTrans, n, k,
+                             alpha, A.data(), lda, B.data(), ldb,
+                             beta_r, C.data(), ldc );
+            }, result );
+        }
+        else {
+            time_call( opts, [&]() {
+                blas::syr2k( layout, Uplo::Lower, Op::NoTrans, n, k,
+                             alpha, A.data(), lda, B.data(), ldb,
+                             beta, C.data(), ldc );
+            }, result );
+        }
+        result.gflop = Gflop< T >::her2k( n, k );
+        result.gbyte = Gbyte< T >::her2k( n, k );
+        m = 0;
+    }
+    else if (routine == "trmm" || routine == "trsm") {
+        int64_t lda = alloc( A, m, m, 1 );
+        int64_t ldb = alloc( B, m, n, 2 );
+        if (routine == "trmm") {
+            time_call( opts, [&]() {
+                blas::trmm( layout, Side::Left, Uplo::Lower, Op::NoTrans,
+                            Diag::NonUnit, m, n, alpha, A.data(), lda,
+                            B.data(), ldb );
+            }, result );
+        }
+        else {
+            make_diag_dominant( m, A, lda );
+            time_call( opts, [&]() {
+                blas::trsm( layout, Side::Left, Uplo::Lower, Op::NoTrans,
+                            Diag::NonUnit, m, n, alpha, A.data(), lda,
+                            B.data(), ldb );
+            }, result );
+        }
+        result.gflop = Gflop< T >::trmm( Side::Left, m, n );
+        result.gbyte = Gbyte< T >::trmm( Side::Left, m, n );
+        k = 0;
+    }
+    else {
+        return false;
+    }
+    result.dims = Dims { m, n, k };
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+bool bench_blas3( Options const& opts, std::string const& routine,
+                  char type, Dims dims, Result& result )
+{
+    switch (type) {
+        case 's':
+            return run_blas3< float >( opts, routine, dims, result );
+        case 'd':
+            return run_blas3< double >( opts, routine, dims, result );
+        case 'c':
+            return run_blas3< std::complex<float> >(
+                opts, routine, dims, result );
+        case 'z':
+            return run_blas3< std::complex<double> >(
+                opts, routine, dims, result );
+        default:
+            return false;
+    }
+}
+
+}  // namespace bench
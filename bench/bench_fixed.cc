@@ -0,0 +1,175 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "bench.hh"
+
+#include <stdexcept>
+
+namespace bench {
+
+// -----------------------------------------------------------------------------
+/// Fixed-size benchmarks, comparing blas::fixed routines (fixed-gemm, etc.)
+/// with the runtime routines on the same sizes (small-gemm, etc.). Each call
+/// is a loop over a batch of independent n-by-n problems (vectors of
+/// length n), as in an inner loop over small matrices, so the per-call
+/// overhead of the runtime routines is included. Uses NoTrans, Lower,
+/// NonUnit. n must be a compile-time size in the dispatch of run_fixed.
+template <typename T, int64_t n, blas::Layout layout>
+bool run_fixed_n( Options const& opts, std::string const& routine,
+                  Result& result )
+{
+    using blas::Gflop;
+    using blas::Gbyte;
+    using blas::Op;
+    using blas::Uplo;
+    using blas::Diag;
+
+    int64_t batch = opts.batch;
+    std::vector<T> A( n*n*batch ), B( n*n*batch ), C( n*n*batch );
+    std::vector<T> b( n*batch ), x( n*batch ), y( n*batch );
+    randomize( A, 1 );
+    randomize( B, 2 );
+    randomize( C, 3 );
+    randomize( b, 4 );
+    randomize( y, 5 );
+    T alpha = blas::make_scalar<T>( 1.5, 0.5 );
+    T beta  = blas::make_scalar<T>( 0.5, 0.25 );
+
+    if (routine == "fixed-gemm") {
+        time_call( opts, [&]() {
+            for (int64_t i = 0; i < batch; ++i) {
+                blas::fixed::gemm< n, n, n, layout >(
+                    alpha, &A[ i*n*n ], &B[ i*n*n ], beta, &C[ i*n*n ] );
+            }
+        }, result );
+    }
+    else if (routine == "small-gemm") {
+        time_call( opts, [&]() {
+            for (int64_t i = 0; i < batch; ++i) {
+                blas::gemm( layout, Op::NoTrans, Op::NoTrans, n, n, n,
+                            alpha, &A[ i*n*n ], n, &B[ i*n*n ], n,
+                            beta, &C[ i*n*n ], n );
+            }
+        }, result );
+    }
+    else if (routine == "fixed-gemv") {
+        time_call( opts, [&]() {
+            for (int64_t i = 0; i < batch; ++i) {
+                blas::fixed::gemv< n, n, layout >(
+                    alpha, &A[ i*n*n ], &b[ i*n ], beta, &y[ i*n ] );
+            }
+        }, result );
+    }
+    else if (routine == "small-gemv") {
+        time_call( opts, [&]() {
+            for (int64_t i = 0; i < batch; ++i) {
+                blas::gemv( layout, Op::NoTrans, n, n,
+                            alpha, &A[ i*n*n ], n, &b[ i*n ], 1,
+                            beta, &y[ i*n ], 1 );
+            }
+        }, result );
+    }
+    else if (routine == "fixed-trsv" || routine == "small-trsv") {
+        // well conditioned; each call solves from the same b
+        for (int64_t i = 0; i < batch; ++i) {
+            for (int64_t j = 0; j < n; ++j)
+                A[ i*n*n + j + j*n ] += blas::real_type<T>( n );
+        }
+        if (routine == "fixed-trsv") {
+            time_call( opts, [&]() {
+                std::copy( b.begin(), b.end(), x.begin() );
+                for (int64_t i = 0; i < batch; ++i) {
+                    blas::fixed::trsv< n, layout, Uplo::Lower, Op::NoTrans,
+                                       Diag::NonUnit >( &A[ i*n*n ], &x[ i*n ] );
+                }
+            }, result );
+        }
+        else {
+            time_call( opts, [&]() {
+                std::copy( b.begin(), b.end(), x.begin() );
+                for (int64_t i = 0; i < batch; ++i) {
+                    blas::trsv( layout, Uplo::Lower, Op::NoTrans,
+                                Diag::NonUnit, n, &A[ i*n*n ], n, &x[ i*n ], 1 );
+                }
+            }, result );
+        }
+    }
+    else {
+        return false;
+    }
+
+    if (routine == "fixed-gemm" || routine == "small-gemm") {
+        result.gflop = Gflop< T >::gemm( n, n, n ) * batch;
+        result.gbyte = Gbyte< T >::gemm( n, n, n ) * batch;
+        result.dims  = Dims { n, n, n };
+    }
+    else if (routine == "fixed-gemv" || routine == "small-gemv") {
+        result.gflop = Gflop< T >::gemv( n, n ) * batch;
+        result.gbyte = Gbyte< T >::gemv( n, n ) * batch;
+        result.dims  = Dims { n, n, 0 };
+    }
+    else {
+        result.gflop = Gflop< T >::trsv( n ) * batch;
+        result.gbyte = Gbyte< T >::trsv( n ) * batch;
+        result.dims  = Dims { n, n, 0 };
+    }
+    result.batch = batch;
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+/// Dispatches the runtime layout to a template parameter.
+template <typename T, int64_t n>
+bool run_fixed_layout( Options const& opts, std::string const& routine,
+                       Result& result )
+{
+    if (opts.layout == blas::Layout::ColMajor)
+        return run_fixed_n< T, n, blas::Layout::ColMajor >(
+            opts, routine, result );
+    else
+        return run_fixed_n< T, n, blas::Layout::RowMajor >(
+            opts, routine, result );
+}
+
+// -----------------------------------------------------------------------------
+/// Dispatches the runtime size n to a template parameter.
+template <typename T>
+bool run_fixed( Options const& opts, std::string const& routine,
+                Dims dims, Result& result )
+{
+    switch (dims.n) {
+        case 2: return run_fixed_layout< T, 2 >( opts, routine, result );
+        case 3: return run_fixed_layout< T, 3 >( opts, routine, result );
+        case 4: return run_fixed_layout< T, 4 >( opts, routine, result );
+        case 5: return run_fixed_layout< T, 5 >( opts, routine, result );
+        case 6: return run_fixed_layout< T, 6 >( opts, routine, result );
+        case 8: return run_fixed_layout< T, 8 >( opts, routine, result );
+        default:
+            throw std::runtime_error(
+                "fixed-size n must be one of 2, 3, 4, 5, 6, 8" );
+    }
+}
+
+// -----------------------------------------------------------------------------
+bool bench_fixed( Options const& opts, std::string const& routine,
+                  char type, Dims dims, Result& result )
+{
+    switch (type) {
+        case 's':
+            return run_fixed< float >( opts, routine, dims, result );
+        case 'd':
+            return run_fixed< double >( opts, routine, dims, result );
+        case 'c':
+            return run_fixed< std::complex<float> >(
+                opts, routine, dims, result );
+        case 'z':
+            return run_fixed< std::complex<double> >(
+                opts, routine, dims, result );
+        default:
+            return false;
+    }
+}
+
+}  // namespace bench
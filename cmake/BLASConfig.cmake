@@ -248,6 +248,34 @@ else()
     set(compile_output1 "")
 endif()
 
+message(STATUS "Checking for BLAS gemmt extension...")
+
+try_run(run_res1 compile_res1 ${CMAKE_CURRENT_BINARY_DIR}
+    SOURCES
+        ${CMAKE_CURRENT_SOURCE_DIR}/config/blas_gemmt.cc
+    LINK_LIBRARIES
+        ${BLAS_links}
+        ${BLAS_cxx_flags}
+    COMPILE_DEFINITIONS
+        ${BLAS_int}
+    COMPILE_OUTPUT_VARIABLE
+        compile_output1
+    RUN_OUTPUT_VARIABLE
+        run_output1
+)
+
+if (compile_res1 AND "${run_output1}" MATCHES "ok")
+    message("${Blue}  BLAS (dgemmt) available${ColourReset}")
+    set(BLAS_GEMMT_DEFINES "HAVE_GEMMT" CACHE INTERNAL "")
+else()
+    message("${Red}  BLAS (dgemmt) not found; using BLAS++ gemmt${ColourReset}")
+    set(BLAS_GEMMT_DEFINES "" CACHE INTERNAL "")
+endif()
+set(run_res1 "")
+set(compile_res1 "")
+set(run_output1 "")
+set(compile_output1 "")
+
 if(DEBUG)
     message("lib defines: " ${LIB_DEFINES})
     message("blas defines: " ${BLAS_DEFINES})
@@ -255,6 +283,7 @@ if(DEBUG)
     message("fortran mangling defines: " ${FORTRAN_MANGLING_DEFINES})
     message("blas complex return: " ${BLAS_COMPLEX_RETURN})
     message("blas float return: " ${BLAS_FLOAT_RETURN})
+    message("blas gemmt: " ${BLAS_GEMMT_DEFINES})
     message("config_found: " ${config_found})
 endif()
 
@@ -498,6 +498,19 @@ def blas_complex_return():
         print_warn( 'unexpected error!' )
 # end
 
+#-------------------------------------------------------------------------------
+def blas_gemmt():
+    '''
+    Check for gemmt, an extension in MKL, BLIS, and recent OpenBLAS that
+    computes one triangle of a general matrix product.
+    '''
+    (rc, out, err) = config.compile_run(
+        'config/blas_gemmt.cc', {},
+        'BLAS (dgemmt) available' )
+    if (rc == 0):
+        config.environ.append( 'CXXFLAGS', '-DHAVE_GEMMT' )
+# end
+
 #-------------------------------------------------------------------------------
 def lapack_version():
     '''
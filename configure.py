@@ -80,6 +80,7 @@ def main():
     config.lapack.blas_float_return()
     config.lapack.blas_complex_return()
     config.lapack.vendor_version()
+    config.lapack.blas_gemmt()
 
     # Must test mkl_version before cblas, to define HAVE_MKL.
     try:
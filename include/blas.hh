@@ -63,6 +63,66 @@ const char* blaspp_id();
 #include "blas/trmm.hh"
 #include "blas/trsm.hh"
 
+// =============================================================================
+// Pre-packed gemm operands
+
+#include "blas/gemm_pack.hh"
+
+// =============================================================================
+// gemm with fused epilogue: bias, scaling, activation
+
+#include "blas/gemm_epilogue.hh"
+
+// =============================================================================
+// Out-of-core gemm on matrices in files
+
+#include "blas/gemm_ooc.hh"
+
+// =============================================================================
+// Fixed-size BLAS, with compile-time dimensions
+
+#include "blas/fixed.hh"
+
+// =============================================================================
+// Tiled Level 3 BLAS, executed as a graph of tasks
+
+#include "blas/tiled.hh"
+
+// =============================================================================
+// NUMA topology, memory placement, and locality-aware scheduling
+
+#include "blas/numa.hh"
+
+// =============================================================================
+// Thread count control, coordinated with the vendor BLAS
+
+#include "blas/threads.hh"
+
+// =============================================================================
+// Sparse matrix times dense vector or matrix
+
+#include "blas/sparse.hh"
+
+// =============================================================================
+// Column and row norms and iamax of a matrix
+
+#include "blas/norms.hh"
+
+// =============================================================================
+// Dispatch between vendor BLAS and in-library kernels
+
+#include "blas/tune.hh"
+
+// =============================================================================
+// Profiling of BLAS++ calls
+
+#include "blas/profile.hh"
+
+// =============================================================================
+// Bitwise reproducible reductions
+
+#include "blas/repro.hh"
+
 // =============================================================================
 // Device BLAS
 
@@ -139,6 +139,127 @@ void gemm_check(
     }
 }
 
+// -----------------------------------------------------------------------------
+// batch gemmt check
+template<typename T>
+void gemmt_check(
+        blas::Layout                   layout,
+        std::vector<blas::Uplo> const &uplo,
+        std::vector<blas::Op>   const &transA,
+        std::vector<blas::Op>   const &transB,
+        std::vector<int64_t>    const &n,
+        std::vector<int64_t>    const &k,
+        std::vector<T >         const &alpha,
+        std::vector<T*>         const &A, std::vector<int64_t> const &lda,
+        std::vector<T*>         const &B, std::vector<int64_t> const &ldb,
+        std::vector<T >         const &beta,
+        std::vector<T*>         const &C, std::vector<int64_t> const &ldc,
+        const size_t batchCount, std::vector<int64_t> &info)
+{
+    // size error checking
+    blas_error_if( (uplo.size()   != 1 && uplo.size()   != batchCount) );
+    blas_error_if( (transA.size() != 1 && transA.size() != batchCount) );
+    blas_error_if( (transB.size() != 1 && transB.size() != batchCount) );
+
+    blas_error_if( (n.size() != 1 && n.size() != batchCount) );
+    blas_error_if( (k.size() != 1 && k.size() != batchCount) );
+
+    blas_error_if( (alpha.size() != 1 && alpha.size() != batchCount) );
+    blas_error_if( (beta.size()  != 1 && beta.size()  != batchCount) );
+
+    blas_error_if( (lda.size() != 1 && lda.size() != batchCount) );
+    blas_error_if( (ldb.size() != 1 && ldb.size() != batchCount) );
+    blas_error_if( (ldc.size() != 1 && ldc.size() != batchCount) );
+
+    // to support checking errors for the group interface, batchCount will be equal to group_count
+    // but the data arrays are generally >= group_count
+    blas_error_if( (A.size() != 1 && A.size() < batchCount) );
+    blas_error_if( (B.size() != 1 && B.size() < batchCount) );
+    blas_error_if( (C.size() < batchCount) );
+
+    blas_error_if( A.size() == 1 && (n.size() > 1 || k.size() > 1 || lda.size() > 1) );
+    blas_error_if( B.size() == 1 && (n.size() > 1 || k.size() > 1 || ldb.size() > 1) );
+    blas_error_if( C.size() == 1 &&
+               (uplo.size()   > 1 ||
+                transA.size() > 1 || transB.size() > 1 ||
+                n.size()      > 1 || k.size()      > 1 ||
+                alpha.size()  > 1 || beta.size()   > 1 ||
+                lda.size()    > 1 || ldb.size()    > 1 || ldc.size() > 1 ||
+                A.size()      > 1 || B.size()      > 1
+                )
+             );
+
+    int64_t* internal_info;
+    if (info.size() == 1) {
+        internal_info = new int64_t[batchCount];
+    }
+    else {
+        internal_info = &info[0];
+    }
+
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t i = 0; i < batchCount; ++i) {
+        Uplo uplo_   = extract<Uplo>(uplo, i);
+        Op   transA_ = extract<Op>(transA, i);
+        Op   transB_ = extract<Op>(transB, i);
+
+        int64_t n_ = extract<int64_t>(n, i);
+        int64_t k_ = extract<int64_t>(k, i);
+
+        int64_t lda_ = extract<int64_t>(lda, i);
+        int64_t ldb_ = extract<int64_t>(ldb, i);
+        int64_t ldc_ = extract<int64_t>(ldc, i);
+
+        int64_t nrowA_ = ((transA_ == Op::NoTrans) ^ (layout == Layout::RowMajor)) ? n_ : k_;
+        int64_t nrowB_ = ((transB_ == Op::NoTrans) ^ (layout == Layout::RowMajor)) ? k_ : n_;
+
+        internal_info[i] = 0;
+        if (uplo_ != Uplo::Lower && uplo_ != Uplo::Upper) {
+            internal_info[i] = -2;
+        }
+        else if (transA_ != Op::NoTrans &&
+                 transA_ != Op::Trans   &&
+                 transA_ != Op::ConjTrans) {
+            internal_info[i] = -3;
+        }
+        else if (transB_ != Op::NoTrans &&
+                 transB_ != Op::Trans   &&
+                 transB_ != Op::ConjTrans) {
+            internal_info[i] = -4;
+        }
+        else if (n_ < 0) internal_info[i] = -5;
+        else if (k_ < 0) internal_info[i] = -6;
+        else if (lda_ < nrowA_) internal_info[i] = -9;
+        else if (ldb_ < nrowB_) internal_info[i] = -11;
+        else if (ldc_ < n_)     internal_info[i] = -14;
+    }
+
+    if (info.size() == 1) {
+        // do a reduction that finds the first argument to encounter an error
+        int64_t lerror = INTERNAL_INFO_DEFAULT;
+        #pragma omp parallel for reduction(max:lerror)
+        for (size_t i = 0; i < batchCount; ++i) {
+            if (internal_info[i] == 0) continue;    // skip problems that passed error checks
+            lerror = std::max(lerror, internal_info[i]);
+        }
+        info[0] = (lerror == INTERNAL_INFO_DEFAULT) ? 0 : lerror;
+
+        // delete the internal vector
+        delete[] internal_info;
+
+        // throw an exception if needed
+        blas_error_if_msg( info[0] != 0, "info = %lld", (long long) info[0] );
+    }
+    else {
+        int64_t info_ = 0;
+        #pragma omp parallel for reduction(+:info_)
+        for (size_t i = 0; i < batchCount; ++i) {
+            info_ += info[i];
+        }
+        blas_error_if_msg( info_ != 0, "One or more non-zero entry in vector info");
+    }
+}
+
 // -----------------------------------------------------------------------------
 // batch trsm check
 template<typename T>
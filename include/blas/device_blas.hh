@@ -69,6 +69,56 @@ void gemm(
     std::complex<double>       *dC, int64_t lddc,
     blas::Queue &queue );
 
+// -----------------------------------------------------------------------------
+// geam
+void geam(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n,
+    float alpha,
+    float const *dA, int64_t ldda,
+    float beta,
+    float const *dB, int64_t lddb,
+    float       *dC, int64_t lddc,
+    blas::Queue &queue );
+
+void geam(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n,
+    double alpha,
+    double const *dA, int64_t ldda,
+    double beta,
+    double const *dB, int64_t lddb,
+    double       *dC, int64_t lddc,
+    blas::Queue &queue );
+
+void geam(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n,
+    std::complex<float> alpha,
+    std::complex<float> const *dA, int64_t ldda,
+    std::complex<float> beta,
+    std::complex<float> const *dB, int64_t lddb,
+    std::complex<float>       *dC, int64_t lddc,
+    blas::Queue &queue );
+
+void geam(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n,
+    std::complex<double> alpha,
+    std::complex<double> const *dA, int64_t ldda,
+    std::complex<double> beta,
+    std::complex<double> const *dB, int64_t lddb,
+    std::complex<double>       *dC, int64_t lddc,
+    blas::Queue &queue );
+
 // -----------------------------------------------------------------------------
 // trsm
 void trsm(
@@ -65,6 +65,48 @@ void DEVICE_zgemm(
     std::complex<double> beta,
     std::complex<double>       *dC, device_blas_int lddc);
 
+// -----------------------------------------------------------------------------
+// geam
+void DEVICE_sgeam(
+    device_blas_handle_t handle,
+    device_trans_t transA, device_trans_t transB,
+    device_blas_int m, device_blas_int n,
+    float alpha,
+    float const *dA, device_blas_int ldda,
+    float beta,
+    float const *dB, device_blas_int lddb,
+    float       *dC, device_blas_int lddc);
+
+void DEVICE_dgeam(
+    device_blas_handle_t handle,
+    device_trans_t transA, device_trans_t transB,
+    device_blas_int m, device_blas_int n,
+    double alpha,
+    double const *dA, device_blas_int ldda,
+    double beta,
+    double const *dB, device_blas_int lddb,
+    double       *dC, device_blas_int lddc);
+
+void DEVICE_cgeam(
+    device_blas_handle_t handle,
+    device_trans_t transA, device_trans_t transB,
+    device_blas_int m, device_blas_int n,
+    std::complex<float> alpha,
+    std::complex<float> const *dA, device_blas_int ldda,
+    std::complex<float> beta,
+    std::complex<float> const *dB, device_blas_int lddb,
+    std::complex<float>       *dC, device_blas_int lddc);
+
+void DEVICE_zgeam(
+    device_blas_handle_t handle,
+    device_trans_t transA, device_trans_t transB,
+    device_blas_int m, device_blas_int n,
+    std::complex<double> alpha,
+    std::complex<double> const *dA, device_blas_int ldda,
+    std::complex<double> beta,
+    std::complex<double> const *dB, device_blas_int lddb,
+    std::complex<double>       *dC, device_blas_int lddc);
+
 // -----------------------------------------------------------------------------
 // trsm
 void DEVICE_strsm(
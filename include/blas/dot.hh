@@ -12,6 +12,64 @@
 
 namespace blas {
 
+// =============================================================================
+/// @return dot product, \f$ x^H y. \f$
+/// @see dotu for unconjugated version, \f$ x^T y. \f$
+///
+/// Generic implementation for arbitrary data types.
+///
+/// @param[in] n
+///     Number of elements in x and y. n >= 0.
+///
+/// @param[in] x
+///     The n-element vector x, in an array of length (n-1)*abs(incx) + 1.
+///
+/// @param[in] incx
+///     Stride between elements of x. incx must not be zero.
+///     If incx < 0, uses elements of x in reverse order: x(n-1), ..., x(0).
+///
+/// @param[in] y
+///     The n-element vector y, in an array of length (n-1)*abs(incy) + 1.
+///
+/// @param[in] incy
+///     Stride between elements of y. incy must not be zero.
+///     If incy < 0, uses elements of y in reverse order: y(n-1), ..., y(0).
+///
+/// @ingroup dot
+
+template< typename TX, typename TY >
+scalar_type<TX, TY> dot(
+    int64_t n,
+    TX const *x, int64_t incx,
+    TY const *y, int64_t incy )
+{
+    typedef scalar_type<TX, TY> scalar_t;
+
+    // check arguments
+    blas_error_if( n < 0 );
+    blas_error_if( incx == 0 );
+    blas_error_if( incy == 0 );
+
+    scalar_t result = 0;
+    if (incx == 1 && incy == 1) {
+        // unit stride
+        for (int64_t i = 0; i < n; ++i) {
+            result += conj( x[i] ) * y[i];
+        }
+    }
+    else {
+        // non-unit stride
+        int64_t ix = (incx > 0 ? 0 : (-n + 1)*incx);
+        int64_t iy = (incy > 0 ? 0 : (-n + 1)*incy);
+        for (int64_t i = 0; i < n; ++i) {
+            result += conj( x[ix] ) * y[iy];
+            ix += incx;
+            iy += incy;
+        }
+    }
+    return result;
+}
+
 // =============================================================================
 /// @return unconjugated dot product, \f$ x^T y. \f$
 /// @see dot for conjugated version, \f$ x^H y. \f$
@@ -0,0 +1,276 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BLAS_FIXED_HH
+#define BLAS_FIXED_HH
+
+#include "blas/util.hh"
+
+//------------------------------------------------------------------------------
+/// Asks the compiler to fully unroll the following loop, if it has at most
+/// 16 iterations, independent of the optimization level. Loops in
+/// blas::fixed have compile-time trip counts, so once unrolled, small
+/// arrays indexed by the loop counter are kept in registers.
+#if defined( __GNUC__ ) || defined( __clang__ )
+    #define BLAS_FIXED_UNROLL _Pragma( "GCC unroll 16" )
+#else
+    #define BLAS_FIXED_UNROLL
+#endif
+
+namespace blas {
+
+// =============================================================================
+/// BLAS on small matrices and vectors whose dimensions, layout, and options
+/// are compile-time constants, e.g., 3x3 or 4x4 matrices in an inner loop.
+///
+/// Routines are header-only inline templates without argument checks or
+/// profiling, so the compiler can inline them and fully unroll their
+/// fixed-length loops. For such sizes, calling the runtime routines, which
+/// check arguments, convert enums to chars, and call the Fortran BLAS, costs
+/// more than the arithmetic.
+///
+/// Vectors have unit stride, and matrices are dense: the leading dimension
+/// is the number of rows (ColMajor) or columns (RowMajor). Semantics are
+/// otherwise those of the runtime routine of the same name; e.g.,
+///
+///     double A[ 9 ], B[ 9 ], C[ 9 ];
+///     blas::fixed::gemm< 3, 3, 3 >( 1.0, A, B, 0.0, C );
+///
+/// computes C = A B for 3x3 ColMajor matrices. As in the runtime routines,
+/// if beta = 0, C or y need not be initialized.
+///
+namespace fixed {
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// @return offset of entry (i, j) of a dense rows-by-cols matrix in layout.
+template <Layout layout, int64_t rows, int64_t cols>
+constexpr int64_t index( int64_t i, int64_t j )
+{
+    return (layout == Layout::ColMajor ? i + j*rows : i*cols + j);
+}
+
+//------------------------------------------------------------------------------
+/// @return a b for real types.
+template <typename T>
+inline T mul( T a, T b )
+{
+    return a * b;
+}
+
+/// @return a b for complex types, by the textbook formula, as in Fortran.
+/// std::complex operator* also recovers infinities from NaN results,
+/// in an out-of-line call that keeps the products from being vectorized.
+template <typename T>
+inline std::complex<T> mul( std::complex<T> a, std::complex<T> b )
+{
+    return std::complex<T>( real( a )*real( b ) - imag( a )*imag( b ),
+                            real( a )*imag( b ) + imag( a )*real( b ) );
+}
+
+//------------------------------------------------------------------------------
+/// @return entry (i, j) of op(A), where op(A) is rows-by-cols, so A is
+/// rows-by-cols for NoTrans, else cols-by-rows.
+template <Layout layout, Op trans, int64_t rows, int64_t cols, typename T>
+inline T op_entry( T const* A, int64_t i, int64_t j )
+{
+    using blas::conj;
+    return (trans == Op::NoTrans
+            ? A[ index< layout, rows, cols >( i, j ) ]
+            : trans == Op::Trans
+            ? A[ index< layout, cols, rows >( j, i ) ]
+            : conj( A[ index< layout, cols, rows >( j, i ) ] ));
+}
+
+}  // namespace internal
+
+//------------------------------------------------------------------------------
+/// @return x^H y for length-N vectors x and y, as blas::dot.
+/// @ingroup dot
+template <int64_t N, typename T>
+inline T dot( T const* x, T const* y )
+{
+    static_assert( N >= 0, "N must be >= 0" );
+    using blas::conj;
+    T result = 0;
+    BLAS_FIXED_UNROLL
+    for (int64_t i = 0; i < N; ++i)
+        result += internal::mul( conj( x[ i ] ), y[ i ] );
+    return result;
+}
+
+//------------------------------------------------------------------------------
+/// y = alpha x + y for length-N vectors x and y, as blas::axpy.
+/// @ingroup axpy
+template <int64_t N, typename T>
+inline void axpy( T alpha, T const* x, T* y )
+{
+    static_assert( N >= 0, "N must be >= 0" );
+    BLAS_FIXED_UNROLL
+    for (int64_t i = 0; i < N; ++i)
+        y[ i ] += internal::mul( alpha, x[ i ] );
+}
+
+//------------------------------------------------------------------------------
+/// y = alpha op(A) x + beta y, for M-by-N A, as blas::gemv.
+/// x has N entries and y has M for NoTrans, and vice-versa otherwise.
+/// @ingroup gemv
+template <int64_t M, int64_t N,
+          Layout layout = Layout::ColMajor,
+          Op trans = Op::NoTrans,
+          typename T>
+inline void gemv( T alpha, T const* A, T const* x, T beta, T* y )
+{
+    static_assert( M >= 0 && N >= 0, "dimensions must be >= 0" );
+    // quick return, without scaling y, as in blas::gemv
+    if (M == 0 || N == 0)
+        return;
+
+    // op(A) is Ym-by-Xn
+    const int64_t Ym = (trans == Op::NoTrans ? M : N);
+    const int64_t Xn = (trans == Op::NoTrans ? N : M);
+
+    // t = op(A) x, as a sum of columns of op(A)
+    T t[ Ym > 0 ? Ym : 1 ];
+    BLAS_FIXED_UNROLL
+    for (int64_t i = 0; i < Ym; ++i)
+        t[ i ] = 0;
+    BLAS_FIXED_UNROLL
+    for (int64_t j = 0; j < Xn; ++j) {
+        T xj = x[ j ];
+        BLAS_FIXED_UNROLL
+        for (int64_t i = 0; i < Ym; ++i)
+            t[ i ] += internal::mul(
+                internal::op_entry< layout, trans, Ym, Xn >( A, i, j ), xj );
+    }
+    // if beta = 0, y need not be initialized
+    if (beta == T( 0 )) {
+        BLAS_FIXED_UNROLL
+        for (int64_t i = 0; i < Ym; ++i)
+            y[ i ] = internal::mul( alpha, t[ i ] );
+    }
+    else {
+        BLAS_FIXED_UNROLL
+        for (int64_t i = 0; i < Ym; ++i)
+            y[ i ] = internal::mul( alpha, t[ i ] )
+                     + internal::mul( beta, y[ i ] );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// A = alpha x y^H + A, for M-by-N A, as blas::ger.
+/// @ingroup ger
+template <int64_t M, int64_t N,
+          Layout layout = Layout::ColMajor,
+          typename T>
+inline void ger( T alpha, T const* x, T const* y, T* A )
+{
+    static_assert( M >= 0 && N >= 0, "dimensions must be >= 0" );
+    using blas::conj;
+    BLAS_FIXED_UNROLL
+    for (int64_t j = 0; j < N; ++j) {
+        T ay = internal::mul( alpha, conj( y[ j ] ) );
+        BLAS_FIXED_UNROLL
+        for (int64_t i = 0; i < M; ++i)
+            A[ internal::index< layout, M, N >( i, j ) ] += internal::mul( x[ i ], ay );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// C = alpha op(A) op(B) + beta C, for M-by-N C, M-by-K op(A), and
+/// K-by-N op(B), as blas::gemm.
+/// @ingroup gemm
+template <int64_t M, int64_t N, int64_t K,
+          Layout layout = Layout::ColMajor,
+          Op transA = Op::NoTrans,
+          Op transB = Op::NoTrans,
+          typename T>
+inline void gemm( T alpha, T const* A, T const* B, T beta, T* C )
+{
+    static_assert( M >= 0 && N >= 0 && K >= 0, "dimensions must be >= 0" );
+    if (M == 0 || N == 0)
+        return;
+
+    BLAS_FIXED_UNROLL
+    for (int64_t j = 0; j < N; ++j) {
+        // t = beta C(:, j) + alpha op(A) op(B)(:, j), as a sum of columns
+        // of op(A); if beta = 0, C need not be initialized
+        T t[ M > 0 ? M : 1 ];
+        if (beta == T( 0 )) {
+            BLAS_FIXED_UNROLL
+            for (int64_t i = 0; i < M; ++i)
+                t[ i ] = 0;
+        }
+        else {
+            BLAS_FIXED_UNROLL
+            for (int64_t i = 0; i < M; ++i)
+                t[ i ] = internal::mul(
+                    beta, C[ internal::index< layout, M, N >( i, j ) ] );
+        }
+        BLAS_FIXED_UNROLL
+        for (int64_t l = 0; l < K; ++l) {
+            T b = internal::mul(
+                alpha, internal::op_entry< layout, transB, K, N >( B, l, j ) );
+            BLAS_FIXED_UNROLL
+            for (int64_t i = 0; i < M; ++i)
+                t[ i ] += internal::mul(
+                    internal::op_entry< layout, transA, M, K >( A, i, l ), b );
+        }
+        BLAS_FIXED_UNROLL
+        for (int64_t i = 0; i < M; ++i)
+            C[ internal::index< layout, M, N >( i, j ) ] = t[ i ];
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Solves op(A) x = b, for N-by-N triangular A, overwriting b with x,
+/// as blas::trsv. No check is made for singularity.
+/// @ingroup trsv
+template <int64_t N,
+          Layout layout = Layout::ColMajor,
+          Uplo uplo = Uplo::Lower,
+          Op trans = Op::NoTrans,
+          Diag diag = Diag::NonUnit,
+          typename T>
+inline void trsv( T const* A, T* x )
+{
+    static_assert( N >= 0, "N must be >= 0" );
+    static_assert( uplo == Uplo::Lower || uplo == Uplo::Upper,
+                   "uplo must be Lower or Upper" );
+    // op(A) is lower if A is lower and not transposed, or upper and transposed
+    const bool lower = ((uplo == Uplo::Lower) == (trans == Op::NoTrans));
+    if (lower) {
+        // forward substitution
+        BLAS_FIXED_UNROLL
+        for (int64_t i = 0; i < N; ++i) {
+            T s = x[ i ];
+            BLAS_FIXED_UNROLL
+            for (int64_t j = 0; j < i; ++j)
+                s -= internal::mul(
+                    internal::op_entry< layout, trans, N, N >( A, i, j ), x[ j ] );
+            x[ i ] = (diag == Diag::Unit
+                      ? s : s / internal::op_entry< layout, trans, N, N >( A, i, i ));
+        }
+    }
+    else {
+        // backward substitution
+        BLAS_FIXED_UNROLL
+        for (int64_t i = N-1; i >= 0; --i) {
+            T s = x[ i ];
+            BLAS_FIXED_UNROLL
+            for (int64_t j = i+1; j < N; ++j)
+                s -= internal::mul(
+                    internal::op_entry< layout, trans, N, N >( A, i, j ), x[ j ] );
+            x[ i ] = (diag == Diag::Unit
+                      ? s : s / internal::op_entry< layout, trans, N, N >( A, i, i ));
+        }
+    }
+}
+
+}  // namespace fixed
+}  // namespace blas
+
+#endif        //  #ifndef BLAS_FIXED_HH
@@ -221,6 +221,10 @@ public:
     static double gemm( double m, double n, double k )
         { return 1e-9 * ((m*k + k*n + 2*m*n) * sizeof(T)); }
 
+    // read A, B, C triangle; write C triangle
+    static double gemmt( double n, double k )
+        { return her2k( n, k ); }
+
     static double hemm( blas::Side side, double m, double n )
     {
         // read A, B, C; write C
@@ -262,6 +266,20 @@ public:
 
     static double trsm( blas::Side side, double m, double n )
         { return trmm( side, m, n ); }
+
+    // ----------------------------------------
+    // Matrix copy, transpose, and addition
+    // read A; write B
+    static double omatcopy( double m, double n )
+        { return 1e-9 * (2*m*n * sizeof(T)); }
+
+    // read A; write A
+    static double imatcopy( double m, double n )
+        { return omatcopy( m, n ); }
+
+    // read A, B; write C
+    static double geam( double m, double n )
+        { return 1e-9 * (3*m*n * sizeof(T)); }
 };
 
 //==============================================================================
@@ -370,6 +388,10 @@ public:
         { return 1e-9 * (mul_ops*fmuls_gemm(m, n, k) +
                          add_ops*fadds_gemm(m, n, k)); }
 
+    // triangle of C, as in herk
+    static double gemmt(double n, double k)
+        { return herk( n, k ); }
+
     static double gbmm(double m, double n, double k, double kl, double ku)
         {
             // gbmm works if and only if A is a square matrix: m == k.
@@ -413,6 +435,17 @@ public:
     static double trsm(blas::Side side, double m, double n)
         { return trmm( side, m, n ); }
 
+    // ----------------------------------------
+    // Matrix copy, transpose, and addition
+    static double omatcopy(double m, double n)
+        { return 1e-9 * (mul_ops*m*n); }
+
+    static double imatcopy(double m, double n)
+        { return omatcopy( m, n ); }
+
+    static double geam(double m, double n)
+        { return 1e-9 * (mul_ops*2*m*n + add_ops*m*n); }
+
 };
 
 }  // namespace blas
@@ -752,6 +752,48 @@ void BLAS_zgemm(
     blas_complex_double const *beta,
     blas_complex_double       *C, blas_int const *ldc );
 
+// -----------------------------------------------------------------------------
+// gemmt is an extension (MKL, BLIS, OpenBLAS), called only if HAVE_GEMMT.
+#define BLAS_sgemmt BLAS_FORTRAN_NAME( sgemmt, SGEMMT )
+void BLAS_sgemmt(
+    char const *uplo, char const *transA, char const *transB,
+    blas_int const *n, blas_int const *k,
+    float const *alpha,
+    float const *A, blas_int const *lda,
+    float const *B, blas_int const *ldb,
+    float const *beta,
+    float       *C, blas_int const *ldc );
+
+#define BLAS_dgemmt BLAS_FORTRAN_NAME( dgemmt, DGEMMT )
+void BLAS_dgemmt(
+    char const *uplo, char const *transA, char const *transB,
+    blas_int const *n, blas_int const *k,
+    double const *alpha,
+    double const *A, blas_int const *lda,
+    double const *B, blas_int const *ldb,
+    double const *beta,
+    double       *C, blas_int const *ldc );
+
+#define BLAS_cgemmt BLAS_FORTRAN_NAME( cgemmt, CGEMMT )
+void BLAS_cgemmt(
+    char const *uplo, char const *transA, char const *transB,
+    blas_int const *n, blas_int const *k,
+    blas_complex_float const *alpha,
+    blas_complex_float const *A, blas_int const *lda,
+    blas_complex_float const *B, blas_int const *ldb,
+    blas_complex_float const *beta,
+    blas_complex_float       *C, blas_int const *ldc );
+
+#define BLAS_zgemmt BLAS_FORTRAN_NAME( zgemmt, ZGEMMT )
+void BLAS_zgemmt(
+    char const *uplo, char const *transA, char const *transB,
+    blas_int const *n, blas_int const *k,
+    blas_complex_double const *alpha,
+    blas_complex_double const *A, blas_int const *lda,
+    blas_complex_double const *B, blas_int const *ldb,
+    blas_complex_double const *beta,
+    blas_complex_double       *C, blas_int const *ldc );
+
 // -----------------------------------------------------------------------------
 #define BLAS_ssymm BLAS_FORTRAN_NAME( ssymm, SSYMM )
 void BLAS_ssymm(
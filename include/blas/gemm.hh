@@ -23,7 +23,9 @@ namespace blas {
 /// op(A) an m-by-k matrix, op(B) a k-by-n matrix, and C an m-by-n matrix.
 ///
 /// Generic implementation for arbitrary data types.
-/// TODO: generic version not yet implemented.
+/// This is a straightforward loop nest, without blocking, so it is useful
+/// for tiny matrices where the overhead of calling the vendor BLAS dominates;
+/// see blas::tune.
 ///
 /// @param[in] layout
 ///     Matrix storage, Layout::ColMajor or Layout::RowMajor.
@@ -97,7 +99,142 @@ void gemm(
     scalar_type<TA, TB, TC> beta,
     TC       *C, int64_t ldc )
 {
-    throw std::exception();  // not yet implemented
+    typedef blas::scalar_type<TA, TB, TC> scalar_t;
+
+    #define A(i_, j_) A[ (i_) + (j_)*lda ]
+    #define B(i_, j_) B[ (i_) + (j_)*ldb ]
+    #define C(i_, j_) C[ (i_) + (j_)*ldc ]
+
+    // constants
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+
+    // check arguments
+    blas_error_if( layout != Layout::ColMajor &&
+                   layout != Layout::RowMajor );
+    blas_error_if( transA != Op::NoTrans &&
+                   transA != Op::Trans &&
+                   transA != Op::ConjTrans );
+    blas_error_if( transB != Op::NoTrans &&
+                   transB != Op::Trans &&
+                   transB != Op::ConjTrans );
+    blas_error_if( m < 0 );
+    blas_error_if( n < 0 );
+    blas_error_if( k < 0 );
+
+    if ((transA == Op::NoTrans) ^ (layout == Layout::RowMajor))
+        blas_error_if( lda < m );
+    else
+        blas_error_if( lda < k );
+
+    if ((transB == Op::NoTrans) ^ (layout == Layout::RowMajor))
+        blas_error_if( ldb < k );
+    else
+        blas_error_if( ldb < n );
+
+    if (layout == Layout::ColMajor)
+        blas_error_if( ldc < m );
+    else
+        blas_error_if( ldc < n );
+
+    // quick return
+    if (m == 0 || n == 0 || ((alpha == zero || k == 0) && beta == one))
+        return;
+
+    if (layout == Layout::RowMajor) {
+        // swap transA <=> transB, m <=> n, B <=> A
+        // explicit template arguments prevent dispatching to the vendor BLAS
+        gemm< TB, TA, TC >( Layout::ColMajor, transB, transA, n, m, k,
+                            alpha, B, ldb, A, lda, beta, C, ldc );
+        return;
+    }
+
+    // ----------
+    // form C = beta*C
+    if (alpha == zero || k == 0) {
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t i = 0; i < m; ++i) {
+                C(i, j) = (beta == zero ? zero : beta * C(i, j));
+            }
+        }
+        return;
+    }
+
+    // ----------
+    if (transA == Op::NoTrans) {
+        // form C = alpha * A * op(B) + beta*C
+        for (int64_t j = 0; j < n; ++j) {
+            if (beta == zero) {
+                for (int64_t i = 0; i < m; ++i) {
+                    C(i, j) = zero;
+                }
+            }
+            else if (beta != one) {
+                for (int64_t i = 0; i < m; ++i) {
+                    C(i, j) *= beta;
+                }
+            }
+            for (int64_t l = 0; l < k; ++l) {
+                scalar_t tmp;
+                if (transB == Op::NoTrans)
+                    tmp = alpha * B(l, j);
+                else if (transB == Op::Trans)
+                    tmp = alpha * B(j, l);
+                else
+                    tmp = alpha * conj( B(j, l) );
+                for (int64_t i = 0; i < m; ++i) {
+                    C(i, j) += tmp * A(i, l);
+                }
+            }
+        }
+    }
+    else {
+        // form C = alpha * A^T * op(B) + beta*C, or with A^H
+        bool conjA = (transA == Op::ConjTrans);
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t i = 0; i < m; ++i) {
+                scalar_t sum = zero;
+                if (transB == Op::NoTrans) {
+                    if (conjA) {
+                        for (int64_t l = 0; l < k; ++l)
+                            sum += conj( A(l, i) ) * B(l, j);
+                    }
+                    else {
+                        for (int64_t l = 0; l < k; ++l)
+                            sum += A(l, i) * B(l, j);
+                    }
+                }
+                else if (transB == Op::Trans) {
+                    if (conjA) {
+                        for (int64_t l = 0; l < k; ++l)
+                            sum += conj( A(l, i) ) * B(j, l);
+                    }
+                    else {
+                        for (int64_t l = 0; l < k; ++l)
+                            sum += A(l, i) * B(j, l);
+                    }
+                }
+                else {
+                    if (conjA) {
+                        for (int64_t l = 0; l < k; ++l)
+                            sum += conj( A(l, i) ) * conj( B(j, l) );
+                    }
+                    else {
+                        for (int64_t l = 0; l < k; ++l)
+                            sum += A(l, i) * conj( B(j, l) );
+                    }
+                }
+                if (beta == zero)
+                    C(i, j) = alpha * sum;
+                else
+                    C(i, j) = alpha * sum + beta * C(i, j);
+            }
+        }
+    }
+
+    #undef A
+    #undef B
+    #undef C
 }
 
 }  // namespace blas
@@ -0,0 +1,144 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BLAS_GEMM_EPILOGUE_HH
+#define BLAS_GEMM_EPILOGUE_HH
+
+#include "blas/util.hh"
+
+#include <cctype>
+
+namespace blas {
+
+// =============================================================================
+/// Elementwise function applied by a gemm epilogue.
+enum class Activation : char {
+    Identity = 'i',  ///< x
+    ReLU     = 'r',  ///< max( x, 0 ); real types only
+    Clamp    = 'c',  ///< min( max( x, lower ), upper ); real types only
+    Sigmoid  = 's',  ///< 1 / (1 + exp( -x ))
+    Tanh     = 't',  ///< tanh( x )
+};
+
+inline char activation2char( Activation activation )
+{
+    return char( activation );
+}
+
+inline const char* activation2str( Activation activation )
+{
+    switch (activation) {
+        case Activation::Identity: return "identity";
+        case Activation::ReLU:     return "relu";
+        case Activation::Clamp:    return "clamp";
+        case Activation::Sigmoid:  return "sigmoid";
+        case Activation::Tanh:     return "tanh";
+    }
+    return "";
+}
+
+inline Activation char2activation( char activation )
+{
+    activation = char( tolower( activation ) );
+    blas_error_if( activation != 'i' && activation != 'r' &&
+                   activation != 'c' && activation != 's' &&
+                   activation != 't' );
+    return Activation( activation );
+}
+
+//------------------------------------------------------------------------------
+/// Epilogue of gemm, fused into the computation of C: after each tile of
+///
+///     T(i, j) = alpha op(A)(i, :) op(B)(:, j) + beta C(i, j)
+///
+/// is computed, and while it is still in registers or cache, C is set to
+///
+///     C(i, j) = f( row_scale[ i ] col_scale[ j ] T(i, j) + bias[ j ] ),
+///
+/// where f is the activation. Null vectors are omitted, i.e., a scale of 1
+/// and bias of 0. Indices are of C as an m-by-n matrix, in either layout.
+/// This avoids a separate pass over C, which reads and writes all of C
+/// again after the gemm.
+///
+/// @ingroup gemm
+template <typename T>
+struct Epilogue
+{
+    /// Per-column bias, length n, or null.
+    T const* bias = nullptr;
+
+    /// Per-row scaling, length m, or null.
+    T const* row_scale = nullptr;
+
+    /// Per-column scaling, length n, or null.
+    T const* col_scale = nullptr;
+
+    /// Elementwise function f.
+    Activation activation = Activation::Identity;
+
+    /// Bounds for Activation::Clamp.
+    real_type<T> lower = 0;
+    real_type<T> upper = 0;
+};
+
+//------------------------------------------------------------------------------
+// C = f( diag( row_scale ) (alpha op(A) op(B) + beta C) diag( col_scale )
+//        + ones bias^T ), per the epilogue; see blas::Epilogue.
+// Other arguments are as in blas::gemm.
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    float alpha,
+    float const *A, int64_t lda,
+    float const *B, int64_t ldb,
+    float beta,
+    float       *C, int64_t ldc,
+    Epilogue<float> const& epilogue );
+
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    double alpha,
+    double const *A, int64_t lda,
+    double const *B, int64_t ldb,
+    double beta,
+    double       *C, int64_t ldc,
+    Epilogue<double> const& epilogue );
+
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<float> alpha,
+    std::complex<float> const *A, int64_t lda,
+    std::complex<float> const *B, int64_t ldb,
+    std::complex<float> beta,
+    std::complex<float>       *C, int64_t ldc,
+    Epilogue< std::complex<float> > const& epilogue );
+
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<double> alpha,
+    std::complex<double> const *A, int64_t lda,
+    std::complex<double> const *B, int64_t ldb,
+    std::complex<double> beta,
+    std::complex<double>       *C, int64_t ldc,
+    Epilogue< std::complex<double> > const& epilogue );
+
+}  // namespace blas
+
+#endif        //  #ifndef BLAS_GEMM_EPILOGUE_HH
@@ -0,0 +1,121 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BLAS_GEMM_OOC_HH
+#define BLAS_GEMM_OOC_HH
+
+#include "blas/util.hh"
+
+namespace blas {
+
+// =============================================================================
+/// Matrix stored in a file, for out-of-core gemm. Entries are stored as in
+/// memory, with the layout passed to gemm and leading dimension ld,
+/// starting at byte offset in the file open as descriptor fd.
+/// The file must be opened for reading, and also for writing if it is C.
+///
+/// Matrices larger than memory can be multiplied without reading them
+/// whole:
+///
+///     int fdA = open( "A.bin", O_RDONLY );
+///     ...
+///     blas::gemm( Layout::ColMajor, Op::NoTrans, Op::NoTrans, m, n, k,
+///                 alpha, FileMatrix<double>( fdA, lda ),
+///                        FileMatrix<double>( fdB, ldb ),
+///                 beta,  FileMatrix<double>( fdC, ldc ),
+///                 size_t(4) << 30 );  // 4 GiB of buffers
+///
+/// The descriptors are used with pread and pwrite, so several matrices may
+/// be in one file at different offsets, and the file position is unchanged.
+/// A memory-mapped matrix is simply a matrix in memory; pass its pointer to
+/// the standard blas::gemm, or its file descriptor here to bound the memory
+/// used and read ahead of the computation.
+///
+/// @ingroup gemm
+template <typename T>
+class FileMatrix
+{
+public:
+    FileMatrix( int fd, int64_t ld, int64_t offset=0 )
+        : fd_( fd ),
+          ld_( ld ),
+          offset_( offset )
+    {}
+
+    /// File descriptor.
+    int fd() const { return fd_; }
+
+    /// Leading dimension, in entries.
+    int64_t ld() const { return ld_; }
+
+    /// Offset of the first entry, in bytes.
+    int64_t offset() const { return offset_; }
+
+private:
+    int fd_;
+    int64_t ld_;
+    int64_t offset_;
+};
+
+//------------------------------------------------------------------------------
+// C = alpha op(A) op(B) + beta C, out-of-core, with A, B, C in files.
+// Tiles are streamed through at most `memory` bytes of buffers, reading the
+// next tiles while the current ones are multiplied. Other arguments are as
+// in blas::gemm.
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    float alpha,
+    FileMatrix<float> const& A,
+    FileMatrix<float> const& B,
+    float beta,
+    FileMatrix<float> const& C,
+    size_t memory );
+
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    double alpha,
+    FileMatrix<double> const& A,
+    FileMatrix<double> const& B,
+    double beta,
+    FileMatrix<double> const& C,
+    size_t memory );
+
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<float> alpha,
+    FileMatrix< std::complex<float> > const& A,
+    FileMatrix< std::complex<float> > const& B,
+    std::complex<float> beta,
+    FileMatrix< std::complex<float> > const& C,
+    size_t memory );
+
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<double> alpha,
+    FileMatrix< std::complex<double> > const& A,
+    FileMatrix< std::complex<double> > const& B,
+    std::complex<double> beta,
+    FileMatrix< std::complex<double> > const& C,
+    size_t memory );
+
+}  // namespace blas
+
+#endif        //  #ifndef BLAS_GEMM_OOC_HH
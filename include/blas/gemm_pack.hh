@@ -0,0 +1,261 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BLAS_GEMM_PACK_HH
+#define BLAS_GEMM_PACK_HH
+
+#include "blas/util.hh"
+
+#include <memory>
+#include <vector>
+
+namespace blas {
+
+// =============================================================================
+/// Operand of gemm, packed once by blas::gemm_pack, to be multiplied many
+/// times without being packed again, e.g., a matrix A applied to many B:
+///
+///     auto Ap = blas::gemm_pack( layout, Side::Left, transA, m, n, k,
+///                                A, lda );
+///     for (...)
+///         blas::gemm( layout, transB, m, n, k, alpha, Ap, B, ldb,
+///                     beta, C, ldc );
+///
+/// The packed format is opaque, and depends on the backend: for real types,
+/// in-library micro-kernel panels if the library is compiled with AVX2 or
+/// AVX-512, otherwise op(A) copied contiguously, as the vendor gemm prefers.
+/// A packed matrix is a copy, so later changes to A don't affect it.
+/// Copies of a PackedMatrix share the same, read-only storage.
+///
+/// @ingroup gemm
+template <typename T>
+class PackedMatrix
+{
+public:
+    /// Packed storage; defined in src/gemm_pack.cc.
+    struct Data;
+
+    PackedMatrix()
+    {}
+
+    PackedMatrix( std::shared_ptr<Data> data, blas::Side side,
+                  int64_t rows, int64_t cols )
+        : data_( data ),
+          side_( side ),
+          rows_( rows ),
+          cols_( cols )
+    {}
+
+    /// Side::Left if A was packed, Side::Right if B was packed.
+    blas::Side side() const { return side_; }
+
+    /// Rows of op(A) or op(B), as packed: m for A, k for B.
+    int64_t rows() const { return rows_; }
+
+    /// Columns of op(A) or op(B), as packed: k for A, n for B.
+    int64_t cols() const { return cols_; }
+
+    /// true if default constructed.
+    bool empty() const { return data_ == nullptr; }
+
+    Data const* data() const { return data_.get(); }
+
+private:
+    std::shared_ptr<Data> data_;
+    blas::Side side_ = blas::Side::Left;
+    int64_t rows_ = 0;
+    int64_t cols_ = 0;
+};
+
+//------------------------------------------------------------------------------
+// Packs op(A), m-by-k, if side = Left, or op(B), k-by-n, if side = Right,
+// for gemm with the given layout; the other dimension (n or m) is ignored.
+// Arguments are as in blas::gemm; trans is transA or transB.
+/// @ingroup gemm
+PackedMatrix<float> gemm_pack(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Op trans,
+    int64_t m, int64_t n, int64_t k,
+    float const *A, int64_t lda );
+
+/// @ingroup gemm
+PackedMatrix<double> gemm_pack(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Op trans,
+    int64_t m, int64_t n, int64_t k,
+    double const *A, int64_t lda );
+
+/// @ingroup gemm
+PackedMatrix< std::complex<float> > gemm_pack(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Op trans,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<float> const *A, int64_t lda );
+
+/// @ingroup gemm
+PackedMatrix< std::complex<double> > gemm_pack(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Op trans,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<double> const *A, int64_t lda );
+
+//------------------------------------------------------------------------------
+// C = alpha op(A) op(B) + beta C, with op(A) packed by gemm_pack, m-by-k.
+// layout applies to B and C; A may have been packed with either layout.
+// Other arguments are as in blas::gemm.
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    float alpha,
+    PackedMatrix<float> const& A,
+    float const *B, int64_t ldb,
+    float beta,
+    float       *C, int64_t ldc );
+
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    double alpha,
+    PackedMatrix<double> const& A,
+    double const *B, int64_t ldb,
+    double beta,
+    double       *C, int64_t ldc );
+
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<float> alpha,
+    PackedMatrix< std::complex<float> > const& A,
+    std::complex<float> const *B, int64_t ldb,
+    std::complex<float> beta,
+    std::complex<float>       *C, int64_t ldc );
+
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<double> alpha,
+    PackedMatrix< std::complex<double> > const& A,
+    std::complex<double> const *B, int64_t ldb,
+    std::complex<double> beta,
+    std::complex<double>       *C, int64_t ldc );
+
+//------------------------------------------------------------------------------
+// C = alpha op(A) op(B) + beta C, with op(B) packed by gemm_pack, k-by-n.
+// layout applies to A and C; B may have been packed with either layout.
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    int64_t m, int64_t n, int64_t k,
+    float alpha,
+    float const *A, int64_t lda,
+    PackedMatrix<float> const& B,
+    float beta,
+    float       *C, int64_t ldc );
+
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    int64_t m, int64_t n, int64_t k,
+    double alpha,
+    double const *A, int64_t lda,
+    PackedMatrix<double> const& B,
+    double beta,
+    double       *C, int64_t ldc );
+
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<float> alpha,
+    std::complex<float> const *A, int64_t lda,
+    PackedMatrix< std::complex<float> > const& B,
+    std::complex<float> beta,
+    std::complex<float>       *C, int64_t ldc );
+
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<double> alpha,
+    std::complex<double> const *A, int64_t lda,
+    PackedMatrix< std::complex<double> > const& B,
+    std::complex<double> beta,
+    std::complex<double>       *C, int64_t ldc );
+
+namespace batch {
+
+//------------------------------------------------------------------------------
+// Batch gemm with one packed op(A), m-by-k, shared by all problems:
+// C_i = alpha_i op(A) op(B_i) + beta_i C_i, for i = 0, ..., batch-1.
+// The other arguments are as in batch::gemm, with m and k given by A.
+/// @ingroup gemm
+void gemm(
+    blas::Layout                 layout,
+    std::vector<blas::Op> const &transB,
+    std::vector<int64_t>  const &n,
+    std::vector< float >   const &alpha,
+    PackedMatrix<float> const& A,
+    std::vector< float* >  const &Barray, std::vector<int64_t> const &lddb,
+    std::vector< float >   const &beta,
+    std::vector< float* >  const &Carray, std::vector<int64_t> const &lddc,
+    const size_t batch,                std::vector<int64_t>       &info );
+
+/// @ingroup gemm
+void gemm(
+    blas::Layout                 layout,
+    std::vector<blas::Op> const &transB,
+    std::vector<int64_t>  const &n,
+    std::vector< double >   const &alpha,
+    PackedMatrix<double> const& A,
+    std::vector< double* >  const &Barray, std::vector<int64_t> const &lddb,
+    std::vector< double >   const &beta,
+    std::vector< double* >  const &Carray, std::vector<int64_t> const &lddc,
+    const size_t batch,                std::vector<int64_t>       &info );
+
+/// @ingroup gemm
+void gemm(
+    blas::Layout                 layout,
+    std::vector<blas::Op> const &transB,
+    std::vector<int64_t>  const &n,
+    std::vector< std::complex<float> >   const &alpha,
+    PackedMatrix< std::complex<float> > const& A,
+    std::vector< std::complex<float>* >  const &Barray, std::vector<int64_t> const &lddb,
+    std::vector< std::complex<float> >   const &beta,
+    std::vector< std::complex<float>* >  const &Carray, std::vector<int64_t> const &lddc,
+    const size_t batch,                std::vector<int64_t>       &info );
+
+/// @ingroup gemm
+void gemm(
+    blas::Layout                 layout,
+    std::vector<blas::Op> const &transB,
+    std::vector<int64_t>  const &n,
+    std::vector< std::complex<double> >   const &alpha,
+    PackedMatrix< std::complex<double> > const& A,
+    std::vector< std::complex<double>* >  const &Barray, std::vector<int64_t> const &lddb,
+    std::vector< std::complex<double> >   const &beta,
+    std::vector< std::complex<double>* >  const &Carray, std::vector<int64_t> const &lddc,
+    const size_t batch,                std::vector<int64_t>       &info );
+
+}  // namespace batch
+
+}  // namespace blas
+
+#endif        //  #ifndef BLAS_GEMM_PACK_HH
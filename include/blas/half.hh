@@ -0,0 +1,289 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BLAS_HALF_HH
+#define BLAS_HALF_HH
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#if defined( __F16C__ )
+    #include <immintrin.h>
+#endif
+
+namespace blas {
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+inline uint32_t float_bits( float x )
+{
+    uint32_t bits;
+    std::memcpy( &bits, &x, sizeof(bits) );
+    return bits;
+}
+
+inline float bits_float( uint32_t bits )
+{
+    float x;
+    std::memcpy( &x, &bits, sizeof(x) );
+    return x;
+}
+
+//------------------------------------------------------------------------------
+/// Converts IEEE binary16 bits to float. Exact.
+inline float half_to_float( uint16_t h )
+{
+    uint32_t sign = uint32_t( h & 0x8000 ) << 16;
+    uint32_t exp  = (h >> 10) & 0x1f;
+    uint32_t mant = h & 0x3ff;
+    if (exp == 0) {
+        if (mant == 0)
+            return bits_float( sign );  // +-0
+        // subnormal: normalize
+        int e = -1;
+        do {
+            mant <<= 1;
+            ++e;
+        } while ((mant & 0x400) == 0);
+        mant &= 0x3ff;
+        return bits_float( sign | uint32_t( 127 - 15 - e ) << 23
+                                | mant << 13 );
+    }
+    else if (exp == 0x1f) {
+        return bits_float( sign | 0x7f800000 | mant << 13 );  // inf, nan
+    }
+    return bits_float( sign | (exp + 127 - 15) << 23 | mant << 13 );
+}
+
+//------------------------------------------------------------------------------
+/// Converts float to IEEE binary16 bits, rounding to nearest even.
+/// Overflow goes to inf; NaN stays NaN.
+inline uint16_t float_to_half( float x )
+{
+    uint32_t bits = float_bits( x );
+    uint16_t sign = (bits >> 16) & 0x8000;
+    uint32_t abs  = bits & 0x7fffffff;
+    if (abs >= 0x7f800000) {
+        // inf or nan; keep nan quiet
+        return sign | 0x7c00 | (abs > 0x7f800000 ? 0x200 : 0);
+    }
+    if (abs >= 0x477ff000) {
+        // >= 65520 rounds to inf
+        return sign | 0x7c00;
+    }
+    if (abs < 0x38800000) {
+        // below smallest normal half, 2^-14: subnormal or zero.
+        // Adding 0.5 aligns the half subnormal ulp, 2^-24, with the float
+        // ulp, so the float add does the rounding.
+        const uint32_t magic = 126 << 23;  // 0.5f
+        float f = bits_float( abs ) + bits_float( magic );
+        return sign | uint16_t( float_bits( f ) - magic );
+    }
+    // normal: rebias exponent, round mantissa to 10 bits
+    uint32_t odd = (abs >> 13) & 1;
+    abs += (uint32_t( 15 - 127 ) << 23) + 0xfff + odd;
+    return sign | uint16_t( abs >> 13 );
+}
+
+//------------------------------------------------------------------------------
+/// Converts bfloat16 bits to float. Exact.
+inline float bfloat16_to_float( uint16_t b )
+{
+    return bits_float( uint32_t( b ) << 16 );
+}
+
+//------------------------------------------------------------------------------
+/// Converts float to bfloat16 bits, rounding to nearest even.
+inline uint16_t float_to_bfloat16( float x )
+{
+    uint32_t bits = float_bits( x );
+    if ((bits & 0x7fffffff) > 0x7f800000)
+        return uint16_t( (bits >> 16) | 0x40 );  // quiet nan
+    bits += 0x7fff + ((bits >> 16) & 1);
+    return uint16_t( bits >> 16 );
+}
+
+}  // namespace internal
+
+//==============================================================================
+/// IEEE 754 binary16 half precision: 1 sign, 5 exponent, 10 mantissa bits.
+/// A storage type: arithmetic converts to float, so expressions such as
+/// `a * b` with float16 a, b are computed in float. Converting back to
+/// float16 rounds to nearest even.
+class float16
+{
+public:
+    float16() = default;
+
+    float16( float x ):
+        bits_( internal::float_to_half( x ) )
+    {}
+
+    /// Converts to float; exact.
+    operator float() const
+        { return internal::half_to_float( bits_ ); }
+
+    /// @return float16 with given bit pattern.
+    static float16 from_bits( uint16_t bits )
+    {
+        float16 x;
+        x.bits_ = bits;
+        return x;
+    }
+
+    /// @return bit pattern.
+    uint16_t bits() const { return bits_; }
+
+    // Compound assignment computes in float, then rounds.
+    float16& operator += ( float x ) { return *this = float( *this ) + x; }
+    float16& operator -= ( float x ) { return *this = float( *this ) - x; }
+    float16& operator *= ( float x ) { return *this = float( *this ) * x; }
+    float16& operator /= ( float x ) { return *this = float( *this ) / x; }
+
+private:
+    uint16_t bits_;
+};
+
+//==============================================================================
+/// bfloat16 (brain floating point): 1 sign, 8 exponent, 7 mantissa bits,
+/// i.e., the top half of a float, with the same range as float but less
+/// precision. A storage type, like float16.
+class bfloat16
+{
+public:
+    bfloat16() = default;
+
+    bfloat16( float x ):
+        bits_( internal::float_to_bfloat16( x ) )
+    {}
+
+    /// Converts to float; exact.
+    operator float() const
+        { return internal::bfloat16_to_float( bits_ ); }
+
+    /// @return bfloat16 with given bit pattern.
+    static bfloat16 from_bits( uint16_t bits )
+    {
+        bfloat16 x;
+        x.bits_ = bits;
+        return x;
+    }
+
+    /// @return bit pattern.
+    uint16_t bits() const { return bits_; }
+
+    // Compound assignment computes in float, then rounds.
+    bfloat16& operator += ( float x ) { return *this = float( *this ) + x; }
+    bfloat16& operator -= ( float x ) { return *this = float( *this ) - x; }
+    bfloat16& operator *= ( float x ) { return *this = float( *this ) * x; }
+    bfloat16& operator /= ( float x ) { return *this = float( *this ) / x; }
+
+private:
+    uint16_t bits_;
+};
+
+static_assert( sizeof(float16)  == 2, "float16 must be 2 bytes" );
+static_assert( sizeof(bfloat16) == 2, "bfloat16 must be 2 bytes" );
+
+//------------------------------------------------------------------------------
+/// True if T is float16 or bfloat16.
+template <typename T>
+struct is_half:
+    std::integral_constant<bool, false>
+{};
+
+template <>
+struct is_half< float16 >:
+    std::integral_constant<bool, true>
+{};
+
+template <>
+struct is_half< bfloat16 >:
+    std::integral_constant<bool, true>
+{};
+
+//------------------------------------------------------------------------------
+/// Converts n entries of x to float y. Uses F16C instructions if available.
+inline void convert( int64_t n, float16 const* x, float* y )
+{
+    int64_t i = 0;
+    #if defined( __F16C__ )
+        for (; i + 8 <= n; i += 8) {
+            __m128i h = _mm_loadu_si128( (__m128i const*) &x[ i ] );
+            _mm256_storeu_ps( &y[ i ], _mm256_cvtph_ps( h ) );
+        }
+    #endif
+    for (; i < n; ++i)
+        y[ i ] = x[ i ];
+}
+
+inline void convert( int64_t n, bfloat16 const* x, float* y )
+{
+    for (int64_t i = 0; i < n; ++i)
+        y[ i ] = x[ i ];
+}
+
+inline void convert( int64_t n, float const* x, float* y )
+{
+    std::memcpy( y, x, n * sizeof(float) );
+}
+
+}  // namespace blas
+
+//==============================================================================
+namespace std {
+
+template <>
+class numeric_limits< blas::float16 >
+{
+public:
+    static constexpr bool is_specialized = true;
+    static constexpr bool is_signed      = true;
+    static constexpr bool is_integer     = false;
+    static constexpr bool is_exact       = false;
+    static constexpr bool has_infinity   = true;
+    static constexpr bool has_quiet_NaN  = true;
+    static constexpr int  digits         = 11;
+    static constexpr int  radix          = 2;
+    static constexpr int  min_exponent   = -13;
+    static constexpr int  max_exponent   = 16;
+
+    static blas::float16 min()       { return blas::float16::from_bits( 0x0400 ); }
+    static blas::float16 max()       { return blas::float16::from_bits( 0x7bff ); }
+    static blas::float16 lowest()    { return blas::float16::from_bits( 0xfbff ); }
+    static blas::float16 epsilon()   { return blas::float16::from_bits( 0x1400 ); }
+    static blas::float16 infinity()  { return blas::float16::from_bits( 0x7c00 ); }
+    static blas::float16 quiet_NaN() { return blas::float16::from_bits( 0x7e00 ); }
+};
+
+template <>
+class numeric_limits< blas::bfloat16 >
+{
+public:
+    static constexpr bool is_specialized = true;
+    static constexpr bool is_signed      = true;
+    static constexpr bool is_integer     = false;
+    static constexpr bool is_exact       = false;
+    static constexpr bool has_infinity   = true;
+    static constexpr bool has_quiet_NaN  = true;
+    static constexpr int  digits         = 8;
+    static constexpr int  radix          = 2;
+    static constexpr int  min_exponent   = -125;
+    static constexpr int  max_exponent   = 128;
+
+    static blas::bfloat16 min()       { return blas::bfloat16::from_bits( 0x0080 ); }
+    static blas::bfloat16 max()       { return blas::bfloat16::from_bits( 0x7f7f ); }
+    static blas::bfloat16 lowest()    { return blas::bfloat16::from_bits( 0xff7f ); }
+    static blas::bfloat16 epsilon()   { return blas::bfloat16::from_bits( 0x3c00 ); }
+    static blas::bfloat16 infinity()  { return blas::bfloat16::from_bits( 0x7f80 ); }
+    static blas::bfloat16 quiet_NaN() { return blas::bfloat16::from_bits( 0x7fc0 ); }
+};
+
+}  // namespace std
+
+#endif        //  #ifndef BLAS_HALF_HH
@@ -0,0 +1,186 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BLAS_NORMS_HH
+#define BLAS_NORMS_HH
+
+#include "blas/util.hh"
+
+#include <cctype>
+
+namespace blas {
+
+// =============================================================================
+/// Vector norm computed for each column or row of a matrix.
+enum class Norm : char {
+    One = '1',  ///< sum_i |x_i|
+    Two = '2',  ///< (sum_i |x_i|^2)^{1/2}, scaled to avoid over- and underflow
+    Max = 'm',  ///< max_i |x_i|
+};
+
+inline char norm2char( Norm norm )
+{
+    return char( norm );
+}
+
+inline const char* norm2str( Norm norm )
+{
+    switch (norm) {
+        case Norm::One: return "one";
+        case Norm::Two: return "two";
+        case Norm::Max: return "max";
+    }
+    return "";
+}
+
+inline Norm char2norm( char norm )
+{
+    norm = char( tolower( norm ) );
+    blas_error_if( norm != '1' && norm != '2' && norm != 'm' );
+    return Norm( norm );
+}
+
+//------------------------------------------------------------------------------
+// Column and row norms and iamax of the m-by-n matrix A, in one pass over A,
+// instead of n (or m) calls to blas::nrm2, asum, or iamax.
+//
+// Where the vectors are contiguous, i.e., columns for ColMajor or rows for
+// RowMajor, threads own ranges of vectors. Otherwise, threads own ranges of
+// output entries, and sweep across A accumulating each range in cache,
+// so A is always read with unit stride.
+
+//------------------------------------------------------------------------------
+// values[ j ] = || A(:, j) ||, for the given norm, j = 0, ..., n-1.
+/// @ingroup nrm2
+void col_norms(
+    blas::Layout layout,
+    blas::Norm norm,
+    int64_t m, int64_t n,
+    float const *A, int64_t lda,
+    float *values );
+
+/// @ingroup nrm2
+void col_norms(
+    blas::Layout layout,
+    blas::Norm norm,
+    int64_t m, int64_t n,
+    double const *A, int64_t lda,
+    double *values );
+
+/// @ingroup nrm2
+void col_norms(
+    blas::Layout layout,
+    blas::Norm norm,
+    int64_t m, int64_t n,
+    std::complex<float> const *A, int64_t lda,
+    float *values );
+
+/// @ingroup nrm2
+void col_norms(
+    blas::Layout layout,
+    blas::Norm norm,
+    int64_t m, int64_t n,
+    std::complex<double> const *A, int64_t lda,
+    double *values );
+
+//------------------------------------------------------------------------------
+// values[ i ] = || A(i, :) ||, for the given norm, i = 0, ..., m-1.
+/// @ingroup nrm2
+void row_norms(
+    blas::Layout layout,
+    blas::Norm norm,
+    int64_t m, int64_t n,
+    float const *A, int64_t lda,
+    float *values );
+
+/// @ingroup nrm2
+void row_norms(
+    blas::Layout layout,
+    blas::Norm norm,
+    int64_t m, int64_t n,
+    double const *A, int64_t lda,
+    double *values );
+
+/// @ingroup nrm2
+void row_norms(
+    blas::Layout layout,
+    blas::Norm norm,
+    int64_t m, int64_t n,
+    std::complex<float> const *A, int64_t lda,
+    float *values );
+
+/// @ingroup nrm2
+void row_norms(
+    blas::Layout layout,
+    blas::Norm norm,
+    int64_t m, int64_t n,
+    std::complex<double> const *A, int64_t lda,
+    double *values );
+
+//------------------------------------------------------------------------------
+// indices[ j ] = blas::iamax of A(:, j), j = 0, ..., n-1, i.e., the first i
+// maximizing |Re( A(i, j) )| + |Im( A(i, j) )|, or, if A(:, j) has a NaN,
+// the first i where A(i, j) is NaN, as in the reference i?amax; -1 if m = 0.
+/// @ingroup iamax
+void col_iamax(
+    blas::Layout layout,
+    int64_t m, int64_t n,
+    float const *A, int64_t lda,
+    int64_t *indices );
+
+/// @ingroup iamax
+void col_iamax(
+    blas::Layout layout,
+    int64_t m, int64_t n,
+    double const *A, int64_t lda,
+    int64_t *indices );
+
+/// @ingroup iamax
+void col_iamax(
+    blas::Layout layout,
+    int64_t m, int64_t n,
+    std::complex<float> const *A, int64_t lda,
+    int64_t *indices );
+
+/// @ingroup iamax
+void col_iamax(
+    blas::Layout layout,
+    int64_t m, int64_t n,
+    std::complex<double> const *A, int64_t lda,
+    int64_t *indices );
+
+//------------------------------------------------------------------------------
+// indices[ i ] = blas::iamax of A(i, :), i = 0, ..., m-1; -1 if n = 0.
+/// @ingroup iamax
+void row_iamax(
+    blas::Layout layout,
+    int64_t m, int64_t n,
+    float const *A, int64_t lda,
+    int64_t *indices );
+
+/// @ingroup iamax
+void row_iamax(
+    blas::Layout layout,
+    int64_t m, int64_t n,
+    double const *A, int64_t lda,
+    int64_t *indices );
+
+/// @ingroup iamax
+void row_iamax(
+    blas::Layout layout,
+    int64_t m, int64_t n,
+    std::complex<float> const *A, int64_t lda,
+    int64_t *indices );
+
+/// @ingroup iamax
+void row_iamax(
+    blas::Layout layout,
+    int64_t m, int64_t n,
+    std::complex<double> const *A, int64_t lda,
+    int64_t *indices );
+
+}  // namespace blas
+
+#endif        //  #ifndef BLAS_NORMS_HH
@@ -0,0 +1,186 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BLAS_NUMA_HH
+#define BLAS_NUMA_HH
+
+#include "blas/util.hh"
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <vector>
+
+namespace blas {
+
+// =============================================================================
+/// NUMA topology, memory placement, and locality-aware batch scheduling.
+///
+/// On multi-socket nodes, memory is attached to one socket (NUMA node), and
+/// a thread reading memory on another node pays for the cross-socket link.
+/// The topology is read once from /sys/devices/system/node; where that is
+/// not available (non-Linux, containers hiding /sys), everything is one
+/// node and the routines here reduce to their plain equivalents.
+///
+/// Linux places a page on the node of the thread that first writes it
+/// (first touch). blas::numa::allocate with Policy::FirstTouch touches the
+/// pages with an OpenMP static schedule, so each thread's share lands on
+/// its own node; Policy::Interleave spreads pages round-robin over all
+/// nodes, which is best for data read by every thread.
+///
+/// Batch routines (currently blas::batch::gemm) look up the node holding
+/// each problem's C and have each thread compute problems on its own node
+/// first, before helping others. This only pays off when OpenMP threads
+/// are bound to cores, e.g.,
+///
+///     export OMP_PLACES=cores OMP_PROC_BIND=spread
+///
+/// otherwise the OS may move threads between sockets at any time.
+///
+namespace numa {
+
+/// Memory placement policy for blas::numa::allocate.
+enum class Policy {
+    FirstTouch,     ///< pages on the node of the thread that first touches them
+    Interleave,     ///< pages round-robin over all nodes
+};
+
+int64_t num_nodes();
+
+int64_t cpu_node( int64_t cpu );
+
+std::vector<int64_t> const& node_cpus( int64_t node );
+
+int64_t current_node();
+
+int64_t node_of( void const* ptr );
+
+void nodes_of( size_t count, void const* const* ptrs, int64_t* nodes );
+
+void* allocate( size_t bytes, Policy policy=Policy::FirstTouch );
+
+void deallocate( void* ptr, size_t bytes );
+
+namespace internal {
+
+std::vector< std::vector<size_t> > group_by_node(
+    size_t count, void const* const* ptrs );
+
+}  // namespace internal
+
+//------------------------------------------------------------------------------
+/// Calls body( i ) for i = 0, ..., count - 1 in an OpenMP parallel region,
+/// preferring to run i on a thread on the node holding ptr( i ).
+/// Items are grouped by node; each thread takes items from its own node's
+/// group first, dynamically, then from the other groups in turn, so no
+/// thread idles while work remains. With one node, this is a plain
+/// `omp parallel for schedule(dynamic)`.
+///
+/// A template, so ptr and body, usually lambdas, are inlined into the loop.
+///
+/// @param[in] count
+///     Number of items.
+///
+/// @param[in] ptr
+///     ptr( i ) is the data that item i mostly accesses, e.g., its output.
+///
+/// @param[in] body
+///     body( i ) does item i. Called concurrently from several threads.
+template <typename Ptr, typename Body>
+void for_each_local( size_t count, Ptr const& ptr, Body const& body )
+{
+    int64_t nodes = num_nodes();
+    if (nodes == 1 || count <= 1) {
+        #pragma omp parallel for schedule(dynamic)
+        for (size_t i = 0; i < count; ++i)
+            body( i );
+        return;
+    }
+
+    // group items by node; group[ nodes ] is for unknown nodes
+    std::vector<void const*> ptrs( count );
+    for (size_t i = 0; i < count; ++i)
+        ptrs[ i ] = ptr( i );
+    std::vector< std::vector<size_t> > groups
+        = internal::group_by_node( count, ptrs.data() );
+    std::vector< std::atomic<size_t> > next( nodes + 1 );
+    for (auto& n : next)
+        n.store( 0 );
+
+    #pragma omp parallel
+    {
+        int64_t home = current_node();
+        if (home < 0 || home >= nodes)
+            home = nodes;
+        for (int64_t g = 0; g <= nodes; ++g) {
+            int64_t q = (home + g) % (nodes + 1);
+            std::vector<size_t> const& group = groups[ q ];
+            for (size_t j = next[ q ]++; j < group.size(); j = next[ q ]++)
+                body( group[ j ] );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Standard allocator that places memory by a NUMA policy, for use in
+/// containers, e.g.,
+///
+///     std::vector< double, blas::numa::Allocator<double> >
+///         C( n*n, 0.0, blas::numa::Allocator<double>( Policy::Interleave ) );
+///
+/// Note that the container's initialization is itself a first touch
+/// only if the pages were not already touched by allocate.
+///
+template <typename T>
+class Allocator
+{
+public:
+    typedef T value_type;
+
+    Allocator( Policy policy=Policy::FirstTouch ):
+        policy_( policy )
+    {}
+
+    template <typename U>
+    Allocator( Allocator<U> const& other ):
+        policy_( other.policy() )
+    {}
+
+    T* allocate( size_t n )
+    {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T))
+            throw std::bad_alloc();
+        return static_cast<T*>( numa::allocate( n*sizeof(T), policy_ ) );
+    }
+
+    void deallocate( T* ptr, size_t n )
+    {
+        numa::deallocate( ptr, n*sizeof(T) );
+    }
+
+    Policy policy() const { return policy_; }
+
+private:
+    Policy policy_;
+};
+
+/// All allocators are equal: any of them can deallocate the others' memory.
+template <typename T, typename U>
+bool operator == ( Allocator<T> const& a, Allocator<U> const& b )
+{
+    return true;
+}
+
+template <typename T, typename U>
+bool operator != ( Allocator<T> const& a, Allocator<U> const& b )
+{
+    return ! (a == b);
+}
+
+}  // namespace numa
+}  // namespace blas
+
+#endif        //  #ifndef BLAS_NUMA_HH
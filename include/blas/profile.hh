@@ -0,0 +1,193 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BLAS_PROFILE_HH
+#define BLAS_PROFILE_HH
+
+#include "blas/util.hh"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <initializer_list>
+#include <string>
+
+namespace blas {
+
+// =============================================================================
+/// Opt-in profiling of BLAS++ calls.
+///
+/// When enabled, each BLAS++ wrapper records its routine name, precision,
+/// options (layout, side, uplo, trans, diag), dimensions, elapsed time,
+/// and Gflop count (from blas/flops.hh). Calls are aggregated per shape,
+/// i.e., per unique routine, precision, options, and dimensions, into
+/// count, total, min, and max time, and a histogram of call times
+/// in power-of-2 microsecond bins. When disabled, the overhead is a
+/// single relaxed atomic load per call.
+///
+/// Batch routines record one entry per batch call, keyed by the batch
+/// count, in addition to the entries of the calls they make for each
+/// matrix. Device routines record the time to enqueue the work; device
+/// batch routines synchronize the queue when profiling or tracing, so their
+/// time includes execution.
+///
+/// Profiling is enabled by blas::profile::enable(), or by setting the
+/// environment variable `BLASPP_PROFILE` to a filename, in which case the
+/// summary is written to that file at exit: JSON if the name ends in
+/// `.json`, otherwise CSV. If `BLASPP_PROFILE` is 1, CSV is written to
+/// stderr.
+///
+/// Independently, tracing keeps every call as a span on the thread that
+/// made it, and writes a timeline in the Chrome trace event format, which
+/// can be viewed in chrome://tracing or Perfetto. Since batch routines
+/// call the non-batch routine for each matrix, inside an OpenMP loop,
+/// the timeline shows which thread ran each batch item. Device queue
+/// fork, revolve, and join are marked as instant events.
+/// Tracing is enabled by blas::profile::enable_trace(), or by setting
+/// `BLASPP_TRACE` to a filename, in which case the trace is written to
+/// that file at exit.
+///
+namespace profile {
+
+namespace internal {
+
+typedef std::chrono::steady_clock::time_point time_point;
+
+// Bit flags in g_mode.
+const int profiling = 1;
+const int tracing   = 2;
+
+extern std::atomic<int> g_mode;
+
+void record( const char* routine, char precision, const char* opts,
+             int64_t m, int64_t n, int64_t k, int64_t batch,
+             double gflop, time_point start, time_point end );
+
+}  // namespace internal
+
+//------------------------------------------------------------------------------
+/// @return true if profiling is enabled.
+inline bool enabled()
+{
+    return internal::g_mode.load( std::memory_order_relaxed )
+           & internal::profiling;
+}
+
+//------------------------------------------------------------------------------
+/// @return true if tracing is enabled.
+inline bool tracing()
+{
+    return internal::g_mode.load( std::memory_order_relaxed )
+           & internal::tracing;
+}
+
+void enable( bool on=true );
+
+void reset();
+
+void write_csv( FILE* file );
+
+void write_json( FILE* file );
+
+void dump( std::string const& filename );
+
+void enable_trace( bool on=true );
+
+void reset_trace();
+
+void mark( const char* name, const char* arg_name=nullptr, int64_t arg=0 );
+
+void write_trace( FILE* file );
+
+void dump_trace( std::string const& filename );
+
+//------------------------------------------------------------------------------
+/// Times a BLAS++ call from construction to destruction, and records it
+/// if profiling or tracing is enabled when constructed.
+/// Usage, inside a wrapper:
+///
+///     profile::Scope scope( "gemm", 'd',
+///                           { layout2char( layout ), op2char( transA ),
+///                             op2char( transB ) },
+///                           m, n, k, Gflop< double >::gemm( m, n, k ) );
+///
+class Scope
+{
+public:
+    /// @param[in] routine
+    ///     Routine name; must be a string literal or otherwise outlive
+    ///     the profile.
+    ///
+    /// @param[in] precision
+    ///     Precision: 's', 'd', 'c', or 'z'.
+    ///
+    /// @param[in] opts
+    ///     Up to max_opts option chars, e.g., layout and transposes.
+    ///
+    /// @param[in] m, n, k
+    ///     Dimensions; 0 if not applicable.
+    ///
+    /// @param[in] gflop
+    ///     Number of Gflop performed by the call.
+    ///
+    /// @param[in] batch
+    ///     Batch count; 1 for non-batch routines.
+    ///
+    Scope( const char* routine, char precision,
+           std::initializer_list<char> opts,
+           int64_t m, int64_t n, int64_t k, double gflop,
+           int64_t batch=1 )
+        : active_( internal::g_mode.load( std::memory_order_relaxed ) != 0 )
+    {
+        if (active_) {
+            routine_   = routine;
+            precision_ = precision;
+            int i = 0;
+            for (char opt : opts) {
+                if (i < max_opts)
+                    opts_[ i++ ] = opt;
+            }
+            opts_[ i ] = '\0';
+            m_      = m;
+            n_      = n;
+            k_      = k;
+            batch_  = batch;
+            gflop_  = gflop;
+            start_  = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~Scope()
+    {
+        if (active_) {
+            internal::record( routine_, precision_, opts_,
+                              m_, n_, k_, batch_, gflop_,
+                              start_, std::chrono::steady_clock::now() );
+        }
+    }
+
+    /// Set Gflop count, when not known at construction.
+    void set_gflop( double gflop ) { gflop_ = gflop; }
+
+    static const int max_opts = 7;
+
+private:
+    // not copyable
+    Scope( Scope const& );
+    Scope& operator = ( Scope const& );
+
+    bool active_;
+    const char* routine_;
+    char precision_;
+    char opts_[ max_opts + 1 ];
+    int64_t m_, n_, k_, batch_;
+    double gflop_;
+    internal::time_point start_;
+};
+
+}  // namespace profile
+}  // namespace blas
+
+#endif        //  #ifndef BLAS_PROFILE_HH
@@ -0,0 +1,131 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BLAS_REPRO_HH
+#define BLAS_REPRO_HH
+
+#include "blas/util.hh"
+
+#include <atomic>
+
+namespace blas {
+
+// =============================================================================
+/// Bitwise reproducible reductions: dot, dotu, asum, and nrm2.
+///
+/// The routines in this namespace return bit-identical results regardless
+/// of the number of threads, the vector width, or the order of the
+/// entries. They use pre-rounded summation (Rump, Ogita, and Oishi;
+/// Demmel and Nguyen, as in ReproBLAS). A first pass finds max |v_i| over
+/// the values v_i to sum (products x_i y_i for dot). Each v_i is then
+/// split against fixed powers of two, sigma_1 > sigma_2 > sigma_3, chosen
+/// from max |v_i| and n only, into 3 parts that are multiples of
+/// ulp( sigma_k ). The sum of the k-th parts is exact in any order, so
+/// it can be computed in parallel and in SIMD lanes. The result is
+/// (T_1 + T_2) + T_3, computed in that order. Each fold keeps about
+/// 53 - log2( n ) bits, so the error is roughly
+/// 2^( 3 (log2( n ) - 53) ) max |v_i|, independent of cancellation.
+///
+/// All precisions accumulate in double. Products of floats are exact in
+/// double, so single precision results are rounded only once, at the end.
+/// If any value is inf or NaN, the values are summed sequentially in
+/// index order instead, which is also reproducible.
+///
+/// Reproducible mode makes blas::dot, blas::dotu, blas::asum, and
+/// blas::nrm2 call these routines. It is enabled by blas::repro::enable(),
+/// or by setting the environment variable `BLASPP_REPRO` to 1 (or y).
+/// The routines can also be called directly, e.g., blas::repro::dot().
+///
+namespace repro {
+
+namespace internal {
+
+extern std::atomic<bool> g_enabled;
+
+}  // namespace internal
+
+//------------------------------------------------------------------------------
+/// @return true if reproducible mode is enabled.
+inline bool enabled()
+{
+    return internal::g_enabled.load( std::memory_order_relaxed );
+}
+
+void enable( bool on=true );
+
+//------------------------------------------------------------------------------
+// Reproducible dot products, x^H y. Arguments as in blas::dot.
+float dot(
+    int64_t n,
+    float const *x, int64_t incx,
+    float const *y, int64_t incy );
+
+double dot(
+    int64_t n,
+    double const *x, int64_t incx,
+    double const *y, int64_t incy );
+
+std::complex<float> dot(
+    int64_t n,
+    std::complex<float> const *x, int64_t incx,
+    std::complex<float> const *y, int64_t incy );
+
+std::complex<double> dot(
+    int64_t n,
+    std::complex<double> const *x, int64_t incx,
+    std::complex<double> const *y, int64_t incy );
+
+//------------------------------------------------------------------------------
+// Reproducible unconjugated dot products, x^T y. Arguments as in blas::dotu.
+std::complex<float> dotu(
+    int64_t n,
+    std::complex<float> const *x, int64_t incx,
+    std::complex<float> const *y, int64_t incy );
+
+std::complex<double> dotu(
+    int64_t n,
+    std::complex<double> const *x, int64_t incx,
+    std::complex<double> const *y, int64_t incy );
+
+//------------------------------------------------------------------------------
+// Reproducible 1-norms, sum |Re(x_i)| + |Im(x_i)|. Arguments as in blas::asum.
+float asum(
+    int64_t n,
+    float const *x, int64_t incx );
+
+double asum(
+    int64_t n,
+    double const *x, int64_t incx );
+
+float asum(
+    int64_t n,
+    std::complex<float> const *x, int64_t incx );
+
+double asum(
+    int64_t n,
+    std::complex<double> const *x, int64_t incx );
+
+//------------------------------------------------------------------------------
+// Reproducible 2-norms. Arguments as in blas::nrm2.
+float nrm2(
+    int64_t n,
+    float const *x, int64_t incx );
+
+double nrm2(
+    int64_t n,
+    double const *x, int64_t incx );
+
+float nrm2(
+    int64_t n,
+    std::complex<float> const *x, int64_t incx );
+
+double nrm2(
+    int64_t n,
+    std::complex<double> const *x, int64_t incx );
+
+}  // namespace repro
+}  // namespace blas
+
+#endif        //  #ifndef BLAS_REPRO_HH
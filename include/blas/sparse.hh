@@ -0,0 +1,214 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BLAS_SPARSE_HH
+#define BLAS_SPARSE_HH
+
+#include "blas/util.hh"
+
+#include <cctype>
+
+namespace blas {
+
+// =============================================================================
+/// Sparse matrix times dense vector (SpMV) and dense matrix (SpMM).
+///
+/// The sparse matrix is described by a blas::sparse::Matrix view of arrays
+/// owned by the caller, in one of three formats:
+/// - CSR: compressed sparse row. ptr has m+1 entries; the nonzeros of row
+///   i are values[ p ] in column ind[ p ], for ptr[ i ] <= p < ptr[ i+1 ].
+/// - CSC: compressed sparse column, likewise with rows and columns swapped;
+///   ptr has n+1 entries and ind holds row indices.
+/// - BSR: block sparse row, CSR of dense bs-by-bs blocks. ptr has m/bs + 1
+///   entries, ind holds block column indices, and block p is the
+///   column-major bs-by-bs array at values[ p*bs*bs ].
+///
+/// Indices are 0-based. Within each row (CSR, BSR) or column (CSC),
+/// indices must be sorted and unique.
+///
+/// Kernels are multithreaded with OpenMP. When each output row is a row
+/// (column) of CSR or BSR (CSC), i.e., CSR or BSR with NoTrans or CSC
+/// with Trans, threads own ranges of rows holding equal numbers of
+/// nonzeros, which balances skewed matrices. Otherwise, threads own equal
+/// ranges of output rows, each scanning the matrix for its range.
+/// For the dense side of gemm, RowMajor gives unit-stride inner loops.
+///
+namespace sparse {
+
+/// Storage format of a sparse matrix.
+enum class Format : char {
+    CSR = 'r',  ///< compressed sparse row
+    CSC = 'c',  ///< compressed sparse column
+    BSR = 'b',  ///< block sparse row
+};
+
+inline char format2char( Format format )
+{
+    return char( format );
+}
+
+inline const char* format2str( Format format )
+{
+    switch (format) {
+        case Format::CSR: return "csr";
+        case Format::CSC: return "csc";
+        case Format::BSR: return "bsr";
+    }
+    return "";
+}
+
+inline Format char2format( char format )
+{
+    format = char( tolower( format ) );
+    blas_error_if( format != 'r' && format != 'c' && format != 'b' );
+    return Format( format );
+}
+
+//------------------------------------------------------------------------------
+/// View of an m-by-n sparse matrix in CSR, CSC, or BSR format; see
+/// blas::sparse. The arrays are not copied, and must outlive the view.
+/// For BSR, m and n are in entries, and must be multiples of block_size.
+template <typename T>
+class Matrix
+{
+public:
+    Matrix( Format format, int64_t m, int64_t n,
+            int64_t const* ptr, int64_t const* ind, T const* values,
+            int64_t block_size=1 )
+        : format_( format ),
+          m_( m ),
+          n_( n ),
+          ptr_( ptr ),
+          ind_( ind ),
+          values_( values ),
+          block_size_( format == Format::BSR ? block_size : 1 )
+    {
+        blas_error_if( format != Format::CSR &&
+                       format != Format::CSC &&
+                       format != Format::BSR );
+        blas_error_if( m < 0 );
+        blas_error_if( n < 0 );
+        blas_error_if( block_size_ < 1 );
+        blas_error_if( m % block_size_ != 0 || n % block_size_ != 0 );
+    }
+
+    Format format() const { return format_; }
+    int64_t m() const { return m_; }
+    int64_t n() const { return n_; }
+    int64_t const* ptr() const { return ptr_; }
+    int64_t const* ind() const { return ind_; }
+    T const* values() const { return values_; }
+    int64_t block_size() const { return block_size_; }
+
+    /// Length of ptr, minus 1: rows (CSR), columns (CSC), or block rows (BSR).
+    int64_t compressed() const
+    {
+        return (format_ == Format::CSC ? n_ : m_ / block_size_);
+    }
+
+    /// Number of stored entries, including explicit zeros in BSR blocks.
+    int64_t nnz() const
+    {
+        return ptr_[ compressed() ] * block_size_ * block_size_;
+    }
+
+private:
+    Format format_;
+    int64_t m_, n_;
+    int64_t const* ptr_;
+    int64_t const* ind_;
+    T const* values_;
+    int64_t block_size_;
+};
+
+//------------------------------------------------------------------------------
+// y = alpha op(A) x + beta y, for sparse A. Arguments are as in blas::gemv.
+/// @ingroup gemv
+void gemv(
+    blas::Op trans,
+    float alpha,
+    Matrix<float> const& A,
+    float const *x, int64_t incx,
+    float beta,
+    float       *y, int64_t incy );
+
+/// @ingroup gemv
+void gemv(
+    blas::Op trans,
+    double alpha,
+    Matrix<double> const& A,
+    double const *x, int64_t incx,
+    double beta,
+    double       *y, int64_t incy );
+
+/// @ingroup gemv
+void gemv(
+    blas::Op trans,
+    std::complex<float> alpha,
+    Matrix< std::complex<float> > const& A,
+    std::complex<float> const *x, int64_t incx,
+    std::complex<float> beta,
+    std::complex<float>       *y, int64_t incy );
+
+/// @ingroup gemv
+void gemv(
+    blas::Op trans,
+    std::complex<double> alpha,
+    Matrix< std::complex<double> > const& A,
+    std::complex<double> const *x, int64_t incx,
+    std::complex<double> beta,
+    std::complex<double>       *y, int64_t incy );
+
+//------------------------------------------------------------------------------
+// C = alpha op(A) B + beta C, for sparse A; B and C are dense with n columns,
+// stored in the given layout. Other arguments are as in blas::gemm.
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    int64_t n,
+    float alpha,
+    Matrix<float> const& A,
+    float const *B, int64_t ldb,
+    float beta,
+    float       *C, int64_t ldc );
+
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    int64_t n,
+    double alpha,
+    Matrix<double> const& A,
+    double const *B, int64_t ldb,
+    double beta,
+    double       *C, int64_t ldc );
+
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    int64_t n,
+    std::complex<float> alpha,
+    Matrix< std::complex<float> > const& A,
+    std::complex<float> const *B, int64_t ldb,
+    std::complex<float> beta,
+    std::complex<float>       *C, int64_t ldc );
+
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    int64_t n,
+    std::complex<double> alpha,
+    Matrix< std::complex<double> > const& A,
+    std::complex<double> const *B, int64_t ldb,
+    std::complex<double> beta,
+    std::complex<double>       *C, int64_t ldc );
+
+}  // namespace sparse
+}  // namespace blas
+
+#endif        //  #ifndef BLAS_SPARSE_HH
@@ -0,0 +1,57 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BLAS_THREADS_HH
+#define BLAS_THREADS_HH
+
+#include "blas/util.hh"
+
+namespace blas {
+
+int64_t get_num_threads();
+
+int64_t batch_threads( size_t batch );
+
+//------------------------------------------------------------------------------
+/// Sets the number of threads for BLAS++ and vendor BLAS calls made by the
+/// calling thread, for the lifetime of the object. The previous counts are
+/// restored when it goes out of scope, so scopes nest:
+///
+///     {
+///         blas::ThreadScope scope( 4 );
+///         blas::gemm( ... );  // runs on 4 threads
+///     }
+///     blas::gemm( ... );      // runs on the previous number of threads
+///
+/// This sets:
+/// - the OpenMP thread count (omp_set_num_threads), which applies to
+///   BLAS++'s own parallel regions and to vendor BLAS built on OpenMP,
+///   and is per thread, so it is safe inside a parallel region;
+/// - with MKL, the thread-local count (mkl_set_num_threads_local);
+/// - with OpenBLAS, openblas_set_num_threads. This count is process-wide,
+///   so it is changed only outside parallel regions. Inside them,
+///   OpenBLAS built with OpenMP runs sequentially by itself.
+///
+/// The batch routines use this within each problem, with
+/// blas::batch_threads( batch ) threads, so the OpenMP loop over problems
+/// and the threads within each problem do not oversubscribe the cores.
+///
+class ThreadScope
+{
+public:
+    explicit ThreadScope( int64_t num_threads );
+    ~ThreadScope();
+
+    ThreadScope( ThreadScope const& ) = delete;
+    ThreadScope& operator = ( ThreadScope const& ) = delete;
+
+private:
+    int64_t omp_threads_;
+    int64_t vendor_threads_;
+};
+
+}  // namespace blas
+
+#endif        //  #ifndef BLAS_THREADS_HH
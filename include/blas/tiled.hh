@@ -0,0 +1,210 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BLAS_TILED_HH
+#define BLAS_TILED_HH
+
+#include "blas/util.hh"
+
+namespace blas {
+
+// =============================================================================
+/// Tiled Level 3 BLAS, executed as a graph of tile tasks.
+///
+/// Each routine splits its matrices into nb-by-nb tiles and creates one
+/// OpenMP task per tile operation (a vendor gemm, syrk, or trsm on tiles),
+/// with depend clauses on the tiles it reads and writes. The OpenMP runtime
+/// schedules ready tasks on idle threads, so, e.g., the trailing updates of
+/// a trsm proceed while later diagonal solves wait only for their inputs.
+///
+/// Called outside a parallel region, a routine opens one, and returns when
+/// all its tasks are done, like blas::gemm, etc. Called from inside a
+/// parallel region, typically by one thread in a single or master construct,
+/// it only creates its tasks and returns. Consecutive calls then overlap:
+/// tasks of a later call start as soon as the tiles they depend on are
+/// ready, rather than after the whole earlier call. For example:
+///
+///     int64_t nthreads = blas::get_num_threads();
+///     blas::ThreadScope scope( 1 );  // single threaded vendor BLAS in tasks
+///     #pragma omp parallel num_threads( nthreads )
+///     #pragma omp master
+///     {
+///         blas::tiled::trsm( layout, Side::Left, Uplo::Lower, Op::NoTrans,
+///                            Diag::NonUnit, m, n, 1.0, L, ldl, B, ldb, nb );
+///         blas::tiled::gemm( layout, Op::Trans, Op::NoTrans, n, n, m,
+///                            -1.0, B, ldb, B, ldb, 1.0, C, ldc, nb );
+///         blas::tiled::wait();  // or the end of the parallel region
+///     }
+///
+/// Dependencies are keyed by the address of each tile's first entry, so calls
+/// that share a matrix must use the same layout, nb, and matrix origin, so
+/// their tiles coincide. Results may not be used before blas::tiled::wait()
+/// or the end of the parallel region.
+///
+/// Tasks must call the vendor BLAS single threaded, or each would start
+/// its own threads. In the parallel region a routine opens, it ensures this
+/// with blas::ThreadScope( 1 ). In the caller's own parallel region, it
+/// cannot, since a pthreads vendor BLAS, e.g., OpenBLAS, sets its thread
+/// count process wide; the caller takes the ThreadScope, as above.
+///
+/// Arguments are as in the corresponding blas:: routine, plus the tile
+/// size nb.
+///
+namespace tiled {
+
+//------------------------------------------------------------------------------
+/// Waits for all tasks created by tiled routines in the current region.
+void wait();
+
+//------------------------------------------------------------------------------
+// C = alpha op(A) op(B) + beta C.
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    float alpha,
+    float const *A, int64_t lda,
+    float const *B, int64_t ldb,
+    float beta,
+    float       *C, int64_t ldc,
+    int64_t nb=256 );
+
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    double alpha,
+    double const *A, int64_t lda,
+    double const *B, int64_t ldb,
+    double beta,
+    double       *C, int64_t ldc,
+    int64_t nb=256 );
+
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<float> alpha,
+    std::complex<float> const *A, int64_t lda,
+    std::complex<float> const *B, int64_t ldb,
+    std::complex<float> beta,
+    std::complex<float>       *C, int64_t ldc,
+    int64_t nb=256 );
+
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<double> alpha,
+    std::complex<double> const *A, int64_t lda,
+    std::complex<double> const *B, int64_t ldb,
+    std::complex<double> beta,
+    std::complex<double>       *C, int64_t ldc,
+    int64_t nb=256 );
+
+//------------------------------------------------------------------------------
+// C = alpha op(A) op(A)^T + beta C, C symmetric.
+void syrk(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op trans,
+    int64_t n, int64_t k,
+    float alpha,
+    float const *A, int64_t lda,
+    float beta,
+    float       *C, int64_t ldc,
+    int64_t nb=256 );
+
+void syrk(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op trans,
+    int64_t n, int64_t k,
+    double alpha,
+    double const *A, int64_t lda,
+    double beta,
+    double       *C, int64_t ldc,
+    int64_t nb=256 );
+
+void syrk(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op trans,
+    int64_t n, int64_t k,
+    std::complex<float> alpha,
+    std::complex<float> const *A, int64_t lda,
+    std::complex<float> beta,
+    std::complex<float>       *C, int64_t ldc,
+    int64_t nb=256 );
+
+void syrk(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op trans,
+    int64_t n, int64_t k,
+    std::complex<double> alpha,
+    std::complex<double> const *A, int64_t lda,
+    std::complex<double> beta,
+    std::complex<double>       *C, int64_t ldc,
+    int64_t nb=256 );
+
+//------------------------------------------------------------------------------
+// Solves op(A) X = alpha B or X op(A) = alpha B, overwriting B with X.
+void trsm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    int64_t m, int64_t n,
+    float alpha,
+    float const *A, int64_t lda,
+    float       *B, int64_t ldb,
+    int64_t nb=256 );
+
+void trsm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    int64_t m, int64_t n,
+    double alpha,
+    double const *A, int64_t lda,
+    double       *B, int64_t ldb,
+    int64_t nb=256 );
+
+void trsm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    int64_t m, int64_t n,
+    std::complex<float> alpha,
+    std::complex<float> const *A, int64_t lda,
+    std::complex<float>       *B, int64_t ldb,
+    int64_t nb=256 );
+
+void trsm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    int64_t m, int64_t n,
+    std::complex<double> alpha,
+    std::complex<double> const *A, int64_t lda,
+    std::complex<double>       *B, int64_t ldb,
+    int64_t nb=256 );
+
+}  // namespace tiled
+}  // namespace blas
+
+#endif        //  #ifndef BLAS_TILED_HH
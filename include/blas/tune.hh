@@ -0,0 +1,95 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BLAS_TUNE_HH
+#define BLAS_TUNE_HH
+
+#include "blas/util.hh"
+
+#include <string>
+
+namespace blas {
+
+// =============================================================================
+/// Dispatch between the vendor BLAS and the generic, in-library kernels.
+///
+/// For tiny problems, the overhead of calling the vendor BLAS through its
+/// Fortran interface exceeds the arithmetic, so the generic templates
+/// (e.g., blas::gemm< TA, TB, TC >) are faster. For each routine, precision,
+/// and transpose combination, a crossover size is kept in a table;
+/// calls whose size is below the crossover use the in-library kernel,
+/// all others use the vendor BLAS. The size is max( m, n, k ) for gemm,
+/// max( m, n ) for gemv, and n for dot.
+///
+/// By default all crossovers are 0, i.e., the vendor BLAS is always used.
+/// On first use, the table is read from the file named by the environment
+/// variable `BLASPP_TUNE_FILE`, if set. If that file cannot be read and
+/// `BLASPP_TUNE` is set to 1 (or y), the crossovers are measured by
+/// blas::tune::benchmark() and saved to `BLASPP_TUNE_FILE`.
+/// This can also be done once at install time:
+///
+///     BLASPP_TUNE=1 BLASPP_TUNE_FILE=/path/to/blaspp.tune ./tester tune
+///
+/// The file is plain text, one crossover per line:
+///
+///     # routine  precision  op  crossover
+///     gemm       d          nt  12
+///
+namespace tune {
+
+/// Routines that have an in-library kernel selectable by tuning.
+enum class Routine {
+    gemm = 0,
+    gemv,
+    dot,
+    num_routines,  // last
+};
+
+const char* routine2str( Routine routine );
+
+int64_t crossover( Routine routine, char precision,
+                   Op opA=Op::NoTrans, Op opB=Op::NoTrans );
+
+void set_crossover( Routine routine, char precision,
+                    Op opA, Op opB, int64_t size );
+
+void reset();
+
+void load( std::string const& filename );
+
+void save( std::string const& filename );
+
+void benchmark( int64_t max_size=128 );
+
+//------------------------------------------------------------------------------
+/// @return true if a call of the given size should use the in-library kernel
+/// instead of the vendor BLAS.
+///
+/// @param[in] routine
+///     Routine being called.
+///
+/// @param[in] precision
+///     Precision: 's', 'd', 'c', or 'z'.
+///
+/// @param[in] opA
+///     Transpose of A (gemm) or A (gemv); NoTrans otherwise.
+///
+/// @param[in] opB
+///     Transpose of B (gemm); NoTrans otherwise.
+///
+/// @param[in] size
+///     Size of call: max( m, n, k ) for gemm, max( m, n ) for gemv,
+///     n for dot.
+///
+inline bool use_kernel( Routine routine, char precision,
+                        Op opA, Op opB, int64_t size )
+{
+    return size < crossover( routine, precision, opA, opB );
+}
+
+}  // namespace tune
+}  // namespace blas
+
+#endif        //  #ifndef BLAS_TUNE_HH
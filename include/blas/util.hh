@@ -12,6 +12,8 @@
 
 #include <assert.h>
 
+#include "blas/half.hh"
+
 namespace blas {
 
 // -----------------------------------------------------------------------------
@@ -209,6 +211,22 @@ inline T conj( T x )
     return x;
 }
 
+/// @return x, conjugated if do_conj; do_conj is ignored for real types.
+/// Usage:
+///     scalar_t y = blas::conj_if( trans == Op::ConjTrans, x );
+///
+template< typename T >
+inline T conj_if( bool, T x )
+{
+    return x;
+}
+
+template< typename T >
+inline std::complex<T> conj_if( bool do_conj, std::complex<T> x )
+{
+    return (do_conj ? std::conj( x ) : x);
+}
+
 // -----------------------------------------------------------------------------
 // Based on C++14 common_type implementation from
 // http://www.cplusplus.com/reference/type_traits/common_type/
@@ -220,6 +238,33 @@ inline T conj( T x )
 //
 // std::common_type_t< int, complex<long> > is not defined (compile error)
 //        scalar_type< int, complex<long> > is complex<long> (right)
+//
+// Half precision storage types float16 and bfloat16 are promoted to float,
+// the type their arithmetic is done in:
+//        scalar_type< float16, float16 > is float
+//        scalar_type< bfloat16, double > is double
+
+// computation type: float for half precision, otherwise T itself
+template< typename T >
+struct compute_type_traits
+{
+    using type = T;
+};
+
+template<>
+struct compute_type_traits< float16 >
+{
+    using type = float;
+};
+
+template<>
+struct compute_type_traits< bfloat16 >
+{
+    using type = float;
+};
+
+template< typename T >
+using compute_type = typename compute_type_traits< decay_t<T> >::type;
 
 // for zero types
 template< typename... Types >
@@ -233,7 +278,7 @@ using scalar_type = typename scalar_type_traits< Types... >::type;
 template< typename T >
 struct scalar_type_traits< T >
 {
-    using type = decay_t<T>;
+    using type = compute_type<T>;
 };
 
 // for two types
@@ -241,7 +286,8 @@ struct scalar_type_traits< T >
 template< typename T1, typename T2 >
 struct scalar_type_traits< T1, T2 >
 {
-    using type = decay_t< decltype( true ? std::declval<T1>() : std::declval<T2>() ) >;
+    using type = decay_t< decltype( true ? std::declval< compute_type<T1> >()
+                                         : std::declval< compute_type<T2> >() ) >;
 };
 
 // for either or both complex,
@@ -285,6 +331,8 @@ struct scalar_type_traits< T1, T2, Types... >
 // complex_type< float >                            is complex<float>
 // complex_type< float, double >                    is complex<double>
 // complex_type< float, double, complex<float> >    is complex<double>
+//
+// real_type< float16 >                             is float
 
 // for zero types
 template< typename... Types >
@@ -298,11 +346,11 @@ using real_type = typename real_type_traits< Types... >::real_t;
 template< typename... Types >
 using complex_type = std::complex< real_type< Types... > >;
 
-// for one type
+// for one type; half precision is promoted to float, like scalar_type
 template< typename T >
 struct real_type_traits<T>
 {
-    using real_t = T;
+    using real_t = compute_type<T>;
 };
 
 // for one complex type, strip complex
@@ -392,6 +392,102 @@ void gemv(
     std::complex<double> beta,
     std::complex<double>       *y, int64_t incy );
 
+// Half precision A and x, accumulated in float; y is half or float.
+// See src/gemv_half.cc.
+/// @ingroup gemv
+void gemv(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    float alpha,
+    float16 const *A, int64_t lda,
+    float16 const *x, int64_t incx,
+    float beta,
+    float16 *y, int64_t incy );
+
+/// @ingroup gemv
+void gemv(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    float alpha,
+    float16 const *A, int64_t lda,
+    float16 const *x, int64_t incx,
+    float beta,
+    float *y, int64_t incy );
+
+/// @ingroup gemv
+void gemv(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    float alpha,
+    bfloat16 const *A, int64_t lda,
+    bfloat16 const *x, int64_t incx,
+    float beta,
+    bfloat16 *y, int64_t incy );
+
+/// @ingroup gemv
+void gemv(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    float alpha,
+    bfloat16 const *A, int64_t lda,
+    bfloat16 const *x, int64_t incx,
+    float beta,
+    float *y, int64_t incy );
+
+// 8-bit integer A and x, accumulated in int32; y is int32, or float with
+// an optional dequantization scale per entry of y (may be null).
+// x may be unsigned, e.g., activations, with signed A, e.g., weights.
+// See src/gemv_int8.cc.
+/// @ingroup gemv
+void gemv(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    int32_t alpha,
+    int8_t const *A, int64_t lda,
+    int8_t const *x, int64_t incx,
+    int32_t beta,
+    int32_t *y, int64_t incy );
+
+/// @ingroup gemv
+void gemv(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    int32_t alpha,
+    int8_t  const *A, int64_t lda,
+    uint8_t const *x, int64_t incx,
+    int32_t beta,
+    int32_t *y, int64_t incy );
+
+/// @ingroup gemv
+void gemv(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    float alpha,
+    int8_t const *A, int64_t lda,
+    int8_t const *x, int64_t incx,
+    float beta,
+    float *y, int64_t incy,
+    float const *scale );
+
+/// @ingroup gemv
+void gemv(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    float alpha,
+    int8_t  const *A, int64_t lda,
+    uint8_t const *x, int64_t incx,
+    float beta,
+    float *y, int64_t incy,
+    float const *scale );
+
 // -----------------------------------------------------------------------------
 /// @ingroup ger
 void ger(
@@ -828,6 +924,355 @@ void gemm(
     std::complex<double> beta,
     std::complex<double>       *C, int64_t ldc );
 
+// Vendor gemm, without argument checks, profiling, tuning, or splitting k,
+// for routines that call gemm on sub-problems they have already checked,
+// e.g., from their own parallel regions. See src/gemm.cc.
+namespace internal {
+
+void gemm_vendor(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    float alpha,
+    float const *A, int64_t lda,
+    float const *B, int64_t ldb,
+    float beta,
+    float       *C, int64_t ldc );
+
+void gemm_vendor(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    double alpha,
+    double const *A, int64_t lda,
+    double const *B, int64_t ldb,
+    double beta,
+    double       *C, int64_t ldc );
+
+void gemm_vendor(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<float> alpha,
+    std::complex<float> const *A, int64_t lda,
+    std::complex<float> const *B, int64_t ldb,
+    std::complex<float> beta,
+    std::complex<float>       *C, int64_t ldc );
+
+void gemm_vendor(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<double> alpha,
+    std::complex<double> const *A, int64_t lda,
+    std::complex<double> const *B, int64_t ldb,
+    std::complex<double> beta,
+    std::complex<double>       *C, int64_t ldc );
+
+}  // namespace internal
+
+// Half precision A and B, accumulated in float; C is half or float.
+// See src/gemm_half.cc.
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    float alpha,
+    float16 const *A, int64_t lda,
+    float16 const *B, int64_t ldb,
+    float beta,
+    float16 *C, int64_t ldc );
+
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    float alpha,
+    float16 const *A, int64_t lda,
+    float16 const *B, int64_t ldb,
+    float beta,
+    float *C, int64_t ldc );
+
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    float alpha,
+    bfloat16 const *A, int64_t lda,
+    bfloat16 const *B, int64_t ldb,
+    float beta,
+    bfloat16 *C, int64_t ldc );
+
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    float alpha,
+    bfloat16 const *A, int64_t lda,
+    bfloat16 const *B, int64_t ldb,
+    float beta,
+    float *C, int64_t ldc );
+
+// 8-bit integer A and B, accumulated in int32; C is int32, or float with
+// optional dequantization scales per row and per column of C (may be null):
+// C(i, j) = alpha row_scale(i) col_scale(j) sum_l A(i, l) B(l, j)
+//         + beta C(i, j).
+// A may be unsigned, e.g., activations, with signed B, e.g., weights.
+// With int32 C, overflow wraps. See src/gemm_int8.cc.
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    int32_t alpha,
+    int8_t const *A, int64_t lda,
+    int8_t const *B, int64_t ldb,
+    int32_t beta,
+    int32_t *C, int64_t ldc );
+
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    int32_t alpha,
+    uint8_t const *A, int64_t lda,
+    int8_t  const *B, int64_t ldb,
+    int32_t beta,
+    int32_t *C, int64_t ldc );
+
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    float alpha,
+    int8_t const *A, int64_t lda,
+    int8_t const *B, int64_t ldb,
+    float beta,
+    float *C, int64_t ldc,
+    float const *row_scale,
+    float const *col_scale );
+
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    float alpha,
+    uint8_t const *A, int64_t lda,
+    int8_t  const *B, int64_t ldb,
+    float beta,
+    float *C, int64_t ldc,
+    float const *row_scale,
+    float const *col_scale );
+
+// General stride, with a row and a column stride per matrix, instead of a
+// layout and leading dimension, e.g., for slices of tensors:
+// C = alpha A B + beta C, where A is m-by-k with A(i, l) = A[ i*rsa + l*csa ],
+// B is k-by-n with B(l, j) = B[ l*rsb + j*csb ], and C is m-by-n with
+// C(i, j) = C[ i*rsc + j*csc ]. Strides may be negative, or zero for A, B.
+// Transposes are expressed by swapping strides. See src/gemm_strided.cc.
+/// @ingroup gemm
+void gemm(
+    int64_t m, int64_t n, int64_t k,
+    float alpha,
+    float const *A, int64_t rsa, int64_t csa,
+    float const *B, int64_t rsb, int64_t csb,
+    float beta,
+    float       *C, int64_t rsc, int64_t csc );
+
+/// @ingroup gemm
+void gemm(
+    int64_t m, int64_t n, int64_t k,
+    double alpha,
+    double const *A, int64_t rsa, int64_t csa,
+    double const *B, int64_t rsb, int64_t csb,
+    double beta,
+    double       *C, int64_t rsc, int64_t csc );
+
+/// @ingroup gemm
+void gemm(
+    int64_t m, int64_t n, int64_t k,
+    std::complex<float> alpha,
+    std::complex<float> const *A, int64_t rsa, int64_t csa,
+    std::complex<float> const *B, int64_t rsb, int64_t csb,
+    std::complex<float> beta,
+    std::complex<float>       *C, int64_t rsc, int64_t csc );
+
+/// @ingroup gemm
+void gemm(
+    int64_t m, int64_t n, int64_t k,
+    std::complex<double> alpha,
+    std::complex<double> const *A, int64_t rsa, int64_t csa,
+    std::complex<double> const *B, int64_t rsb, int64_t csb,
+    std::complex<double> beta,
+    std::complex<double>       *C, int64_t rsc, int64_t csc );
+
+// Complex gemm by the 3M method: 3 real gemms on the real and imaginary
+// parts, plus additions, instead of 4, saving 25% of the flops for large
+// problems. Opt-in, since it is less accurate than gemm: the error bound
+// on the imaginary part of C grows with ||Re A|| + ||Im A|| and
+// ||Re B|| + ||Im B||, instead of ||A|| and ||B||, so it is larger if
+// the real and imaginary parts differ greatly in magnitude. The error in
+// C is still normwise bounded by a small multiple of gemm's bound.
+// Also needs 3 m k + 3 (m + k) min( n, 512 ) reals of workspace.
+// Small problems use gemm. See src/gemm3m.cc.
+/// @ingroup gemm
+void gemm3m(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<float> alpha,
+    std::complex<float> const *A, int64_t lda,
+    std::complex<float> const *B, int64_t ldb,
+    std::complex<float> beta,
+    std::complex<float>       *C, int64_t ldc );
+
+/// @ingroup gemm
+void gemm3m(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<double> alpha,
+    std::complex<double> const *A, int64_t lda,
+    std::complex<double> const *B, int64_t ldb,
+    std::complex<double> beta,
+    std::complex<double>       *C, int64_t ldc );
+
+// Strassen-Winograd gemm, for very large problems: each level of recursion
+// does 7 half-size products instead of 8, saving up to 12.5% of the flops
+// per level, at the cost of O(n^2) additions. Recurses up to levels times,
+// while min( m, n, k ) >= 1536, so small or thin problems fall back to
+// gemm; leaves use gemm. Opt-in, since it is less accurate than gemm:
+// the error is only normwise bounded, and the bound grows by roughly a
+// factor of 6 per level. One workspace of about (m k + k n + m n) / 3
+// elements is allocated and reused by all levels. See src/gemm_strassen.cc.
+/// @ingroup gemm
+void gemm_strassen(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    float alpha,
+    float const *A, int64_t lda,
+    float const *B, int64_t ldb,
+    float beta,
+    float       *C, int64_t ldc,
+    int64_t levels=1 );
+
+/// @ingroup gemm
+void gemm_strassen(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    double alpha,
+    double const *A, int64_t lda,
+    double const *B, int64_t ldb,
+    double beta,
+    double       *C, int64_t ldc,
+    int64_t levels=1 );
+
+/// @ingroup gemm
+void gemm_strassen(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<float> alpha,
+    std::complex<float> const *A, int64_t lda,
+    std::complex<float> const *B, int64_t ldb,
+    std::complex<float> beta,
+    std::complex<float>       *C, int64_t ldc,
+    int64_t levels=1 );
+
+/// @ingroup gemm
+void gemm_strassen(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<double> alpha,
+    std::complex<double> const *A, int64_t lda,
+    std::complex<double> const *B, int64_t ldb,
+    std::complex<double> beta,
+    std::complex<double>       *C, int64_t ldc,
+    int64_t levels=1 );
+
+// -----------------------------------------------------------------------------
+// C = alpha op(A) op(B) + beta C, updating only the uplo triangle of the
+// n-by-n matrix C. Other arguments are as in gemm.
+/// @ingroup gemm
+void gemmt(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t n, int64_t k,
+    float alpha,
+    float const *A, int64_t lda,
+    float const *B, int64_t ldb,
+    float beta,
+    float       *C, int64_t ldc );
+
+/// @ingroup gemm
+void gemmt(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t n, int64_t k,
+    double alpha,
+    double const *A, int64_t lda,
+    double const *B, int64_t ldb,
+    double beta,
+    double       *C, int64_t ldc );
+
+/// @ingroup gemm
+void gemmt(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t n, int64_t k,
+    std::complex<float> alpha,
+    std::complex<float> const *A, int64_t lda,
+    std::complex<float> const *B, int64_t ldb,
+    std::complex<float> beta,
+    std::complex<float>       *C, int64_t ldc );
+
+/// @ingroup gemm
+void gemmt(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t n, int64_t k,
+    std::complex<double> alpha,
+    std::complex<double> const *A, int64_t lda,
+    std::complex<double> const *B, int64_t ldb,
+    std::complex<double> beta,
+    std::complex<double>       *C, int64_t ldc );
+
 // -----------------------------------------------------------------------------
 /// @ingroup hemm
 void hemm(
@@ -1220,6 +1665,137 @@ void trsm(
     std::complex<double> const *A, int64_t lda,
     std::complex<double>       *B, int64_t ldb );
 
+// =============================================================================
+// Matrix copy, transpose, and addition
+
+// -----------------------------------------------------------------------------
+// B = alpha op(A), where A is m-by-n, so B is m-by-n for NoTrans, else n-by-m.
+// Converts between layouts: a ColMajor A is a RowMajor A^T.
+// See src/matcopy.cc.
+/// @ingroup copy
+void omatcopy(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    float alpha,
+    float const *A, int64_t lda,
+    float       *B, int64_t ldb );
+
+/// @ingroup copy
+void omatcopy(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    double alpha,
+    double const *A, int64_t lda,
+    double       *B, int64_t ldb );
+
+/// @ingroup copy
+void omatcopy(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    std::complex<float> alpha,
+    std::complex<float> const *A, int64_t lda,
+    std::complex<float>       *B, int64_t ldb );
+
+/// @ingroup copy
+void omatcopy(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    std::complex<double> alpha,
+    std::complex<double> const *A, int64_t lda,
+    std::complex<double>       *B, int64_t ldb );
+
+// -----------------------------------------------------------------------------
+// In-place B = alpha op(A): on entry, AB holds the m-by-n A with leading
+// dimension lda; on exit, B with leading dimension ldb. AB must be large
+// enough to hold both. Non-square transposes use cycle-following.
+/// @ingroup copy
+void imatcopy(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    float alpha,
+    float *AB, int64_t lda, int64_t ldb );
+
+/// @ingroup copy
+void imatcopy(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    double alpha,
+    double *AB, int64_t lda, int64_t ldb );
+
+/// @ingroup copy
+void imatcopy(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    std::complex<float> alpha,
+    std::complex<float> *AB, int64_t lda, int64_t ldb );
+
+/// @ingroup copy
+void imatcopy(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    std::complex<double> alpha,
+    std::complex<double> *AB, int64_t lda, int64_t ldb );
+
+// -----------------------------------------------------------------------------
+// C = alpha op(A) + beta op(B), where C is m-by-n. If beta = 0, B is not
+// read; if alpha = 0, A is not read. C may be A, if transA = NoTrans and
+// lda = ldc, or likewise B. See src/geam.cc.
+/// @ingroup gemm
+void geam(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n,
+    float alpha,
+    float const *A, int64_t lda,
+    float beta,
+    float const *B, int64_t ldb,
+    float       *C, int64_t ldc );
+
+/// @ingroup gemm
+void geam(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n,
+    double alpha,
+    double const *A, int64_t lda,
+    double beta,
+    double const *B, int64_t ldb,
+    double       *C, int64_t ldc );
+
+/// @ingroup gemm
+void geam(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n,
+    std::complex<float> alpha,
+    std::complex<float> const *A, int64_t lda,
+    std::complex<float> beta,
+    std::complex<float> const *B, int64_t ldb,
+    std::complex<float>       *C, int64_t ldc );
+
+/// @ingroup gemm
+void geam(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n,
+    std::complex<double> alpha,
+    std::complex<double> const *A, int64_t lda,
+    std::complex<double> beta,
+    std::complex<double> const *B, int64_t ldb,
+    std::complex<double>       *C, int64_t ldc );
+
 // =============================================================================
 //                     Batch BLAS APIs ( host )
 // =============================================================================
@@ -1283,6 +1859,64 @@ void gemm(
     std::vector< std::complex<double>* >   const &Carray, std::vector<int64_t> const &lddc,
     const size_t batch,                                   std::vector<int64_t>       &info );
 
+// -----------------------------------------------------------------------------
+// batch gemmt
+void gemmt(
+    blas::Layout                   layout,
+    std::vector<blas::Uplo> const &uplo,
+    std::vector<blas::Op>   const &transA,
+    std::vector<blas::Op>   const &transB,
+    std::vector<int64_t>    const &n,
+    std::vector<int64_t>    const &k,
+    std::vector<float> const &alpha,
+    std::vector<float*> const &Aarray, std::vector<int64_t> const &ldda,
+    std::vector<float*> const &Barray, std::vector<int64_t> const &lddb,
+    std::vector<float> const &beta,
+    std::vector<float*> const &Carray, std::vector<int64_t> const &lddc,
+    const size_t batch, std::vector<int64_t> &info );
+
+void gemmt(
+    blas::Layout                   layout,
+    std::vector<blas::Uplo> const &uplo,
+    std::vector<blas::Op>   const &transA,
+    std::vector<blas::Op>   const &transB,
+    std::vector<int64_t>    const &n,
+    std::vector<int64_t>    const &k,
+    std::vector<double> const &alpha,
+    std::vector<double*> const &Aarray, std::vector<int64_t> const &ldda,
+    std::vector<double*> const &Barray, std::vector<int64_t> const &lddb,
+    std::vector<double> const &beta,
+    std::vector<double*> const &Carray, std::vector<int64_t> const &lddc,
+    const size_t batch, std::vector<int64_t> &info );
+
+void gemmt(
+    blas::Layout                   layout,
+    std::vector<blas::Uplo> const &uplo,
+    std::vector<blas::Op>   const &transA,
+    std::vector<blas::Op>   const &transB,
+    std::vector<int64_t>    const &n,
+    std::vector<int64_t>    const &k,
+    std::vector< std::complex<float> > const &alpha,
+    std::vector< std::complex<float>* > const &Aarray, std::vector<int64_t> const &ldda,
+    std::vector< std::complex<float>* > const &Barray, std::vector<int64_t> const &lddb,
+    std::vector< std::complex<float> > const &beta,
+    std::vector< std::complex<float>* > const &Carray, std::vector<int64_t> const &lddc,
+    const size_t batch, std::vector<int64_t> &info );
+
+void gemmt(
+    blas::Layout                   layout,
+    std::vector<blas::Uplo> const &uplo,
+    std::vector<blas::Op>   const &transA,
+    std::vector<blas::Op>   const &transB,
+    std::vector<int64_t>    const &n,
+    std::vector<int64_t>    const &k,
+    std::vector< std::complex<double> > const &alpha,
+    std::vector< std::complex<double>* > const &Aarray, std::vector<int64_t> const &ldda,
+    std::vector< std::complex<double>* > const &Barray, std::vector<int64_t> const &lddb,
+    std::vector< std::complex<double> > const &beta,
+    std::vector< std::complex<double>* > const &Carray, std::vector<int64_t> const &lddc,
+    const size_t batch, std::vector<int64_t> &info );
+
 // -----------------------------------------------------------------------------
 // batch trsm
 void trsm(
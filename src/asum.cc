@@ -5,6 +5,9 @@
 
 #include "blas/fortran.h"
 #include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
+#include "blas/repro.hh"
 
 #include <limits>
 
@@ -23,6 +26,14 @@ float asum(
     blas_error_if( n < 0 );      // standard BLAS returns, doesn't fail
     blas_error_if( incx <= 0 );  // standard BLAS returns, doesn't fail
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "asum", 's', {},
+                          n, 0, 0, Gflop< float >::asum( n ) );
+
+    // bitwise reproducible mode; see blas::repro
+    if (repro::enabled())
+        return repro::asum( n, x, incx );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n    > std::numeric_limits<blas_int>::max() );
@@ -44,6 +55,14 @@ double asum(
     blas_error_if( n < 0 );      // standard BLAS returns, doesn't fail
     blas_error_if( incx <= 0 );  // standard BLAS returns, doesn't fail
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "asum", 'd', {},
+                          n, 0, 0, Gflop< double >::asum( n ) );
+
+    // bitwise reproducible mode; see blas::repro
+    if (repro::enabled())
+        return repro::asum( n, x, incx );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n    > std::numeric_limits<blas_int>::max() );
@@ -65,6 +84,14 @@ float asum(
     blas_error_if( n < 0 );      // standard BLAS returns, doesn't fail
     blas_error_if( incx <= 0 );  // standard BLAS returns, doesn't fail
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "asum", 'c', {},
+                          n, 0, 0, Gflop< std::complex<float> >::asum( n ) );
+
+    // bitwise reproducible mode; see blas::repro
+    if (repro::enabled())
+        return repro::asum( n, x, incx );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n    > std::numeric_limits<blas_int>::max() );
@@ -87,6 +114,14 @@ double asum(
     blas_error_if( n < 0 );      // standard BLAS returns, doesn't fail
     blas_error_if( incx <= 0 );  // standard BLAS returns, doesn't fail
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "asum", 'z', {},
+                          n, 0, 0, Gflop< std::complex<double> >::asum( n ) );
+
+    // bitwise reproducible mode; see blas::repro
+    if (repro::enabled())
+        return repro::asum( n, x, incx );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n    > std::numeric_limits<blas_int>::max() );
@@ -5,6 +5,8 @@
 
 #include "blas/fortran.h"
 #include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 
 #include <limits>
 
@@ -29,6 +31,10 @@ void axpy(
     blas_error_if( incx == 0 );  // standard BLAS doesn't detect inc[xy] == 0
     blas_error_if( incy == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "axpy", 's', {},
+                          n, 0, 0, Gflop< float >::axpy( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n              > std::numeric_limits<blas_int>::max() );
@@ -55,6 +61,10 @@ void axpy(
     blas_error_if( incx == 0 );  // standard BLAS doesn't detect inc[xy] == 0
     blas_error_if( incy == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "axpy", 'd', {},
+                          n, 0, 0, Gflop< double >::axpy( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n              > std::numeric_limits<blas_int>::max() );
@@ -81,6 +91,10 @@ void axpy(
     blas_error_if( incx == 0 );  // standard BLAS doesn't detect inc[xy] == 0
     blas_error_if( incy == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "axpy", 'c', {},
+                          n, 0, 0, Gflop< std::complex<float> >::axpy( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n              > std::numeric_limits<blas_int>::max() );
@@ -110,6 +124,10 @@ void axpy(
     blas_error_if( incx == 0 );  // standard BLAS doesn't detect inc[xy] == 0
     blas_error_if( incy == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "axpy", 'z', {},
+                          n, 0, 0, Gflop< std::complex<double> >::axpy( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n              > std::numeric_limits<blas_int>::max() );
@@ -6,8 +6,129 @@
 #include <limits>
 #include <cstring>
 #include "blas/batch_common.hh"
+#include "blas/flops.hh"
+#include "blas/numa.hh"
+#include "blas/profile.hh"
 #include "blas.hh"
 
+namespace blas {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Batch gemm where one A or one B is shared by all problems, and all other
+/// arguments are uniform (vectors of size 1), as batch::gemm_check permits.
+/// If the unshared operand and C of each problem are stored back-to-back,
+/// the batch is one large gemm, with problems concatenated along n
+/// (shared A) or m (shared B). Otherwise, the shared operand is packed once
+/// by gemm_pack and each problem multiplies by the packed copy.
+///
+/// @return true if the batch was computed;
+///         false if not applicable, to do independent gemms.
+template <typename T>
+bool batch_gemm_shared(
+    blas::Layout                layout,
+    std::vector<blas::Op> const &transA,
+    std::vector<blas::Op> const &transB,
+    std::vector<int64_t>  const &m,
+    std::vector<int64_t>  const &n,
+    std::vector<int64_t>  const &k,
+    std::vector<T >       const &alpha,
+    std::vector<T*>       const &Aarray, std::vector<int64_t> const &ldda,
+    std::vector<T*>       const &Barray, std::vector<int64_t> const &lddb,
+    std::vector<T >       const &beta,
+    std::vector<T*>       const &Carray, std::vector<int64_t> const &lddc,
+    const size_t batch )
+{
+    bool shared_A = (Aarray.size() == 1);
+    bool shared_B = (Barray.size() == 1);
+    if (batch < 2 || ! (shared_A || shared_B)
+        || Carray.size() < batch
+        || transA.size() != 1 || transB.size() != 1
+        || m.size()      != 1 || n.size()      != 1 || k.size() != 1
+        || alpha.size()  != 1 || beta.size()   != 1
+        || ldda.size()   != 1 || lddb.size()   != 1 || lddc.size() != 1)
+        return false;
+
+    // Column-major view, C = op(L) op(R), M-by-N; row-major swaps A and B.
+    bool col = (layout == Layout::ColMajor);
+    Op transL = (col ? transA[0] : transB[0]);
+    Op transR = (col ? transB[0] : transA[0]);
+    int64_t M   = (col ? m[0] : n[0]);
+    int64_t N   = (col ? n[0] : m[0]);
+    int64_t K   = k[0];
+    int64_t ldl = (col ? ldda[0] : lddb[0]);
+    int64_t ldr = (col ? lddb[0] : ldda[0]);
+    int64_t ldc = lddc[0];
+    std::vector<T*> const& Larray = (col ? Aarray : Barray);
+    std::vector<T*> const& Rarray = (col ? Barray : Aarray);
+    bool shared_L = (Larray.size() == 1);
+    bool shared_R = (Rarray.size() == 1);
+
+    if (M > 0 && N > 0 && shared_L != shared_R) {
+        // Shared L: C_i are adjacent columns, [C_0 ... C_b] = L [R_0 ... R_b].
+        // Shared R: C_i are adjacent rows,    [C_0; ...; C_b] = [L_0; ...; L_b] R.
+        int64_t nb = int64_t( batch );
+        T* const* X = (shared_L ? Rarray.data() : Larray.data());
+        Op transX   = (shared_L ? transR : transL);
+        int64_t ldx = (shared_L ? ldr : ldl);
+        int64_t mn  = (shared_L ? N : M);
+        // offsets between problems in X and C; both must fit in one matrix
+        bool x_cols = (shared_L == (transX == Op::NoTrans));
+        int64_t dx = (x_cols ? mn*ldx : mn);
+        int64_t dc = (shared_L ? mn*ldc : mn);
+        bool concat = (x_cols || ldx >= nb*mn)
+                      && (shared_L || ldc >= nb*mn);
+        for (int64_t i = 1; i < nb && concat; ++i) {
+            concat = (X[ i ] == X[ 0 ] + i*dx)
+                     && (Carray[ i ] == Carray[ 0 ] + i*dc);
+        }
+        if (concat) {
+            if (shared_L)
+                blas::gemm( Layout::ColMajor, transL, transR, M, nb*N, K,
+                            alpha[0], Larray[0], ldl, X[0], ldr,
+                            beta[0], Carray[0], ldc );
+            else
+                blas::gemm( Layout::ColMajor, transL, transR, nb*M, N, K,
+                            alpha[0], X[0], ldl, Rarray[0], ldr,
+                            beta[0], Carray[0], ldc );
+            return true;
+        }
+    }
+
+    // pack the shared operand once; each gemm runs on its share of threads
+    int64_t nthreads = batch_threads( batch );
+    if (shared_A) {
+        PackedMatrix<T> Ap = blas::gemm_pack(
+            layout, Side::Left, transA[0], m[0], n[0], k[0], Aarray[0], ldda[0] );
+        numa::for_each_local(
+            batch,
+            [&]( size_t i ) -> void const* { return Carray[ i ]; },
+            [&]( size_t i ) {
+                ThreadScope thread_scope( nthreads );
+                blas::gemm( layout, transB[0], m[0], n[0], k[0],
+                            alpha[0], Ap, batch::extract<T*>( Barray, i ), lddb[0],
+                            beta[0], Carray[ i ], lddc[0] );
+            } );
+    }
+    else {
+        PackedMatrix<T> Bp = blas::gemm_pack(
+            layout, Side::Right, transB[0], m[0], n[0], k[0], Barray[0], lddb[0] );
+        numa::for_each_local(
+            batch,
+            [&]( size_t i ) -> void const* { return Carray[ i ]; },
+            [&]( size_t i ) {
+                ThreadScope thread_scope( nthreads );
+                blas::gemm( layout, transA[0], m[0], n[0], k[0],
+                            alpha[0], Aarray[ i ], ldda[0], Bp,
+                            beta[0], Carray[ i ], lddc[0] );
+            } );
+    }
+    return true;
+}
+
+}  // namespace internal
+}  // namespace blas
+
 // -----------------------------------------------------------------------------
 /// @ingroup gemm
 void blas::batch::gemm(
@@ -36,27 +157,45 @@ void blas::batch::gemm(
                                         batch, info );
     }
 
-    #pragma omp parallel for schedule(dynamic)
-    for (size_t i = 0; i < batch; ++i) {
-        Op transA_   = blas::batch::extract<Op>(transA, i);
-        Op transB_   = blas::batch::extract<Op>(transB, i);
-        int64_t m_   = blas::batch::extract<int64_t>(m, i);
-        int64_t n_   = blas::batch::extract<int64_t>(n, i);
-        int64_t k_   = blas::batch::extract<int64_t>(k, i);
-        int64_t lda_ = blas::batch::extract<int64_t>(ldda, i);
-        int64_t ldb_ = blas::batch::extract<int64_t>(lddb, i);
-        int64_t ldc_ = blas::batch::extract<int64_t>(lddc, i);
-        float alpha_ = blas::batch::extract<float>(alpha, i);
-        float beta_  = blas::batch::extract<float>(beta, i);
-        float* dA_   = blas::batch::extract<float*>(Aarray, i);
-        float* dB_   = blas::batch::extract<float*>(Barray, i);
-        float* dC_   = blas::batch::extract<float*>(Carray, i);
-        blas::gemm(
-            layout, transA_, transB_, m_, n_, k_,
-            alpha_, dA_, lda_,
-                    dB_, ldb_,
-            beta_,  dC_, ldc_ );
-    }
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "batch_gemm", 's', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
+    // one large or packed gemm if A or B is shared
+    if (internal::batch_gemm_shared( layout, transA, transB, m, n, k,
+                                     alpha, Aarray, ldda, Barray, lddb,
+                                     beta, Carray, lddc, batch ))
+        return;
+
+    // prefer a thread on the NUMA node holding each C; see blas::numa
+    // threads per problem, so problems times threads fit the cores
+    int64_t nthreads = batch_threads( batch );
+    numa::for_each_local(
+        batch,
+        [&]( size_t i ) -> void const* {
+            return blas::batch::extract<float*>(Carray, i);
+        },
+        [&]( size_t i ) {
+            ThreadScope thread_scope( nthreads );
+            Op transA_   = blas::batch::extract<Op>(transA, i);
+            Op transB_   = blas::batch::extract<Op>(transB, i);
+            int64_t m_   = blas::batch::extract<int64_t>(m, i);
+            int64_t n_   = blas::batch::extract<int64_t>(n, i);
+            int64_t k_   = blas::batch::extract<int64_t>(k, i);
+            int64_t lda_ = blas::batch::extract<int64_t>(ldda, i);
+            int64_t ldb_ = blas::batch::extract<int64_t>(lddb, i);
+            int64_t ldc_ = blas::batch::extract<int64_t>(lddc, i);
+            float alpha_ = blas::batch::extract<float>(alpha, i);
+            float beta_  = blas::batch::extract<float>(beta, i);
+            float* dA_   = blas::batch::extract<float*>(Aarray, i);
+            float* dB_   = blas::batch::extract<float*>(Barray, i);
+            float* dC_   = blas::batch::extract<float*>(Carray, i);
+            blas::gemm(
+                layout, transA_, transB_, m_, n_, k_,
+                alpha_, dA_, lda_,
+                        dB_, ldb_,
+                beta_,  dC_, ldc_ );
+        } );
 }
 
 // -----------------------------------------------------------------------------
@@ -88,27 +227,45 @@ void blas::batch::gemm(
                                          batch, info );
     }
 
-    #pragma omp parallel for schedule(dynamic)
-    for (size_t i = 0; i < batch; ++i) {
-        Op transA_    = blas::batch::extract<Op>(transA, i);
-        Op transB_    = blas::batch::extract<Op>(transB, i);
-        int64_t m_    = blas::batch::extract<int64_t>(m, i);
-        int64_t n_    = blas::batch::extract<int64_t>(n, i);
-        int64_t k_    = blas::batch::extract<int64_t>(k, i);
-        int64_t lda_  = blas::batch::extract<int64_t>(ldda, i);
-        int64_t ldb_  = blas::batch::extract<int64_t>(lddb, i);
-        int64_t ldc_  = blas::batch::extract<int64_t>(lddc, i);
-        double alpha_ = blas::batch::extract<double>(alpha, i);
-        double beta_  = blas::batch::extract<double>(beta, i);
-        double* dA_   = blas::batch::extract<double*>(Aarray, i);
-        double* dB_   = blas::batch::extract<double*>(Barray, i);
-        double* dC_   = blas::batch::extract<double*>(Carray, i);
-        blas::gemm(
-            layout, transA_, transB_, m_, n_, k_,
-            alpha_, dA_, lda_,
-                    dB_, ldb_,
-            beta_,  dC_, ldc_ );
-    }
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "batch_gemm", 'd', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
+    // one large or packed gemm if A or B is shared
+    if (internal::batch_gemm_shared( layout, transA, transB, m, n, k,
+                                     alpha, Aarray, ldda, Barray, lddb,
+                                     beta, Carray, lddc, batch ))
+        return;
+
+    // prefer a thread on the NUMA node holding each C; see blas::numa
+    // threads per problem, so problems times threads fit the cores
+    int64_t nthreads = batch_threads( batch );
+    numa::for_each_local(
+        batch,
+        [&]( size_t i ) -> void const* {
+            return blas::batch::extract<double*>(Carray, i);
+        },
+        [&]( size_t i ) {
+            ThreadScope thread_scope( nthreads );
+            Op transA_    = blas::batch::extract<Op>(transA, i);
+            Op transB_    = blas::batch::extract<Op>(transB, i);
+            int64_t m_    = blas::batch::extract<int64_t>(m, i);
+            int64_t n_    = blas::batch::extract<int64_t>(n, i);
+            int64_t k_    = blas::batch::extract<int64_t>(k, i);
+            int64_t lda_  = blas::batch::extract<int64_t>(ldda, i);
+            int64_t ldb_  = blas::batch::extract<int64_t>(lddb, i);
+            int64_t ldc_  = blas::batch::extract<int64_t>(lddc, i);
+            double alpha_ = blas::batch::extract<double>(alpha, i);
+            double beta_  = blas::batch::extract<double>(beta, i);
+            double* dA_   = blas::batch::extract<double*>(Aarray, i);
+            double* dB_   = blas::batch::extract<double*>(Barray, i);
+            double* dC_   = blas::batch::extract<double*>(Carray, i);
+            blas::gemm(
+                layout, transA_, transB_, m_, n_, k_,
+                alpha_, dA_, lda_,
+                        dB_, ldb_,
+                beta_,  dC_, ldc_ );
+        } );
 }
 
 // -----------------------------------------------------------------------------
@@ -140,27 +297,45 @@ void blas::batch::gemm(
                                         batch, info );
     }
 
-    #pragma omp parallel for schedule(dynamic)
-    for (size_t i = 0; i < batch; ++i) {
-        Op transA_    = blas::batch::extract<Op>(transA, i);
-        Op transB_    = blas::batch::extract<Op>(transB, i);
-        int64_t m_    = blas::batch::extract<int64_t>(m, i);
-        int64_t n_    = blas::batch::extract<int64_t>(n, i);
-        int64_t k_    = blas::batch::extract<int64_t>(k, i);
-        int64_t lda_  = blas::batch::extract<int64_t>(ldda, i);
-        int64_t ldb_  = blas::batch::extract<int64_t>(lddb, i);
-        int64_t ldc_  = blas::batch::extract<int64_t>(lddc, i);
-        std::complex<float> alpha_ = blas::batch::extract<std::complex<float> >(alpha, i);
-        std::complex<float> beta_  = blas::batch::extract<std::complex<float> >(beta, i);
-        std::complex<float>* dA_   = blas::batch::extract<std::complex<float>*>(Aarray, i);
-        std::complex<float>* dB_   = blas::batch::extract<std::complex<float>*>(Barray, i);
-        std::complex<float>* dC_   = blas::batch::extract<std::complex<float>*>(Carray, i);
-        blas::gemm(
-            layout, transA_, transB_, m_, n_, k_,
-            alpha_, dA_, lda_,
-                    dB_, ldb_,
-            beta_,  dC_, ldc_ );
-    }
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "batch_gemm", 'c', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
+    // one large or packed gemm if A or B is shared
+    if (internal::batch_gemm_shared( layout, transA, transB, m, n, k,
+                                     alpha, Aarray, ldda, Barray, lddb,
+                                     beta, Carray, lddc, batch ))
+        return;
+
+    // prefer a thread on the NUMA node holding each C; see blas::numa
+    // threads per problem, so problems times threads fit the cores
+    int64_t nthreads = batch_threads( batch );
+    numa::for_each_local(
+        batch,
+        [&]( size_t i ) -> void const* {
+            return blas::batch::extract<std::complex<float>*>(Carray, i);
+        },
+        [&]( size_t i ) {
+            ThreadScope thread_scope( nthreads );
+            Op transA_    = blas::batch::extract<Op>(transA, i);
+            Op transB_    = blas::batch::extract<Op>(transB, i);
+            int64_t m_    = blas::batch::extract<int64_t>(m, i);
+            int64_t n_    = blas::batch::extract<int64_t>(n, i);
+            int64_t k_    = blas::batch::extract<int64_t>(k, i);
+            int64_t lda_  = blas::batch::extract<int64_t>(ldda, i);
+            int64_t ldb_  = blas::batch::extract<int64_t>(lddb, i);
+            int64_t ldc_  = blas::batch::extract<int64_t>(lddc, i);
+            std::complex<float> alpha_ = blas::batch::extract<std::complex<float> >(alpha, i);
+            std::complex<float> beta_  = blas::batch::extract<std::complex<float> >(beta, i);
+            std::complex<float>* dA_   = blas::batch::extract<std::complex<float>*>(Aarray, i);
+            std::complex<float>* dB_   = blas::batch::extract<std::complex<float>*>(Barray, i);
+            std::complex<float>* dC_   = blas::batch::extract<std::complex<float>*>(Carray, i);
+            blas::gemm(
+                layout, transA_, transB_, m_, n_, k_,
+                alpha_, dA_, lda_,
+                        dB_, ldb_,
+                beta_,  dC_, ldc_ );
+        } );
 }
 
 // -----------------------------------------------------------------------------
@@ -192,25 +367,43 @@ void blas::batch::gemm(
                                         batch, info );
     }
 
-    #pragma omp parallel for schedule(dynamic)
-    for (size_t i = 0; i < batch; ++i) {
-        Op transA_    = blas::batch::extract<Op>(transA, i);
-        Op transB_    = blas::batch::extract<Op>(transB, i);
-        int64_t m_    = blas::batch::extract<int64_t>(m, i);
-        int64_t n_    = blas::batch::extract<int64_t>(n, i);
-        int64_t k_    = blas::batch::extract<int64_t>(k, i);
-        int64_t lda_  = blas::batch::extract<int64_t>(ldda, i);
-        int64_t ldb_  = blas::batch::extract<int64_t>(lddb, i);
-        int64_t ldc_  = blas::batch::extract<int64_t>(lddc, i);
-        std::complex<double> alpha_ = blas::batch::extract<std::complex<double> >(alpha, i);
-        std::complex<double> beta_  = blas::batch::extract<std::complex<double> >(beta, i);
-        std::complex<double>* dA_   = blas::batch::extract<std::complex<double>*>(Aarray, i);
-        std::complex<double>* dB_   = blas::batch::extract<std::complex<double>*>(Barray, i);
-        std::complex<double>* dC_   = blas::batch::extract<std::complex<double>*>(Carray, i);
-        blas::gemm(
-            layout, transA_, transB_, m_, n_, k_,
-            alpha_, dA_, lda_,
-                    dB_, ldb_,
-            beta_,  dC_, ldc_ );
-     }
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "batch_gemm", 'z', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
+    // one large or packed gemm if A or B is shared
+    if (internal::batch_gemm_shared( layout, transA, transB, m, n, k,
+                                     alpha, Aarray, ldda, Barray, lddb,
+                                     beta, Carray, lddc, batch ))
+        return;
+
+    // prefer a thread on the NUMA node holding each C; see blas::numa
+    // threads per problem, so problems times threads fit the cores
+    int64_t nthreads = batch_threads( batch );
+    numa::for_each_local(
+        batch,
+        [&]( size_t i ) -> void const* {
+            return blas::batch::extract<std::complex<double>*>(Carray, i);
+        },
+        [&]( size_t i ) {
+            ThreadScope thread_scope( nthreads );
+            Op transA_    = blas::batch::extract<Op>(transA, i);
+            Op transB_    = blas::batch::extract<Op>(transB, i);
+            int64_t m_    = blas::batch::extract<int64_t>(m, i);
+            int64_t n_    = blas::batch::extract<int64_t>(n, i);
+            int64_t k_    = blas::batch::extract<int64_t>(k, i);
+            int64_t lda_  = blas::batch::extract<int64_t>(ldda, i);
+            int64_t ldb_  = blas::batch::extract<int64_t>(lddb, i);
+            int64_t ldc_  = blas::batch::extract<int64_t>(lddc, i);
+            std::complex<double> alpha_ = blas::batch::extract<std::complex<double> >(alpha, i);
+            std::complex<double> beta_  = blas::batch::extract<std::complex<double> >(beta, i);
+            std::complex<double>* dA_   = blas::batch::extract<std::complex<double>*>(Aarray, i);
+            std::complex<double>* dB_   = blas::batch::extract<std::complex<double>*>(Barray, i);
+            std::complex<double>* dC_   = blas::batch::extract<std::complex<double>*>(Carray, i);
+            blas::gemm(
+                layout, transA_, transB_, m_, n_, k_,
+                alpha_, dA_, lda_,
+                        dB_, ldb_,
+                beta_,  dC_, ldc_ );
+        } );
 }
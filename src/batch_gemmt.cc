@@ -0,0 +1,247 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include <limits>
+#include <cstring>
+#include "blas/batch_common.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
+#include "blas.hh"
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void blas::batch::gemmt(
+    blas::Layout                   layout,
+    std::vector<blas::Uplo> const &uplo,
+    std::vector<blas::Op>   const &transA,
+    std::vector<blas::Op>   const &transB,
+    std::vector<int64_t>    const &n,
+    std::vector<int64_t>    const &k,
+    std::vector<float> const &alpha,
+    std::vector<float*> const &Aarray, std::vector<int64_t> const &ldda,
+    std::vector<float*> const &Barray, std::vector<int64_t> const &lddb,
+    std::vector<float> const &beta,
+    std::vector<float*> const &Carray, std::vector<int64_t> const &lddc,
+    const size_t batch, std::vector<int64_t> &info )
+{
+    blas_error_if( batch < 0 );
+    blas_error_if( !(info.size() == 0 || info.size() == 1 || info.size() == batch) );
+    if (info.size() > 0) {
+        // perform error checking
+        blas::batch::gemmt_check<float>(
+                        layout, uplo, transA, transB,
+                        n, k,
+                        alpha, Aarray, ldda,
+                               Barray, lddb,
+                        beta,  Carray, lddc,
+                        batch, info );
+    }
+
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "batch_gemmt", 's', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
+    // threads per problem, so problems times threads fit the cores
+    int64_t nthreads = batch_threads( batch );
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t i = 0; i < batch; ++i) {
+        ThreadScope thread_scope( nthreads );
+        Uplo uplo_   = blas::batch::extract<Uplo>(uplo, i);
+        Op   transA_ = blas::batch::extract<Op>(transA, i);
+        Op   transB_ = blas::batch::extract<Op>(transB, i);
+        int64_t n_   = blas::batch::extract<int64_t>(n, i);
+        int64_t k_   = blas::batch::extract<int64_t>(k, i);
+        int64_t lda_ = blas::batch::extract<int64_t>(ldda, i);
+        int64_t ldb_ = blas::batch::extract<int64_t>(lddb, i);
+        int64_t ldc_ = blas::batch::extract<int64_t>(lddc, i);
+        float alpha_ = blas::batch::extract<float>(alpha, i);
+        float beta_  = blas::batch::extract<float>(beta, i);
+        float* A_    = blas::batch::extract<float*>(Aarray, i);
+        float* B_    = blas::batch::extract<float*>(Barray, i);
+        float* C_    = blas::batch::extract<float*>(Carray, i);
+        blas::gemmt(
+            layout, uplo_, transA_, transB_, n_, k_,
+            alpha_, A_, lda_,
+                    B_, ldb_,
+            beta_,  C_, ldc_ );
+    }
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void blas::batch::gemmt(
+    blas::Layout                   layout,
+    std::vector<blas::Uplo> const &uplo,
+    std::vector<blas::Op>   const &transA,
+    std::vector<blas::Op>   const &transB,
+    std::vector<int64_t>    const &n,
+    std::vector<int64_t>    const &k,
+    std::vector<double> const &alpha,
+    std::vector<double*> const &Aarray, std::vector<int64_t> const &ldda,
+    std::vector<double*> const &Barray, std::vector<int64_t> const &lddb,
+    std::vector<double> const &beta,
+    std::vector<double*> const &Carray, std::vector<int64_t> const &lddc,
+    const size_t batch, std::vector<int64_t> &info )
+{
+    blas_error_if( batch < 0 );
+    blas_error_if( !(info.size() == 0 || info.size() == 1 || info.size() == batch) );
+    if (info.size() > 0) {
+        // perform error checking
+        blas::batch::gemmt_check<double>(
+                        layout, uplo, transA, transB,
+                        n, k,
+                        alpha, Aarray, ldda,
+                               Barray, lddb,
+                        beta,  Carray, lddc,
+                        batch, info );
+    }
+
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "batch_gemmt", 'd', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
+    // threads per problem, so problems times threads fit the cores
+    int64_t nthreads = batch_threads( batch );
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t i = 0; i < batch; ++i) {
+        ThreadScope thread_scope( nthreads );
+        Uplo uplo_   = blas::batch::extract<Uplo>(uplo, i);
+        Op   transA_ = blas::batch::extract<Op>(transA, i);
+        Op   transB_ = blas::batch::extract<Op>(transB, i);
+        int64_t n_   = blas::batch::extract<int64_t>(n, i);
+        int64_t k_   = blas::batch::extract<int64_t>(k, i);
+        int64_t lda_ = blas::batch::extract<int64_t>(ldda, i);
+        int64_t ldb_ = blas::batch::extract<int64_t>(lddb, i);
+        int64_t ldc_ = blas::batch::extract<int64_t>(lddc, i);
+        double alpha_ = blas::batch::extract<double>(alpha, i);
+        double beta_  = blas::batch::extract<double>(beta, i);
+        double* A_    = blas::batch::extract<double*>(Aarray, i);
+        double* B_    = blas::batch::extract<double*>(Barray, i);
+        double* C_    = blas::batch::extract<double*>(Carray, i);
+        blas::gemmt(
+            layout, uplo_, transA_, transB_, n_, k_,
+            alpha_, A_, lda_,
+                    B_, ldb_,
+            beta_,  C_, ldc_ );
+    }
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void blas::batch::gemmt(
+    blas::Layout                   layout,
+    std::vector<blas::Uplo> const &uplo,
+    std::vector<blas::Op>   const &transA,
+    std::vector<blas::Op>   const &transB,
+    std::vector<int64_t>    const &n,
+    std::vector<int64_t>    const &k,
+    std::vector<std::complex<float> > const &alpha,
+    std::vector<std::complex<float>*> const &Aarray, std::vector<int64_t> const &ldda,
+    std::vector<std::complex<float>*> const &Barray, std::vector<int64_t> const &lddb,
+    std::vector<std::complex<float> > const &beta,
+    std::vector<std::complex<float>*> const &Carray, std::vector<int64_t> const &lddc,
+    const size_t batch, std::vector<int64_t> &info )
+{
+    blas_error_if( batch < 0 );
+    blas_error_if( !(info.size() == 0 || info.size() == 1 || info.size() == batch) );
+    if (info.size() > 0) {
+        // perform error checking
+        blas::batch::gemmt_check<std::complex<float>>(
+                        layout, uplo, transA, transB,
+                        n, k,
+                        alpha, Aarray, ldda,
+                               Barray, lddb,
+                        beta,  Carray, lddc,
+                        batch, info );
+    }
+
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "batch_gemmt", 'c', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
+    // threads per problem, so problems times threads fit the cores
+    int64_t nthreads = batch_threads( batch );
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t i = 0; i < batch; ++i) {
+        ThreadScope thread_scope( nthreads );
+        Uplo uplo_   = blas::batch::extract<Uplo>(uplo, i);
+        Op   transA_ = blas::batch::extract<Op>(transA, i);
+        Op   transB_ = blas::batch::extract<Op>(transB, i);
+        int64_t n_   = blas::batch::extract<int64_t>(n, i);
+        int64_t k_   = blas::batch::extract<int64_t>(k, i);
+        int64_t lda_ = blas::batch::extract<int64_t>(ldda, i);
+        int64_t ldb_ = blas::batch::extract<int64_t>(lddb, i);
+        int64_t ldc_ = blas::batch::extract<int64_t>(lddc, i);
+        std::complex<float> alpha_ = blas::batch::extract<std::complex<float>>(alpha, i);
+        std::complex<float> beta_  = blas::batch::extract<std::complex<float>>(beta, i);
+        std::complex<float>* A_    = blas::batch::extract<std::complex<float>*>(Aarray, i);
+        std::complex<float>* B_    = blas::batch::extract<std::complex<float>*>(Barray, i);
+        std::complex<float>* C_    = blas::batch::extract<std::complex<float>*>(Carray, i);
+        blas::gemmt(
+            layout, uplo_, transA_, transB_, n_, k_,
+            alpha_, A_, lda_,
+                    B_, ldb_,
+            beta_,  C_, ldc_ );
+    }
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void blas::batch::gemmt(
+    blas::Layout                   layout,
+    std::vector<blas::Uplo> const &uplo,
+    std::vector<blas::Op>   const &transA,
+    std::vector<blas::Op>   const &transB,
+    std::vector<int64_t>    const &n,
+    std::vector<int64_t>    const &k,
+    std::vector<std::complex<double> > const &alpha,
+    std::vector<std::complex<double>*> const &Aarray, std::vector<int64_t> const &ldda,
+    std::vector<std::complex<double>*> const &Barray, std::vector<int64_t> const &lddb,
+    std::vector<std::complex<double> > const &beta,
+    std::vector<std::complex<double>*> const &Carray, std::vector<int64_t> const &lddc,
+    const size_t batch, std::vector<int64_t> &info )
+{
+    blas_error_if( batch < 0 );
+    blas_error_if( !(info.size() == 0 || info.size() == 1 || info.size() == batch) );
+    if (info.size() > 0) {
+        // perform error checking
+        blas::batch::gemmt_check<std::complex<double>>(
+                        layout, uplo, transA, transB,
+                        n, k,
+                        alpha, Aarray, ldda,
+                               Barray, lddb,
+                        beta,  Carray, lddc,
+                        batch, info );
+    }
+
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "batch_gemmt", 'z', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
+    // threads per problem, so problems times threads fit the cores
+    int64_t nthreads = batch_threads( batch );
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t i = 0; i < batch; ++i) {
+        ThreadScope thread_scope( nthreads );
+        Uplo uplo_   = blas::batch::extract<Uplo>(uplo, i);
+        Op   transA_ = blas::batch::extract<Op>(transA, i);
+        Op   transB_ = blas::batch::extract<Op>(transB, i);
+        int64_t n_   = blas::batch::extract<int64_t>(n, i);
+        int64_t k_   = blas::batch::extract<int64_t>(k, i);
+        int64_t lda_ = blas::batch::extract<int64_t>(ldda, i);
+        int64_t ldb_ = blas::batch::extract<int64_t>(lddb, i);
+        int64_t ldc_ = blas::batch::extract<int64_t>(lddc, i);
+        std::complex<double> alpha_ = blas::batch::extract<std::complex<double>>(alpha, i);
+        std::complex<double> beta_  = blas::batch::extract<std::complex<double>>(beta, i);
+        std::complex<double>* A_    = blas::batch::extract<std::complex<double>*>(Aarray, i);
+        std::complex<double>* B_    = blas::batch::extract<std::complex<double>*>(Barray, i);
+        std::complex<double>* C_    = blas::batch::extract<std::complex<double>*>(Carray, i);
+        blas::gemmt(
+            layout, uplo_, transA_, transB_, n_, k_,
+            alpha_, A_, lda_,
+                    B_, ldb_,
+            beta_,  C_, ldc_ );
+    }
+}
@@ -6,6 +6,8 @@
 #include <limits>
 #include <cstring>
 #include "blas/batch_common.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 #include "blas.hh"
 
 // -----------------------------------------------------------------------------
@@ -34,8 +36,15 @@ void blas::batch::herk(
                         batch, info );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "batch_herk", 's', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
+    // threads per problem, so problems times threads fit the cores
+    int64_t nthreads = batch_threads( batch );
     #pragma omp parallel for schedule(dynamic)
     for (size_t i = 0; i < batch; ++i) {
+        ThreadScope thread_scope( nthreads );
         Uplo uplo_   = blas::batch::extract<Uplo>(uplo, i);
         Op   trans_  = blas::batch::extract<Op>(trans, i);
         int64_t n_   = blas::batch::extract<int64_t>(n, i);
@@ -79,8 +88,15 @@ void blas::batch::herk(
                         batch, info );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "batch_herk", 'd', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
+    // threads per problem, so problems times threads fit the cores
+    int64_t nthreads = batch_threads( batch );
     #pragma omp parallel for schedule(dynamic)
     for (size_t i = 0; i < batch; ++i) {
+        ThreadScope thread_scope( nthreads );
         Uplo uplo_   = blas::batch::extract<Uplo>(uplo, i);
         Op   trans_  = blas::batch::extract<Op>(trans, i);
         int64_t n_   = blas::batch::extract<int64_t>(n, i);
@@ -124,8 +140,15 @@ void blas::batch::herk(
                         batch, info );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "batch_herk", 'c', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
+    // threads per problem, so problems times threads fit the cores
+    int64_t nthreads = batch_threads( batch );
     #pragma omp parallel for schedule(dynamic)
     for (size_t i = 0; i < batch; ++i) {
+        ThreadScope thread_scope( nthreads );
         Uplo uplo_   = blas::batch::extract<Uplo>(uplo, i);
         Op   trans_  = blas::batch::extract<Op>(trans, i);
         int64_t n_   = blas::batch::extract<int64_t>(n, i);
@@ -169,8 +192,15 @@ void blas::batch::herk(
                         batch, info );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "batch_herk", 'z', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
+    // threads per problem, so problems times threads fit the cores
+    int64_t nthreads = batch_threads( batch );
     #pragma omp parallel for schedule(dynamic)
     for (size_t i = 0; i < batch; ++i) {
+        ThreadScope thread_scope( nthreads );
         Uplo uplo_   = blas::batch::extract<Uplo>(uplo, i);
         Op   trans_  = blas::batch::extract<Op>(trans, i);
         int64_t n_   = blas::batch::extract<int64_t>(n, i);
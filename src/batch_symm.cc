@@ -6,6 +6,8 @@
 #include <limits>
 #include <cstring>
 #include "blas/batch_common.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 #include "blas.hh"
 
 // -----------------------------------------------------------------------------
@@ -36,8 +38,15 @@ void blas::batch::symm(
                         batch, info );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "batch_symm", 's', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
+    // threads per problem, so problems times threads fit the cores
+    int64_t nthreads = batch_threads( batch );
     #pragma omp parallel for schedule(dynamic)
     for (size_t i = 0; i < batch; ++i) {
+        ThreadScope thread_scope( nthreads );
         Side side_   = blas::batch::extract<Side>(side, i);
         Uplo uplo_   = blas::batch::extract<Uplo>(uplo, i);
         int64_t m_   = blas::batch::extract<int64_t>(m, i);
@@ -86,8 +95,15 @@ void blas::batch::symm(
                         batch, info );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "batch_symm", 'd', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
+    // threads per problem, so problems times threads fit the cores
+    int64_t nthreads = batch_threads( batch );
     #pragma omp parallel for schedule(dynamic)
     for (size_t i = 0; i < batch; ++i) {
+        ThreadScope thread_scope( nthreads );
         Side side_   = blas::batch::extract<Side>(side, i);
         Uplo uplo_   = blas::batch::extract<Uplo>(uplo, i);
         int64_t m_   = blas::batch::extract<int64_t>(m, i);
@@ -136,8 +152,15 @@ void blas::batch::symm(
                         batch, info );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "batch_symm", 'c', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
+    // threads per problem, so problems times threads fit the cores
+    int64_t nthreads = batch_threads( batch );
     #pragma omp parallel for schedule(dynamic)
     for (size_t i = 0; i < batch; ++i) {
+        ThreadScope thread_scope( nthreads );
         Side side_   = blas::batch::extract<Side>(side, i);
         Uplo uplo_   = blas::batch::extract<Uplo>(uplo, i);
         int64_t m_   = blas::batch::extract<int64_t>(m, i);
@@ -186,8 +209,15 @@ void blas::batch::symm(
                         batch, info );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "batch_symm", 'z', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
+    // threads per problem, so problems times threads fit the cores
+    int64_t nthreads = batch_threads( batch );
     #pragma omp parallel for schedule(dynamic)
     for (size_t i = 0; i < batch; ++i) {
+        ThreadScope thread_scope( nthreads );
         Side side_   = blas::batch::extract<Side>(side, i);
         Uplo uplo_   = blas::batch::extract<Uplo>(uplo, i);
         int64_t m_   = blas::batch::extract<int64_t>(m, i);
@@ -5,6 +5,8 @@
 
 #include "blas/fortran.h"
 #include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 
 #include <limits>
 
@@ -25,6 +27,10 @@ void copy(
     blas_error_if( incx == 0 );  // standard BLAS doesn't detect inc[xy] == 0
     blas_error_if( incy == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "copy", 's', {},
+                          n, 0, 0, Gflop< float >::copy( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n              > std::numeric_limits<blas_int>::max() );
@@ -50,6 +56,10 @@ void copy(
     blas_error_if( incx == 0 );  // standard BLAS doesn't detect inc[xy] == 0
     blas_error_if( incy == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "copy", 'd', {},
+                          n, 0, 0, Gflop< double >::copy( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n              > std::numeric_limits<blas_int>::max() );
@@ -75,6 +85,10 @@ void copy(
     blas_error_if( incx == 0 );  // standard BLAS doesn't detect inc[xy] == 0
     blas_error_if( incy == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "copy", 'c', {},
+                          n, 0, 0, Gflop< std::complex<float> >::copy( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n              > std::numeric_limits<blas_int>::max() );
@@ -102,6 +116,10 @@ void copy(
     blas_error_if( incx == 0 );  // standard BLAS doesn't detect inc[xy] == 0
     blas_error_if( incy == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "copy", 'z', {},
+                          n, 0, 0, Gflop< std::complex<double> >::copy( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n              > std::numeric_limits<blas_int>::max() );
@@ -6,6 +6,8 @@
 #include <limits>
 #include <cstring>
 #include "blas/batch_common.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 #include "blas/device_blas.hh"
 
 // -----------------------------------------------------------------------------
@@ -52,8 +54,14 @@ void blas::batch::gemm(
                           Carray.size() == batch &&
                           lddc.size()   == 1 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_batch_gemm", 's', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
     blas::set_device( queue.device() );
     if (fixed_size) {
+        scope.set_gflop( batch * Gflop< float >::gemm( m[0], n[0], k[0] ) );
+
         // call the vendor routine
         device_trans_t  transA_ = blas::device_trans_const( transA[0] );
         device_trans_t  transB_ = blas::device_trans_const( transB[0] );
@@ -122,6 +130,10 @@ void blas::batch::gemm(
         }
         queue.join();
     }
+
+    // include execution time in profile
+    if (profile::enabled() || profile::tracing())
+        queue.sync();
 }
 
 // -----------------------------------------------------------------------------
@@ -167,8 +179,14 @@ void blas::batch::gemm(
                           Carray.size() == batch &&
                           lddc.size()   == 1 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_batch_gemm", 'd', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
     blas::set_device( queue.device() );
     if (fixed_size) {
+        scope.set_gflop( batch * Gflop< double >::gemm( m[0], n[0], k[0] ) );
+
         // call the vendor routine
         device_trans_t  transA_ = blas::device_trans_const( transA[0] );
         device_trans_t  transB_ = blas::device_trans_const( transB[0] );
@@ -237,6 +255,10 @@ void blas::batch::gemm(
         }
         queue.join();
     }
+
+    // include execution time in profile
+    if (profile::enabled() || profile::tracing())
+        queue.sync();
 }
 
 // -----------------------------------------------------------------------------
@@ -282,9 +304,17 @@ void blas::batch::gemm(
                           beta.size()   == 1     &&
                           Carray.size() == batch &&
                           lddc.size()   == 1 );
+
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_batch_gemm", 'c', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
     blas::set_device( queue.device() );
 
     if (fixed_size) {
+        scope.set_gflop( batch *
+                         Gflop< std::complex<float> >::gemm( m[0], n[0], k[0] ) );
+
         // call the vendor routine
         device_trans_t  transA_ = blas::device_trans_const( transA[0] );
         device_trans_t  transB_ = blas::device_trans_const( transB[0] );
@@ -353,6 +383,10 @@ void blas::batch::gemm(
         }
         queue.join();
     }
+
+    // include execution time in profile
+    if (profile::enabled() || profile::tracing())
+        queue.sync();
 }
 
 // -----------------------------------------------------------------------------
@@ -398,9 +432,17 @@ void blas::batch::gemm(
                           beta.size()   == 1     &&
                           Carray.size() == batch &&
                           lddc.size()   == 1 );
+
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_batch_gemm", 'z', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
     blas::set_device( queue.device() );
 
     if (fixed_size) {
+        scope.set_gflop( batch *
+                         Gflop< std::complex<double> >::gemm( m[0], n[0], k[0] ) );
+
         // call the vendor routine
         device_trans_t  transA_ = blas::device_trans_const( transA[0] );
         device_trans_t  transB_ = blas::device_trans_const( transB[0] );
@@ -469,6 +511,10 @@ void blas::batch::gemm(
         }
         queue.join();
     }
+
+    // include execution time in profile
+    if (profile::enabled() || profile::tracing())
+        queue.sync();
 }
 
 // -----------------------------------------------------------------------------
@@ -528,6 +574,10 @@ void blas::batch::gemm(
                                         group_count, info );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_batch_gemm", 's', { layout2char( layout ) },
+                          0, 0, 0, 0, batch_size );
+
     // set device
     blas::set_device( queue.device() );
 
@@ -587,6 +637,10 @@ void blas::batch::gemm(
     }
 
     if( group_count > 1 ) queue.join();
+
+    // include execution time in profile
+    if (profile::enabled() || profile::tracing())
+        queue.sync();
 }
 
 // -----------------------------------------------------------------------------
@@ -646,6 +700,10 @@ void blas::batch::gemm(
                                          group_count, info );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_batch_gemm", 'd', { layout2char( layout ) },
+                          0, 0, 0, 0, batch_size );
+
     // set device
     blas::set_device( queue.device() );
 
@@ -705,6 +763,10 @@ void blas::batch::gemm(
     }
 
     if( group_count > 1 ) queue.join();
+
+    // include execution time in profile
+    if (profile::enabled() || profile::tracing())
+        queue.sync();
 }
 
 // -----------------------------------------------------------------------------
@@ -764,6 +826,10 @@ void blas::batch::gemm(
                                          group_count, info );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_batch_gemm", 'c', { layout2char( layout ) },
+                          0, 0, 0, 0, batch_size );
+
     // set device
     blas::set_device( queue.device() );
 
@@ -823,6 +889,10 @@ void blas::batch::gemm(
     }
 
     if( group_count > 1 ) queue.join();
+
+    // include execution time in profile
+    if (profile::enabled() || profile::tracing())
+        queue.sync();
 }
 
 // -----------------------------------------------------------------------------
@@ -882,6 +952,10 @@ void blas::batch::gemm(
                                          group_count, info );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_batch_gemm", 'z', { layout2char( layout ) },
+                          0, 0, 0, 0, batch_size );
+
     // set device
     blas::set_device( queue.device() );
 
@@ -941,4 +1015,8 @@ void blas::batch::gemm(
     }
 
     if( group_count > 1 ) queue.join();
+
+    // include execution time in profile
+    if (profile::enabled() || profile::tracing())
+        queue.sync();
 }
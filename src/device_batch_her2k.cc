@@ -6,6 +6,8 @@
 #include <limits>
 #include <cstring>
 #include "blas/batch_common.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 #include "blas/device_blas.hh"
 
 // -----------------------------------------------------------------------------
@@ -38,6 +40,10 @@ void blas::batch::her2k(
                         batch, info );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_batch_her2k", 's', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
     blas::set_device( queue.device() );
 
     queue.fork();
@@ -62,6 +68,10 @@ void blas::batch::her2k(
         queue.revolve();
     }
     queue.join();
+
+    // include execution time in profile
+    if (profile::enabled() || profile::tracing())
+        queue.sync();
 }
 
 // -----------------------------------------------------------------------------
@@ -94,6 +104,10 @@ void blas::batch::her2k(
                         batch, info );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_batch_her2k", 'd', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
     blas::set_device( queue.device() );
 
     queue.fork();
@@ -118,6 +132,10 @@ void blas::batch::her2k(
         queue.revolve();
     }
     queue.join();
+
+    // include execution time in profile
+    if (profile::enabled() || profile::tracing())
+        queue.sync();
 }
 
 // -----------------------------------------------------------------------------
@@ -150,6 +168,10 @@ void blas::batch::her2k(
                         batch, info );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_batch_her2k", 'c', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
     blas::set_device( queue.device() );
 
     queue.fork();
@@ -174,6 +196,10 @@ void blas::batch::her2k(
         queue.revolve();
     }
     queue.join();
+
+    // include execution time in profile
+    if (profile::enabled() || profile::tracing())
+        queue.sync();
 }
 
 // -----------------------------------------------------------------------------
@@ -206,6 +232,10 @@ void blas::batch::her2k(
                         batch, info );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_batch_her2k", 'z', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
     blas::set_device( queue.device() );
 
     queue.fork();
@@ -230,4 +260,8 @@ void blas::batch::her2k(
         queue.revolve();
     }
     queue.join();
+
+    // include execution time in profile
+    if (profile::enabled() || profile::tracing())
+        queue.sync();
 }
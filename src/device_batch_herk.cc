@@ -6,6 +6,8 @@
 #include <limits>
 #include <cstring>
 #include "blas/batch_common.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 #include "blas/device_blas.hh"
 
 // -----------------------------------------------------------------------------
@@ -36,6 +38,10 @@ void blas::batch::herk(
                         batch, info );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_batch_herk", 's', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
     blas::set_device( queue.device() );
 
     queue.fork();
@@ -57,6 +63,10 @@ void blas::batch::herk(
         queue.revolve();
     }
     queue.join();
+
+    // include execution time in profile
+    if (profile::enabled() || profile::tracing())
+        queue.sync();
 }
 
 // -----------------------------------------------------------------------------
@@ -87,6 +97,10 @@ void blas::batch::herk(
                         batch, info );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_batch_herk", 'd', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
     blas::set_device( queue.device() );
 
     queue.fork();
@@ -108,6 +122,10 @@ void blas::batch::herk(
         queue.revolve();
     }
     queue.join();
+
+    // include execution time in profile
+    if (profile::enabled() || profile::tracing())
+        queue.sync();
 }
 
 // -----------------------------------------------------------------------------
@@ -138,6 +156,10 @@ void blas::batch::herk(
                         batch, info );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_batch_herk", 'c', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
     blas::set_device( queue.device() );
 
     queue.fork();
@@ -159,6 +181,10 @@ void blas::batch::herk(
         queue.revolve();
     }
     queue.join();
+
+    // include execution time in profile
+    if (profile::enabled() || profile::tracing())
+        queue.sync();
 }
 
 // -----------------------------------------------------------------------------
@@ -189,6 +215,10 @@ void blas::batch::herk(
                         batch, info );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_batch_herk", 'z', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
     blas::set_device( queue.device() );
 
     queue.fork();
@@ -210,4 +240,8 @@ void blas::batch::herk(
         queue.revolve();
     }
     queue.join();
+
+    // include execution time in profile
+    if (profile::enabled() || profile::tracing())
+        queue.sync();
 }
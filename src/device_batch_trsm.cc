@@ -6,6 +6,8 @@
 #include <limits>
 #include <cstring>
 #include "blas/batch_common.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 #include "blas/device_blas.hh"
 
 // -----------------------------------------------------------------------------
@@ -48,8 +50,14 @@ void blas::batch::trsm(
                           Barray.size() == batch &&
                           lddb.size()   == 1  );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_batch_trsm", 's', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
     blas::set_device( queue.device() );
     if (fixed_size) {
+        scope.set_gflop( batch * Gflop< float >::trsm( side[0], m[0], n[0] ) );
+
         // call the vendor routine
         device_blas_int m_      = (device_blas_int) m[0];
         device_blas_int n_      = (device_blas_int) n[0];
@@ -111,6 +119,10 @@ void blas::batch::trsm(
         }
         queue.join();
     }
+
+    // include execution time in profile
+    if (profile::enabled() || profile::tracing())
+        queue.sync();
 }
 
 
@@ -154,8 +166,14 @@ void blas::batch::trsm(
                           Barray.size() == batch &&
                           lddb.size()   == 1  );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_batch_trsm", 'd', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
     blas::set_device( queue.device() );
     if (fixed_size) {
+        scope.set_gflop( batch * Gflop< double >::trsm( side[0], m[0], n[0] ) );
+
         // call the vendor routine
         device_blas_int m_      = (device_blas_int) m[0];
         device_blas_int n_      = (device_blas_int) n[0];
@@ -217,6 +235,10 @@ void blas::batch::trsm(
         }
         queue.join();
     }
+
+    // include execution time in profile
+    if (profile::enabled() || profile::tracing())
+        queue.sync();
 }
 
 
@@ -260,8 +282,15 @@ void blas::batch::trsm(
                           Barray.size() == batch &&
                           lddb.size()   == 1  );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_batch_trsm", 'c', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
     blas::set_device( queue.device() );
     if (fixed_size) {
+        scope.set_gflop( batch *
+                         Gflop< std::complex<float> >::trsm( side[0], m[0], n[0] ) );
+
         // call the vendor routine
         device_blas_int m_      = (device_blas_int) m[0];
         device_blas_int n_      = (device_blas_int) n[0];
@@ -323,6 +352,10 @@ void blas::batch::trsm(
         }
         queue.join();
     }
+
+    // include execution time in profile
+    if (profile::enabled() || profile::tracing())
+        queue.sync();
 }
 
 
@@ -366,8 +399,15 @@ void blas::batch::trsm(
                           Barray.size() == batch &&
                           lddb.size()   == 1  );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_batch_trsm", 'z', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
     blas::set_device( queue.device() );
     if (fixed_size) {
+        scope.set_gflop( batch *
+                         Gflop< std::complex<double> >::trsm( side[0], m[0], n[0] ) );
+
         // call the vendor routine
         device_blas_int m_      = (device_blas_int) m[0];
         device_blas_int n_      = (device_blas_int) n[0];
@@ -429,4 +469,8 @@ void blas::batch::trsm(
         }
         queue.join();
     }
+
+    // include execution time in profile
+    if (profile::enabled() || profile::tracing())
+        queue.sync();
 }
@@ -107,6 +107,100 @@ void DEVICE_zgemm(
     #endif
 }
 
+// -----------------------------------------------------------------------------
+// geam
+// -----------------------------------------------------------------------------
+// sgeam
+void DEVICE_sgeam(
+    device_blas_handle_t handle,
+    device_trans_t transA, device_trans_t transB,
+    device_blas_int m, device_blas_int n,
+    float alpha,
+    float const *dA, device_blas_int ldda,
+    float beta,
+    float const *dB, device_blas_int lddb,
+    float       *dC, device_blas_int lddc)
+{
+    #ifdef BLASPP_WITH_CUBLAS
+    cublasSgeam( handle, transA, transB,
+                 m, n,
+                 &alpha, dA, ldda,
+                 &beta,  dB, lddb,
+                 dC, lddc );
+    #elif defined(HAVE_ROCBLAS)
+    // TODO: call rocBLAS
+    #endif
+}
+
+// -----------------------------------------------------------------------------
+// dgeam
+void DEVICE_dgeam(
+    device_blas_handle_t handle,
+    device_trans_t transA, device_trans_t transB,
+    device_blas_int m, device_blas_int n,
+    double alpha,
+    double const *dA, device_blas_int ldda,
+    double beta,
+    double const *dB, device_blas_int lddb,
+    double       *dC, device_blas_int lddc)
+{
+    #ifdef BLASPP_WITH_CUBLAS
+    cublasDgeam( handle, transA, transB,
+                 m, n,
+                 &alpha, dA, ldda,
+                 &beta,  dB, lddb,
+                 dC, lddc );
+    #elif defined(HAVE_ROCBLAS)
+    // TODO: call rocBLAS
+    #endif
+}
+
+// -----------------------------------------------------------------------------
+// cgeam
+void DEVICE_cgeam(
+    device_blas_handle_t handle,
+    device_trans_t transA, device_trans_t transB,
+    device_blas_int m, device_blas_int n,
+    std::complex<float> alpha,
+    std::complex<float> const *dA, device_blas_int ldda,
+    std::complex<float> beta,
+    std::complex<float> const *dB, device_blas_int lddb,
+    std::complex<float>       *dC, device_blas_int lddc)
+{
+    #ifdef BLASPP_WITH_CUBLAS
+    cublasCgeam( handle, transA, transB,
+                 m, n,
+                 (cuComplex*)&alpha, (cuComplex*)dA, ldda,
+                 (cuComplex*)&beta,  (cuComplex*)dB, lddb,
+                 (cuComplex*)dC, lddc );
+    #elif defined(HAVE_ROCBLAS)
+    // TODO: call rocBLAS
+    #endif
+}
+
+// -----------------------------------------------------------------------------
+// zgeam
+void DEVICE_zgeam(
+    device_blas_handle_t handle,
+    device_trans_t transA, device_trans_t transB,
+    device_blas_int m, device_blas_int n,
+    std::complex<double> alpha,
+    std::complex<double> const *dA, device_blas_int ldda,
+    std::complex<double> beta,
+    std::complex<double> const *dB, device_blas_int lddb,
+    std::complex<double>       *dC, device_blas_int lddc)
+{
+    #ifdef BLASPP_WITH_CUBLAS
+    cublasZgeam( handle, transA, transB,
+                 m, n,
+                 (cuDoubleComplex*)&alpha, (cuDoubleComplex*)dA, ldda,
+                 (cuDoubleComplex*)&beta,  (cuDoubleComplex*)dB, lddb,
+                 (cuDoubleComplex*)dC, lddc );
+    #elif defined(HAVE_ROCBLAS)
+    // TODO: call rocBLAS
+    #endif
+}
+
 // -----------------------------------------------------------------------------
 // trsm
 // -----------------------------------------------------------------------------
@@ -0,0 +1,350 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "blas/device_blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
+#include <limits>
+
+// =============================================================================
+// Overloaded wrappers for s, d, c, z precisions.
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void blas::geam(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n,
+    float alpha,
+    float const *dA, int64_t ldda,
+    float beta,
+    float const *dB, int64_t lddb,
+    float       *dC, int64_t lddc,
+    blas::Queue &queue )
+{
+    // check arguments
+    blas_error_if( layout != Layout::ColMajor &&
+                   layout != Layout::RowMajor );
+    blas_error_if( transA != Op::NoTrans &&
+                   transA != Op::Trans &&
+                   transA != Op::ConjTrans );
+    blas_error_if( transB != Op::NoTrans &&
+                   transB != Op::Trans &&
+                   transB != Op::ConjTrans );
+    blas_error_if( m < 0 );
+    blas_error_if( n < 0 );
+
+    if ((transA == Op::NoTrans) ^ (layout == Layout::RowMajor))
+        blas_error_if( ldda < m );
+    else
+        blas_error_if( ldda < n );
+
+    if ((transB == Op::NoTrans) ^ (layout == Layout::RowMajor))
+        blas_error_if( lddb < m );
+    else
+        blas_error_if( lddb < n );
+
+    if (layout == Layout::ColMajor)
+        blas_error_if( lddc < m );
+    else
+        blas_error_if( lddc < n );
+
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_geam", 's',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, 0, Gflop< float >::geam( m, n ) );
+
+    // check for overflow in native BLAS integer type, if smaller than int64_t
+    if (sizeof(int64_t) > sizeof(device_blas_int)) {
+        blas_error_if( m    > std::numeric_limits<device_blas_int>::max() );
+        blas_error_if( n    > std::numeric_limits<device_blas_int>::max() );
+        blas_error_if( ldda > std::numeric_limits<device_blas_int>::max() );
+        blas_error_if( lddb > std::numeric_limits<device_blas_int>::max() );
+        blas_error_if( lddc > std::numeric_limits<device_blas_int>::max() );
+    }
+
+    device_trans_t  transA_ = blas::device_trans_const( transA );
+    device_trans_t  transB_ = blas::device_trans_const( transB );
+    device_blas_int m_      = (device_blas_int) m;
+    device_blas_int n_      = (device_blas_int) n;
+    device_blas_int ldda_   = (device_blas_int) ldda;
+    device_blas_int lddb_   = (device_blas_int) lddb;
+    device_blas_int lddc_   = (device_blas_int) lddc;
+
+    blas::set_device( queue.device() );
+    if (layout == Layout::RowMajor) {
+        // row-major C^T = alpha op(A)^T + beta op(B)^T; swap m <=> n
+        DEVICE_sgeam(
+                queue.handle(), transA_, transB_,
+                n_, m_,
+                alpha, dA, ldda_,
+                beta,  dB, lddb_,
+                dC, lddc_);
+    }
+    else {
+        DEVICE_sgeam(
+                queue.handle(), transA_, transB_,
+                m_, n_,
+                alpha, dA, ldda_,
+                beta,  dB, lddb_,
+                dC, lddc_);
+    }
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void blas::geam(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n,
+    double alpha,
+    double const *dA, int64_t ldda,
+    double beta,
+    double const *dB, int64_t lddb,
+    double       *dC, int64_t lddc,
+    blas::Queue &queue )
+{
+    // check arguments
+    blas_error_if( layout != Layout::ColMajor &&
+                   layout != Layout::RowMajor );
+    blas_error_if( transA != Op::NoTrans &&
+                   transA != Op::Trans &&
+                   transA != Op::ConjTrans );
+    blas_error_if( transB != Op::NoTrans &&
+                   transB != Op::Trans &&
+                   transB != Op::ConjTrans );
+    blas_error_if( m < 0 );
+    blas_error_if( n < 0 );
+
+    if ((transA == Op::NoTrans) ^ (layout == Layout::RowMajor))
+        blas_error_if( ldda < m );
+    else
+        blas_error_if( ldda < n );
+
+    if ((transB == Op::NoTrans) ^ (layout == Layout::RowMajor))
+        blas_error_if( lddb < m );
+    else
+        blas_error_if( lddb < n );
+
+    if (layout == Layout::ColMajor)
+        blas_error_if( lddc < m );
+    else
+        blas_error_if( lddc < n );
+
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_geam", 'd',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, 0, Gflop< double >::geam( m, n ) );
+
+    // check for overflow in native BLAS integer type, if smaller than int64_t
+    if (sizeof(int64_t) > sizeof(device_blas_int)) {
+        blas_error_if( m    > std::numeric_limits<device_blas_int>::max() );
+        blas_error_if( n    > std::numeric_limits<device_blas_int>::max() );
+        blas_error_if( ldda > std::numeric_limits<device_blas_int>::max() );
+        blas_error_if( lddb > std::numeric_limits<device_blas_int>::max() );
+        blas_error_if( lddc > std::numeric_limits<device_blas_int>::max() );
+    }
+
+    device_trans_t  transA_ = blas::device_trans_const( transA );
+    device_trans_t  transB_ = blas::device_trans_const( transB );
+    device_blas_int m_      = (device_blas_int) m;
+    device_blas_int n_      = (device_blas_int) n;
+    device_blas_int ldda_   = (device_blas_int) ldda;
+    device_blas_int lddb_   = (device_blas_int) lddb;
+    device_blas_int lddc_   = (device_blas_int) lddc;
+
+    blas::set_device( queue.device() );
+    if (layout == Layout::RowMajor) {
+        // row-major C^T = alpha op(A)^T + beta op(B)^T; swap m <=> n
+        DEVICE_dgeam(
+                queue.handle(), transA_, transB_,
+                n_, m_,
+                alpha, dA, ldda_,
+                beta,  dB, lddb_,
+                dC, lddc_);
+    }
+    else {
+        DEVICE_dgeam(
+                queue.handle(), transA_, transB_,
+                m_, n_,
+                alpha, dA, ldda_,
+                beta,  dB, lddb_,
+                dC, lddc_);
+    }
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void blas::geam(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n,
+    std::complex<float> alpha,
+    std::complex<float> const *dA, int64_t ldda,
+    std::complex<float> beta,
+    std::complex<float> const *dB, int64_t lddb,
+    std::complex<float>       *dC, int64_t lddc,
+    blas::Queue &queue )
+{
+    // check arguments
+    blas_error_if( layout != Layout::ColMajor &&
+                   layout != Layout::RowMajor );
+    blas_error_if( transA != Op::NoTrans &&
+                   transA != Op::Trans &&
+                   transA != Op::ConjTrans );
+    blas_error_if( transB != Op::NoTrans &&
+                   transB != Op::Trans &&
+                   transB != Op::ConjTrans );
+    blas_error_if( m < 0 );
+    blas_error_if( n < 0 );
+
+    if ((transA == Op::NoTrans) ^ (layout == Layout::RowMajor))
+        blas_error_if( ldda < m );
+    else
+        blas_error_if( ldda < n );
+
+    if ((transB == Op::NoTrans) ^ (layout == Layout::RowMajor))
+        blas_error_if( lddb < m );
+    else
+        blas_error_if( lddb < n );
+
+    if (layout == Layout::ColMajor)
+        blas_error_if( lddc < m );
+    else
+        blas_error_if( lddc < n );
+
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_geam", 'c',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, 0,
+                          Gflop< std::complex<float> >::geam( m, n ) );
+
+    // check for overflow in native BLAS integer type, if smaller than int64_t
+    if (sizeof(int64_t) > sizeof(device_blas_int)) {
+        blas_error_if( m    > std::numeric_limits<device_blas_int>::max() );
+        blas_error_if( n    > std::numeric_limits<device_blas_int>::max() );
+        blas_error_if( ldda > std::numeric_limits<device_blas_int>::max() );
+        blas_error_if( lddb > std::numeric_limits<device_blas_int>::max() );
+        blas_error_if( lddc > std::numeric_limits<device_blas_int>::max() );
+    }
+
+    device_trans_t  transA_ = blas::device_trans_const( transA );
+    device_trans_t  transB_ = blas::device_trans_const( transB );
+    device_blas_int m_      = (device_blas_int) m;
+    device_blas_int n_      = (device_blas_int) n;
+    device_blas_int ldda_   = (device_blas_int) ldda;
+    device_blas_int lddb_   = (device_blas_int) lddb;
+    device_blas_int lddc_   = (device_blas_int) lddc;
+
+    blas::set_device( queue.device() );
+    if (layout == Layout::RowMajor) {
+        // row-major C^T = alpha op(A)^T + beta op(B)^T; swap m <=> n
+        DEVICE_cgeam(
+                queue.handle(), transA_, transB_,
+                n_, m_,
+                alpha, dA, ldda_,
+                beta,  dB, lddb_,
+                dC, lddc_);
+    }
+    else {
+        DEVICE_cgeam(
+                queue.handle(), transA_, transB_,
+                m_, n_,
+                alpha, dA, ldda_,
+                beta,  dB, lddb_,
+                dC, lddc_);
+    }
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void blas::geam(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n,
+    std::complex<double> alpha,
+    std::complex<double> const *dA, int64_t ldda,
+    std::complex<double> beta,
+    std::complex<double> const *dB, int64_t lddb,
+    std::complex<double>       *dC, int64_t lddc,
+    blas::Queue &queue )
+{
+    // check arguments
+    blas_error_if( layout != Layout::ColMajor &&
+                   layout != Layout::RowMajor );
+    blas_error_if( transA != Op::NoTrans &&
+                   transA != Op::Trans &&
+                   transA != Op::ConjTrans );
+    blas_error_if( transB != Op::NoTrans &&
+                   transB != Op::Trans &&
+                   transB != Op::ConjTrans );
+    blas_error_if( m < 0 );
+    blas_error_if( n < 0 );
+
+    if ((transA == Op::NoTrans) ^ (layout == Layout::RowMajor))
+        blas_error_if( ldda < m );
+    else
+        blas_error_if( ldda < n );
+
+    if ((transB == Op::NoTrans) ^ (layout == Layout::RowMajor))
+        blas_error_if( lddb < m );
+    else
+        blas_error_if( lddb < n );
+
+    if (layout == Layout::ColMajor)
+        blas_error_if( lddc < m );
+    else
+        blas_error_if( lddc < n );
+
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_geam", 'z',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, 0,
+                          Gflop< std::complex<double> >::geam( m, n ) );
+
+    // check for overflow in native BLAS integer type, if smaller than int64_t
+    if (sizeof(int64_t) > sizeof(device_blas_int)) {
+        blas_error_if( m    > std::numeric_limits<device_blas_int>::max() );
+        blas_error_if( n    > std::numeric_limits<device_blas_int>::max() );
+        blas_error_if( ldda > std::numeric_limits<device_blas_int>::max() );
+        blas_error_if( lddb > std::numeric_limits<device_blas_int>::max() );
+        blas_error_if( lddc > std::numeric_limits<device_blas_int>::max() );
+    }
+
+    device_trans_t  transA_ = blas::device_trans_const( transA );
+    device_trans_t  transB_ = blas::device_trans_const( transB );
+    device_blas_int m_      = (device_blas_int) m;
+    device_blas_int n_      = (device_blas_int) n;
+    device_blas_int ldda_   = (device_blas_int) ldda;
+    device_blas_int lddb_   = (device_blas_int) lddb;
+    device_blas_int lddc_   = (device_blas_int) lddc;
+
+    blas::set_device( queue.device() );
+    if (layout == Layout::RowMajor) {
+        // row-major C^T = alpha op(A)^T + beta op(B)^T; swap m <=> n
+        DEVICE_zgeam(
+                queue.handle(), transA_, transB_,
+                n_, m_,
+                alpha, dA, ldda_,
+                beta,  dB, lddb_,
+                dC, lddc_);
+    }
+    else {
+        DEVICE_zgeam(
+                queue.handle(), transA_, transB_,
+                m_, n_,
+                alpha, dA, ldda_,
+                beta,  dB, lddb_,
+                dC, lddc_);
+    }
+}
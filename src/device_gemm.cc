@@ -4,6 +4,8 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "blas/device_blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 #include <limits>
 
 // =============================================================================
@@ -51,6 +53,12 @@ void blas::gemm(
     else
         blas_error_if( lddc < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_gemm", 's',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, k, Gflop< float >::gemm( m, n, k ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(device_blas_int)) {
         blas_error_if( m    > std::numeric_limits<device_blas_int>::max() );
@@ -143,6 +151,12 @@ void blas::gemm(
         blas_error_if( lddc < n );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_gemm", 'd',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, k, Gflop< double >::gemm( m, n, k ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(device_blas_int)) {
         blas_error_if( m    > std::numeric_limits<device_blas_int>::max() );
@@ -234,6 +248,13 @@ void blas::gemm(
         blas_error_if( lddc < n );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_gemm", 'c',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, k,
+                          Gflop< std::complex<float> >::gemm( m, n, k ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(device_blas_int)) {
         blas_error_if( m    > std::numeric_limits<device_blas_int>::max() );
@@ -325,6 +346,13 @@ void blas::gemm(
         blas_error_if( lddc < n );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_gemm", 'z',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, k,
+                          Gflop< std::complex<double> >::gemm( m, n, k ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(device_blas_int)) {
         blas_error_if( m    > std::numeric_limits<device_blas_int>::max() );
@@ -4,6 +4,8 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "blas/device_blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 #include <limits>
 
 // =============================================================================
@@ -83,6 +85,13 @@ void blas::hemm(
         blas_error_if( lddc < n );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_hemm", 'c',
+                          { layout2char( layout ), side2char( side ),
+                            uplo2char( uplo ) },
+                          m, n, 0,
+                          Gflop< std::complex<float> >::hemm( side, m, n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(device_blas_int)) {
         blas_error_if( m   > std::numeric_limits<device_blas_int>::max() );
@@ -156,6 +165,13 @@ void blas::hemm(
         blas_error_if( lddc < n );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_hemm", 'z',
+                          { layout2char( layout ), side2char( side ),
+                            uplo2char( uplo ) },
+                          m, n, 0,
+                          Gflop< std::complex<double> >::hemm( side, m, n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(device_blas_int)) {
         blas_error_if( m   > std::numeric_limits<device_blas_int>::max() );
@@ -4,6 +4,8 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "blas/device_blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 #include <limits>
 
 // =============================================================================
@@ -78,6 +80,13 @@ void blas::her2k(
 
     blas_error_if( lddc < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_her2k", 'c',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( trans ) },
+                          n, 0, k,
+                          Gflop< std::complex<float> >::her2k( n, k ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(device_blas_int)) {
         blas_error_if( n   > std::numeric_limits<device_blas_int>::max() );
@@ -145,6 +154,13 @@ void blas::her2k(
 
     blas_error_if( lddc < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_her2k", 'z',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( trans ) },
+                          n, 0, k,
+                          Gflop< std::complex<double> >::her2k( n, k ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(device_blas_int)) {
         blas_error_if( n   > std::numeric_limits<device_blas_int>::max() );
@@ -4,6 +4,7 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "blas/device.hh"
+#include "blas/profile.hh"
 
 /** queue member functions **/
 
@@ -151,6 +152,8 @@ void blas::Queue::fork()
 
     // assign cublas handle to current stream
     device_blas_check( cublasSetStream( handle_, *current_stream_ ) );
+
+    profile::mark( "Queue::fork", "streams", num_active_streams_ );
     #else
     // TODO: rocBLAS equivalent
     #endif
@@ -178,6 +181,8 @@ void blas::Queue::join()
 
     // assign cublas handle to current stream
     device_blas_check( cublasSetStream( handle_, *current_stream_ ) );
+
+    profile::mark( "Queue::join" );
     #else
     // TODO: rocBLAS equivalent
     #endif
@@ -198,6 +203,8 @@ void blas::Queue::revolve()
 
     // assign cublas handle to current stream
     device_blas_check( cublasSetStream( handle_, *current_stream_ ) );
+
+    profile::mark( "Queue::revolve", "stream", current_stream_index_ );
     #else
     // TODO: rocBLAS equivalent
     #endif
@@ -4,6 +4,8 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "blas/device_blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 #include <limits>
 
 // =============================================================================
@@ -49,6 +51,12 @@ void blas::symm(
         blas_error_if( lddc < n );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_symm", 's',
+                          { layout2char( layout ), side2char( side ),
+                            uplo2char( uplo ) },
+                          m, n, 0, Gflop< float >::symm( side, m, n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(device_blas_int)) {
         blas_error_if( m   > std::numeric_limits<device_blas_int>::max() );
@@ -122,6 +130,12 @@ void blas::symm(
         blas_error_if( lddc < n );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_symm", 'd',
+                          { layout2char( layout ), side2char( side ),
+                            uplo2char( uplo ) },
+                          m, n, 0, Gflop< double >::symm( side, m, n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(device_blas_int)) {
         blas_error_if( m   > std::numeric_limits<device_blas_int>::max() );
@@ -195,6 +209,13 @@ void blas::symm(
         blas_error_if( lddc < n );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_symm", 'c',
+                          { layout2char( layout ), side2char( side ),
+                            uplo2char( uplo ) },
+                          m, n, 0,
+                          Gflop< std::complex<float> >::symm( side, m, n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(device_blas_int)) {
         blas_error_if( m   > std::numeric_limits<device_blas_int>::max() );
@@ -268,6 +289,13 @@ void blas::symm(
         blas_error_if( lddc < n );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_symm", 'z',
+                          { layout2char( layout ), side2char( side ),
+                            uplo2char( uplo ) },
+                          m, n, 0,
+                          Gflop< std::complex<double> >::symm( side, m, n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(device_blas_int)) {
         blas_error_if( m   > std::numeric_limits<device_blas_int>::max() );
@@ -4,6 +4,8 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "blas/device_blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 #include <limits>
 
 // =============================================================================
@@ -45,6 +47,12 @@ void blas::syr2k(
 
     blas_error_if( lddc < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_syr2k", 's',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( trans ) },
+                          n, 0, k, Gflop< float >::syr2k( n, k ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(device_blas_int)) {
         blas_error_if( n   > std::numeric_limits<device_blas_int>::max() );
@@ -114,6 +122,12 @@ void blas::syr2k(
 
     blas_error_if( lddc < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_syr2k", 'd',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( trans ) },
+                          n, 0, k, Gflop< double >::syr2k( n, k ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(device_blas_int)) {
         blas_error_if( n   > std::numeric_limits<device_blas_int>::max() );
@@ -182,6 +196,13 @@ void blas::syr2k(
 
     blas_error_if( lddc < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_syr2k", 'c',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( trans ) },
+                          n, 0, k,
+                          Gflop< std::complex<float> >::syr2k( n, k ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(device_blas_int)) {
         blas_error_if( n   > std::numeric_limits<device_blas_int>::max() );
@@ -250,6 +271,13 @@ void blas::syr2k(
 
     blas_error_if( lddc < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_syr2k", 'z',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( trans ) },
+                          n, 0, k,
+                          Gflop< std::complex<double> >::syr2k( n, k ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(device_blas_int)) {
         blas_error_if( n   > std::numeric_limits<device_blas_int>::max() );
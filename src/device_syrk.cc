@@ -4,6 +4,8 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "blas/device_blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 #include <limits>
 
 // =============================================================================
@@ -40,6 +42,12 @@ void blas::syrk(
 
     blas_error_if( lddc < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_syrk", 's',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( trans ) },
+                          n, 0, k, Gflop< float >::syrk( n, k ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(device_blas_int)) {
         blas_error_if( n   > std::numeric_limits<device_blas_int>::max() );
@@ -102,6 +110,12 @@ void blas::syrk(
 
     blas_error_if( lddc < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_syrk", 'd',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( trans ) },
+                          n, 0, k, Gflop< double >::syrk( n, k ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(device_blas_int)) {
         blas_error_if( n   > std::numeric_limits<device_blas_int>::max() );
@@ -163,6 +177,12 @@ void blas::syrk(
 
     blas_error_if( lddc < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_syrk", 'c',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( trans ) },
+                          n, 0, k, Gflop< std::complex<float> >::syrk( n, k ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(device_blas_int)) {
         blas_error_if( n   > std::numeric_limits<device_blas_int>::max() );
@@ -224,6 +244,13 @@ void blas::syrk(
 
     blas_error_if( lddc < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_syrk", 'z',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( trans ) },
+                          n, 0, k,
+                          Gflop< std::complex<double> >::syrk( n, k ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(device_blas_int)) {
         blas_error_if( n   > std::numeric_limits<device_blas_int>::max() );
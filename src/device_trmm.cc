@@ -4,6 +4,8 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "blas/device_blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 #include <limits>
 
 // =============================================================================
@@ -49,6 +51,13 @@ void blas::trmm(
     else
         blas_error_if( lddb < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_trmm", 's',
+                          { layout2char( layout ), side2char( side ),
+                            uplo2char( uplo ), op2char( trans ),
+                            diag2char( diag ) },
+                          m, n, 0, Gflop< float >::trmm( side, m, n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(device_blas_int)) {
         blas_error_if( m   > std::numeric_limits<device_blas_int>::max() );
@@ -123,6 +132,13 @@ void blas::trmm(
     else
         blas_error_if( lddb < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_trmm", 'd',
+                          { layout2char( layout ), side2char( side ),
+                            uplo2char( uplo ), op2char( trans ),
+                            diag2char( diag ) },
+                          m, n, 0, Gflop< double >::trmm( side, m, n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(device_blas_int)) {
         blas_error_if( m   > std::numeric_limits<device_blas_int>::max() );
@@ -197,6 +213,14 @@ void blas::trmm(
     else
         blas_error_if( lddb < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_trmm", 'c',
+                          { layout2char( layout ), side2char( side ),
+                            uplo2char( uplo ), op2char( trans ),
+                            diag2char( diag ) },
+                          m, n, 0,
+                          Gflop< std::complex<float> >::trmm( side, m, n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(device_blas_int)) {
         blas_error_if( m   > std::numeric_limits<device_blas_int>::max() );
@@ -271,6 +295,14 @@ void blas::trmm(
     else
         blas_error_if( lddb < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "device_trmm", 'z',
+                          { layout2char( layout ), side2char( side ),
+                            uplo2char( uplo ), op2char( trans ),
+                            diag2char( diag ) },
+                          m, n, 0,
+                          Gflop< std::complex<double> >::trmm( side, m, n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(device_blas_int)) {
         blas_error_if( m   > std::numeric_limits<device_blas_int>::max() );
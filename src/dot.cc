@@ -5,6 +5,10 @@
 
 #include "blas/fortran.h"
 #include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
+#include "blas/repro.hh"
+#include "blas/tune.hh"
 
 #include <limits>
 
@@ -26,6 +30,19 @@ float dot(
     blas_error_if( incx == 0 );  // standard BLAS doesn't detect inc[xy] == 0
     blas_error_if( incy == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "dot", 's', {},
+                          n, 0, 0, Gflop< float >::dot( n ) );
+
+    // bitwise reproducible mode; see blas::repro
+    if (repro::enabled())
+        return repro::dot( n, x, incx, y, incy );
+
+    // for tiny sizes, the in-library kernel is faster; see blas::tune
+    if (tune::use_kernel( tune::Routine::dot, 's', Op::NoTrans, Op::NoTrans,
+                          n ))
+        return dot< float, float >( n, x, incx, y, incy );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n              > std::numeric_limits<blas_int>::max() );
@@ -51,6 +68,19 @@ double dot(
     blas_error_if( incx == 0 );  // standard BLAS doesn't detect inc[xy] == 0
     blas_error_if( incy == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "dot", 'd', {},
+                          n, 0, 0, Gflop< double >::dot( n ) );
+
+    // bitwise reproducible mode; see blas::repro
+    if (repro::enabled())
+        return repro::dot( n, x, incx, y, incy );
+
+    // for tiny sizes, the in-library kernel is faster; see blas::tune
+    if (tune::use_kernel( tune::Routine::dot, 'd', Op::NoTrans, Op::NoTrans,
+                          n ))
+        return dot< double, double >( n, x, incx, y, incy );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n              > std::numeric_limits<blas_int>::max() );
@@ -76,6 +106,19 @@ std::complex<float> dot(
     blas_error_if( incx == 0 );  // standard BLAS doesn't detect inc[xy] == 0
     blas_error_if( incy == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "dot", 'c', {},
+                          n, 0, 0, Gflop< std::complex<float> >::dot( n ) );
+
+    // bitwise reproducible mode; see blas::repro
+    if (repro::enabled())
+        return repro::dot( n, x, incx, y, incy );
+
+    // for tiny sizes, the in-library kernel is faster; see blas::tune
+    if (tune::use_kernel( tune::Routine::dot, 'c', Op::NoTrans, Op::NoTrans,
+                          n ))
+        return dot< std::complex<float>, std::complex<float> >( n, x, incx, y, incy );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n              > std::numeric_limits<blas_int>::max() );
@@ -116,6 +159,19 @@ std::complex<double> dot(
     blas_error_if( incx == 0 );  // standard BLAS doesn't detect inc[xy] == 0
     blas_error_if( incy == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "dot", 'z', {},
+                          n, 0, 0, Gflop< std::complex<double> >::dot( n ) );
+
+    // bitwise reproducible mode; see blas::repro
+    if (repro::enabled())
+        return repro::dot( n, x, incx, y, incy );
+
+    // for tiny sizes, the in-library kernel is faster; see blas::tune
+    if (tune::use_kernel( tune::Routine::dot, 'z', Op::NoTrans, Op::NoTrans,
+                          n ))
+        return dot< std::complex<double>, std::complex<double> >( n, x, incx, y, incy );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n              > std::numeric_limits<blas_int>::max() );
@@ -179,6 +235,14 @@ std::complex<float> dotu(
     blas_error_if( incx == 0 );  // standard BLAS doesn't detect inc[xy] == 0
     blas_error_if( incy == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "dotu", 'c', {},
+                          n, 0, 0, Gflop< std::complex<float> >::dot( n ) );
+
+    // bitwise reproducible mode; see blas::repro
+    if (repro::enabled())
+        return repro::dotu( n, x, incx, y, incy );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n              > std::numeric_limits<blas_int>::max() );
@@ -219,6 +283,14 @@ std::complex<double> dotu(
     blas_error_if( incx == 0 );  // standard BLAS doesn't detect inc[xy] == 0
     blas_error_if( incy == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "dotu", 'z', {},
+                          n, 0, 0, Gflop< std::complex<double> >::dot( n ) );
+
+    // bitwise reproducible mode; see blas::repro
+    if (repro::enabled())
+        return repro::dotu( n, x, incx, y, incy );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n              > std::numeric_limits<blas_int>::max() );
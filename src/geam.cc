@@ -0,0 +1,243 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
+
+#include <algorithm>
+
+namespace blas {
+namespace internal {
+
+// With a transposed operand, C is done in nb-by-nb tiles, so the tiles of
+// A, B, C, read along rows or columns, all stay in L1 cache. Threads are
+// used if C has at least geam_parallel_min entries.
+const int64_t geam_nb           = 32;
+const int64_t geam_parallel_min = 128*128;
+
+//------------------------------------------------------------------------------
+/// C = alpha op(A) + beta op(B) for an mb-by-nb tile, column-major, where
+/// op(A)(i, j) = A[ i*rsa + j*csa ], conjugated if conjA, and likewise B.
+/// If beta = 0, B is not read, and if alpha = 0, A is not read.
+template <typename T>
+void geam_tile(
+    int64_t mb, int64_t nb,
+    T alpha, T const* A, int64_t rsa, int64_t csa, bool conjA,
+    T beta,  T const* B, int64_t rsb, int64_t csb, bool conjB,
+    T* C, int64_t ldc )
+{
+    for (int64_t j = 0; j < nb; ++j) {
+        T* Cj = &C[ j*ldc ];
+        T const* Aj = &A[ j*csa ];
+        T const* Bj = &B[ j*csb ];
+        if (beta == T( 0 )) {
+            if (alpha == T( 0 )) {
+                std::fill( Cj, Cj + mb, T( 0 ) );
+            }
+            else {
+                for (int64_t i = 0; i < mb; ++i)
+                    Cj[ i ] = alpha * conj_if( conjA, Aj[ i*rsa ] );
+            }
+        }
+        else if (alpha == T( 0 )) {
+            for (int64_t i = 0; i < mb; ++i)
+                Cj[ i ] = beta * conj_if( conjB, Bj[ i*rsb ] );
+        }
+        else {
+            for (int64_t i = 0; i < mb; ++i)
+                Cj[ i ] = alpha * conj_if( conjA, Aj[ i*rsa ] )
+                        + beta  * conj_if( conjB, Bj[ i*rsb ] );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// C = alpha op(A) + beta op(B), where C is m-by-n. C may be A, if
+/// transA = NoTrans and lda = ldc, or likewise B.
+/// A RowMajor m-by-n matrix is a ColMajor n-by-m matrix, with the same op,
+/// so RowMajor swaps m and n.
+template <typename T>
+void geam(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n,
+    T alpha,
+    T const *A, int64_t lda,
+    T beta,
+    T const *B, int64_t ldb,
+    T       *C, int64_t ldc )
+{
+    // check arguments
+    blas_error_if( layout != Layout::ColMajor &&
+                   layout != Layout::RowMajor );
+    blas_error_if( transA != Op::NoTrans &&
+                   transA != Op::Trans &&
+                   transA != Op::ConjTrans );
+    blas_error_if( transB != Op::NoTrans &&
+                   transB != Op::Trans &&
+                   transB != Op::ConjTrans );
+    blas_error_if( m < 0 );
+    blas_error_if( n < 0 );
+
+    if ((transA == Op::NoTrans) ^ (layout == Layout::RowMajor))
+        blas_error_if( lda < m );
+    else
+        blas_error_if( lda < n );
+
+    if ((transB == Op::NoTrans) ^ (layout == Layout::RowMajor))
+        blas_error_if( ldb < m );
+    else
+        blas_error_if( ldb < n );
+
+    if (layout == Layout::ColMajor)
+        blas_error_if( ldc < m );
+    else
+        blas_error_if( ldc < n );
+
+    // in-place only if C overwrites A or B entry by entry
+    blas_error_if_msg( C == A && (transA != Op::NoTrans || lda != ldc),
+                       "C = A requires transA = NoTrans and lda = ldc" );
+    blas_error_if_msg( C == B && (transB != Op::NoTrans || ldb != ldc),
+                       "C = B requires transB = NoTrans and ldb = ldc" );
+
+    // quick return
+    if (m == 0 || n == 0)
+        return;
+
+    if (layout == Layout::RowMajor)
+        std::swap( m, n );
+
+    bool transA_ = (transA != Op::NoTrans);
+    bool transB_ = (transB != Op::NoTrans);
+    int64_t rsa = (transA_ ? lda : 1);
+    int64_t csa = (transA_ ? 1 : lda);
+    int64_t rsb = (transB_ ? ldb : 1);
+    int64_t csb = (transB_ ? 1 : ldb);
+    bool conjA = (transA == Op::ConjTrans);
+    bool conjB = (transB == Op::ConjTrans);
+    bool parallel = m*n >= geam_parallel_min;
+
+    if (! transA_ && ! transB_) {
+        // unit stride columns
+        #pragma omp parallel for schedule(static) if (parallel)
+        for (int64_t j = 0; j < n; ++j) {
+            geam_tile( m, 1, alpha, &A[ j*lda ], 1, lda, false,
+                       beta, &B[ j*ldb ], 1, ldb, false, &C[ j*ldc ], ldc );
+        }
+    }
+    else {
+        const int64_t nb = geam_nb;
+        #pragma omp parallel for collapse(2) schedule(static) if (parallel)
+        for (int64_t j = 0; j < n; j += nb) {
+            for (int64_t i = 0; i < m; i += nb) {
+                geam_tile( std::min( nb, m - i ), std::min( nb, n - j ),
+                           alpha, &A[ i*rsa + j*csa ], rsa, csa, conjA,
+                           beta,  &B[ i*rsb + j*csb ], rsb, csb, conjB,
+                           &C[ i + j*ldc ], ldc );
+            }
+        }
+    }
+}
+
+}  // namespace internal
+
+// =============================================================================
+// Overloaded wrappers for s, d, c, z precisions.
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void geam(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n,
+    float alpha,
+    float const *A, int64_t lda,
+    float beta,
+    float const *B, int64_t ldb,
+    float       *C, int64_t ldc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "geam", 's',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, 0, Gflop< float >::geam( m, n ) );
+
+    internal::geam( layout, transA, transB, m, n,
+                    alpha, A, lda, beta, B, ldb, C, ldc );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void geam(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n,
+    double alpha,
+    double const *A, int64_t lda,
+    double beta,
+    double const *B, int64_t ldb,
+    double       *C, int64_t ldc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "geam", 'd',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, 0, Gflop< double >::geam( m, n ) );
+
+    internal::geam( layout, transA, transB, m, n,
+                    alpha, A, lda, beta, B, ldb, C, ldc );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void geam(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n,
+    std::complex<float> alpha,
+    std::complex<float> const *A, int64_t lda,
+    std::complex<float> beta,
+    std::complex<float> const *B, int64_t ldb,
+    std::complex<float>       *C, int64_t ldc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "geam", 'c',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, 0, Gflop< std::complex<float> >::geam( m, n ) );
+
+    internal::geam( layout, transA, transB, m, n,
+                    alpha, A, lda, beta, B, ldb, C, ldc );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void geam(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n,
+    std::complex<double> alpha,
+    std::complex<double> const *A, int64_t lda,
+    std::complex<double> beta,
+    std::complex<double> const *B, int64_t ldb,
+    std::complex<double>       *C, int64_t ldc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "geam", 'z',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, 0, Gflop< std::complex<double> >::geam( m, n ) );
+
+    internal::geam( layout, transA, transB, m, n,
+                    alpha, A, lda, beta, B, ldb, C, ldc );
+}
+
+}  // namespace blas
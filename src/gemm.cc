@@ -5,10 +5,286 @@
 
 #include "blas/fortran.h"
 #include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
+#include "blas/tune.hh"
 
+#include <algorithm>
 #include <limits>
+#include <vector>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
 
 namespace blas {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Vendor gemm, without argument checks, profiling, tuning, or splitting k,
+/// for each of s, d, c, z; see blas::gemm. Dimensions must fit in blas_int.
+void gemm_vendor(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    float alpha,
+    float const *A, int64_t lda,
+    float const *B, int64_t ldb,
+    float beta,
+    float       *C, int64_t ldc )
+{
+    blas_int m_   = (blas_int) m;
+    blas_int n_   = (blas_int) n;
+    blas_int k_   = (blas_int) k;
+    blas_int lda_ = (blas_int) lda;
+    blas_int ldb_ = (blas_int) ldb;
+    blas_int ldc_ = (blas_int) ldc;
+
+    char transA_ = op2char( transA );
+    char transB_ = op2char( transB );
+    if (layout == Layout::RowMajor) {
+        // swap transA <=> transB, m <=> n, B <=> A
+        BLAS_sgemm( &transB_, &transA_, &n_, &m_, &k_,
+                   &alpha, B, &ldb_, A, &lda_, &beta, C, &ldc_ );
+    }
+    else {
+        BLAS_sgemm( &transA_, &transB_, &m_, &n_, &k_,
+                   &alpha, A, &lda_, B, &ldb_, &beta, C, &ldc_ );
+    }
+}
+
+//------------------------------------------------------------------------------
+void gemm_vendor(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    double alpha,
+    double const *A, int64_t lda,
+    double const *B, int64_t ldb,
+    double beta,
+    double       *C, int64_t ldc )
+{
+    blas_int m_   = (blas_int) m;
+    blas_int n_   = (blas_int) n;
+    blas_int k_   = (blas_int) k;
+    blas_int lda_ = (blas_int) lda;
+    blas_int ldb_ = (blas_int) ldb;
+    blas_int ldc_ = (blas_int) ldc;
+
+    char transA_ = op2char( transA );
+    char transB_ = op2char( transB );
+    if (layout == Layout::RowMajor) {
+        // swap transA <=> transB, m <=> n, B <=> A
+        BLAS_dgemm( &transB_, &transA_, &n_, &m_, &k_,
+                   &alpha, B, &ldb_, A, &lda_, &beta, C, &ldc_ );
+    }
+    else {
+        BLAS_dgemm( &transA_, &transB_, &m_, &n_, &k_,
+                   &alpha, A, &lda_, B, &ldb_, &beta, C, &ldc_ );
+    }
+}
+
+//------------------------------------------------------------------------------
+void gemm_vendor(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<float> alpha,
+    std::complex<float> const *A, int64_t lda,
+    std::complex<float> const *B, int64_t ldb,
+    std::complex<float> beta,
+    std::complex<float>       *C, int64_t ldc )
+{
+    blas_int m_   = (blas_int) m;
+    blas_int n_   = (blas_int) n;
+    blas_int k_   = (blas_int) k;
+    blas_int lda_ = (blas_int) lda;
+    blas_int ldb_ = (blas_int) ldb;
+    blas_int ldc_ = (blas_int) ldc;
+
+    char transA_ = op2char( transA );
+    char transB_ = op2char( transB );
+    if (layout == Layout::RowMajor) {
+        // swap transA <=> transB, m <=> n, B <=> A
+        BLAS_cgemm( &transB_, &transA_, &n_, &m_, &k_,
+                    (blas_complex_float*) &alpha,
+                    (blas_complex_float*) B, &ldb_,
+                    (blas_complex_float*) A, &lda_,
+                    (blas_complex_float*) &beta,
+                    (blas_complex_float*) C, &ldc_ );
+    }
+    else {
+        BLAS_cgemm( &transA_, &transB_, &m_, &n_, &k_,
+                    (blas_complex_float*) &alpha,
+                    (blas_complex_float*) A, &lda_,
+                    (blas_complex_float*) B, &ldb_,
+                    (blas_complex_float*) &beta,
+                    (blas_complex_float*) C, &ldc_ );
+    }
+}
+
+//------------------------------------------------------------------------------
+void gemm_vendor(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<double> alpha,
+    std::complex<double> const *A, int64_t lda,
+    std::complex<double> const *B, int64_t ldb,
+    std::complex<double> beta,
+    std::complex<double>       *C, int64_t ldc )
+{
+    blas_int m_   = (blas_int) m;
+    blas_int n_   = (blas_int) n;
+    blas_int k_   = (blas_int) k;
+    blas_int lda_ = (blas_int) lda;
+    blas_int ldb_ = (blas_int) ldb;
+    blas_int ldc_ = (blas_int) ldc;
+
+    char transA_ = op2char( transA );
+    char transB_ = op2char( transB );
+    if (layout == Layout::RowMajor) {
+        // swap transA <=> transB, m <=> n, B <=> A
+        BLAS_zgemm( &transB_, &transA_, &n_, &m_, &k_,
+                    (blas_complex_double*) &alpha,
+                    (blas_complex_double*) B, &ldb_,
+                    (blas_complex_double*) A, &lda_,
+                    (blas_complex_double*) &beta,
+                    (blas_complex_double*) C, &ldc_ );
+    }
+    else {
+        BLAS_zgemm( &transA_, &transB_, &m_, &n_, &k_,
+                    (blas_complex_double*) &alpha,
+                    (blas_complex_double*) A, &lda_,
+                    (blas_complex_double*) B, &ldb_,
+                    (blas_complex_double*) &beta,
+                    (blas_complex_double*) C, &ldc_ );
+    }
+}
+
+// Tall-skinny gemm with a small C and long k, e.g., the Gram matrix A^T A
+// of a tall panel: vendor BLAS often parallelize only over m and n, leaving
+// most threads idle. If k >= gemm_ksplit_ratio max( m, n ) and
+// m n <= gemm_ksplit_max_mn, k is instead partitioned across threads, each
+// with at least gemm_ksplit_min_k, into private partial C that are summed.
+const int64_t gemm_ksplit_ratio  = 16;
+const int64_t gemm_ksplit_max_mn = 512*512;
+const int64_t gemm_ksplit_min_k  = 4096;
+
+//------------------------------------------------------------------------------
+/// @return number of threads to split k across, or 1 to call the vendor
+/// gemm as is, e.g., if already in a parallel region.
+inline int64_t gemm_ksplit_threads( int64_t m, int64_t n, int64_t k )
+{
+    #ifdef _OPENMP
+        if (omp_in_parallel()
+            || k < gemm_ksplit_ratio * std::max( m, n )
+            || m*n > gemm_ksplit_max_mn)
+            return 1;
+        int64_t nt = std::min( int64_t( omp_get_max_threads() ),
+                               k / gemm_ksplit_min_k );
+        return std::max( nt, int64_t( 1 ) );
+    #else
+        return 1;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// C = alpha op(A) op(B) + beta C, with k partitioned across nthreads.
+/// Thread 0 updates C with beta; the others compute partial products in
+/// a workspace, which are added to C in thread order.
+template <typename T>
+void gemm_ksplit(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    T alpha,
+    T const *A, int64_t lda,
+    T const *B, int64_t ldb,
+    T beta,
+    T       *C, int64_t ldc,
+    int64_t nthreads )
+{
+    // row-major: compute C^T = op(B)^T op(A)^T in column-major
+    if (layout == Layout::RowMajor) {
+        std::swap( transA, transB );
+        std::swap( m, n );
+        std::swap( A, B );
+        std::swap( lda, ldb );
+    }
+
+    std::vector<T> W( (nthreads - 1) * m * n );
+
+    // each vendor gemm runs single threaded, also with a pthreads vendor
+    // BLAS that does not see the OpenMP region
+    ThreadScope thread_scope( 1 );
+    #pragma omp parallel num_threads( nthreads )
+    {
+        #ifdef _OPENMP
+            int64_t nt  = omp_get_num_threads();
+            int64_t tid = omp_get_thread_num();
+        #else
+            int64_t nt  = 1;
+            int64_t tid = 0;
+        #endif
+        int64_t k0 = k * tid / nt;
+        int64_t k1 = k * (tid + 1) / nt;
+        T const* At = A + (transA == Op::NoTrans ? k0*lda : k0);
+        T const* Bt = B + (transB == Op::NoTrans ? k0 : k0*ldb);
+        if (tid == 0) {
+            gemm_vendor( Layout::ColMajor, transA, transB, m, n, k1 - k0,
+                         alpha, At, lda, Bt, ldb, beta, C, ldc );
+        }
+        else {
+            gemm_vendor( Layout::ColMajor, transA, transB, m, n, k1 - k0,
+                         alpha, At, lda, Bt, ldb, T( 0 ), &W[ (tid - 1)*m*n ], m );
+        }
+
+        #pragma omp barrier
+
+        // reduce, each thread doing a block of columns
+        int64_t j0 = n * tid / nt;
+        int64_t j1 = n * (tid + 1) / nt;
+        for (int64_t t = 1; t < nt; ++t) {
+            T const* Wt = &W[ (t - 1)*m*n ];
+            for (int64_t j = j0; j < j1; ++j) {
+                for (int64_t i = 0; i < m; ++i) {
+                    C[ i + j*ldc ] += Wt[ i + j*m ];
+                }
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// If gemm_ksplit_threads( m, n, k ) > 1, computes C with gemm_ksplit.
+/// @return true if C was computed; false to call the vendor gemm.
+template <typename T>
+bool gemm_ksplit_try(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    T alpha,
+    T const *A, int64_t lda,
+    T const *B, int64_t ldb,
+    T beta,
+    T       *C, int64_t ldc )
+{
+    int64_t nthreads = gemm_ksplit_threads( m, n, k );
+    if (nthreads <= 1)
+        return false;
+    gemm_ksplit( layout, transA, transB, m, n, k,
+                 alpha, A, lda, B, ldb, beta, C, ldc, nthreads );
+    return true;
+}
+
+}  // namespace internal
 
 // =============================================================================
 // Overloaded wrappers for s, d, c, z precisions.
@@ -54,6 +330,21 @@ void gemm(
     else
         blas_error_if( ldc < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm", 's',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, k, Gflop< float >::gemm( m, n, k ) );
+
+    // for tiny sizes, the in-library kernel is faster; see blas::tune
+    if (tune::use_kernel( tune::Routine::gemm, 's', transA, transB,
+                          max( m, n, k ) )) {
+        gemm< float, float, float >(
+            layout, transA, transB, m, n, k,
+            alpha, A, lda, B, ldb, beta, C, ldc );
+        return;
+    }
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( m   > std::numeric_limits<blas_int>::max() );
@@ -64,24 +355,13 @@ void gemm(
         blas_error_if( ldc > std::numeric_limits<blas_int>::max() );
     }
 
-    blas_int m_   = (blas_int) m;
-    blas_int n_   = (blas_int) n;
-    blas_int k_   = (blas_int) k;
-    blas_int lda_ = (blas_int) lda;
-    blas_int ldb_ = (blas_int) ldb;
-    blas_int ldc_ = (blas_int) ldc;
+    // long k with small C: split k across threads
+    if (internal::gemm_ksplit_try( layout, transA, transB, m, n, k,
+                                   alpha, A, lda, B, ldb, beta, C, ldc ))
+        return;
 
-    char transA_ = op2char( transA );
-    char transB_ = op2char( transB );
-    if (layout == Layout::RowMajor) {
-        // swap transA <=> transB, m <=> n, B <=> A
-        BLAS_sgemm( &transB_, &transA_, &n_, &m_, &k_,
-                   &alpha, B, &ldb_, A, &lda_, &beta, C, &ldc_ );
-    }
-    else {
-        BLAS_sgemm( &transA_, &transB_, &m_, &n_, &k_,
-                   &alpha, A, &lda_, B, &ldb_, &beta, C, &ldc_ );
-    }
+    internal::gemm_vendor( layout, transA, transB, m, n, k,
+                           alpha, A, lda, B, ldb, beta, C, ldc );
 }
 
 // -----------------------------------------------------------------------------
@@ -137,6 +417,21 @@ void gemm(
         blas_error_if( ldc < n );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm", 'd',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, k, Gflop< double >::gemm( m, n, k ) );
+
+    // for tiny sizes, the in-library kernel is faster; see blas::tune
+    if (tune::use_kernel( tune::Routine::gemm, 'd', transA, transB,
+                          max( m, n, k ) )) {
+        gemm< double, double, double >(
+            layout, transA, transB, m, n, k,
+            alpha, A, lda, B, ldb, beta, C, ldc );
+        return;
+    }
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( m   > std::numeric_limits<blas_int>::max() );
@@ -147,24 +442,13 @@ void gemm(
         blas_error_if( ldc > std::numeric_limits<blas_int>::max() );
     }
 
-    blas_int m_   = (blas_int) m;
-    blas_int n_   = (blas_int) n;
-    blas_int k_   = (blas_int) k;
-    blas_int lda_ = (blas_int) lda;
-    blas_int ldb_ = (blas_int) ldb;
-    blas_int ldc_ = (blas_int) ldc;
+    // long k with small C: split k across threads
+    if (internal::gemm_ksplit_try( layout, transA, transB, m, n, k,
+                                   alpha, A, lda, B, ldb, beta, C, ldc ))
+        return;
 
-    char transA_ = op2char( transA );
-    char transB_ = op2char( transB );
-    if (layout == Layout::RowMajor) {
-        // swap transA <=> transB, m <=> n, B <=> A
-        BLAS_dgemm( &transB_, &transA_, &n_, &m_, &k_,
-                   &alpha, B, &ldb_, A, &lda_, &beta, C, &ldc_ );
-    }
-    else {
-        BLAS_dgemm( &transA_, &transB_, &m_, &n_, &k_,
-                   &alpha, A, &lda_, B, &ldb_, &beta, C, &ldc_ );
-    }
+    internal::gemm_vendor( layout, transA, transB, m, n, k,
+                           alpha, A, lda, B, ldb, beta, C, ldc );
 }
 
 // -----------------------------------------------------------------------------
@@ -220,6 +504,22 @@ void gemm(
         blas_error_if( ldc < n );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm", 'c',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, k,
+                          Gflop< std::complex<float> >::gemm( m, n, k ) );
+
+    // for tiny sizes, the in-library kernel is faster; see blas::tune
+    if (tune::use_kernel( tune::Routine::gemm, 'c', transA, transB,
+                          max( m, n, k ) )) {
+        gemm< std::complex<float>, std::complex<float>, std::complex<float> >(
+            layout, transA, transB, m, n, k,
+            alpha, A, lda, B, ldb, beta, C, ldc );
+        return;
+    }
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( m   > std::numeric_limits<blas_int>::max() );
@@ -230,32 +530,13 @@ void gemm(
         blas_error_if( ldc > std::numeric_limits<blas_int>::max() );
     }
 
-    blas_int m_   = (blas_int) m;
-    blas_int n_   = (blas_int) n;
-    blas_int k_   = (blas_int) k;
-    blas_int lda_ = (blas_int) lda;
-    blas_int ldb_ = (blas_int) ldb;
-    blas_int ldc_ = (blas_int) ldc;
+    // long k with small C: split k across threads
+    if (internal::gemm_ksplit_try( layout, transA, transB, m, n, k,
+                                   alpha, A, lda, B, ldb, beta, C, ldc ))
+        return;
 
-    char transA_ = op2char( transA );
-    char transB_ = op2char( transB );
-    if (layout == Layout::RowMajor) {
-        // swap transA <=> transB, m <=> n, B <=> A
-        BLAS_cgemm( &transB_, &transA_, &n_, &m_, &k_,
-                    (blas_complex_float*) &alpha,
-                    (blas_complex_float*) B, &ldb_,
-                    (blas_complex_float*) A, &lda_,
-                    (blas_complex_float*) &beta,
-                    (blas_complex_float*) C, &ldc_ );
-    }
-    else {
-        BLAS_cgemm( &transA_, &transB_, &m_, &n_, &k_,
-                    (blas_complex_float*) &alpha,
-                    (blas_complex_float*) A, &lda_,
-                    (blas_complex_float*) B, &ldb_,
-                    (blas_complex_float*) &beta,
-                    (blas_complex_float*) C, &ldc_ );
-    }
+    internal::gemm_vendor( layout, transA, transB, m, n, k,
+                           alpha, A, lda, B, ldb, beta, C, ldc );
 }
 
 // -----------------------------------------------------------------------------
@@ -311,6 +592,22 @@ void gemm(
         blas_error_if( ldc < n );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm", 'z',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, k,
+                          Gflop< std::complex<double> >::gemm( m, n, k ) );
+
+    // for tiny sizes, the in-library kernel is faster; see blas::tune
+    if (tune::use_kernel( tune::Routine::gemm, 'z', transA, transB,
+                          max( m, n, k ) )) {
+        gemm< std::complex<double>, std::complex<double>, std::complex<double> >(
+            layout, transA, transB, m, n, k,
+            alpha, A, lda, B, ldb, beta, C, ldc );
+        return;
+    }
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( m   > std::numeric_limits<blas_int>::max() );
@@ -321,32 +618,13 @@ void gemm(
         blas_error_if( ldc > std::numeric_limits<blas_int>::max() );
     }
 
-    blas_int m_   = (blas_int) m;
-    blas_int n_   = (blas_int) n;
-    blas_int k_   = (blas_int) k;
-    blas_int lda_ = (blas_int) lda;
-    blas_int ldb_ = (blas_int) ldb;
-    blas_int ldc_ = (blas_int) ldc;
+    // long k with small C: split k across threads
+    if (internal::gemm_ksplit_try( layout, transA, transB, m, n, k,
+                                   alpha, A, lda, B, ldb, beta, C, ldc ))
+        return;
 
-    char transA_ = op2char( transA );
-    char transB_ = op2char( transB );
-    if (layout == Layout::RowMajor) {
-        // swap transA <=> transB, m <=> n, B <=> A
-        BLAS_zgemm( &transB_, &transA_, &n_, &m_, &k_,
-                    (blas_complex_double*) &alpha,
-                    (blas_complex_double*) B, &ldb_,
-                    (blas_complex_double*) A, &lda_,
-                    (blas_complex_double*) &beta,
-                    (blas_complex_double*) C, &ldc_ );
-    }
-    else {
-        BLAS_zgemm( &transA_, &transB_, &m_, &n_, &k_,
-                    (blas_complex_double*) &alpha,
-                    (blas_complex_double*) A, &lda_,
-                    (blas_complex_double*) B, &ldb_,
-                    (blas_complex_double*) &beta,
-                    (blas_complex_double*) C, &ldc_ );
-    }
+    internal::gemm_vendor( layout, transA, transB, m, n, k,
+                           alpha, A, lda, B, ldb, beta, C, ldc );
 }
 
 }  // namespace blas
@@ -0,0 +1,213 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace blas {
+namespace internal {
+
+// Columns of C computed per block: workspace is 3 m k reals for op(A),
+// plus 3 (k + m) gemm3m_nb reals for a block of op(B) and the products.
+const int64_t gemm3m_nb = 512;
+
+// Below this min( m, n, k ), splitting costs more than the saved multiply,
+// so the standard 4M gemm is used.
+const int64_t gemm3m_min = 64;
+
+//------------------------------------------------------------------------------
+/// Splits the rows-by-cols matrix op(X) into column-major real matrices
+/// Xr = real( op(X) ), Xi = imag( op(X) ), and Xs = Xr + Xi, each with
+/// leading dimension rows.
+template <typename real_t>
+void gemm3m_split(
+    blas::Op trans, int64_t rows, int64_t cols,
+    std::complex<real_t> const* X, int64_t ldx,
+    real_t* Xr, real_t* Xi, real_t* Xs )
+{
+    int64_t rs = (trans == Op::NoTrans ? 1 : ldx);
+    int64_t cs = (trans == Op::NoTrans ? ldx : 1);
+    real_t sign = (trans == Op::ConjTrans ? -1 : 1);
+    #pragma omp parallel for schedule(static)
+    for (int64_t j = 0; j < cols; ++j) {
+        for (int64_t i = 0; i < rows; ++i) {
+            std::complex<real_t> x = X[ i*rs + j*cs ];
+            real_t xr = real( x );
+            real_t xi = sign * imag( x );
+            Xr[ i + j*rows ] = xr;
+            Xi[ i + j*rows ] = xi;
+            Xs[ i + j*rows ] = xr + xi;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Complex gemm using 3 real gemms (3M method) instead of the 4 implied by
+/// complex arithmetic. With op(A) = Ar + i Ai, op(B) = Br + i Bi,
+///     T1 = Ar Br,  T2 = Ai Bi,  T3 = (Ar + Ai) (Br + Bi),
+///     op(A) op(B) = (T1 - T2) + i (T3 - T1 - T2).
+template <typename T>
+void gemm3m(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    T alpha,
+    T const *A, int64_t lda,
+    T const *B, int64_t ldb,
+    T beta,
+    T       *C, int64_t ldc )
+{
+    typedef real_type<T> real_t;
+
+    // check arguments
+    blas_error_if( layout != Layout::ColMajor &&
+                   layout != Layout::RowMajor );
+    blas_error_if( transA != Op::NoTrans &&
+                   transA != Op::Trans &&
+                   transA != Op::ConjTrans );
+    blas_error_if( transB != Op::NoTrans &&
+                   transB != Op::Trans &&
+                   transB != Op::ConjTrans );
+    blas_error_if( m < 0 );
+    blas_error_if( n < 0 );
+    blas_error_if( k < 0 );
+
+    if ((transA == Op::NoTrans) ^ (layout == Layout::RowMajor))
+        blas_error_if( lda < m );
+    else
+        blas_error_if( lda < k );
+
+    if ((transB == Op::NoTrans) ^ (layout == Layout::RowMajor))
+        blas_error_if( ldb < k );
+    else
+        blas_error_if( ldb < n );
+
+    if (layout == Layout::ColMajor)
+        blas_error_if( ldc < m );
+    else
+        blas_error_if( ldc < n );
+
+    // quick return
+    if (m == 0 || n == 0)
+        return;
+
+    // row-major: compute C^T = op(B)^T op(A)^T in column-major
+    if (layout == Layout::RowMajor) {
+        std::swap( transA, transB );
+        std::swap( m, n );
+        std::swap( A, B );
+        std::swap( lda, ldb );
+    }
+
+    // small sizes, or only C scaled: standard gemm
+    if (std::min( std::min( m, n ), k ) < gemm3m_min || alpha == T( 0 )) {
+        blas::gemm( Layout::ColMajor, transA, transB, m, n, k,
+                    alpha, A, lda, B, ldb, beta, C, ldc );
+        return;
+    }
+
+    // split op(A) once
+    std::vector<real_t> Awork( 3*m*k );
+    real_t* Ar = &Awork[ 0 ];
+    real_t* Ai = Ar + m*k;
+    real_t* As = Ai + m*k;
+    gemm3m_split( transA, m, k, A, lda, Ar, Ai, As );
+
+    int64_t nb = std::min( n, gemm3m_nb );
+    std::vector<real_t> Bwork( 3*k*nb );
+    std::vector<real_t> Twork( 3*m*nb );
+    real_t* Br = &Bwork[ 0 ];
+    real_t* Bi = Br + k*nb;
+    real_t* Bs = Bi + k*nb;
+    real_t* T1 = &Twork[ 0 ];
+    real_t* T2 = T1 + m*nb;
+    real_t* T3 = T2 + m*nb;
+
+    for (int64_t j = 0; j < n; j += nb) {
+        int64_t jb = std::min( nb, n - j );
+        T const* Bj = B + (transB == Op::NoTrans ? j*ldb : j);
+        gemm3m_split( transB, k, jb, Bj, ldb, Br, Bi, Bs );
+
+        blas::gemm( Layout::ColMajor, Op::NoTrans, Op::NoTrans, m, jb, k,
+                    real_t( 1 ), Ar, m, Br, k, real_t( 0 ), T1, m );
+        blas::gemm( Layout::ColMajor, Op::NoTrans, Op::NoTrans, m, jb, k,
+                    real_t( 1 ), Ai, m, Bi, k, real_t( 0 ), T2, m );
+        blas::gemm( Layout::ColMajor, Op::NoTrans, Op::NoTrans, m, jb, k,
+                    real_t( 1 ), As, m, Bs, k, real_t( 0 ), T3, m );
+
+        // C = alpha ((T1 - T2) + i (T3 - T1 - T2)) + beta C;
+        // C is not read if beta = 0
+        T* Cj = C + j*ldc;
+        bool beta_zero = (beta == T( 0 ));
+        #pragma omp parallel for schedule(static)
+        for (int64_t jj = 0; jj < jb; ++jj) {
+            for (int64_t i = 0; i < m; ++i) {
+                int64_t ij = i + jj*m;
+                T p( T1[ ij ] - T2[ ij ], T3[ ij ] - T1[ ij ] - T2[ ij ] );
+                T& c = Cj[ i + jj*ldc ];
+                c = (beta_zero ? alpha*p : alpha*p + beta*c);
+            }
+        }
+    }
+}
+
+}  // namespace internal
+
+// =============================================================================
+// Overloaded wrappers for c, z precisions.
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm3m(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<float> alpha,
+    std::complex<float> const *A, int64_t lda,
+    std::complex<float> const *B, int64_t ldb,
+    std::complex<float> beta,
+    std::complex<float>       *C, int64_t ldc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm3m", 'c',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, k, Gflop< std::complex<float> >::gemm( m, n, k ) );
+
+    internal::gemm3m( layout, transA, transB, m, n, k,
+                      alpha, A, lda, B, ldb, beta, C, ldc );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm3m(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<double> alpha,
+    std::complex<double> const *A, int64_t lda,
+    std::complex<double> const *B, int64_t ldb,
+    std::complex<double> beta,
+    std::complex<double>       *C, int64_t ldc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm3m", 'z',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, k, Gflop< std::complex<double> >::gemm( m, n, k ) );
+
+    internal::gemm3m( layout, transA, transB, m, n, k,
+                      alpha, A, lda, B, ldb, beta, C, ldc );
+}
+
+}  // namespace blas
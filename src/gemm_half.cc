@@ -0,0 +1,428 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "blas/fortran.h"
+#include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
+
+#include <algorithm>
+#include <vector>
+
+namespace blas {
+namespace internal {
+
+// Register block of the micro-kernel, and cache blocks of the packed
+// panels: an mc-by-kc block of A and a kc-by-nc panel of B, both in float.
+// The float workspace for C is mw-by-nc. The kernel is written for the
+// compiler to vectorize; mr = 32, nr = 6 vectorizes well with both
+// AVX2 and AVX-512 in gcc, whereas some smaller blocks don't vectorize.
+// It is used only if the library is compiled for AVX2 or AVX-512;
+// otherwise, blocks are converted to float and multiplied by the vendor
+// sgemm, which is much faster than the kernel vectorized for SSE or not
+// at all.
+#if defined( __AVX2__ ) || defined( __AVX512F__ )
+    const bool gemm_half_use_kernel = true;
+#else
+    const bool gemm_half_use_kernel = false;
+#endif
+const int64_t gemm_half_mr = 32;
+const int64_t gemm_half_nr = 6;
+const int64_t gemm_half_mc = 128;
+const int64_t gemm_half_kc = 256;
+const int64_t gemm_half_nc = 512;
+const int64_t gemm_half_mw = 2048;
+
+//------------------------------------------------------------------------------
+/// Packs op(A)( i:i+mb, l:l+kb ), column-major A, into float panels of
+/// mr rows, each stored kb-by-mr, row-wise, padded with zeros.
+template <typename TA>
+void gemm_half_pack_A(
+    blas::Op transA, int64_t mb, int64_t kb,
+    TA const* A, int64_t lda, float* Ap )
+{
+    const int64_t mr = gemm_half_mr;
+    for (int64_t ir = 0; ir < mb; ir += mr) {
+        int64_t mr_ = std::min( mr, mb - ir );
+        float* panel = &Ap[ ir*kb ];
+        if (transA == Op::NoTrans) {
+            for (int64_t l = 0; l < kb; ++l) {
+                convert( mr_, &A[ ir + l*lda ], &panel[ l*mr ] );
+                for (int64_t i = mr_; i < mr; ++i)
+                    panel[ l*mr + i ] = 0;
+            }
+        }
+        else {
+            // real types, so ConjTrans is Trans
+            for (int64_t l = 0; l < kb; ++l) {
+                for (int64_t i = 0; i < mr_; ++i)
+                    panel[ l*mr + i ] = A[ l + (ir + i)*lda ];
+                for (int64_t i = mr_; i < mr; ++i)
+                    panel[ l*mr + i ] = 0;
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Packs op(B)( l:l+kb, j:j+nb ), column-major B, into float panels of
+/// nr columns, each stored kb-by-nr, row-wise, padded with zeros.
+/// For NoTrans, each column is converted with the bulk convert, then
+/// interleaved.
+template <typename TB>
+void gemm_half_pack_B(
+    blas::Op transB, int64_t kb, int64_t nb,
+    TB const* B, int64_t ldb, float* Bp )
+{
+    const int64_t nr = gemm_half_nr;
+    #pragma omp parallel
+    {
+        std::vector<float> col( kb );
+        #pragma omp for schedule(static)
+        for (int64_t jr = 0; jr < nb; jr += nr) {
+            int64_t nr_ = std::min( nr, nb - jr );
+            float* panel = &Bp[ jr*kb ];
+            for (int64_t j = 0; j < nr_; ++j) {
+                if (transB == Op::NoTrans) {
+                    convert( kb, &B[ (jr + j)*ldb ], col.data() );
+                    for (int64_t l = 0; l < kb; ++l)
+                        panel[ l*nr + j ] = col[ l ];
+                }
+                else {
+                    for (int64_t l = 0; l < kb; ++l)
+                        panel[ l*nr + j ] = B[ (jr + j) + l*ldb ];
+                }
+            }
+            for (int64_t j = nr_; j < nr; ++j) {
+                for (int64_t l = 0; l < kb; ++l)
+                    panel[ l*nr + j ] = 0;
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Converts the rows-by-cols column-major block X to float Xf,
+/// column-major with leading dimension rows.
+template <typename T>
+void gemm_half_convert(
+    int64_t rows, int64_t cols, T const* X, int64_t ldx, float* Xf )
+{
+    #pragma omp parallel for schedule(static)
+    for (int64_t j = 0; j < cols; ++j)
+        convert( rows, &X[ j*ldx ], &Xf[ j*rows ] );
+}
+
+//------------------------------------------------------------------------------
+/// Micro-kernel: W( 0:mr_, 0:nr_ ) += Ap * Bp, for one mr-row panel of A
+/// and one nr-column panel of B, accumulating in float.
+inline void gemm_half_kernel(
+    int64_t kb, float const* Ap, float const* Bp,
+    int64_t mr_, int64_t nr_, float* W, int64_t ldw )
+{
+    const int64_t mr = gemm_half_mr;
+    const int64_t nr = gemm_half_nr;
+    float acc[ nr ][ mr ] = {};
+    for (int64_t l = 0; l < kb; ++l) {
+        float const* a = &Ap[ l*mr ];
+        for (int64_t j = 0; j < nr; ++j) {
+            float b = Bp[ l*nr + j ];
+            for (int64_t i = 0; i < mr; ++i)
+                acc[ j ][ i ] += a[ i ] * b;
+        }
+    }
+    for (int64_t j = 0; j < nr_; ++j) {
+        for (int64_t i = 0; i < mr_; ++i)
+            W[ i + j*ldw ] += acc[ j ][ i ];
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Blocked gemm for half precision A, B: panels are converted to float
+/// while packing, and all products are accumulated in a float workspace,
+/// so C is rounded only once, when written back as alpha W + beta C.
+/// TC is the half type or float.
+template <typename T, typename TC>
+void gemm_half(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    float alpha,
+    T const *A, int64_t lda,
+    T const *B, int64_t ldb,
+    float beta,
+    TC *C, int64_t ldc )
+{
+    // check arguments
+    blas_error_if( layout != Layout::ColMajor &&
+                   layout != Layout::RowMajor );
+    blas_error_if( transA != Op::NoTrans &&
+                   transA != Op::Trans &&
+                   transA != Op::ConjTrans );
+    blas_error_if( transB != Op::NoTrans &&
+                   transB != Op::Trans &&
+                   transB != Op::ConjTrans );
+    blas_error_if( m < 0 );
+    blas_error_if( n < 0 );
+    blas_error_if( k < 0 );
+
+    if ((transA == Op::NoTrans) ^ (layout == Layout::RowMajor))
+        blas_error_if( lda < m );
+    else
+        blas_error_if( lda < k );
+
+    if ((transB == Op::NoTrans) ^ (layout == Layout::RowMajor))
+        blas_error_if( ldb < k );
+    else
+        blas_error_if( ldb < n );
+
+    if (layout == Layout::ColMajor)
+        blas_error_if( ldc < m );
+    else
+        blas_error_if( ldc < n );
+
+    // quick return
+    if (m == 0 || n == 0 || ((alpha == 0 || k == 0) && beta == 1))
+        return;
+
+    if (layout == Layout::RowMajor) {
+        // swap transA <=> transB, m <=> n, B <=> A
+        std::swap( transA, transB );
+        std::swap( m, n );
+        std::swap( A, B );
+        std::swap( lda, ldb );
+    }
+
+    // form C = beta*C
+    if (alpha == 0 || k == 0) {
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t i = 0; i < m; ++i) {
+                C[ i + j*ldc ] = (beta == 0 ? 0.0f : beta * C[ i + j*ldc ]);
+            }
+        }
+        return;
+    }
+
+    const int64_t mc = gemm_half_mc;
+    const int64_t kc = gemm_half_kc;
+    const int64_t nc = gemm_half_nc;
+    const int64_t mw = std::min( gemm_half_mw, m );
+
+    // packed panels are padded to multiples of mr, nr
+    int64_t mc_max = (mc + gemm_half_mr - 1) / gemm_half_mr * gemm_half_mr;
+
+    std::vector<float> W( mw * std::min( nc, n ) );
+    int64_t nb_max = std::min( nc, n );
+    nb_max = (nb_max + gemm_half_nr - 1) / gemm_half_nr * gemm_half_nr;
+    std::vector<float> Bp( kc * nb_max );
+
+    // without the kernel: op(A), op(B) blocks stored as A, B are, in float;
+    // real types, so ConjTrans is Trans
+    char transA_ = (transA == Op::NoTrans ? 'n' : 't');
+    char transB_ = (transB == Op::NoTrans ? 'n' : 't');
+    std::vector<float> Af;
+    if (! gemm_half_use_kernel)
+        Af.resize( mw * std::min( kc, k ) );
+
+    for (int64_t ib = 0; ib < m; ib += mw) {
+        int64_t mb = std::min( mw, m - ib );
+        for (int64_t jc = 0; jc < n; jc += nc) {
+            int64_t nb = std::min( nc, n - jc );
+            std::fill( W.begin(), W.end(), 0.0f );
+
+            for (int64_t pc = 0; pc < k; pc += kc) {
+                int64_t kb = std::min( kc, k - pc );
+                if (! gemm_half_use_kernel) {
+                    // W += op(Af) op(Bf) by the threaded vendor sgemm
+                    int64_t ldaf, ldbf;
+                    if (transA == Op::NoTrans) {
+                        gemm_half_convert( mb, kb, &A[ ib + pc*lda ], lda,
+                                           Af.data() );
+                        ldaf = mb;
+                    }
+                    else {
+                        gemm_half_convert( kb, mb, &A[ pc + ib*lda ], lda,
+                                           Af.data() );
+                        ldaf = kb;
+                    }
+                    if (transB == Op::NoTrans) {
+                        gemm_half_convert( kb, nb, &B[ pc + jc*ldb ], ldb,
+                                           Bp.data() );
+                        ldbf = kb;
+                    }
+                    else {
+                        gemm_half_convert( nb, kb, &B[ jc + pc*ldb ], ldb,
+                                           Bp.data() );
+                        ldbf = nb;
+                    }
+                    blas_int mb_   = (blas_int) mb;
+                    blas_int nb_   = (blas_int) nb;
+                    blas_int kb_   = (blas_int) kb;
+                    blas_int ldaf_ = (blas_int) ldaf;
+                    blas_int ldbf_ = (blas_int) ldbf;
+                    blas_int ldw_  = (blas_int) mw;
+                    float one = 1;
+                    BLAS_sgemm( &transA_, &transB_, &mb_, &nb_, &kb_,
+                                &one, Af.data(), &ldaf_, Bp.data(), &ldbf_,
+                                &one, W.data(), &ldw_ );
+                    continue;
+                }
+
+                if (transB == Op::NoTrans)
+                    gemm_half_pack_B( transB, kb, nb, &B[ pc + jc*ldb ], ldb,
+                                      Bp.data() );
+                else
+                    gemm_half_pack_B( transB, kb, nb, &B[ jc + pc*ldb ], ldb,
+                                      Bp.data() );
+
+                #pragma omp parallel
+                {
+                    std::vector<float> Ap( mc_max * kc );
+                    #pragma omp for schedule(dynamic)
+                    for (int64_t ic = 0; ic < mb; ic += mc) {
+                        int64_t mcb = std::min( mc, mb - ic );
+                        int64_t i = ib + ic;
+                        if (transA == Op::NoTrans)
+                            gemm_half_pack_A( transA, mcb, kb,
+                                              &A[ i + pc*lda ], lda,
+                                              Ap.data() );
+                        else
+                            gemm_half_pack_A( transA, mcb, kb,
+                                              &A[ pc + i*lda ], lda,
+                                              Ap.data() );
+
+                        for (int64_t jr = 0; jr < nb; jr += gemm_half_nr) {
+                            int64_t nr_ = std::min( gemm_half_nr, nb - jr );
+                            for (int64_t ir = 0; ir < mcb;
+                                 ir += gemm_half_mr)
+                            {
+                                int64_t mr_ = std::min( gemm_half_mr,
+                                                        mcb - ir );
+                                gemm_half_kernel(
+                                    kb, &Ap[ ir*kb ], &Bp[ jr*kb ],
+                                    mr_, nr_, &W[ (ic + ir) + jr*mw ], mw );
+                            }
+                        }
+                    }
+                }
+            }
+
+            // C = alpha W + beta C; the only rounding to TC
+            for (int64_t j = 0; j < nb; ++j) {
+                TC* Cj = &C[ ib + (jc + j)*ldc ];
+                float const* Wj = &W[ j*mw ];
+                if (beta == 0) {
+                    for (int64_t i = 0; i < mb; ++i)
+                        Cj[ i ] = alpha * Wj[ i ];
+                }
+                else {
+                    for (int64_t i = 0; i < mb; ++i)
+                        Cj[ i ] = alpha * Wj[ i ] + beta * float( Cj[ i ] );
+                }
+            }
+        }
+    }
+}
+
+}  // namespace internal
+
+// =============================================================================
+// Overloaded wrappers for half precision, float16 and bfloat16.
+// A and B are half; C is half or float. Products are accumulated in float.
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    float alpha,
+    float16 const *A, int64_t lda,
+    float16 const *B, int64_t ldb,
+    float beta,
+    float16 *C, int64_t ldc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm", 'h',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, k, Gflop< float16 >::gemm( m, n, k ) );
+
+    internal::gemm_half( layout, transA, transB, m, n, k,
+                         alpha, A, lda, B, ldb, beta, C, ldc );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    float alpha,
+    float16 const *A, int64_t lda,
+    float16 const *B, int64_t ldb,
+    float beta,
+    float *C, int64_t ldc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm", 'h',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, k, Gflop< float16 >::gemm( m, n, k ) );
+
+    internal::gemm_half( layout, transA, transB, m, n, k,
+                         alpha, A, lda, B, ldb, beta, C, ldc );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    float alpha,
+    bfloat16 const *A, int64_t lda,
+    bfloat16 const *B, int64_t ldb,
+    float beta,
+    bfloat16 *C, int64_t ldc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm", 'b',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, k, Gflop< bfloat16 >::gemm( m, n, k ) );
+
+    internal::gemm_half( layout, transA, transB, m, n, k,
+                         alpha, A, lda, B, ldb, beta, C, ldc );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    float alpha,
+    bfloat16 const *A, int64_t lda,
+    bfloat16 const *B, int64_t ldb,
+    float beta,
+    float *C, int64_t ldc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm", 'b',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, k, Gflop< bfloat16 >::gemm( m, n, k ) );
+
+    internal::gemm_half( layout, transA, transB, m, n, k,
+                         alpha, A, lda, B, ldb, beta, C, ldc );
+}
+
+}  // namespace blas
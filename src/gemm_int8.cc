@@ -0,0 +1,496 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// VNNI kernels are compiled with target attributes, independent of the
+// flags the library is built with, and chosen at runtime by the CPU.
+// AVX-VNNI needs gcc 11 or clang 12.
+#if (defined( __x86_64__ ) || defined( __i386__ )) \
+    && ((defined( __clang__ ) && __clang_major__ >= 12) \
+        || (! defined( __clang__ ) && defined( __GNUC__ ) && __GNUC__ >= 11))
+    #define BLAS_GEMM_INT8_VNNI
+    #include <immintrin.h>
+#endif
+
+namespace blas {
+namespace internal {
+
+// Register block of the micro-kernel, and cache blocks of the packed
+// panels: an mc-by-kc block of A and a kc-by-nc panel of B, both in 8-bit.
+// The int32 workspace for C is mw-by-nc. Packed panels store k in groups
+// of 4 consecutive entries, the operand layout of the VNNI dot product
+// instructions: one 32-bit lane holds op(A)( i, 4p:4p+4 ).
+const int64_t gemm_int8_mr = 32;
+const int64_t gemm_int8_nr = 8;
+const int64_t gemm_int8_mc = 128;
+const int64_t gemm_int8_kc = 512;
+const int64_t gemm_int8_nc = 512;
+const int64_t gemm_int8_mw = 2048;
+
+//------------------------------------------------------------------------------
+/// VNNI instructions multiply unsigned by signed bytes, so signed A is
+/// packed offset by 128, and 128 sum_l B( l, j ) is subtracted afterwards.
+inline uint8_t gemm_int8_offset( int8_t a )
+    { return uint8_t( a ) ^ 0x80; }
+
+inline uint8_t gemm_int8_offset( uint8_t a )
+    { return a; }
+
+template <typename TA>
+struct gemm_int8_shift
+{
+    static constexpr int32_t value = std::is_signed<TA>::value ? 128 : 0;
+};
+
+//------------------------------------------------------------------------------
+/// Packs op(A)( i:i+mb, l:l+kb ) into uint8 panels of mr rows, each
+/// stored as ceil(kb/4) groups of mr-by-4, padded with zeros.
+/// If a_col, op(A)( i, l ) is A[ i + l*lda ], else A[ l + i*lda ].
+template <typename TA>
+void gemm_int8_pack_A(
+    bool a_col, int64_t mb, int64_t kb,
+    TA const* A, int64_t lda, uint8_t* Ap )
+{
+    const int64_t mr = gemm_int8_mr;
+    int64_t kq = (kb + 3) / 4;
+    for (int64_t ir = 0; ir < mb; ir += mr) {
+        int64_t mr_ = std::min( mr, mb - ir );
+        uint8_t* panel = &Ap[ ir*kq*4 ];
+        std::memset( panel, 0, mr*kq*4 );
+        for (int64_t l = 0; l < kb; ++l) {
+            uint8_t* p = &panel[ (l/4)*mr*4 + l%4 ];
+            if (a_col) {
+                for (int64_t i = 0; i < mr_; ++i)
+                    p[ i*4 ] = gemm_int8_offset( A[ (ir + i) + l*lda ] );
+            }
+            else {
+                for (int64_t i = 0; i < mr_; ++i)
+                    p[ i*4 ] = gemm_int8_offset( A[ l + (ir + i)*lda ] );
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Packs op(B)( l:l+kb, j:j+nb ) into int8 panels of nr columns, each
+/// stored as ceil(kb/4) groups of nr-by-4, padded with zeros.
+/// Also sets column sums, sums[ j ] = sum_l op(B)( l, j ).
+/// If b_col, op(B)( l, j ) is B[ l + j*ldb ], else B[ j + l*ldb ].
+inline void gemm_int8_pack_B(
+    bool b_col, int64_t kb, int64_t nb,
+    int8_t const* B, int64_t ldb, int8_t* Bp, int32_t* sums )
+{
+    const int64_t nr = gemm_int8_nr;
+    int64_t kq = (kb + 3) / 4;
+    #pragma omp parallel for schedule(static)
+    for (int64_t jr = 0; jr < nb; jr += nr) {
+        int64_t nr_ = std::min( nr, nb - jr );
+        int8_t* panel = &Bp[ jr*kq*4 ];
+        std::memset( panel, 0, nr*kq*4 );
+        for (int64_t j = 0; j < nr; ++j) {
+            int32_t sum = 0;
+            if (j < nr_) {
+                for (int64_t l = 0; l < kb; ++l) {
+                    int8_t b = b_col ? B[ l + (jr + j)*ldb ]
+                                     : B[ (jr + j) + l*ldb ];
+                    panel[ (l/4)*nr*4 + j*4 + l%4 ] = b;
+                    sum += b;
+                }
+            }
+            sums[ jr + j ] = sum;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Sets acc( i, j ) = sum_p Ap( i, 4p:4p+4 ) . Bp( 4p:4p+4, j ), for one
+/// mr-row panel of A and one nr-column panel of B, with kq groups of 4.
+/// Plain loops over the packed layout, for CPUs without VNNI.
+typedef void (*gemm_int8_dot_t)(
+    int64_t kq, uint8_t const* Ap, int8_t const* Bp, int32_t* acc );
+
+inline void gemm_int8_dot(
+    int64_t kq, uint8_t const* Ap, int8_t const* Bp, int32_t* acc )
+{
+    const int64_t mr = gemm_int8_mr;
+    const int64_t nr = gemm_int8_nr;
+    std::memset( acc, 0, mr*nr*sizeof(int32_t) );
+    for (int64_t p = 0; p < kq; ++p) {
+        uint8_t const* a = &Ap[ p*mr*4 ];
+        for (int64_t j = 0; j < nr; ++j) {
+            int8_t const* b = &Bp[ p*nr*4 + j*4 ];
+            int32_t b0 = b[ 0 ], b1 = b[ 1 ], b2 = b[ 2 ], b3 = b[ 3 ];
+            for (int64_t i = 0; i < mr; ++i) {
+                acc[ i + j*mr ] += a[ i*4     ] * b0 + a[ i*4 + 1 ] * b1
+                                 + a[ i*4 + 2 ] * b2 + a[ i*4 + 3 ] * b3;
+            }
+        }
+    }
+}
+
+#ifdef BLAS_GEMM_INT8_VNNI
+//------------------------------------------------------------------------------
+/// gemm_int8_dot with AVX-512 VNNI: each column of acc is 2 vectors.
+__attribute__(( target( "avx512f,avx512bw,avx512vnni" ) ))
+void gemm_int8_dot_avx512vnni(
+    int64_t kq, uint8_t const* Ap, int8_t const* Bp, int32_t* acc )
+{
+    const int64_t mr = gemm_int8_mr;
+    const int64_t nr = gemm_int8_nr;
+    __m512i c[ nr ][ 2 ];
+    for (int64_t j = 0; j < nr; ++j) {
+        c[ j ][ 0 ] = _mm512_setzero_si512();
+        c[ j ][ 1 ] = _mm512_setzero_si512();
+    }
+    for (int64_t p = 0; p < kq; ++p) {
+        __m512i a0 = _mm512_loadu_si512( &Ap[ p*mr*4      ] );
+        __m512i a1 = _mm512_loadu_si512( &Ap[ p*mr*4 + 64 ] );
+        for (int64_t j = 0; j < nr; ++j) {
+            int32_t bj;
+            std::memcpy( &bj, &Bp[ p*nr*4 + j*4 ], sizeof(bj) );
+            __m512i b = _mm512_set1_epi32( bj );
+            c[ j ][ 0 ] = _mm512_dpbusd_epi32( c[ j ][ 0 ], a0, b );
+            c[ j ][ 1 ] = _mm512_dpbusd_epi32( c[ j ][ 1 ], a1, b );
+        }
+    }
+    for (int64_t j = 0; j < nr; ++j) {
+        _mm512_storeu_si512( &acc[ j*mr      ], c[ j ][ 0 ] );
+        _mm512_storeu_si512( &acc[ j*mr + 16 ], c[ j ][ 1 ] );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// gemm_int8_dot with AVX-VNNI: each column of acc is 4 vectors.
+__attribute__(( target( "avx2,avxvnni" ) ))
+void gemm_int8_dot_avxvnni(
+    int64_t kq, uint8_t const* Ap, int8_t const* Bp, int32_t* acc )
+{
+    const int64_t mr = gemm_int8_mr;
+    const int64_t nr = gemm_int8_nr;
+    __m256i c[ nr ][ 4 ];
+    for (int64_t j = 0; j < nr; ++j) {
+        for (int h = 0; h < 4; ++h)
+            c[ j ][ h ] = _mm256_setzero_si256();
+    }
+    for (int64_t p = 0; p < kq; ++p) {
+        __m256i a[ 4 ];
+        for (int h = 0; h < 4; ++h)
+            a[ h ] = _mm256_loadu_si256(
+                (__m256i const*) &Ap[ p*mr*4 + h*32 ] );
+        for (int64_t j = 0; j < nr; ++j) {
+            int32_t bj;
+            std::memcpy( &bj, &Bp[ p*nr*4 + j*4 ], sizeof(bj) );
+            __m256i b = _mm256_set1_epi32( bj );
+            for (int h = 0; h < 4; ++h)
+                c[ j ][ h ] = _mm256_dpbusd_avx_epi32( c[ j ][ h ], a[ h ], b );
+        }
+    }
+    for (int64_t j = 0; j < nr; ++j) {
+        for (int h = 0; h < 4; ++h)
+            _mm256_storeu_si256( (__m256i*) &acc[ j*mr + h*8 ], c[ j ][ h ] );
+    }
+}
+#endif
+
+//------------------------------------------------------------------------------
+/// @return the widest gemm_int8_dot the CPU supports.
+inline gemm_int8_dot_t gemm_int8_select_dot()
+{
+    #ifdef BLAS_GEMM_INT8_VNNI
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports( "avx512vnni" ))
+            return gemm_int8_dot_avx512vnni;
+        if (__builtin_cpu_supports( "avxvnni" ))
+            return gemm_int8_dot_avxvnni;
+    #endif
+    return gemm_int8_dot;
+}
+
+//------------------------------------------------------------------------------
+/// Micro-kernel: W( 0:mr_, 0:nr_ ) += Ap * Bp - shift * sums, for one
+/// mr-row panel of A and one nr-column panel of B, accumulating in int32.
+inline void gemm_int8_kernel(
+    gemm_int8_dot_t dot,
+    int64_t kq, uint8_t const* Ap, int8_t const* Bp,
+    int32_t const* sums, int32_t shift,
+    int64_t mr_, int64_t nr_, int32_t* W, int64_t ldw )
+{
+    const int64_t mr = gemm_int8_mr;
+    const int64_t nr = gemm_int8_nr;
+    alignas(64) int32_t acc[ nr*mr ];
+    dot( kq, Ap, Bp, acc );
+
+    for (int64_t j = 0; j < nr_; ++j) {
+        int32_t corr = shift * sums[ j ];
+        for (int64_t i = 0; i < mr_; ++i)
+            W[ i + j*ldw ] += acc[ i + j*mr ] - corr;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// C( i, j ) = alpha W( i, j ) + beta C( i, j ), in int32, wrapping on
+/// overflow. Scales must be null.
+inline void gemm_int8_update(
+    int32_t w, int32_t alpha, int32_t beta, int32_t& c, float )
+{
+    int64_t r = int64_t( alpha ) * w;
+    if (beta != 0)
+        r += int64_t( beta ) * c;
+    c = int32_t( uint32_t( r ) );
+}
+
+/// C( i, j ) = scale alpha W( i, j ) + beta C( i, j ), in float,
+/// where scale = row_scale[ i ] col_scale[ j ].
+inline void gemm_int8_update(
+    int32_t w, float alpha, float beta, float& c, float scale )
+{
+    float r = scale * alpha * float( w );
+    c = (beta == 0 ? r : r + beta * c);
+}
+
+//------------------------------------------------------------------------------
+/// Blocked gemm for 8-bit integer A, B: products are accumulated exactly
+/// in an int32 workspace, then C = alpha W + beta C is applied once per
+/// entry, with the dequantization scales in the float case.
+/// TA is int8_t or uint8_t; TS and TC are both int32_t or both float.
+template <typename TA, typename TS, typename TC>
+void gemm_int8(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    TS alpha,
+    TA const *A, int64_t lda,
+    int8_t const *B, int64_t ldb,
+    TS beta,
+    TC *C, int64_t ldc,
+    float const* row_scale,
+    float const* col_scale )
+{
+    // check arguments
+    blas_error_if( layout != Layout::ColMajor &&
+                   layout != Layout::RowMajor );
+    blas_error_if( transA != Op::NoTrans &&
+                   transA != Op::Trans &&
+                   transA != Op::ConjTrans );
+    blas_error_if( transB != Op::NoTrans &&
+                   transB != Op::Trans &&
+                   transB != Op::ConjTrans );
+    blas_error_if( m < 0 );
+    blas_error_if( n < 0 );
+    blas_error_if( k < 0 );
+
+    if ((transA == Op::NoTrans) ^ (layout == Layout::RowMajor))
+        blas_error_if( lda < m );
+    else
+        blas_error_if( lda < k );
+
+    if ((transB == Op::NoTrans) ^ (layout == Layout::RowMajor))
+        blas_error_if( ldb < k );
+    else
+        blas_error_if( ldb < n );
+
+    if (layout == Layout::ColMajor)
+        blas_error_if( ldc < m );
+    else
+        blas_error_if( ldc < n );
+
+    // quick return
+    if (m == 0 || n == 0)
+        return;
+
+    // Rather than swapping A and B for RowMajor, which would put the
+    // unsigned operand on the right, read A, B, C transposed.
+    bool a_col = (transA == Op::NoTrans) ^ (layout == Layout::RowMajor);
+    bool b_col = (transB == Op::NoTrans) ^ (layout == Layout::RowMajor);
+    int64_t ci = 1, cj = ldc;
+    if (layout == Layout::RowMajor)
+        std::swap( ci, cj );
+
+    const int64_t mr = gemm_int8_mr;
+    const int64_t nr = gemm_int8_nr;
+    const int64_t mc = gemm_int8_mc;
+    const int64_t kc = gemm_int8_kc;
+    const int64_t nc = gemm_int8_nc;
+    const int64_t mw = std::min( gemm_int8_mw, m );
+    const int32_t shift = gemm_int8_shift<TA>::value;
+    static const gemm_int8_dot_t dot = gemm_int8_select_dot();
+
+    // packed panels are padded to multiples of mr, nr, and 4
+    int64_t mc_max = (mc + mr - 1) / mr * mr;
+    int64_t nb_max = (std::min( nc, n ) + nr - 1) / nr * nr;
+
+    std::vector<int32_t> W( mw * std::min( nc, n ) );
+    std::vector<int8_t>  Bp( kc * nb_max );
+    std::vector<int32_t> sums( nb_max );
+
+    for (int64_t ib = 0; ib < m; ib += mw) {
+        int64_t mb = std::min( mw, m - ib );
+        for (int64_t jc = 0; jc < n; jc += nc) {
+            int64_t nb = std::min( nc, n - jc );
+            std::fill( W.begin(), W.end(), 0 );
+
+            for (int64_t pc = 0; pc < k; pc += kc) {
+                int64_t kb = std::min( kc, k - pc );
+                int64_t kq = (kb + 3) / 4;
+                gemm_int8_pack_B( b_col, kb, nb,
+                                  b_col ? &B[ pc + jc*ldb ] : &B[ jc + pc*ldb ],
+                                  ldb, Bp.data(), sums.data() );
+
+                #pragma omp parallel
+                {
+                    std::vector<uint8_t> Ap( mc_max * kc );
+                    #pragma omp for schedule(dynamic)
+                    for (int64_t ic = 0; ic < mb; ic += mc) {
+                        int64_t mcb = std::min( mc, mb - ic );
+                        int64_t i = ib + ic;
+                        gemm_int8_pack_A( a_col, mcb, kb,
+                                          a_col ? &A[ i + pc*lda ]
+                                                : &A[ pc + i*lda ],
+                                          lda, Ap.data() );
+
+                        for (int64_t jr = 0; jr < nb; jr += nr) {
+                            int64_t nr_ = std::min( nr, nb - jr );
+                            for (int64_t ir = 0; ir < mcb; ir += mr) {
+                                int64_t mr_ = std::min( mr, mcb - ir );
+                                gemm_int8_kernel(
+                                    dot, kq, &Ap[ ir*kq*4 ], &Bp[ jr*kq*4 ],
+                                    &sums[ jr ], shift,
+                                    mr_, nr_, &W[ (ic + ir) + jr*mw ], mw );
+                            }
+                        }
+                    }
+                }
+            }
+
+            // C = alpha W + beta C, with scales
+            for (int64_t j = 0; j < nb; ++j) {
+                float sj = (col_scale ? col_scale[ jc + j ] : 1.0f);
+                for (int64_t i = 0; i < mb; ++i) {
+                    float s = (row_scale ? row_scale[ ib + i ] * sj : sj);
+                    gemm_int8_update( W[ i + j*mw ], alpha, beta,
+                                      C[ (ib + i)*ci + (jc + j)*cj ], s );
+                }
+            }
+        }
+    }
+}
+
+}  // namespace internal
+
+// =============================================================================
+// Overloaded wrappers for 8-bit integers: A is int8 or uint8; B is int8.
+// Products are accumulated in int32. C is int32, or float, dequantized
+// with optional per-row and per-column scales.
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    int32_t alpha,
+    int8_t const *A, int64_t lda,
+    int8_t const *B, int64_t ldb,
+    int32_t beta,
+    int32_t *C, int64_t ldc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm", 'i',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, k, Gflop< int8_t >::gemm( m, n, k ) );
+
+    internal::gemm_int8( layout, transA, transB, m, n, k,
+                         alpha, A, lda, B, ldb, beta, C, ldc,
+                         nullptr, nullptr );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    int32_t alpha,
+    uint8_t const *A, int64_t lda,
+    int8_t  const *B, int64_t ldb,
+    int32_t beta,
+    int32_t *C, int64_t ldc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm", 'u',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, k, Gflop< int8_t >::gemm( m, n, k ) );
+
+    internal::gemm_int8( layout, transA, transB, m, n, k,
+                         alpha, A, lda, B, ldb, beta, C, ldc,
+                         nullptr, nullptr );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    float alpha,
+    int8_t const *A, int64_t lda,
+    int8_t const *B, int64_t ldb,
+    float beta,
+    float *C, int64_t ldc,
+    float const *row_scale,
+    float const *col_scale )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm", 'i',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, k, Gflop< int8_t >::gemm( m, n, k ) );
+
+    internal::gemm_int8( layout, transA, transB, m, n, k,
+                         alpha, A, lda, B, ldb, beta, C, ldc,
+                         row_scale, col_scale );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    float alpha,
+    uint8_t const *A, int64_t lda,
+    int8_t  const *B, int64_t ldb,
+    float beta,
+    float *C, int64_t ldc,
+    float const *row_scale,
+    float const *col_scale )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm", 'u',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, k, Gflop< int8_t >::gemm( m, n, k ) );
+
+    internal::gemm_int8( layout, transA, transB, m, n, k,
+                         alpha, A, lda, B, ldb, beta, C, ldc,
+                         row_scale, col_scale );
+}
+
+}  // namespace blas
@@ -0,0 +1,323 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <future>
+#include <vector>
+
+#include <unistd.h>
+
+namespace blas {
+namespace internal {
+
+// Number of tile buffers: two each of A, B, and C, to read ahead.
+const int64_t gemm_ooc_buffers = 6;
+
+//------------------------------------------------------------------------------
+/// Reads or writes (write = true) the rows-by-cols tile starting at
+/// (i, j) of the column-major matrix X in a file, to or from the
+/// column-major buffer tile with leading dimension rows.
+template <typename T>
+void gemm_ooc_io(
+    bool write, FileMatrix<T> const& X,
+    int64_t i, int64_t j, int64_t rows, int64_t cols, T* tile )
+{
+    // whole columns are contiguous in the file, so transfer at once
+    int64_t chunk = rows;
+    int64_t nchunks = cols;
+    if (rows == X.ld()) {
+        chunk = rows * cols;
+        nchunks = 1;
+    }
+    for (int64_t c = 0; c < nchunks; ++c) {
+        char* buf = reinterpret_cast<char*>( tile + c*rows );
+        size_t bytes = chunk * sizeof(T);
+        off_t offset = X.offset() + ((j + c)*X.ld() + i) * sizeof(T);
+        while (bytes > 0) {
+            ssize_t done = write ? pwrite( X.fd(), buf, bytes, offset )
+                                 : pread(  X.fd(), buf, bytes, offset );
+            if (done < 0 && errno == EINTR)
+                continue;
+            blas_error_if_msg( done <= 0, "cannot %s matrix file: %s",
+                               write ? "write" : "read",
+                               done < 0 ? strerror( errno ) : "end of file" );
+            buf    += done;
+            bytes  -= done;
+            offset += done;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Out-of-core gemm. C is computed one nb-by-nb tile at a time, as a sum of
+/// products of nb-by-nb tiles of op(A) and op(B). Each step reads its tiles
+/// into one of two sets of buffers while the previous step's tiles are
+/// multiplied by blas::gemm, and each finished C tile is written back
+/// while the next is computed.
+template <typename T>
+void gemm_ooc(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    T alpha,
+    FileMatrix<T> const& A_,
+    FileMatrix<T> const& B_,
+    T beta,
+    FileMatrix<T> const& C,
+    size_t memory )
+{
+    FileMatrix<T> A = A_;
+    FileMatrix<T> B = B_;
+
+    // check arguments
+    blas_error_if( layout != Layout::ColMajor &&
+                   layout != Layout::RowMajor );
+    blas_error_if( transA != Op::NoTrans &&
+                   transA != Op::Trans &&
+                   transA != Op::ConjTrans );
+    blas_error_if( transB != Op::NoTrans &&
+                   transB != Op::Trans &&
+                   transB != Op::ConjTrans );
+    blas_error_if( m < 0 );
+    blas_error_if( n < 0 );
+    blas_error_if( k < 0 );
+
+    if ((transA == Op::NoTrans) ^ (layout == Layout::RowMajor))
+        blas_error_if( A.ld() < m );
+    else
+        blas_error_if( A.ld() < k );
+
+    if ((transB == Op::NoTrans) ^ (layout == Layout::RowMajor))
+        blas_error_if( B.ld() < k );
+    else
+        blas_error_if( B.ld() < n );
+
+    if (layout == Layout::ColMajor)
+        blas_error_if( C.ld() < m );
+    else
+        blas_error_if( C.ld() < n );
+
+    blas_error_if( A.offset() < 0 || B.offset() < 0 || C.offset() < 0 );
+
+    // largest square tile whose buffers fit in memory
+    int64_t nb = int64_t( std::sqrt( double( memory )
+                                     / (gemm_ooc_buffers * sizeof(T)) ) );
+    blas_error_if_msg( nb < 1, "memory %lld too small",
+                       (long long) memory );
+
+    // quick return
+    if (m == 0 || n == 0)
+        return;
+
+    // row-major: compute C^T = op(B)^T op(A)^T in column-major
+    if (layout == Layout::RowMajor) {
+        std::swap( transA, transB );
+        std::swap( m, n );
+        std::swap( A, B );
+    }
+
+    // only C is scaled if alpha = 0 or k = 0
+    int64_t mt = (m + nb - 1) / nb;
+    int64_t nt = (n + nb - 1) / nb;
+    int64_t kt = (alpha == T( 0 ) ? 0 : (k + nb - 1) / nb);
+    int64_t steps_per_tile = std::max( kt, int64_t( 1 ) );
+    int64_t nsteps = mt * nt * steps_per_tile;
+
+    int64_t mb = std::min( m, nb );
+    int64_t nb_ = std::min( n, nb );
+    int64_t kb = std::min( k, nb );
+    std::vector<T> Abuf[ 2 ], Bbuf[ 2 ], Cbuf[ 2 ];
+    for (int b = 0; b < 2; ++b) {
+        Abuf[ b ].resize( kt > 0 ? mb*kb : 0 );
+        Bbuf[ b ].resize( kt > 0 ? kb*nb_ : 0 );
+        Cbuf[ b ].resize( mb*nb_ );
+    }
+
+    // step s computes C( i, j ) += op(A)( i, l ) op(B)( l, j ) into
+    // C buffer t % 2, where t is C tile i + j*mt, with A, B buffers s % 2.
+    struct Step {
+        int64_t i, j, l, t;
+        int64_t ib, jb, lb;
+    };
+    auto step = [&]( int64_t s ) {
+        Step st;
+        st.t  = s / steps_per_tile;
+        st.l  = s % steps_per_tile;
+        st.i  = st.t % mt;
+        st.j  = st.t / mt;
+        st.ib = std::min( nb, m - st.i*nb );
+        st.jb = std::min( nb, n - st.j*nb );
+        st.lb = (kt > 0 ? std::min( nb, k - st.l*nb ) : 0);
+        return st;
+    };
+
+    // reads tiles of op(A), op(B), and, at the first step of a C tile, C
+    auto fetch = [&]( int64_t s ) {
+        Step st = step( s );
+        int b = s % 2;
+        if (st.lb > 0) {
+            if (transA == Op::NoTrans)
+                gemm_ooc_io( false, A, st.i*nb, st.l*nb, st.ib, st.lb,
+                             Abuf[ b ].data() );
+            else
+                gemm_ooc_io( false, A, st.l*nb, st.i*nb, st.lb, st.ib,
+                             Abuf[ b ].data() );
+            if (transB == Op::NoTrans)
+                gemm_ooc_io( false, B, st.l*nb, st.j*nb, st.lb, st.jb,
+                             Bbuf[ b ].data() );
+            else
+                gemm_ooc_io( false, B, st.j*nb, st.l*nb, st.jb, st.lb,
+                             Bbuf[ b ].data() );
+        }
+        if (st.l == 0 && beta != T( 0 ))
+            gemm_ooc_io( false, C, st.i*nb, st.j*nb, st.ib, st.jb,
+                         Cbuf[ st.t % 2 ].data() );
+    };
+
+    std::future<void> reads[ 2 ], writes[ 2 ];
+    reads[ 0 ] = std::async( std::launch::async, fetch, 0 );
+    for (int64_t s = 0; s < nsteps; ++s) {
+        Step st = step( s );
+        reads[ s % 2 ].get();
+
+        // read ahead, once the C buffer the next step reads is written
+        if (s + 1 < nsteps) {
+            Step next = step( s + 1 );
+            if (next.l == 0 && writes[ next.t % 2 ].valid())
+                writes[ next.t % 2 ].get();
+            reads[ (s + 1) % 2 ] = std::async( std::launch::async, fetch, s + 1 );
+        }
+
+        T* Ct = Cbuf[ st.t % 2 ].data();
+        T beta_ = (st.l == 0 ? beta : T( 1 ));
+        int64_t lda = (transA == Op::NoTrans ? st.ib : st.lb);
+        int64_t ldb = (transB == Op::NoTrans ? st.lb : st.jb);
+        blas::gemm( Layout::ColMajor, transA, transB, st.ib, st.jb, st.lb,
+                    alpha, Abuf[ s % 2 ].data(), std::max( lda, int64_t( 1 ) ),
+                           Bbuf[ s % 2 ].data(), std::max( ldb, int64_t( 1 ) ),
+                    beta_, Ct, st.ib );
+
+        if (st.l == steps_per_tile - 1) {
+            writes[ st.t % 2 ] = std::async(
+                std::launch::async, gemm_ooc_io<T>, true, std::cref( C ),
+                st.i*nb, st.j*nb, st.ib, st.jb, Ct );
+        }
+    }
+    for (int b = 0; b < 2; ++b) {
+        if (writes[ b ].valid())
+            writes[ b ].get();
+    }
+}
+
+}  // namespace internal
+
+// =============================================================================
+// Overloaded wrappers for s, d, c, z precisions.
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    float alpha,
+    FileMatrix<float> const& A,
+    FileMatrix<float> const& B,
+    float beta,
+    FileMatrix<float> const& C,
+    size_t memory )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm_ooc", 's',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, k, Gflop<float>::gemm( m, n, k ) );
+
+    internal::gemm_ooc( layout, transA, transB, m, n, k,
+                        alpha, A, B, beta, C, memory );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    double alpha,
+    FileMatrix<double> const& A,
+    FileMatrix<double> const& B,
+    double beta,
+    FileMatrix<double> const& C,
+    size_t memory )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm_ooc", 'd',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, k, Gflop<double>::gemm( m, n, k ) );
+
+    internal::gemm_ooc( layout, transA, transB, m, n, k,
+                        alpha, A, B, beta, C, memory );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<float> alpha,
+    FileMatrix< std::complex<float> > const& A,
+    FileMatrix< std::complex<float> > const& B,
+    std::complex<float> beta,
+    FileMatrix< std::complex<float> > const& C,
+    size_t memory )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm_ooc", 'c',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, k, Gflop< std::complex<float> >::gemm( m, n, k ) );
+
+    internal::gemm_ooc( layout, transA, transB, m, n, k,
+                        alpha, A, B, beta, C, memory );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<double> alpha,
+    FileMatrix< std::complex<double> > const& A,
+    FileMatrix< std::complex<double> > const& B,
+    std::complex<double> beta,
+    FileMatrix< std::complex<double> > const& C,
+    size_t memory )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm_ooc", 'z',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, k, Gflop< std::complex<double> >::gemm( m, n, k ) );
+
+    internal::gemm_ooc( layout, transA, transB, m, n, k,
+                        alpha, A, B, beta, C, memory );
+}
+
+}  // namespace blas
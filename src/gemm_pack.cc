@@ -0,0 +1,1060 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "blas/fortran.h"
+#include "blas.hh"
+#include "blas/batch_common.hh"
+#include "blas/flops.hh"
+#include "blas/numa.hh"
+#include "blas/profile.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+namespace blas {
+
+//------------------------------------------------------------------------------
+/// Packed storage, in one of two formats:
+///
+/// - panels: op(X) in column blocks of kc columns, each split into panels of
+///   p rows, stored column by column, padded with zeros to a multiple of p
+///   rows. Entry (i, l) of panel ir in block pc is at
+///   values[ pc*rows_padded + ir*kb + (l - pc)*p + (i - ir) ].
+///   For B, the panels are of op(B)^T, i.e., nr columns of op(B).
+///   Consumed by the in-library micro-kernel.
+///
+/// - dense: op(X) copied column-major, with leading dimension rows,
+///   and conjugated for ConjTrans. Consumed by the vendor gemm.
+///
+template <typename T>
+struct PackedMatrix<T>::Data
+{
+    bool panels;
+    std::vector<T> values;
+};
+
+namespace internal {
+
+// Micro-kernel register block mr-by-nr, holding 2 vectors per column, and
+// cache blocks. Panels are used only if the library is compiled for AVX2
+// or AVX-512, where the compiler-vectorized kernel is competitive; with
+// SSE only, or for complex, the vendor gemm is faster.
+#if defined( __AVX512F__ )
+    const int64_t gemm_pack_vector_bytes = 64;
+    const int64_t gemm_pack_nr = 8;
+#elif defined( __AVX2__ )
+    const int64_t gemm_pack_vector_bytes = 32;
+    const int64_t gemm_pack_nr = 6;
+#else
+    const int64_t gemm_pack_vector_bytes = 0;
+    const int64_t gemm_pack_nr = 6;
+#endif
+
+const int64_t gemm_pack_mc = 128;
+const int64_t gemm_pack_kc = 256;
+const int64_t gemm_pack_nc = 1024 / gemm_pack_nr * gemm_pack_nr;
+
+template <typename T>
+struct GemmPackMr
+{
+    static const int64_t value
+        = (gemm_pack_vector_bytes > 0
+           ? int64_t( 2 * gemm_pack_vector_bytes / sizeof(T) ) : 1);
+};
+
+//------------------------------------------------------------------------------
+/// @return true if type T uses the panel format.
+template <typename T>
+bool gemm_pack_use_panels()
+{
+    return gemm_pack_vector_bytes > 0 && ! is_complex<T>::value;
+}
+
+//------------------------------------------------------------------------------
+/// @return x rounded up to a multiple of p.
+inline int64_t gemm_pack_roundup( int64_t x, int64_t p )
+{
+    return (x + p - 1) / p * p;
+}
+
+//------------------------------------------------------------------------------
+/// Packs the rows-by-cols matrix X, with strides rs, cs, into panels of
+/// p rows, in column blocks of kc; see PackedMatrix::Data.
+template <int64_t p, typename T>
+void gemm_pack_panels(
+    int64_t rows, int64_t cols, T const* X, int64_t rs, int64_t cs, T* Xp )
+{
+    const int64_t kc = gemm_pack_kc;
+    int64_t rows_padded = gemm_pack_roundup( rows, p );
+    for (int64_t pc = 0; pc < cols; pc += kc) {
+        int64_t kb = std::min( kc, cols - pc );
+        #pragma omp parallel for schedule(static)
+        for (int64_t ir = 0; ir < rows; ir += p) {
+            int64_t p_ = std::min( p, rows - ir );
+            T* panel = &Xp[ pc*rows_padded + ir*kb ];
+            for (int64_t l = 0; l < kb; ++l) {
+                T const* Xl = &X[ ir*rs + (pc + l)*cs ];
+                for (int64_t i = 0; i < p_; ++i)
+                    panel[ l*p + i ] = Xl[ i*rs ];
+                for (int64_t i = p_; i < p; ++i)
+                    panel[ l*p + i ] = 0;
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Micro-kernel: C( 0:mr_, 0:nr_ ) += alpha Ap Bp, for one mr-row panel
+/// of A and one nr-column panel of B. C has strides rsc, csc.
+/// The unroll and simd pragmas are needed for gcc to vectorize over i
+/// and keep acc in registers; without them, some mr, nr are 10x slower.
+template <int64_t mr, int64_t nr, typename T>
+void gemm_pack_kernel(
+    int64_t kb, T alpha, T const* Ap, T const* Bp,
+    int64_t mr_, int64_t nr_, T* C, int64_t rsc, int64_t csc )
+{
+    T acc[ nr ][ mr ] = {};
+    for (int64_t l = 0; l < kb; ++l) {
+        T const* a = &Ap[ l*mr ];
+        #pragma GCC unroll 16
+        for (int64_t j = 0; j < nr; ++j) {
+            T b = Bp[ l*nr + j ];
+            #pragma omp simd
+            for (int64_t i = 0; i < mr; ++i)
+                acc[ j ][ i ] += a[ i ] * b;
+        }
+    }
+    for (int64_t j = 0; j < nr_; ++j) {
+        for (int64_t i = 0; i < mr_; ++i)
+            C[ i*rsc + j*csc ] += alpha * acc[ j ][ i ];
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @return x clamped to [ lower, upper ]. NaN is passed through.
+template <typename T>
+inline T gemm_epilogue_clamp( T x, T lower, T upper )
+{
+    return std::min( std::max( x, lower ), upper );
+}
+
+/// Complex has no ordering; rejected by gemm_epilogue, so not reached.
+template <typename T>
+inline std::complex<T> gemm_epilogue_clamp( std::complex<T> x, T, T )
+{
+    return x;
+}
+
+//------------------------------------------------------------------------------
+/// Applies the epilogue to the mb-by-nb tile C, with strides rsc, csc,
+/// which is at rows i0 and columns j0 of the whole matrix, i.e.,
+///     C(i, j) = f( row_scale[ i0 + i ] col_scale[ j0 + j ] C(i, j)
+///                  + bias[ j0 + j ] ).
+/// Called on each tile right after it is computed, while in cache.
+template <typename T>
+void gemm_epilogue_apply(
+    Epilogue<T> const& epi, int64_t i0, int64_t j0, int64_t mb, int64_t nb,
+    T* C, int64_t rsc, int64_t csc )
+{
+    typedef real_type<T> real_t;
+    const real_t inf = std::numeric_limits<real_t>::infinity();
+
+    for (int64_t j = 0; j < nb; ++j) {
+        T* Cj = &C[ j*csc ];
+        T cs = (epi.col_scale != nullptr ? epi.col_scale[ j0 + j ] : T( 1 ));
+        T b  = (epi.bias      != nullptr ? epi.bias[ j0 + j ]      : T( 0 ));
+        if (epi.row_scale != nullptr) {
+            T const* rs = &epi.row_scale[ i0 ];
+            for (int64_t i = 0; i < mb; ++i)
+                Cj[ i*rsc ] = rs[ i ] * cs * Cj[ i*rsc ] + b;
+        }
+        else if (cs != T( 1 ) || b != T( 0 )) {
+            for (int64_t i = 0; i < mb; ++i)
+                Cj[ i*rsc ] = cs * Cj[ i*rsc ] + b;
+        }
+
+        switch (epi.activation) {
+            case Activation::Identity:
+                break;
+
+            case Activation::ReLU:
+                for (int64_t i = 0; i < mb; ++i)
+                    Cj[ i*rsc ] = gemm_epilogue_clamp( Cj[ i*rsc ],
+                                                       real_t( 0 ), inf );
+                break;
+
+            case Activation::Clamp:
+                for (int64_t i = 0; i < mb; ++i)
+                    Cj[ i*rsc ] = gemm_epilogue_clamp( Cj[ i*rsc ],
+                                                       epi.lower, epi.upper );
+                break;
+
+            case Activation::Sigmoid:
+                for (int64_t i = 0; i < mb; ++i)
+                    Cj[ i*rsc ] = T( 1 ) / (T( 1 ) + std::exp( -Cj[ i*rsc ] ));
+                break;
+
+            case Activation::Tanh:
+                for (int64_t i = 0; i < mb; ++i)
+                    Cj[ i*rsc ] = std::tanh( Cj[ i*rsc ] );
+                break;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Blocked gemm, C = alpha A B + beta C, on panels. Each of A and B is
+/// either prepacked (Apk, Bpk) or packed block by block, from A with
+/// strides rsa, csa, and B with strides rsb, csb. C has strides rsc, csc.
+/// If epilogue is given, it is applied to each mr-by-nr micro-tile of C as
+/// soon as its last k block is done, while the micro-tile is in L1 cache.
+template <typename T>
+void gemm_pack_compute(
+    int64_t m, int64_t n, int64_t k, T alpha,
+    T const* Apk, T const* A, int64_t rsa, int64_t csa,
+    T const* Bpk, T const* B, int64_t rsb, int64_t csb,
+    T beta, T* C, int64_t rsc, int64_t csc,
+    Epilogue<T> const* epilogue = nullptr )
+{
+    const int64_t mr = GemmPackMr<T>::value;
+    const int64_t nr = gemm_pack_nr;
+    const int64_t mc = gemm_pack_mc;
+    const int64_t kc = gemm_pack_kc;
+    const int64_t nc = gemm_pack_nc;
+
+    // C = beta C; the kernel adds alpha A B
+    if (beta != T(1)) {
+        #pragma omp parallel for schedule(static)
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t i = 0; i < m; ++i) {
+                T& Cij = C[ i*rsc + j*csc ];
+                Cij = (beta == T(0) ? T(0) : beta * Cij);
+            }
+        }
+    }
+    if (alpha == T(0) || k == 0) {
+        if (epilogue != nullptr) {
+            #pragma omp parallel for schedule(static)
+            for (int64_t j = 0; j < n; ++j)
+                gemm_epilogue_apply( *epilogue, 0, j, m, 1,
+                                     &C[ j*csc ], rsc, csc );
+        }
+        return;
+    }
+
+    int64_t m_padded = gemm_pack_roundup( m, mr );
+    int64_t n_padded = gemm_pack_roundup( n, nr );
+    std::vector<T> Bp;
+    if (Bpk == nullptr)
+        Bp.resize( kc * std::min( nc, n_padded ) );
+
+    for (int64_t jc = 0; jc < n; jc += nc) {
+        int64_t nb = std::min( nc, n - jc );
+        for (int64_t pc = 0; pc < k; pc += kc) {
+            int64_t kb = std::min( kc, k - pc );
+            Epilogue<T> const* epi = (pc + kb == k ? epilogue : nullptr);
+
+            // panels of B are panels of B^T
+            T const* Bb;
+            if (Bpk != nullptr) {
+                Bb = &Bpk[ pc*n_padded + jc*kb ];
+            }
+            else {
+                gemm_pack_panels<nr>( nb, kb, &B[ pc*rsb + jc*csb ], csb, rsb,
+                                      Bp.data() );
+                Bb = Bp.data();
+            }
+
+            #pragma omp parallel
+            {
+                std::vector<T> Ap;
+                if (Apk == nullptr)
+                    Ap.resize( gemm_pack_roundup( mc, mr ) * kb );
+
+                #pragma omp for schedule(dynamic)
+                for (int64_t ic = 0; ic < m; ic += mc) {
+                    int64_t mb = std::min( mc, m - ic );
+                    T const* Ab;
+                    if (Apk != nullptr) {
+                        Ab = &Apk[ pc*m_padded + ic*kb ];
+                    }
+                    else {
+                        gemm_pack_panels<mr>( mb, kb, &A[ ic*rsa + pc*csa ],
+                                              rsa, csa, Ap.data() );
+                        Ab = Ap.data();
+                    }
+
+                    for (int64_t jr = 0; jr < nb; jr += nr) {
+                        int64_t nr_ = std::min( nr, nb - jr );
+                        for (int64_t ir = 0; ir < mb; ir += mr) {
+                            int64_t mr_ = std::min( mr, mb - ir );
+                            T* Cr = &C[ (ic + ir)*rsc + (jc + jr)*csc ];
+                            gemm_pack_kernel<mr, nr>(
+                                kb, alpha, &Ab[ ir*kb ], &Bb[ jr*kb ],
+                                mr_, nr_, Cr, rsc, csc );
+                            if (epi != nullptr)
+                                gemm_epilogue_apply( *epi, ic + ir, jc + jr,
+                                                     mr_, nr_, Cr, rsc, csc );
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Sets strides rs, cs of op(X) for X stored with the given layout and
+/// leading dimension ld.
+inline void gemm_pack_strides(
+    blas::Layout layout, blas::Op trans, int64_t ld,
+    int64_t* rs, int64_t* cs )
+{
+    bool col = ((trans == Op::NoTrans) == (layout == Layout::ColMajor));
+    *rs = (col ? 1 : ld);
+    *cs = (col ? ld : 1);
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+PackedMatrix<T> gemm_pack(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Op trans,
+    int64_t m, int64_t n, int64_t k,
+    T const *A, int64_t lda )
+{
+    // check arguments
+    blas_error_if( layout != Layout::ColMajor &&
+                   layout != Layout::RowMajor );
+    blas_error_if( side != Side::Left &&
+                   side != Side::Right );
+    blas_error_if( trans != Op::NoTrans &&
+                   trans != Op::Trans &&
+                   trans != Op::ConjTrans );
+    blas_error_if( m < 0 );
+    blas_error_if( n < 0 );
+    blas_error_if( k < 0 );
+
+    // op(X) is rows-by-cols
+    int64_t rows = (side == Side::Left ? m : k);
+    int64_t cols = (side == Side::Left ? k : n);
+    if ((trans == Op::NoTrans) ^ (layout == Layout::RowMajor))
+        blas_error_if( lda < rows );
+    else
+        blas_error_if( lda < cols );
+
+    int64_t rs, cs;
+    gemm_pack_strides( layout, trans, lda, &rs, &cs );
+
+    typedef typename PackedMatrix<T>::Data Data;
+    std::shared_ptr<Data> data = std::make_shared<Data>();
+    data->panels = gemm_pack_use_panels<T>();
+    if (data->panels) {
+        if (side == Side::Left) {
+            const int64_t mr = GemmPackMr<T>::value;
+            data->values.resize( gemm_pack_roundup( rows, mr ) * cols );
+            gemm_pack_panels<mr>( rows, cols, A, rs, cs, data->values.data() );
+        }
+        else {
+            const int64_t nr = gemm_pack_nr;
+            data->values.resize( gemm_pack_roundup( cols, nr ) * rows );
+            gemm_pack_panels<nr>( cols, rows, A, cs, rs, data->values.data() );
+        }
+    }
+    else {
+        using blas::conj;
+        bool conj_x = (trans == Op::ConjTrans);
+        int64_t ld = std::max( rows, int64_t( 1 ) );
+        data->values.resize( ld * cols );
+        T* values = data->values.data();
+        #pragma omp parallel for schedule(static)
+        for (int64_t j = 0; j < cols; ++j) {
+            for (int64_t i = 0; i < rows; ++i) {
+                T x = A[ i*rs + j*cs ];
+                values[ i + j*ld ] = (conj_x ? conj( x ) : x);
+            }
+        }
+    }
+    return PackedMatrix<T>( data, side, rows, cols );
+}
+
+//------------------------------------------------------------------------------
+/// C = alpha op(A) op(B) + beta C, with op(A) packed if side = Left,
+/// else op(B) packed. X is the other, unpacked operand, with transX, ldx.
+template <typename T>
+void gemm_packed(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Op transX,
+    int64_t m, int64_t n, int64_t k,
+    T alpha,
+    PackedMatrix<T> const& P,
+    T const *X, int64_t ldx,
+    T beta,
+    T       *C, int64_t ldc )
+{
+    // check arguments
+    blas_error_if( layout != Layout::ColMajor &&
+                   layout != Layout::RowMajor );
+    blas_error_if( transX != Op::NoTrans &&
+                   transX != Op::Trans &&
+                   transX != Op::ConjTrans );
+    blas_error_if( m < 0 );
+    blas_error_if( n < 0 );
+    blas_error_if( k < 0 );
+    blas_error_if( P.empty() );
+    blas_error_if( P.side() != side );
+    if (side == Side::Left) {
+        blas_error_if( P.rows() != m || P.cols() != k );
+        if ((transX == Op::NoTrans) ^ (layout == Layout::RowMajor))
+            blas_error_if( ldx < k );
+        else
+            blas_error_if( ldx < n );
+    }
+    else {
+        blas_error_if( P.rows() != k || P.cols() != n );
+        if ((transX == Op::NoTrans) ^ (layout == Layout::RowMajor))
+            blas_error_if( ldx < m );
+        else
+            blas_error_if( ldx < k );
+    }
+    if (layout == Layout::ColMajor)
+        blas_error_if( ldc < m );
+    else
+        blas_error_if( ldc < n );
+
+    // quick return
+    if (m == 0 || n == 0)
+        return;
+
+    typename PackedMatrix<T>::Data const* data = P.data();
+    if (! data->panels) {
+        // dense op(P), column-major, which is its transpose in row-major
+        T const* Pd = data->values.data();
+        int64_t ldp = std::max( P.rows(), int64_t( 1 ) );
+        Op transP = (layout == Layout::ColMajor ? Op::NoTrans : Op::Trans);
+        if (side == Side::Left)
+            blas::gemm( layout, transP, transX, m, n, k,
+                        alpha, Pd, ldp, X, ldx, beta, C, ldc );
+        else
+            blas::gemm( layout, transX, transP, m, n, k,
+                        alpha, X, ldx, Pd, ldp, beta, C, ldc );
+        return;
+    }
+
+    // in-library kernel; conjugate of a real type is a no-op
+    int64_t rsx, csx;
+    gemm_pack_strides( layout, transX, ldx, &rsx, &csx );
+    int64_t rsc = (layout == Layout::ColMajor ? 1 : ldc);
+    int64_t csc = (layout == Layout::ColMajor ? ldc : 1);
+    if (side == Side::Left)
+        gemm_pack_compute( m, n, k, alpha,
+                           data->values.data(), (T const*) nullptr, 0, 0,
+                           (T const*) nullptr, X, rsx, csx,
+                           beta, C, rsc, csc );
+    else
+        gemm_pack_compute( m, n, k, alpha,
+                           (T const*) nullptr, X, rsx, csx,
+                           data->values.data(), (T const*) nullptr, 0, 0,
+                           beta, C, rsc, csc );
+}
+
+//------------------------------------------------------------------------------
+/// Batch gemm with shared packed op(A).
+template <typename T>
+void gemm_packed_batch(
+    blas::Layout                 layout,
+    std::vector<blas::Op> const &transB,
+    std::vector<int64_t>  const &n,
+    std::vector<T>        const &alpha,
+    PackedMatrix<T>       const &A,
+    std::vector<T*>       const &Barray, std::vector<int64_t> const &lddb,
+    std::vector<T>        const &beta,
+    std::vector<T*>       const &Carray, std::vector<int64_t> const &lddc,
+    const size_t batch,                  std::vector<int64_t>       &info )
+{
+    blas_error_if( !(info.size() == 0 || info.size() == 1 || info.size() == batch) );
+    if (info.size() > 0) {
+        // size error checking; other errors throw from each gemm
+        blas_error_if( transB.size() != 1 && transB.size() != batch );
+        blas_error_if( n.size()      != 1 && n.size()      != batch );
+        blas_error_if( alpha.size()  != 1 && alpha.size()  != batch );
+        blas_error_if( beta.size()   != 1 && beta.size()   != batch );
+        blas_error_if( lddb.size()   != 1 && lddb.size()   != batch );
+        blas_error_if( lddc.size()   != 1 && lddc.size()   != batch );
+        blas_error_if( Barray.size() != 1 && Barray.size() < batch );
+        blas_error_if( Carray.size() < batch );
+        std::fill( info.begin(), info.end(), 0 );
+    }
+
+    // problems in parallel near their C, each on its share of threads
+    int64_t nthreads = batch_threads( batch );
+    numa::for_each_local(
+        batch,
+        [&]( size_t i ) -> void const* { return Carray[ i ]; },
+        [&]( size_t i ) {
+            ThreadScope thread_scope( nthreads );
+            gemm_packed( layout, Side::Left,
+                         batch::extract<Op>( transB, i ),
+                         A.rows(), batch::extract<int64_t>( n, i ), A.cols(),
+                         batch::extract<T>( alpha, i ), A,
+                         batch::extract<T*>( Barray, i ),
+                         batch::extract<int64_t>( lddb, i ),
+                         batch::extract<T>( beta, i ),
+                         batch::extract<T*>( Carray, i ),
+                         batch::extract<int64_t>( lddc, i ) );
+        } );
+}
+
+// Tile of C for gemm_epilogue without panels: each tile is one vendor gemm,
+// then the epilogue while the tile is in L2 cache.
+const int64_t gemm_epilogue_mb = 256;
+const int64_t gemm_epilogue_nb = 256;
+
+//------------------------------------------------------------------------------
+/// C = alpha op(A) op(B) + beta C, followed by the epilogue, fused into
+/// the blocked computation; see blas::Epilogue. With panels, the
+/// epilogue is applied per micro-tile in the in-library kernel; otherwise,
+/// per tile of C computed by the vendor gemm.
+template <typename T>
+void gemm_epilogue(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    T alpha,
+    T const *A, int64_t lda,
+    T const *B, int64_t ldb,
+    T beta,
+    T       *C, int64_t ldc,
+    Epilogue<T> const& epilogue )
+{
+    // check arguments
+    blas_error_if( layout != Layout::ColMajor &&
+                   layout != Layout::RowMajor );
+    blas_error_if( transA != Op::NoTrans &&
+                   transA != Op::Trans &&
+                   transA != Op::ConjTrans );
+    blas_error_if( transB != Op::NoTrans &&
+                   transB != Op::Trans &&
+                   transB != Op::ConjTrans );
+    blas_error_if( m < 0 );
+    blas_error_if( n < 0 );
+    blas_error_if( k < 0 );
+
+    if ((transA == Op::NoTrans) ^ (layout == Layout::RowMajor))
+        blas_error_if( lda < m );
+    else
+        blas_error_if( lda < k );
+
+    if ((transB == Op::NoTrans) ^ (layout == Layout::RowMajor))
+        blas_error_if( ldb < k );
+    else
+        blas_error_if( ldb < n );
+
+    if (layout == Layout::ColMajor)
+        blas_error_if( ldc < m );
+    else
+        blas_error_if( ldc < n );
+
+    Activation act = epilogue.activation;
+    blas_error_if( act != Activation::Identity &&
+                   act != Activation::ReLU &&
+                   act != Activation::Clamp &&
+                   act != Activation::Sigmoid &&
+                   act != Activation::Tanh );
+    blas_error_if_msg( is_complex<T>::value
+                       && (act == Activation::ReLU || act == Activation::Clamp),
+                       "%s requires a real type", activation2str( act ) );
+    blas_error_if( act == Activation::Clamp
+                   && ! (epilogue.lower <= epilogue.upper) );
+
+    // quick return
+    if (m == 0 || n == 0)
+        return;
+
+    int64_t rsa, csa, rsb, csb;
+    gemm_pack_strides( layout, transA, lda, &rsa, &csa );
+    gemm_pack_strides( layout, transB, ldb, &rsb, &csb );
+    int64_t rsc = (layout == Layout::ColMajor ? 1 : ldc);
+    int64_t csc = (layout == Layout::ColMajor ? ldc : 1);
+
+    if (gemm_pack_use_panels<T>()) {
+        // real type, so op is a transpose at most, given by the strides
+        gemm_pack_compute( m, n, k, alpha,
+                           (T const*) nullptr, A, rsa, csa,
+                           (T const*) nullptr, B, rsb, csb,
+                           beta, C, rsc, csc, &epilogue );
+        return;
+    }
+
+    // check for overflow in native BLAS integer type, if smaller than int64_t
+    if (sizeof(int64_t) > sizeof(blas_int)) {
+        blas_error_if( k   > std::numeric_limits<blas_int>::max() );
+        blas_error_if( lda > std::numeric_limits<blas_int>::max() );
+        blas_error_if( ldb > std::numeric_limits<blas_int>::max() );
+        blas_error_if( ldc > std::numeric_limits<blas_int>::max() );
+    }
+
+    // Sub-blocks keep the layout, ops, and leading dimensions; strides of
+    // op(A), op(B) also hold for ConjTrans.
+    auto tile = [&]( int64_t ic, int64_t jc ) {
+        int64_t nb = std::min( gemm_epilogue_nb, n - jc );
+        int64_t mb = std::min( gemm_epilogue_mb, m - ic );
+        T* Cij = &C[ ic*rsc + jc*csc ];
+        gemm_vendor( layout, transA, transB, mb, nb, k,
+                     alpha, &A[ ic*rsa ], lda, &B[ jc*csb ], ldb,
+                     beta, Cij, ldc );
+        gemm_epilogue_apply( epilogue, ic, jc, mb, nb, Cij, rsc, csc );
+    };
+
+    // Tiles in parallel, each vendor gemm then single threaded, also with
+    // a pthreads vendor BLAS. With fewer tiles than threads, tiles are
+    // instead done in order by the threaded vendor gemm, e.g., if already
+    // in a parallel region.
+    int64_t mt = (m + gemm_epilogue_mb - 1) / gemm_epilogue_mb;
+    int64_t nt = (n + gemm_epilogue_nb - 1) / gemm_epilogue_nb;
+    int64_t nthreads = get_num_threads();
+    bool parallel = false;
+    #ifdef _OPENMP
+        parallel = ! omp_in_parallel() && mt*nt >= nthreads;
+    #endif
+    if (parallel) {
+        ThreadScope thread_scope( 1 );
+        #pragma omp parallel for collapse(2) schedule(dynamic) num_threads( nthreads )
+        for (int64_t jc = 0; jc < n; jc += gemm_epilogue_nb) {
+            for (int64_t ic = 0; ic < m; ic += gemm_epilogue_mb) {
+                tile( ic, jc );
+            }
+        }
+    }
+    else {
+        for (int64_t jc = 0; jc < n; jc += gemm_epilogue_nb) {
+            for (int64_t ic = 0; ic < m; ic += gemm_epilogue_mb) {
+                tile( ic, jc );
+            }
+        }
+    }
+}
+
+}  // namespace internal
+
+// =============================================================================
+// Overloaded wrappers for s, d, c, z precisions.
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+PackedMatrix<float> gemm_pack(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Op trans,
+    int64_t m, int64_t n, int64_t k,
+    float const *A, int64_t lda )
+{
+    return internal::gemm_pack( layout, side, trans, m, n, k, A, lda );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+PackedMatrix<double> gemm_pack(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Op trans,
+    int64_t m, int64_t n, int64_t k,
+    double const *A, int64_t lda )
+{
+    return internal::gemm_pack( layout, side, trans, m, n, k, A, lda );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+PackedMatrix< std::complex<float> > gemm_pack(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Op trans,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<float> const *A, int64_t lda )
+{
+    return internal::gemm_pack( layout, side, trans, m, n, k, A, lda );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+PackedMatrix< std::complex<double> > gemm_pack(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Op trans,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<double> const *A, int64_t lda )
+{
+    return internal::gemm_pack( layout, side, trans, m, n, k, A, lda );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    float alpha,
+    PackedMatrix<float> const& A,
+    float const *B, int64_t ldb,
+    float beta,
+    float       *C, int64_t ldc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm_packed", 's',
+                          { layout2char( layout ), 'p', op2char( transB ) },
+                          m, n, k, Gflop< float >::gemm( m, n, k ) );
+
+    internal::gemm_packed( layout, Side::Left, transB, m, n, k,
+                           alpha, A, B, ldb, beta, C, ldc );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    double alpha,
+    PackedMatrix<double> const& A,
+    double const *B, int64_t ldb,
+    double beta,
+    double       *C, int64_t ldc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm_packed", 'd',
+                          { layout2char( layout ), 'p', op2char( transB ) },
+                          m, n, k, Gflop< double >::gemm( m, n, k ) );
+
+    internal::gemm_packed( layout, Side::Left, transB, m, n, k,
+                           alpha, A, B, ldb, beta, C, ldc );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<float> alpha,
+    PackedMatrix< std::complex<float> > const& A,
+    std::complex<float> const *B, int64_t ldb,
+    std::complex<float> beta,
+    std::complex<float>       *C, int64_t ldc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm_packed", 'c',
+                          { layout2char( layout ), 'p', op2char( transB ) },
+                          m, n, k,
+                          Gflop< std::complex<float> >::gemm( m, n, k ) );
+
+    internal::gemm_packed( layout, Side::Left, transB, m, n, k,
+                           alpha, A, B, ldb, beta, C, ldc );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<double> alpha,
+    PackedMatrix< std::complex<double> > const& A,
+    std::complex<double> const *B, int64_t ldb,
+    std::complex<double> beta,
+    std::complex<double>       *C, int64_t ldc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm_packed", 'z',
+                          { layout2char( layout ), 'p', op2char( transB ) },
+                          m, n, k,
+                          Gflop< std::complex<double> >::gemm( m, n, k ) );
+
+    internal::gemm_packed( layout, Side::Left, transB, m, n, k,
+                           alpha, A, B, ldb, beta, C, ldc );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    int64_t m, int64_t n, int64_t k,
+    float alpha,
+    float const *A, int64_t lda,
+    PackedMatrix<float> const& B,
+    float beta,
+    float       *C, int64_t ldc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm_packed", 's',
+                          { layout2char( layout ), op2char( transA ), 'p' },
+                          m, n, k, Gflop< float >::gemm( m, n, k ) );
+
+    internal::gemm_packed( layout, Side::Right, transA, m, n, k,
+                           alpha, B, A, lda, beta, C, ldc );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    int64_t m, int64_t n, int64_t k,
+    double alpha,
+    double const *A, int64_t lda,
+    PackedMatrix<double> const& B,
+    double beta,
+    double       *C, int64_t ldc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm_packed", 'd',
+                          { layout2char( layout ), op2char( transA ), 'p' },
+                          m, n, k, Gflop< double >::gemm( m, n, k ) );
+
+    internal::gemm_packed( layout, Side::Right, transA, m, n, k,
+                           alpha, B, A, lda, beta, C, ldc );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<float> alpha,
+    std::complex<float> const *A, int64_t lda,
+    PackedMatrix< std::complex<float> > const& B,
+    std::complex<float> beta,
+    std::complex<float>       *C, int64_t ldc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm_packed", 'c',
+                          { layout2char( layout ), op2char( transA ), 'p' },
+                          m, n, k,
+                          Gflop< std::complex<float> >::gemm( m, n, k ) );
+
+    internal::gemm_packed( layout, Side::Right, transA, m, n, k,
+                           alpha, B, A, lda, beta, C, ldc );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<double> alpha,
+    std::complex<double> const *A, int64_t lda,
+    PackedMatrix< std::complex<double> > const& B,
+    std::complex<double> beta,
+    std::complex<double>       *C, int64_t ldc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm_packed", 'z',
+                          { layout2char( layout ), op2char( transA ), 'p' },
+                          m, n, k,
+                          Gflop< std::complex<double> >::gemm( m, n, k ) );
+
+    internal::gemm_packed( layout, Side::Right, transA, m, n, k,
+                           alpha, B, A, lda, beta, C, ldc );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void batch::gemm(
+    blas::Layout                 layout,
+    std::vector<blas::Op> const &transB,
+    std::vector<int64_t>  const &n,
+    std::vector< float >   const &alpha,
+    PackedMatrix<float> const& A,
+    std::vector< float* >  const &Barray, std::vector<int64_t> const &lddb,
+    std::vector< float >   const &beta,
+    std::vector< float* >  const &Carray, std::vector<int64_t> const &lddc,
+    const size_t batch,                std::vector<int64_t>       &info )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "batch_gemm_packed", 's', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
+    internal::gemm_packed_batch( layout, transB, n, alpha, A, Barray, lddb,
+                                 beta, Carray, lddc, batch, info );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void batch::gemm(
+    blas::Layout                 layout,
+    std::vector<blas::Op> const &transB,
+    std::vector<int64_t>  const &n,
+    std::vector< double >   const &alpha,
+    PackedMatrix<double> const& A,
+    std::vector< double* >  const &Barray, std::vector<int64_t> const &lddb,
+    std::vector< double >   const &beta,
+    std::vector< double* >  const &Carray, std::vector<int64_t> const &lddc,
+    const size_t batch,                std::vector<int64_t>       &info )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "batch_gemm_packed", 'd', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
+    internal::gemm_packed_batch( layout, transB, n, alpha, A, Barray, lddb,
+                                 beta, Carray, lddc, batch, info );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void batch::gemm(
+    blas::Layout                 layout,
+    std::vector<blas::Op> const &transB,
+    std::vector<int64_t>  const &n,
+    std::vector< std::complex<float> >   const &alpha,
+    PackedMatrix< std::complex<float> > const& A,
+    std::vector< std::complex<float>* >  const &Barray, std::vector<int64_t> const &lddb,
+    std::vector< std::complex<float> >   const &beta,
+    std::vector< std::complex<float>* >  const &Carray, std::vector<int64_t> const &lddc,
+    const size_t batch,                std::vector<int64_t>       &info )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "batch_gemm_packed", 'c', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
+    internal::gemm_packed_batch( layout, transB, n, alpha, A, Barray, lddb,
+                                 beta, Carray, lddc, batch, info );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void batch::gemm(
+    blas::Layout                 layout,
+    std::vector<blas::Op> const &transB,
+    std::vector<int64_t>  const &n,
+    std::vector< std::complex<double> >   const &alpha,
+    PackedMatrix< std::complex<double> > const& A,
+    std::vector< std::complex<double>* >  const &Barray, std::vector<int64_t> const &lddb,
+    std::vector< std::complex<double> >   const &beta,
+    std::vector< std::complex<double>* >  const &Carray, std::vector<int64_t> const &lddc,
+    const size_t batch,                std::vector<int64_t>       &info )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "batch_gemm_packed", 'z', { layout2char( layout ) },
+                          0, 0, 0, 0, batch );
+
+    internal::gemm_packed_batch( layout, transB, n, alpha, A, Barray, lddb,
+                                 beta, Carray, lddc, batch, info );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    float alpha,
+    float const *A, int64_t lda,
+    float const *B, int64_t ldb,
+    float beta,
+    float       *C, int64_t ldc,
+    Epilogue<float> const& epilogue )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm_epilogue", 's',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ),
+                            activation2char( epilogue.activation ) },
+                          m, n, k, Gflop< float >::gemm( m, n, k ) );
+
+    internal::gemm_epilogue( layout, transA, transB, m, n, k,
+                             alpha, A, lda, B, ldb, beta, C, ldc, epilogue );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    double alpha,
+    double const *A, int64_t lda,
+    double const *B, int64_t ldb,
+    double beta,
+    double       *C, int64_t ldc,
+    Epilogue<double> const& epilogue )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm_epilogue", 'd',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ),
+                            activation2char( epilogue.activation ) },
+                          m, n, k, Gflop< double >::gemm( m, n, k ) );
+
+    internal::gemm_epilogue( layout, transA, transB, m, n, k,
+                             alpha, A, lda, B, ldb, beta, C, ldc, epilogue );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<float> alpha,
+    std::complex<float> const *A, int64_t lda,
+    std::complex<float> const *B, int64_t ldb,
+    std::complex<float> beta,
+    std::complex<float>       *C, int64_t ldc,
+    Epilogue< std::complex<float> > const& epilogue )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm_epilogue", 'c',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ),
+                            activation2char( epilogue.activation ) },
+                          m, n, k,
+                          Gflop< std::complex<float> >::gemm( m, n, k ) );
+
+    internal::gemm_epilogue( layout, transA, transB, m, n, k,
+                             alpha, A, lda, B, ldb, beta, C, ldc, epilogue );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<double> alpha,
+    std::complex<double> const *A, int64_t lda,
+    std::complex<double> const *B, int64_t ldb,
+    std::complex<double> beta,
+    std::complex<double>       *C, int64_t ldc,
+    Epilogue< std::complex<double> > const& epilogue )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm_epilogue", 'z',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ),
+                            activation2char( epilogue.activation ) },
+                          m, n, k,
+                          Gflop< std::complex<double> >::gemm( m, n, k ) );
+
+    internal::gemm_epilogue( layout, transA, transB, m, n, k,
+                             alpha, A, lda, B, ldb, beta, C, ldc, epilogue );
+}
+
+}  // namespace blas
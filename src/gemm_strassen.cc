@@ -0,0 +1,381 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
+
+#include <algorithm>
+#include <vector>
+
+namespace blas {
+namespace internal {
+
+// Recurse only while min( m, n, k ) >= gemm_strassen_min, so each
+// sub-problem is at least half that and the vendor gemm at the leaves
+// still runs near peak; smaller or thinner problems use gemm.
+// At 1024, one level only breaks even with gemm in all precisions;
+// at 1536 it is 5-10% faster.
+const int64_t gemm_strassen_min = 1536;
+
+//------------------------------------------------------------------------------
+/// View of op(X), where X is column-major with leading dimension ld.
+template <typename T>
+struct StrassenView {
+    T const* data;
+    int64_t ld;
+    Op op;
+
+    /// @return op(X)(i, j).
+    T operator() ( int64_t i, int64_t j ) const
+    {
+        using blas::conj;
+        if (op == Op::NoTrans)
+            return data[ i + j*ld ];
+        else if (op == Op::Trans)
+            return data[ j + i*ld ];
+        else
+            return conj( data[ j + i*ld ] );
+    }
+
+    /// @return view of op(X)( i:, j: ).
+    StrassenView sub( int64_t i, int64_t j ) const
+    {
+        StrassenView v = *this;
+        v.data += (op == Op::NoTrans ? i + j*ld : j + i*ld);
+        return v;
+    }
+};
+
+template <typename T>
+StrassenView<T> strassen_view( T const* data, int64_t ld, Op op=Op::NoTrans )
+{
+    StrassenView<T> v = { data, ld, op };
+    return v;
+}
+
+//------------------------------------------------------------------------------
+/// W = op(X) + sign op(Y), for rows-by-cols W, column-major with leading
+/// dimension ldw. W may be the same as X or Y if they are NoTrans with ldw.
+template <typename T>
+void strassen_add(
+    int64_t rows, int64_t cols,
+    StrassenView<T> X, T sign, StrassenView<T> Y,
+    T* W, int64_t ldw )
+{
+    #pragma omp parallel for schedule(static)
+    for (int64_t j = 0; j < cols; ++j) {
+        for (int64_t i = 0; i < rows; ++i) {
+            W[ i + j*ldw ] = X( i, j ) + sign * Y( i, j );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @return workspace needed by strassen_gemm: 3 temporaries per level,
+/// for quadrants of op(A), op(B), and C.
+inline int64_t strassen_workspace(
+    int64_t m, int64_t n, int64_t k, int64_t levels )
+{
+    int64_t lwork = 0;
+    while (levels > 0 && std::min( std::min( m, n ), k ) >= gemm_strassen_min) {
+        m /= 2;
+        n /= 2;
+        k /= 2;
+        lwork += m*k + k*n + m*n;
+        --levels;
+    }
+    return lwork;
+}
+
+//------------------------------------------------------------------------------
+/// C = alpha op(A) op(B) + beta C, column-major, by Strassen-Winograd
+/// recursion on 2x2 blocks for up to the given levels, with gemm at the
+/// leaves. An odd last row, column, or k-slice is peeled off and done by
+/// gemm. work is a stack of strassen_workspace( m, n, k, levels ) entries;
+/// each level uses its top and passes the rest to the next level.
+///
+/// With quadrants A11, ..., B22, the 7 products, accumulated into C, are
+///     P1 = A11 B11,                   C11 += P1 + P2
+///     P2 = A12 B21,                   C12 += P1 + P6 + P5 + P3
+///     P3 = S4 B22,                    C21 += P1 + P6 + P7 - P4
+///     P4 = A22 T4,                    C22 += P1 + P6 + P7 + P5
+///     P5 = S1 T1,   S1 = A21 + A22,   T1 = B12 - B11,
+///     P6 = S2 T2,   S2 = S1 - A11,    T2 = B22 - T1,
+///     P7 = S3 T3,   S3 = A11 - A21,   T3 = B22 - B12,
+///                   S4 = A12 - S2,    T4 = T2 - B21.
+/// Temporaries are X (for S), Y (for T), and Z (for products).
+template <typename T>
+void strassen_gemm(
+    int64_t m, int64_t n, int64_t k,
+    T alpha, StrassenView<T> A, StrassenView<T> B,
+    T beta, T* C, int64_t ldc,
+    int64_t levels, T* work )
+{
+    if (m == 0 || n == 0)
+        return;
+
+    if (levels <= 0 || std::min( std::min( m, n ), k ) < gemm_strassen_min) {
+        blas::gemm( Layout::ColMajor, A.op, B.op, m, n, k,
+                    alpha, A.data, A.ld, B.data, B.ld, beta, C, ldc );
+        return;
+    }
+
+    // C = beta C, then accumulate; C is not read if beta = 0
+    if (beta != T( 1 )) {
+        #pragma omp parallel for schedule(static)
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t i = 0; i < m; ++i) {
+                C[ i + j*ldc ] = (beta == T( 0 ) ? T( 0 ) : beta*C[ i + j*ldc ]);
+            }
+        }
+    }
+
+    int64_t mh = m / 2;
+    int64_t nh = n / 2;
+    int64_t kh = k / 2;
+    T one = 1;
+
+    StrassenView<T> A11 = A, A12 = A.sub( 0, kh ),
+                    A21 = A.sub( mh, 0 ), A22 = A.sub( mh, kh );
+    StrassenView<T> B11 = B, B12 = B.sub( 0, nh ),
+                    B21 = B.sub( kh, 0 ), B22 = B.sub( kh, nh );
+    T* C11 = C;
+    T* C12 = C + nh*ldc;
+    T* C21 = C + mh;
+    T* C22 = C + mh + nh*ldc;
+
+    T* X = work;
+    T* Y = X + mh*kh;
+    T* Z = Y + kh*nh;
+    T* next = Z + mh*nh;
+    StrassenView<T> Xv = strassen_view<T>( X, mh );
+    StrassenView<T> Yv = strassen_view<T>( Y, kh );
+    StrassenView<T> Zv = strassen_view<T>( Z, mh );
+    StrassenView<T> C11v = strassen_view<T>( C11, ldc );
+    StrassenView<T> C12v = strassen_view<T>( C12, ldc );
+    StrassenView<T> C21v = strassen_view<T>( C21, ldc );
+    StrassenView<T> C22v = strassen_view<T>( C22, ldc );
+
+    // Z = P1; C11 += P1 + P2
+    strassen_gemm( mh, nh, kh, alpha, A11, B11, T( 0 ), Z, mh, levels-1, next );
+    strassen_add( mh, nh, C11v, one, Zv, C11, ldc );
+    strassen_gemm( mh, nh, kh, alpha, A12, B21, one, C11, ldc, levels-1, next );
+
+    // X = S2, Y = T2; Z = P1 + P6, added to C12, C21, C22
+    strassen_add( mh, kh, A21, one, A22, X, mh );
+    strassen_add( mh, kh, Xv, -one, A11, X, mh );
+    strassen_add( kh, nh, B22, -one, B12, Y, kh );
+    strassen_add( kh, nh, Yv, one, B11, Y, kh );
+    strassen_gemm( mh, nh, kh, alpha, Xv, Yv, one, Z, mh, levels-1, next );
+    strassen_add( mh, nh, C12v, one, Zv, C12, ldc );
+    strassen_add( mh, nh, C21v, one, Zv, C21, ldc );
+    strassen_add( mh, nh, C22v, one, Zv, C22, ldc );
+
+    // X = S4; C12 += P3
+    strassen_add( mh, kh, A12, -one, Xv, X, mh );
+    strassen_gemm( mh, nh, kh, alpha, Xv, B22, one, C12, ldc, levels-1, next );
+
+    // Y = T4; C21 -= P4
+    strassen_add( kh, nh, Yv, -one, B21, Y, kh );
+    strassen_gemm( mh, nh, kh, -alpha, A22, Yv, one, C21, ldc, levels-1, next );
+
+    // X = S3, Y = T3; Z = P7, added to C21, C22
+    strassen_add( mh, kh, A11, -one, A21, X, mh );
+    strassen_add( kh, nh, B22, -one, B12, Y, kh );
+    strassen_gemm( mh, nh, kh, alpha, Xv, Yv, T( 0 ), Z, mh, levels-1, next );
+    strassen_add( mh, nh, C21v, one, Zv, C21, ldc );
+    strassen_add( mh, nh, C22v, one, Zv, C22, ldc );
+
+    // X = S1, Y = T1; Z = P5, added to C12, C22
+    strassen_add( mh, kh, A21, one, A22, X, mh );
+    strassen_add( kh, nh, B12, -one, B11, Y, kh );
+    strassen_gemm( mh, nh, kh, alpha, Xv, Yv, T( 0 ), Z, mh, levels-1, next );
+    strassen_add( mh, nh, C12v, one, Zv, C12, ldc );
+    strassen_add( mh, nh, C22v, one, Zv, C22, ldc );
+
+    // peel odd dimensions: k-slice, then last rows, then last columns
+    int64_t m2 = 2*mh;
+    int64_t n2 = 2*nh;
+    int64_t k2 = 2*kh;
+    if (k > k2) {
+        StrassenView<T> Ak = A.sub( 0, k2 ), Bk = B.sub( k2, 0 );
+        blas::gemm( Layout::ColMajor, A.op, B.op, m2, n2, k - k2,
+                    alpha, Ak.data, A.ld, Bk.data, B.ld, one, C, ldc );
+    }
+    if (m > m2) {
+        StrassenView<T> Am = A.sub( m2, 0 );
+        blas::gemm( Layout::ColMajor, A.op, B.op, m - m2, n2, k,
+                    alpha, Am.data, A.ld, B.data, B.ld, one, C + m2, ldc );
+    }
+    if (n > n2) {
+        StrassenView<T> Bn = B.sub( 0, n2 );
+        blas::gemm( Layout::ColMajor, A.op, B.op, m, n - n2, k,
+                    alpha, A.data, A.ld, Bn.data, B.ld, one, C + n2*ldc, ldc );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Argument checks and conversion to column-major for gemm_strassen.
+template <typename T>
+void gemm_strassen(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    T alpha,
+    T const *A, int64_t lda,
+    T const *B, int64_t ldb,
+    T beta,
+    T       *C, int64_t ldc,
+    int64_t levels )
+{
+    // check arguments
+    blas_error_if( layout != Layout::ColMajor &&
+                   layout != Layout::RowMajor );
+    blas_error_if( transA != Op::NoTrans &&
+                   transA != Op::Trans &&
+                   transA != Op::ConjTrans );
+    blas_error_if( transB != Op::NoTrans &&
+                   transB != Op::Trans &&
+                   transB != Op::ConjTrans );
+    blas_error_if( m < 0 );
+    blas_error_if( n < 0 );
+    blas_error_if( k < 0 );
+    blas_error_if( levels < 0 );
+
+    if ((transA == Op::NoTrans) ^ (layout == Layout::RowMajor))
+        blas_error_if( lda < m );
+    else
+        blas_error_if( lda < k );
+
+    if ((transB == Op::NoTrans) ^ (layout == Layout::RowMajor))
+        blas_error_if( ldb < k );
+    else
+        blas_error_if( ldb < n );
+
+    if (layout == Layout::ColMajor)
+        blas_error_if( ldc < m );
+    else
+        blas_error_if( ldc < n );
+
+    // row-major: compute C^T = op(B)^T op(A)^T in column-major
+    if (layout == Layout::RowMajor) {
+        std::swap( transA, transB );
+        std::swap( m, n );
+        std::swap( A, B );
+        std::swap( lda, ldb );
+    }
+
+    // one workspace, reused by all products and levels
+    std::vector<T> work( strassen_workspace( m, n, k, levels ) );
+    strassen_gemm( m, n, k, alpha,
+                   strassen_view( A, lda, transA ),
+                   strassen_view( B, ldb, transB ),
+                   beta, C, ldc, levels, work.data() );
+}
+
+}  // namespace internal
+
+// =============================================================================
+// Overloaded wrappers for s, d, c, z precisions.
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm_strassen(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    float alpha,
+    float const *A, int64_t lda,
+    float const *B, int64_t ldb,
+    float beta,
+    float       *C, int64_t ldc,
+    int64_t levels )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm_strassen", 's',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, k, Gflop< float >::gemm( m, n, k ) );
+
+    internal::gemm_strassen( layout, transA, transB, m, n, k,
+                             alpha, A, lda, B, ldb, beta, C, ldc, levels );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm_strassen(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    double alpha,
+    double const *A, int64_t lda,
+    double const *B, int64_t ldb,
+    double beta,
+    double       *C, int64_t ldc,
+    int64_t levels )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm_strassen", 'd',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, k, Gflop< double >::gemm( m, n, k ) );
+
+    internal::gemm_strassen( layout, transA, transB, m, n, k,
+                             alpha, A, lda, B, ldb, beta, C, ldc, levels );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm_strassen(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<float> alpha,
+    std::complex<float> const *A, int64_t lda,
+    std::complex<float> const *B, int64_t ldb,
+    std::complex<float> beta,
+    std::complex<float>       *C, int64_t ldc,
+    int64_t levels )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm_strassen", 'c',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, k, Gflop< std::complex<float> >::gemm( m, n, k ) );
+
+    internal::gemm_strassen( layout, transA, transB, m, n, k,
+                             alpha, A, lda, B, ldb, beta, C, ldc, levels );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm_strassen(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<double> alpha,
+    std::complex<double> const *A, int64_t lda,
+    std::complex<double> const *B, int64_t ldb,
+    std::complex<double> beta,
+    std::complex<double>       *C, int64_t ldc,
+    int64_t levels )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm_strassen", 'z',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, k, Gflop< std::complex<double> >::gemm( m, n, k ) );
+
+    internal::gemm_strassen( layout, transA, transB, m, n, k,
+                             alpha, A, lda, B, ldb, beta, C, ldc, levels );
+}
+
+}  // namespace blas
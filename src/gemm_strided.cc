@@ -0,0 +1,305 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "blas/fortran.h"
+#include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace blas {
+namespace internal {
+
+// Cache blocks for operands that aren't unit stride in either dimension:
+// an mc-by-kc block of A and a kc-by-nc block of B are gathered into
+// column-major workspaces, and an mc-by-nc block of C is gathered once,
+// updated by the vendor gemm for each kc-block, and scattered back.
+const int64_t gemm_strided_mc = 512;
+const int64_t gemm_strided_kc = 256;
+const int64_t gemm_strided_nc = 2048;
+
+//------------------------------------------------------------------------------
+/// Checks whether a rows-by-cols matrix with strides rs, cs can be passed
+/// to the vendor BLAS as is: column-major (trans = 'n'), or row-major,
+/// i.e., its transpose is column-major (trans = 't'). Strides of
+/// dimensions of size 1 are ignored.
+///
+/// @return true and sets trans and ld if so; otherwise false.
+inline bool gemm_strided_blas(
+    int64_t rows, int64_t cols, int64_t rs, int64_t cs,
+    char* trans, int64_t* ld )
+{
+    const int64_t max_int = std::numeric_limits<blas_int>::max();
+    if (rs == 1 || rows <= 1) {
+        int64_t ld_ = (cols <= 1 ? std::max( rows, int64_t( 1 ) ) : cs);
+        if (ld_ >= std::max( rows, int64_t( 1 ) ) && ld_ <= max_int) {
+            *trans = 'n';
+            *ld = ld_;
+            return true;
+        }
+    }
+    if (cs == 1 || cols <= 1) {
+        int64_t ld_ = (rows <= 1 ? std::max( cols, int64_t( 1 ) ) : rs);
+        if (ld_ >= std::max( cols, int64_t( 1 ) ) && ld_ <= max_int) {
+            *trans = 't';
+            *ld = ld_;
+            return true;
+        }
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+/// Gathers the rows-by-cols matrix A, with strides rs, cs, into the
+/// column-major workspace W with leading dimension rows.
+template <typename T>
+void gemm_strided_gather(
+    int64_t rows, int64_t cols, T const* A, int64_t rs, int64_t cs, T* W )
+{
+    #pragma omp parallel for schedule(static)
+    for (int64_t j = 0; j < cols; ++j) {
+        T const* Aj = &A[ j*cs ];
+        T* Wj = &W[ j*rows ];
+        for (int64_t i = 0; i < rows; ++i)
+            Wj[ i ] = Aj[ i*rs ];
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Scatters the column-major workspace W, with leading dimension rows,
+/// into the rows-by-cols matrix C, with strides rs, cs.
+template <typename T>
+void gemm_strided_scatter(
+    int64_t rows, int64_t cols, T const* W, T* C, int64_t rs, int64_t cs )
+{
+    #pragma omp parallel for schedule(static)
+    for (int64_t j = 0; j < cols; ++j) {
+        T* Cj = &C[ j*cs ];
+        T const* Wj = &W[ j*rows ];
+        for (int64_t i = 0; i < rows; ++i)
+            Cj[ i*rs ] = Wj[ i ];
+    }
+}
+
+//------------------------------------------------------------------------------
+/// General stride gemm, C = alpha A B + beta C, with
+/// A(i, l) = A[ i*rsa + l*csa ], etc.
+/// Operands that are unit stride in either dimension are passed directly
+/// to the vendor gemm; others are gathered block by block into column-major
+/// workspaces, and C is scattered back, so only one block of each is copied
+/// at a time.
+template <typename T>
+void gemm_strided(
+    int64_t m, int64_t n, int64_t k,
+    T alpha,
+    T const *A, int64_t rsa, int64_t csa,
+    T const *B, int64_t rsb, int64_t csb,
+    T beta,
+    T       *C, int64_t rsc, int64_t csc )
+{
+    // check arguments
+    blas_error_if( m < 0 );
+    blas_error_if( n < 0 );
+    blas_error_if( k < 0 );
+
+    // entries of C can't alias
+    blas_error_if( rsc == 0 && m > 1 );
+    blas_error_if( csc == 0 && n > 1 );
+
+    // quick return
+    if (m == 0 || n == 0 || ((alpha == T(0) || k == 0) && beta == T(1)))
+        return;
+
+    // form C = beta*C
+    if (alpha == T(0) || k == 0) {
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t i = 0; i < m; ++i) {
+                T& Cij = C[ i*rsc + j*csc ];
+                Cij = (beta == T(0) ? T(0) : beta * Cij);
+            }
+        }
+        return;
+    }
+
+    // if C is row-major, compute C^T = B^T A^T, so C is column-major
+    char transC = 'n';
+    int64_t ldc = 0;
+    if (gemm_strided_blas( m, n, rsc, csc, &transC, &ldc ) && transC == 't') {
+        std::swap( m, n );
+        std::swap( A, B );
+        std::swap( rsa, csb );
+        std::swap( csa, rsb );
+        std::swap( rsc, csc );
+    }
+    bool direct_C = gemm_strided_blas( m, n, rsc, csc, &transC, &ldc )
+                    && transC == 'n';
+
+    char transA = 'n', transB = 'n';
+    int64_t lda = 0, ldb = 0;
+    bool direct_A = gemm_strided_blas( m, k, rsa, csa, &transA, &lda );
+    bool direct_B = gemm_strided_blas( k, n, rsb, csb, &transB, &ldb );
+
+    // one vendor call if all are direct and m, n, k fit in blas_int;
+    // otherwise, blocks are at most mc, nc, kc
+    const int64_t max_int = std::numeric_limits<blas_int>::max();
+    bool fits = (m <= max_int && n <= max_int && k <= max_int);
+    if (direct_A && direct_B && direct_C && fits) {
+        gemm_vendor( Layout::ColMajor, char2op( transA ), char2op( transB ),
+                     m, n, k, alpha, A, lda, B, ldb, beta, C, ldc );
+        return;
+    }
+
+    const int64_t mc = gemm_strided_mc;
+    const int64_t kc = gemm_strided_kc;
+    const int64_t nc = gemm_strided_nc;
+
+    std::vector<T> Ap, Bp, W;
+    if (! direct_A)
+        Ap.resize( std::min( mc, m ) * std::min( kc, k ) );
+    if (! direct_B)
+        Bp.resize( std::min( kc, k ) * std::min( nc, n ) );
+    if (! direct_C)
+        W.resize( std::min( mc, m ) * std::min( nc, n ) );
+
+    // k-blocks are innermost, so each block of C is copied once; a gathered
+    // block of B is then gathered again for each block row of C, but that
+    // is O(k nb) copies against O(mc k nb) flops
+    for (int64_t jc = 0; jc < n; jc += nc) {
+        int64_t nb = std::min( nc, n - jc );
+        for (int64_t ic = 0; ic < m; ic += mc) {
+            int64_t mb = std::min( mc, m - ic );
+
+            // block of C, in place or gathered;
+            // with beta = 0, C isn't read
+            T* Cb = &C[ ic*rsc + jc*csc ];
+            T* Wb = Cb;
+            int64_t ldw = ldc;
+            if (! direct_C) {
+                Wb = W.data();
+                ldw = mb;
+                if (beta != T(0))
+                    gemm_strided_gather( mb, nb, (T const*) Cb, rsc, csc, Wb );
+            }
+
+            for (int64_t pc = 0; pc < k; pc += kc) {
+                int64_t kb = std::min( kc, k - pc );
+                T beta_ = (pc == 0 ? beta : T(1));
+
+                // block of B, in place or gathered
+                T const* Bb = &B[ pc*rsb + jc*csb ];
+                char transB_ = transB;
+                int64_t ldb_ = ldb;
+                if (! direct_B) {
+                    gemm_strided_gather( kb, nb, Bb, rsb, csb, Bp.data() );
+                    Bb = Bp.data();
+                    transB_ = 'n';
+                    ldb_ = kb;
+                }
+
+                // block of A, in place or gathered
+                T const* Ab = &A[ ic*rsa + pc*csa ];
+                char transA_ = transA;
+                int64_t lda_ = lda;
+                if (! direct_A) {
+                    gemm_strided_gather( mb, kb, Ab, rsa, csa, Ap.data() );
+                    Ab = Ap.data();
+                    transA_ = 'n';
+                    lda_ = mb;
+                }
+
+                gemm_vendor( Layout::ColMajor, char2op( transA_ ),
+                             char2op( transB_ ), mb, nb, kb,
+                             alpha, Ab, lda_, Bb, ldb_, beta_, Wb, ldw );
+            }
+
+            if (! direct_C)
+                gemm_strided_scatter( mb, nb, W.data(), Cb, rsc, csc );
+        }
+    }
+}
+
+}  // namespace internal
+
+// =============================================================================
+// Overloaded wrappers for s, d, c, z precisions, with general stride.
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    int64_t m, int64_t n, int64_t k,
+    float alpha,
+    float const *A, int64_t rsa, int64_t csa,
+    float const *B, int64_t rsb, int64_t csb,
+    float beta,
+    float       *C, int64_t rsc, int64_t csc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm_strided", 's', {},
+                          m, n, k, Gflop< float >::gemm( m, n, k ) );
+
+    internal::gemm_strided( m, n, k, alpha, A, rsa, csa, B, rsb, csb,
+                            beta, C, rsc, csc );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    int64_t m, int64_t n, int64_t k,
+    double alpha,
+    double const *A, int64_t rsa, int64_t csa,
+    double const *B, int64_t rsb, int64_t csb,
+    double beta,
+    double       *C, int64_t rsc, int64_t csc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm_strided", 'd', {},
+                          m, n, k, Gflop< double >::gemm( m, n, k ) );
+
+    internal::gemm_strided( m, n, k, alpha, A, rsa, csa, B, rsb, csb,
+                            beta, C, rsc, csc );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    int64_t m, int64_t n, int64_t k,
+    std::complex<float> alpha,
+    std::complex<float> const *A, int64_t rsa, int64_t csa,
+    std::complex<float> const *B, int64_t rsb, int64_t csb,
+    std::complex<float> beta,
+    std::complex<float>       *C, int64_t rsc, int64_t csc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm_strided", 'c', {},
+                          m, n, k,
+                          Gflop< std::complex<float> >::gemm( m, n, k ) );
+
+    internal::gemm_strided( m, n, k, alpha, A, rsa, csa, B, rsb, csb,
+                            beta, C, rsc, csc );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    int64_t m, int64_t n, int64_t k,
+    std::complex<double> alpha,
+    std::complex<double> const *A, int64_t rsa, int64_t csa,
+    std::complex<double> const *B, int64_t rsb, int64_t csb,
+    std::complex<double> beta,
+    std::complex<double>       *C, int64_t rsc, int64_t csc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemm_strided", 'z', {},
+                          m, n, k,
+                          Gflop< std::complex<double> >::gemm( m, n, k ) );
+
+    internal::gemm_strided( m, n, k, alpha, A, rsa, csa, B, rsb, csb,
+                            beta, C, rsc, csc );
+}
+
+}  // namespace blas
@@ -0,0 +1,299 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "blas/fortran.h"
+#include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace blas {
+namespace internal {
+
+#ifdef HAVE_GEMMT
+
+//------------------------------------------------------------------------------
+// Vendor gemmt, in column-major.
+inline void gemmt_vendor(
+    char uplo, char transA, char transB, blas_int n, blas_int k,
+    float alpha,
+    float const *A, blas_int lda,
+    float const *B, blas_int ldb,
+    float beta,
+    float       *C, blas_int ldc )
+{
+    BLAS_sgemmt( &uplo, &transA, &transB, &n, &k,
+                 &alpha, A, &lda, B, &ldb, &beta, C, &ldc );
+}
+
+inline void gemmt_vendor(
+    char uplo, char transA, char transB, blas_int n, blas_int k,
+    double alpha,
+    double const *A, blas_int lda,
+    double const *B, blas_int ldb,
+    double beta,
+    double       *C, blas_int ldc )
+{
+    BLAS_dgemmt( &uplo, &transA, &transB, &n, &k,
+                 &alpha, A, &lda, B, &ldb, &beta, C, &ldc );
+}
+
+inline void gemmt_vendor(
+    char uplo, char transA, char transB, blas_int n, blas_int k,
+    std::complex<float> alpha,
+    std::complex<float> const *A, blas_int lda,
+    std::complex<float> const *B, blas_int ldb,
+    std::complex<float> beta,
+    std::complex<float>       *C, blas_int ldc )
+{
+    BLAS_cgemmt( &uplo, &transA, &transB, &n, &k,
+                 (blas_complex_float*) &alpha,
+                 (blas_complex_float*) A, &lda,
+                 (blas_complex_float*) B, &ldb,
+                 (blas_complex_float*) &beta,
+                 (blas_complex_float*) C, &ldc );
+}
+
+inline void gemmt_vendor(
+    char uplo, char transA, char transB, blas_int n, blas_int k,
+    std::complex<double> alpha,
+    std::complex<double> const *A, blas_int lda,
+    std::complex<double> const *B, blas_int ldb,
+    std::complex<double> beta,
+    std::complex<double>       *C, blas_int ldc )
+{
+    BLAS_zgemmt( &uplo, &transA, &transB, &n, &k,
+                 (blas_complex_double*) &alpha,
+                 (blas_complex_double*) A, &lda,
+                 (blas_complex_double*) B, &ldb,
+                 (blas_complex_double*) &beta,
+                 (blas_complex_double*) C, &ldc );
+}
+
+#else
+
+// Block size of the fallback. Each diagonal tile is computed whole, so
+// the extra work is n nb k / 2 flops, small relative to n^2 k / 2.
+const int64_t gemmt_nb = 256;
+
+#endif
+
+//------------------------------------------------------------------------------
+/// C = alpha op(A) op(B) + beta C, updating only the uplo triangle of C.
+/// Calls the vendor gemmt if available (HAVE_GEMMT). Otherwise, for each
+/// block column of C, the nb-by-nb diagonal tile is computed by gemm into
+/// a workspace and its triangle added to C, and the panel below (lower)
+/// or above (upper) the tile is a single gemm; tiles in the other triangle
+/// are skipped.
+template <typename T>
+void gemmt(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t n, int64_t k,
+    T alpha,
+    T const *A, int64_t lda,
+    T const *B, int64_t ldb,
+    T beta,
+    T       *C, int64_t ldc )
+{
+    // check arguments
+    blas_error_if( layout != Layout::ColMajor &&
+                   layout != Layout::RowMajor );
+    blas_error_if( uplo != Uplo::Lower &&
+                   uplo != Uplo::Upper );
+    blas_error_if( transA != Op::NoTrans &&
+                   transA != Op::Trans &&
+                   transA != Op::ConjTrans );
+    blas_error_if( transB != Op::NoTrans &&
+                   transB != Op::Trans &&
+                   transB != Op::ConjTrans );
+    blas_error_if( n < 0 );
+    blas_error_if( k < 0 );
+
+    if ((transA == Op::NoTrans) ^ (layout == Layout::RowMajor))
+        blas_error_if( lda < n );
+    else
+        blas_error_if( lda < k );
+
+    if ((transB == Op::NoTrans) ^ (layout == Layout::RowMajor))
+        blas_error_if( ldb < k );
+    else
+        blas_error_if( ldb < n );
+
+    blas_error_if( ldc < n );
+
+    // quick return
+    if (n == 0)
+        return;
+
+    // row-major: compute C^T = op(B)^T op(A)^T in column-major,
+    // whose lower triangle is the upper triangle of C, and vice-versa
+    if (layout == Layout::RowMajor) {
+        uplo = (uplo == Uplo::Lower ? Uplo::Upper : Uplo::Lower);
+        std::swap( transA, transB );
+        std::swap( A, B );
+        std::swap( lda, ldb );
+    }
+
+#ifdef HAVE_GEMMT
+    // check for overflow in native BLAS integer type, if smaller than int64_t
+    if (sizeof(int64_t) > sizeof(blas_int)) {
+        blas_error_if( n   > std::numeric_limits<blas_int>::max() );
+        blas_error_if( k   > std::numeric_limits<blas_int>::max() );
+        blas_error_if( lda > std::numeric_limits<blas_int>::max() );
+        blas_error_if( ldb > std::numeric_limits<blas_int>::max() );
+        blas_error_if( ldc > std::numeric_limits<blas_int>::max() );
+    }
+
+    gemmt_vendor( uplo2char( uplo ), op2char( transA ), op2char( transB ),
+                  (blas_int) n, (blas_int) k,
+                  alpha, A, (blas_int) lda, B, (blas_int) ldb,
+                  beta, C, (blas_int) ldc );
+#else
+    int64_t nb = std::min( gemmt_nb, n );
+    std::vector<T> W( nb*nb );
+    for (int64_t j = 0; j < n; j += nb) {
+        int64_t jb = std::min( nb, n - j );
+        T const* Aj = A + (transA == Op::NoTrans ? j : j*lda);
+        T const* Bj = B + (transB == Op::NoTrans ? j*ldb : j);
+
+        // diagonal tile, W = alpha op(A)_j op(B)_j; then triangle of C
+        blas::gemm( Layout::ColMajor, transA, transB, jb, jb, k,
+                    alpha, Aj, lda, Bj, ldb, T( 0 ), W.data(), jb );
+        for (int64_t jj = 0; jj < jb; ++jj) {
+            int64_t i0 = (uplo == Uplo::Lower ? jj : 0);
+            int64_t i1 = (uplo == Uplo::Lower ? jb : jj + 1);
+            T* Cj = &C[ j + (j + jj)*ldc ];
+            T const* Wj = &W[ jj*jb ];
+            if (beta == T( 0 )) {
+                for (int64_t ii = i0; ii < i1; ++ii)
+                    Cj[ ii ] = Wj[ ii ];
+            }
+            else {
+                for (int64_t ii = i0; ii < i1; ++ii)
+                    Cj[ ii ] = Wj[ ii ] + beta * Cj[ ii ];
+            }
+        }
+
+        // off-diagonal panel, rows [ i0, i0 + mi )
+        int64_t i0 = (uplo == Uplo::Lower ? j + jb : 0);
+        int64_t mi = (uplo == Uplo::Lower ? n - i0 : j);
+        if (mi > 0) {
+            T const* Ai = A + (transA == Op::NoTrans ? i0 : i0*lda);
+            blas::gemm( Layout::ColMajor, transA, transB, mi, jb, k,
+                        alpha, Ai, lda, Bj, ldb,
+                        beta, &C[ i0 + j*ldc ], ldc );
+        }
+    }
+#endif
+}
+
+}  // namespace internal
+
+// =============================================================================
+// Overloaded wrappers for s, d, c, z precisions.
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemmt(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t n, int64_t k,
+    float alpha,
+    float const *A, int64_t lda,
+    float const *B, int64_t ldb,
+    float beta,
+    float       *C, int64_t ldc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemmt", 's',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( transA ), op2char( transB ) },
+                          n, 0, k, Gflop< float >::gemmt( n, k ) );
+
+    internal::gemmt( layout, uplo, transA, transB, n, k,
+                     alpha, A, lda, B, ldb, beta, C, ldc );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemmt(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t n, int64_t k,
+    double alpha,
+    double const *A, int64_t lda,
+    double const *B, int64_t ldb,
+    double beta,
+    double       *C, int64_t ldc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemmt", 'd',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( transA ), op2char( transB ) },
+                          n, 0, k, Gflop< double >::gemmt( n, k ) );
+
+    internal::gemmt( layout, uplo, transA, transB, n, k,
+                     alpha, A, lda, B, ldb, beta, C, ldc );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemmt(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t n, int64_t k,
+    std::complex<float> alpha,
+    std::complex<float> const *A, int64_t lda,
+    std::complex<float> const *B, int64_t ldb,
+    std::complex<float> beta,
+    std::complex<float>       *C, int64_t ldc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemmt", 'c',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( transA ), op2char( transB ) },
+                          n, 0, k, Gflop< std::complex<float> >::gemmt( n, k ) );
+
+    internal::gemmt( layout, uplo, transA, transB, n, k,
+                     alpha, A, lda, B, ldb, beta, C, ldc );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemmt(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t n, int64_t k,
+    std::complex<double> alpha,
+    std::complex<double> const *A, int64_t lda,
+    std::complex<double> const *B, int64_t ldb,
+    std::complex<double> beta,
+    std::complex<double>       *C, int64_t ldc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemmt", 'z',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( transA ), op2char( transB ) },
+                          n, 0, k, Gflop< std::complex<double> >::gemmt( n, k ) );
+
+    internal::gemmt( layout, uplo, transA, transB, n, k,
+                     alpha, A, lda, B, ldb, beta, C, ldc );
+}
+
+}  // namespace blas
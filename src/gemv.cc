@@ -5,6 +5,9 @@
 
 #include "blas/fortran.h"
 #include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
+#include "blas/tune.hh"
 
 #include <limits>
 
@@ -42,6 +45,20 @@ void gemv(
     blas_error_if( incx == 0 );
     blas_error_if( incy == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemv", 's',
+                          { layout2char( layout ), op2char( trans ) },
+                          m, n, 0, Gflop< float >::gemv( m, n ) );
+
+    // for tiny sizes, the in-library kernel is faster; see blas::tune
+    if (tune::use_kernel( tune::Routine::gemv, 's', trans, Op::NoTrans,
+                          max( m, n ) )) {
+        gemv< float, float, float >(
+            layout, trans, m, n,
+            alpha, A, lda, x, incx, beta, y, incy );
+        return;
+    }
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( m              > std::numeric_limits<blas_int>::max() );
@@ -97,6 +114,20 @@ void gemv(
     blas_error_if( incx == 0 );
     blas_error_if( incy == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemv", 'd',
+                          { layout2char( layout ), op2char( trans ) },
+                          m, n, 0, Gflop< double >::gemv( m, n ) );
+
+    // for tiny sizes, the in-library kernel is faster; see blas::tune
+    if (tune::use_kernel( tune::Routine::gemv, 'd', trans, Op::NoTrans,
+                          max( m, n ) )) {
+        gemv< double, double, double >(
+            layout, trans, m, n,
+            alpha, A, lda, x, incx, beta, y, incy );
+        return;
+    }
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( m              > std::numeric_limits<blas_int>::max() );
@@ -152,6 +183,20 @@ void gemv(
     blas_error_if( incx == 0 );
     blas_error_if( incy == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemv", 'c',
+                          { layout2char( layout ), op2char( trans ) },
+                          m, n, 0, Gflop< std::complex<float> >::gemv( m, n ) );
+
+    // for tiny sizes, the in-library kernel is faster; see blas::tune
+    if (tune::use_kernel( tune::Routine::gemv, 'c', trans, Op::NoTrans,
+                          max( m, n ) )) {
+        gemv< std::complex<float>, std::complex<float>, std::complex<float> >(
+            layout, trans, m, n,
+            alpha, A, lda, x, incx, beta, y, incy );
+        return;
+    }
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( m              > std::numeric_limits<blas_int>::max() );
@@ -243,6 +288,21 @@ void gemv(
     blas_error_if( incx == 0 );
     blas_error_if( incy == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemv", 'z',
+                          { layout2char( layout ), op2char( trans ) },
+                          m, n, 0,
+                          Gflop< std::complex<double> >::gemv( m, n ) );
+
+    // for tiny sizes, the in-library kernel is faster; see blas::tune
+    if (tune::use_kernel( tune::Routine::gemv, 'z', trans, Op::NoTrans,
+                          max( m, n ) )) {
+        gemv< std::complex<double>, std::complex<double>, std::complex<double> >(
+            layout, trans, m, n,
+            alpha, A, lda, x, incx, beta, y, incy );
+        return;
+    }
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( m              > std::numeric_limits<blas_int>::max() );
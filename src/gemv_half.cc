@@ -0,0 +1,194 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
+
+#include <vector>
+
+namespace blas {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// gemv for half precision A, x: x is converted to float once; each column
+/// of A is converted to float as it is used; and the result is accumulated
+/// in a float workspace, so y is rounded only once.
+/// TY is the half type or float.
+template <typename T, typename TY>
+void gemv_half(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    float alpha,
+    T const *A, int64_t lda,
+    T const *x, int64_t incx,
+    float beta,
+    TY *y, int64_t incy )
+{
+    // check arguments
+    blas_error_if( layout != Layout::ColMajor &&
+                   layout != Layout::RowMajor );
+    blas_error_if( trans != Op::NoTrans &&
+                   trans != Op::Trans &&
+                   trans != Op::ConjTrans );
+    blas_error_if( m < 0 );
+    blas_error_if( n < 0 );
+
+    if (layout == Layout::ColMajor)
+        blas_error_if( lda < m );
+    else
+        blas_error_if( lda < n );
+
+    blas_error_if( incx == 0 );
+    blas_error_if( incy == 0 );
+
+    // quick return
+    if (m == 0 || n == 0 || (alpha == 0 && beta == 1))
+        return;
+
+    if (layout == Layout::RowMajor) {
+        // A^T is column-major; real types, so ConjTrans is Trans
+        std::swap( m, n );
+        trans = (trans == Op::NoTrans ? Op::Trans : Op::NoTrans);
+    }
+    else if (trans == Op::ConjTrans) {
+        trans = Op::Trans;
+    }
+
+    int64_t lenx = (trans == Op::NoTrans ? n : m);
+    int64_t leny = (trans == Op::NoTrans ? m : n);
+    int64_t kx = (incx > 0 ? 0 : (-lenx + 1)*incx);
+    int64_t ky = (incy > 0 ? 0 : (-leny + 1)*incy);
+
+    std::vector<float> w( leny, 0.0f );
+    if (alpha != 0) {
+        std::vector<float> xf( lenx );
+        for (int64_t j = 0; j < lenx; ++j)
+            xf[ j ] = x[ kx + j*incx ];
+
+        std::vector<float> col( m );
+        if (trans == Op::NoTrans) {
+            // w += A(:, j) x(j)
+            for (int64_t j = 0; j < n; ++j) {
+                convert( m, &A[ j*lda ], col.data() );
+                float xj = xf[ j ];
+                for (int64_t i = 0; i < m; ++i)
+                    w[ i ] += col[ i ] * xj;
+            }
+        }
+        else {
+            // w(j) = A(:, j)^T x
+            for (int64_t j = 0; j < n; ++j) {
+                convert( m, &A[ j*lda ], col.data() );
+                float sum = 0;
+                for (int64_t i = 0; i < m; ++i)
+                    sum += col[ i ] * xf[ i ];
+                w[ j ] = sum;
+            }
+        }
+    }
+
+    // y = alpha w + beta y; the only rounding to TY
+    for (int64_t i = 0; i < leny; ++i) {
+        TY& yi = y[ ky + i*incy ];
+        if (beta == 0)
+            yi = alpha * w[ i ];
+        else
+            yi = alpha * w[ i ] + beta * float( yi );
+    }
+}
+
+}  // namespace internal
+
+// =============================================================================
+// Overloaded wrappers for half precision, float16 and bfloat16.
+// A and x are half; y is half or float. Products are accumulated in float.
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemv
+void gemv(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    float alpha,
+    float16 const *A, int64_t lda,
+    float16 const *x, int64_t incx,
+    float beta,
+    float16 *y, int64_t incy )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemv", 'h',
+                          { layout2char( layout ), op2char( trans ) },
+                          m, n, 0, Gflop< float16 >::gemv( m, n ) );
+
+    internal::gemv_half( layout, trans, m, n,
+                         alpha, A, lda, x, incx, beta, y, incy );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemv
+void gemv(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    float alpha,
+    float16 const *A, int64_t lda,
+    float16 const *x, int64_t incx,
+    float beta,
+    float *y, int64_t incy )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemv", 'h',
+                          { layout2char( layout ), op2char( trans ) },
+                          m, n, 0, Gflop< float16 >::gemv( m, n ) );
+
+    internal::gemv_half( layout, trans, m, n,
+                         alpha, A, lda, x, incx, beta, y, incy );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemv
+void gemv(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    float alpha,
+    bfloat16 const *A, int64_t lda,
+    bfloat16 const *x, int64_t incx,
+    float beta,
+    bfloat16 *y, int64_t incy )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemv", 'b',
+                          { layout2char( layout ), op2char( trans ) },
+                          m, n, 0, Gflop< bfloat16 >::gemv( m, n ) );
+
+    internal::gemv_half( layout, trans, m, n,
+                         alpha, A, lda, x, incx, beta, y, incy );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemv
+void gemv(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    float alpha,
+    bfloat16 const *A, int64_t lda,
+    bfloat16 const *x, int64_t incx,
+    float beta,
+    float *y, int64_t incy )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemv", 'b',
+                          { layout2char( layout ), op2char( trans ) },
+                          m, n, 0, Gflop< bfloat16 >::gemv( m, n ) );
+
+    internal::gemv_half( layout, trans, m, n,
+                         alpha, A, lda, x, incx, beta, y, incy );
+}
+
+}  // namespace blas
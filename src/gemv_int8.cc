@@ -0,0 +1,212 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
+
+#include <vector>
+
+namespace blas {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// y = alpha w + beta y, in int32, wrapping on overflow. Scale must be null.
+inline void gemv_int8_update(
+    int32_t w, int32_t alpha, int32_t beta, int32_t& y, float )
+{
+    int64_t r = int64_t( alpha ) * w;
+    if (beta != 0)
+        r += int64_t( beta ) * y;
+    y = int32_t( uint32_t( r ) );
+}
+
+/// y = scale alpha w + beta y, in float.
+inline void gemv_int8_update(
+    int32_t w, float alpha, float beta, float& y, float scale )
+{
+    float r = scale * alpha * float( w );
+    y = (beta == 0 ? r : r + beta * y);
+}
+
+//------------------------------------------------------------------------------
+/// gemv for 8-bit integer A, x: products are accumulated exactly in an
+/// int32 workspace w, then y = alpha w + beta y is applied once per entry,
+/// with the dequantization scale in the float case.
+/// TX is int8_t or uint8_t; TS and TY are both int32_t or both float.
+template <typename TX, typename TS, typename TY>
+void gemv_int8(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    TS alpha,
+    int8_t const *A, int64_t lda,
+    TX const *x, int64_t incx,
+    TS beta,
+    TY *y, int64_t incy,
+    float const* scale )
+{
+    // check arguments
+    blas_error_if( layout != Layout::ColMajor &&
+                   layout != Layout::RowMajor );
+    blas_error_if( trans != Op::NoTrans &&
+                   trans != Op::Trans &&
+                   trans != Op::ConjTrans );
+    blas_error_if( m < 0 );
+    blas_error_if( n < 0 );
+
+    if (layout == Layout::ColMajor)
+        blas_error_if( lda < m );
+    else
+        blas_error_if( lda < n );
+
+    blas_error_if( incx == 0 );
+    blas_error_if( incy == 0 );
+
+    // quick return
+    if (m == 0 || n == 0)
+        return;
+
+    if (layout == Layout::RowMajor) {
+        // A^T is column-major; real types, so ConjTrans is Trans
+        std::swap( m, n );
+        trans = (trans == Op::NoTrans ? Op::Trans : Op::NoTrans);
+    }
+    else if (trans == Op::ConjTrans) {
+        trans = Op::Trans;
+    }
+
+    int64_t lenx = (trans == Op::NoTrans ? n : m);
+    int64_t leny = (trans == Op::NoTrans ? m : n);
+    int64_t kx = (incx > 0 ? 0 : (-lenx + 1)*incx);
+    int64_t ky = (incy > 0 ? 0 : (-leny + 1)*incy);
+
+    std::vector<int32_t> xi( lenx );
+    for (int64_t j = 0; j < lenx; ++j)
+        xi[ j ] = x[ kx + j*incx ];
+
+    std::vector<int32_t> w( leny, 0 );
+    if (trans == Op::NoTrans) {
+        // w += A(:, j) x(j)
+        for (int64_t j = 0; j < n; ++j) {
+            int8_t const* Aj = &A[ j*lda ];
+            int32_t xj = xi[ j ];
+            for (int64_t i = 0; i < m; ++i)
+                w[ i ] += Aj[ i ] * xj;
+        }
+    }
+    else {
+        // w(j) = A(:, j)^T x
+        #pragma omp parallel for schedule(static)
+        for (int64_t j = 0; j < n; ++j) {
+            int8_t const* Aj = &A[ j*lda ];
+            int32_t sum = 0;
+            for (int64_t i = 0; i < m; ++i)
+                sum += Aj[ i ] * xi[ i ];
+            w[ j ] = sum;
+        }
+    }
+
+    // y = alpha w + beta y, with scale
+    for (int64_t i = 0; i < leny; ++i) {
+        gemv_int8_update( w[ i ], alpha, beta, y[ ky + i*incy ],
+                          scale ? scale[ i ] : 1.0f );
+    }
+}
+
+}  // namespace internal
+
+// =============================================================================
+// Overloaded wrappers for 8-bit integers: A is int8; x is int8 or uint8.
+// Products are accumulated in int32. y is int32, or float, dequantized
+// with an optional per-entry scale.
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemv
+void gemv(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    int32_t alpha,
+    int8_t const *A, int64_t lda,
+    int8_t const *x, int64_t incx,
+    int32_t beta,
+    int32_t *y, int64_t incy )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemv", 'i',
+                          { layout2char( layout ), op2char( trans ) },
+                          m, n, 0, Gflop< int8_t >::gemv( m, n ) );
+
+    internal::gemv_int8( layout, trans, m, n,
+                         alpha, A, lda, x, incx, beta, y, incy, nullptr );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemv
+void gemv(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    int32_t alpha,
+    int8_t  const *A, int64_t lda,
+    uint8_t const *x, int64_t incx,
+    int32_t beta,
+    int32_t *y, int64_t incy )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemv", 'u',
+                          { layout2char( layout ), op2char( trans ) },
+                          m, n, 0, Gflop< int8_t >::gemv( m, n ) );
+
+    internal::gemv_int8( layout, trans, m, n,
+                         alpha, A, lda, x, incx, beta, y, incy, nullptr );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemv
+void gemv(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    float alpha,
+    int8_t const *A, int64_t lda,
+    int8_t const *x, int64_t incx,
+    float beta,
+    float *y, int64_t incy,
+    float const *scale )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemv", 'i',
+                          { layout2char( layout ), op2char( trans ) },
+                          m, n, 0, Gflop< int8_t >::gemv( m, n ) );
+
+    internal::gemv_int8( layout, trans, m, n,
+                         alpha, A, lda, x, incx, beta, y, incy, scale );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemv
+void gemv(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    float alpha,
+    int8_t  const *A, int64_t lda,
+    uint8_t const *x, int64_t incx,
+    float beta,
+    float *y, int64_t incy,
+    float const *scale )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "gemv", 'u',
+                          { layout2char( layout ), op2char( trans ) },
+                          m, n, 0, Gflop< int8_t >::gemv( m, n ) );
+
+    internal::gemv_int8( layout, trans, m, n,
+                         alpha, A, lda, x, incx, beta, y, incy, scale );
+}
+
+}  // namespace blas
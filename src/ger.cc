@@ -5,6 +5,8 @@
 
 #include "blas/fortran.h"
 #include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 
 #include <limits>
 
@@ -36,6 +38,11 @@ void ger(
     else
         blas_error_if( lda < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "ger", 's',
+                          { layout2char( layout ) },
+                          m, n, 0, Gflop< float >::ger( m, n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( m              > std::numeric_limits<blas_int>::max() );
@@ -83,6 +90,11 @@ void ger(
     else
         blas_error_if( lda < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "ger", 'd',
+                          { layout2char( layout ) },
+                          m, n, 0, Gflop< double >::ger( m, n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( m              > std::numeric_limits<blas_int>::max() );
@@ -130,6 +142,11 @@ void ger(
     else
         blas_error_if( lda < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "ger", 'c',
+                          { layout2char( layout ) },
+                          m, n, 0, Gflop< std::complex<float> >::ger( m, n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( m              > std::numeric_limits<blas_int>::max() );
@@ -196,6 +213,11 @@ void ger(
     else
         blas_error_if( lda < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "ger", 'z',
+                          { layout2char( layout ) },
+                          m, n, 0, Gflop< std::complex<double> >::ger( m, n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( m              > std::numeric_limits<blas_int>::max() );
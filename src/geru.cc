@@ -5,6 +5,8 @@
 
 #include "blas/fortran.h"
 #include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 
 #include <limits>
 
@@ -62,6 +64,11 @@ void geru(
     else
         blas_error_if( lda < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "geru", 'c',
+                          { layout2char( layout ) },
+                          m, n, 0, Gflop< std::complex<float> >::ger( m, n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( m              > std::numeric_limits<blas_int>::max() );
@@ -117,6 +124,11 @@ void geru(
     else
         blas_error_if( lda < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "geru", 'z',
+                          { layout2char( layout ) },
+                          m, n, 0, Gflop< std::complex<double> >::ger( m, n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( m              > std::numeric_limits<blas_int>::max() );
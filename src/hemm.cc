@@ -5,6 +5,8 @@
 
 #include "blas/fortran.h"
 #include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 
 #include <limits>
 
@@ -84,6 +86,13 @@ void hemm(
         blas_error_if( ldc < n );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "hemm", 'c',
+                          { layout2char( layout ), side2char( side ),
+                            uplo2char( uplo ) },
+                          m, n, 0,
+                          Gflop< std::complex<float> >::hemm( side, m, n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( m   > std::numeric_limits<blas_int>::max() );
@@ -155,6 +164,13 @@ void hemm(
         blas_error_if( ldc < n );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "hemm", 'z',
+                          { layout2char( layout ), side2char( side ),
+                            uplo2char( uplo ) },
+                          m, n, 0,
+                          Gflop< std::complex<double> >::hemm( side, m, n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( m   > std::numeric_limits<blas_int>::max() );
@@ -5,6 +5,8 @@
 
 #include "blas/fortran.h"
 #include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 
 #include <limits>
 
@@ -58,6 +60,11 @@ void her(
     blas_error_if( lda < n );
     blas_error_if( incx == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "her", 'c',
+                          { layout2char( layout ), uplo2char( uplo ) },
+                          n, 0, 0, Gflop< std::complex<float> >::her( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n              > std::numeric_limits<blas_int>::max() );
@@ -115,6 +122,11 @@ void her(
     blas_error_if( lda < n );
     blas_error_if( incx == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "her", 'z',
+                          { layout2char( layout ), uplo2char( uplo ) },
+                          n, 0, 0, Gflop< std::complex<double> >::her( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n              > std::numeric_limits<blas_int>::max() );
@@ -5,6 +5,8 @@
 
 #include "blas/fortran.h"
 #include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 
 #include <limits>
 
@@ -62,6 +64,11 @@ void her2(
     blas_error_if( incx == 0 );
     blas_error_if( incy == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "her2", 'c',
+                          { layout2char( layout ), uplo2char( uplo ) },
+                          n, 0, 0, Gflop< std::complex<float> >::her2( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n              > std::numeric_limits<blas_int>::max() );
@@ -109,6 +116,11 @@ void her2(
     blas_error_if( incx == 0 );
     blas_error_if( incy == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "her2", 'z',
+                          { layout2char( layout ), uplo2char( uplo ) },
+                          n, 0, 0, Gflop< std::complex<double> >::her2( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n              > std::numeric_limits<blas_int>::max() );
@@ -5,6 +5,8 @@
 
 #include "blas/fortran.h"
 #include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 
 #include <limits>
 
@@ -79,6 +81,13 @@ void her2k(
 
     blas_error_if( ldc < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "her2k", 'c',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( trans ) },
+                          n, 0, k,
+                          Gflop< std::complex<float> >::her2k( n, k ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n   > std::numeric_limits<blas_int>::max() );
@@ -144,6 +153,13 @@ void her2k(
 
     blas_error_if( ldc < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "her2k", 'z',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( trans ) },
+                          n, 0, k,
+                          Gflop< std::complex<double> >::her2k( n, k ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n   > std::numeric_limits<blas_int>::max() );
@@ -5,6 +5,8 @@
 
 #include "blas/fortran.h"
 #include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 
 #include <limits>
 
@@ -72,6 +74,12 @@ void herk(
 
     blas_error_if( ldc < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "herk", 'c',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( trans ) },
+                          n, 0, k, Gflop< std::complex<float> >::herk( n, k ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n   > std::numeric_limits<blas_int>::max() );
@@ -130,6 +138,13 @@ void herk(
 
     blas_error_if( ldc < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "herk", 'z',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( trans ) },
+                          n, 0, k,
+                          Gflop< std::complex<double> >::herk( n, k ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n   > std::numeric_limits<blas_int>::max() );
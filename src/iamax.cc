@@ -5,6 +5,8 @@
 
 #include "blas/fortran.h"
 #include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 
 #include <limits>
 
@@ -23,6 +25,10 @@ int64_t iamax(
     blas_error_if( n < 0 );      // standard BLAS returns, doesn't fail
     blas_error_if( incx <= 0 );  // standard BLAS returns, doesn't fail
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "iamax", 's', {},
+                          n, 0, 0, Gflop< float >::iamax( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n    > std::numeric_limits<blas_int>::max() );
@@ -44,6 +50,10 @@ int64_t iamax(
     blas_error_if( n < 0 );      // standard BLAS returns, doesn't fail
     blas_error_if( incx <= 0 );  // standard BLAS returns, doesn't fail
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "iamax", 'd', {},
+                          n, 0, 0, Gflop< double >::iamax( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n    > std::numeric_limits<blas_int>::max() );
@@ -65,6 +75,10 @@ int64_t iamax(
     blas_error_if( n < 0 );      // standard BLAS returns, doesn't fail
     blas_error_if( incx <= 0 );  // standard BLAS returns, doesn't fail
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "iamax", 'c', {},
+                          n, 0, 0, Gflop< std::complex<float> >::iamax( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n    > std::numeric_limits<blas_int>::max() );
@@ -87,6 +101,10 @@ int64_t iamax(
     blas_error_if( n < 0 );      // standard BLAS returns, doesn't fail
     blas_error_if( incx <= 0 );  // standard BLAS returns, doesn't fail
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "iamax", 'z', {},
+                          n, 0, 0, Gflop< std::complex<double> >::iamax( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n    > std::numeric_limits<blas_int>::max() );
@@ -0,0 +1,496 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
+
+#include <algorithm>
+#include <vector>
+
+#if defined( __AVX__ )
+    #include <immintrin.h>
+#endif
+
+namespace blas {
+namespace internal {
+
+// Transposes recurse on the larger dimension, splitting at multiples of
+// matcopy_nb, down to nb-by-nb leaves, which fit in L1 cache for any type.
+// Leaves are done in r-by-r register blocks. Threads, if the matrix has at
+// least matcopy_parallel_min entries, each take tiles of matcopy_tile.
+const int64_t matcopy_nb           = 32;
+const int64_t matcopy_tile         = 256;
+const int64_t matcopy_parallel_min = 128*128;
+
+//------------------------------------------------------------------------------
+/// Size r of the register block transposed by matcopy_kernel.
+template <typename T>
+struct MatcopyR
+{
+    static const int64_t value = 4;
+};
+
+#if defined( __AVX__ )
+template <>
+struct MatcopyR<float>
+{
+    static const int64_t value = 8;
+};
+#endif
+
+//------------------------------------------------------------------------------
+/// B = alpha op(A) for one r-by-r register block, where op is transpose,
+/// conjugated if conj.
+template <typename T>
+inline void matcopy_kernel(
+    T alpha, bool conj, T const* A, int64_t lda, T* B, int64_t ldb )
+{
+    const int64_t r = MatcopyR<T>::value;
+    for (int64_t j = 0; j < r; ++j) {
+        for (int64_t i = 0; i < r; ++i)
+            B[ j + i*ldb ] = alpha * conj_if( conj, A[ i + j*lda ] );
+    }
+}
+
+#if defined( __AVX__ )
+//------------------------------------------------------------------------------
+/// 8-by-8 float transpose in AVX registers: unpack pairs, shuffle quads,
+/// then swap 128-bit lanes.
+inline void matcopy_kernel(
+    float alpha, bool, float const* A, int64_t lda, float* B, int64_t ldb )
+{
+    __m256 a[ 8 ], t[ 8 ];
+    for (int i = 0; i < 8; ++i)
+        a[ i ] = _mm256_loadu_ps( &A[ i*lda ] );
+    for (int i = 0; i < 8; i += 2) {
+        t[ i   ] = _mm256_unpacklo_ps( a[ i ], a[ i+1 ] );
+        t[ i+1 ] = _mm256_unpackhi_ps( a[ i ], a[ i+1 ] );
+    }
+    for (int i = 0; i < 8; i += 4) {
+        a[ i   ] = _mm256_shuffle_ps( t[ i   ], t[ i+2 ], _MM_SHUFFLE( 1, 0, 1, 0 ) );
+        a[ i+1 ] = _mm256_shuffle_ps( t[ i   ], t[ i+2 ], _MM_SHUFFLE( 3, 2, 3, 2 ) );
+        a[ i+2 ] = _mm256_shuffle_ps( t[ i+1 ], t[ i+3 ], _MM_SHUFFLE( 1, 0, 1, 0 ) );
+        a[ i+3 ] = _mm256_shuffle_ps( t[ i+1 ], t[ i+3 ], _MM_SHUFFLE( 3, 2, 3, 2 ) );
+    }
+    __m256 alpha_ = _mm256_set1_ps( alpha );
+    for (int i = 0; i < 4; ++i) {
+        __m256 lo = _mm256_permute2f128_ps( a[ i ], a[ i+4 ], 0x20 );
+        __m256 hi = _mm256_permute2f128_ps( a[ i ], a[ i+4 ], 0x31 );
+        _mm256_storeu_ps( &B[  i   *ldb ], _mm256_mul_ps( alpha_, lo ) );
+        _mm256_storeu_ps( &B[ (i+4)*ldb ], _mm256_mul_ps( alpha_, hi ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// 4-by-4 double transpose in AVX registers.
+inline void matcopy_kernel(
+    double alpha, bool, double const* A, int64_t lda, double* B, int64_t ldb )
+{
+    __m256d a0 = _mm256_loadu_pd( &A[ 0*lda ] );
+    __m256d a1 = _mm256_loadu_pd( &A[ 1*lda ] );
+    __m256d a2 = _mm256_loadu_pd( &A[ 2*lda ] );
+    __m256d a3 = _mm256_loadu_pd( &A[ 3*lda ] );
+    __m256d t0 = _mm256_unpacklo_pd( a0, a1 );
+    __m256d t1 = _mm256_unpackhi_pd( a0, a1 );
+    __m256d t2 = _mm256_unpacklo_pd( a2, a3 );
+    __m256d t3 = _mm256_unpackhi_pd( a2, a3 );
+    __m256d alpha_ = _mm256_set1_pd( alpha );
+    _mm256_storeu_pd( &B[ 0*ldb ], _mm256_mul_pd( alpha_,
+                      _mm256_permute2f128_pd( t0, t2, 0x20 ) ) );
+    _mm256_storeu_pd( &B[ 1*ldb ], _mm256_mul_pd( alpha_,
+                      _mm256_permute2f128_pd( t1, t3, 0x20 ) ) );
+    _mm256_storeu_pd( &B[ 2*ldb ], _mm256_mul_pd( alpha_,
+                      _mm256_permute2f128_pd( t0, t2, 0x31 ) ) );
+    _mm256_storeu_pd( &B[ 3*ldb ], _mm256_mul_pd( alpha_,
+                      _mm256_permute2f128_pd( t1, t3, 0x31 ) ) );
+}
+#endif
+
+//------------------------------------------------------------------------------
+/// B = alpha op(A) for an m-by-n leaf A, m, n <= matcopy_nb, column-major,
+/// where op is transpose, conjugated if conj. Register blocks, then edges.
+template <typename T>
+void matcopy_trans_leaf(
+    int64_t m, int64_t n, T alpha, bool conj,
+    T const* A, int64_t lda, T* B, int64_t ldb )
+{
+    const int64_t r = MatcopyR<T>::value;
+    int64_t mr = m - m % r;
+    int64_t nr = n - n % r;
+    for (int64_t j = 0; j < nr; j += r) {
+        for (int64_t i = 0; i < mr; i += r)
+            matcopy_kernel( alpha, conj, &A[ i + j*lda ], lda,
+                            &B[ j + i*ldb ], ldb );
+    }
+    for (int64_t j = 0; j < n; ++j) {
+        for (int64_t i = (j < nr ? mr : 0); i < m; ++i)
+            B[ j + i*ldb ] = alpha * conj_if( conj, A[ i + j*lda ] );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Cache-oblivious B = alpha op(A), column-major, where op is transpose,
+/// conjugated if conj: halves the larger dimension until a leaf.
+template <typename T>
+void matcopy_trans_rec(
+    int64_t m, int64_t n, T alpha, bool conj,
+    T const* A, int64_t lda, T* B, int64_t ldb )
+{
+    const int64_t nb = matcopy_nb;
+    if (m <= nb && n <= nb) {
+        matcopy_trans_leaf( m, n, alpha, conj, A, lda, B, ldb );
+    }
+    else if (m >= n) {
+        int64_t h = (m/2 + nb - 1) / nb * nb;
+        matcopy_trans_rec( h,     n, alpha, conj, A,     lda, B,         ldb );
+        matcopy_trans_rec( m - h, n, alpha, conj, A + h, lda, B + h*ldb, ldb );
+    }
+    else {
+        int64_t h = (n/2 + nb - 1) / nb * nb;
+        matcopy_trans_rec( m, h,     alpha, conj, A,         lda, B,     ldb );
+        matcopy_trans_rec( m, n - h, alpha, conj, A + h*lda, lda, B + h, ldb );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Out-of-place B = alpha op(A), column-major, A m-by-n.
+template <typename T>
+void omatcopy_cm(
+    blas::Op trans, int64_t m, int64_t n, T alpha,
+    T const* A, int64_t lda, T* B, int64_t ldb )
+{
+    bool parallel = m*n >= matcopy_parallel_min;
+    if (trans == Op::NoTrans) {
+        #pragma omp parallel for schedule(static) if (parallel)
+        for (int64_t j = 0; j < n; ++j) {
+            T const* Aj = &A[ j*lda ];
+            T* Bj = &B[ j*ldb ];
+            if (alpha == T( 1 ))
+                std::copy( Aj, Aj + m, Bj );
+            else
+                for (int64_t i = 0; i < m; ++i)
+                    Bj[ i ] = alpha * Aj[ i ];
+        }
+    }
+    else {
+        bool conj = (trans == Op::ConjTrans);
+        const int64_t tile = matcopy_tile;
+        #pragma omp parallel for collapse(2) schedule(dynamic) if (parallel)
+        for (int64_t j = 0; j < n; j += tile) {
+            for (int64_t i = 0; i < m; i += tile) {
+                matcopy_trans_rec( std::min( tile, m - i ),
+                                   std::min( tile, n - j ), alpha, conj,
+                                   &A[ i + j*lda ], lda, &B[ j + i*ldb ], ldb );
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// In-place transpose of the packed m-by-n A, column-major with lda = m,
+/// into the packed n-by-m B = alpha op(A), by following the cycles of the
+/// permutation taking A(i, j) at i + j m to B(j, i) at j + i n.
+/// Needs m n bits to mark entries already moved.
+template <typename T>
+void imatcopy_cycles( int64_t m, int64_t n, T alpha, bool conj, T* A )
+{
+    int64_t mn = m*n;
+    std::vector<bool> done( mn, false );
+    for (int64_t start = 0; start < mn; ++start) {
+        if (done[ start ])
+            continue;
+        T x = A[ start ];
+        int64_t k = start;
+        do {
+            int64_t next = k / m + (k % m)*n;
+            T y = A[ next ];
+            A[ next ] = alpha * conj_if( conj, x );
+            done[ next ] = true;
+            x = y;
+            k = next;
+        } while (k != start);
+    }
+}
+
+//------------------------------------------------------------------------------
+/// In-place B = alpha op(A), column-major, A m-by-n.
+template <typename T>
+void imatcopy_cm(
+    blas::Op trans, int64_t m, int64_t n, T alpha,
+    T* A, int64_t lda, int64_t ldb )
+{
+    bool parallel = m*n >= matcopy_parallel_min;
+    if (trans == Op::NoTrans) {
+        // Columns move down in memory if ldb < lda, so go forward, else up,
+        // so go backward. Moves use copy, i.e., memmove, which handles the
+        // overlap; alpha is then applied in place, in parallel.
+        if (ldb < lda) {
+            for (int64_t j = 1; j < n; ++j)
+                std::copy( &A[ j*lda ], &A[ j*lda + m ], &A[ j*ldb ] );
+        }
+        else if (ldb > lda) {
+            for (int64_t j = n-1; j >= 1; --j)
+                std::copy_backward( &A[ j*lda ], &A[ j*lda + m ],
+                                    &A[ j*ldb + m ] );
+        }
+        if (alpha != T( 1 )) {
+            #pragma omp parallel for schedule(static) if (parallel)
+            for (int64_t j = 0; j < n; ++j)
+                for (int64_t i = 0; i < m; ++i)
+                    A[ i + j*ldb ] *= alpha;
+        }
+        return;
+    }
+
+    bool conj = (trans == Op::ConjTrans);
+    if (m == n && lda == ldb) {
+        // square: swap nb-by-nb tiles (i, j) and (j, i), i >= j,
+        // which are disjoint across block columns j
+        const int64_t nb = matcopy_nb;
+        #pragma omp parallel for schedule(dynamic) if (parallel)
+        for (int64_t jb = 0; jb < n; jb += nb) {
+            int64_t j1 = std::min( jb + nb, n );
+            for (int64_t ib = jb; ib < n; ib += nb) {
+                int64_t i1 = std::min( ib + nb, n );
+                for (int64_t j = jb; j < j1; ++j) {
+                    for (int64_t i = (ib == jb ? j : ib); i < i1; ++i) {
+                        T x = A[ i + j*lda ];
+                        A[ i + j*lda ] = alpha * conj_if( conj, A[ j + i*lda ] );
+                        A[ j + i*lda ] = alpha * conj_if( conj, x );
+                    }
+                }
+            }
+        }
+    }
+    else {
+        // pack to lda = m, transpose by cycles, then unpack to ldb
+        imatcopy_cm( Op::NoTrans, m, n, T( 1 ), A, lda, m );
+        imatcopy_cycles( m, n, alpha, conj, A );
+        imatcopy_cm( Op::NoTrans, n, m, T( 1 ), A, n, ldb );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Checks arguments common to omatcopy and imatcopy.
+inline void matcopy_check(
+    blas::Layout layout, blas::Op trans, int64_t m, int64_t n,
+    int64_t lda, int64_t ldb )
+{
+    blas_error_if( layout != Layout::ColMajor &&
+                   layout != Layout::RowMajor );
+    blas_error_if( trans != Op::NoTrans &&
+                   trans != Op::Trans &&
+                   trans != Op::ConjTrans );
+    blas_error_if( m < 0 );
+    blas_error_if( n < 0 );
+
+    // op(A) is Bm-by-Bn
+    int64_t Bm = (trans == Op::NoTrans ? m : n);
+    int64_t Bn = (trans == Op::NoTrans ? n : m);
+    if (layout == Layout::ColMajor) {
+        blas_error_if( lda < m );
+        blas_error_if( ldb < Bm );
+    }
+    else {
+        blas_error_if( lda < n );
+        blas_error_if( ldb < Bn );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// B = alpha op(A), where A is m-by-n. A RowMajor m-by-n matrix is
+/// a ColMajor n-by-m matrix, so RowMajor swaps m and n.
+template <typename T>
+void omatcopy(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    T alpha,
+    T const *A, int64_t lda,
+    T       *B, int64_t ldb )
+{
+    matcopy_check( layout, trans, m, n, lda, ldb );
+
+    // quick return
+    if (m == 0 || n == 0)
+        return;
+
+    if (layout == Layout::RowMajor)
+        std::swap( m, n );
+    omatcopy_cm( trans, m, n, alpha, A, lda, B, ldb );
+}
+
+//------------------------------------------------------------------------------
+/// In-place B = alpha op(A), where A is m-by-n.
+template <typename T>
+void imatcopy(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    T alpha,
+    T *AB, int64_t lda, int64_t ldb )
+{
+    matcopy_check( layout, trans, m, n, lda, ldb );
+
+    // quick return
+    if (m == 0 || n == 0)
+        return;
+
+    if (layout == Layout::RowMajor)
+        std::swap( m, n );
+    imatcopy_cm( trans, m, n, alpha, AB, lda, ldb );
+}
+
+}  // namespace internal
+
+// =============================================================================
+// Overloaded wrappers for s, d, c, z precisions.
+
+// -----------------------------------------------------------------------------
+/// @ingroup copy
+void omatcopy(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    float alpha,
+    float const *A, int64_t lda,
+    float       *B, int64_t ldb )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "omatcopy", 's',
+                          { layout2char( layout ), op2char( trans ) },
+                          m, n, 0, Gflop< float >::omatcopy( m, n ) );
+
+    internal::omatcopy( layout, trans, m, n, alpha, A, lda, B, ldb );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup copy
+void omatcopy(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    double alpha,
+    double const *A, int64_t lda,
+    double       *B, int64_t ldb )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "omatcopy", 'd',
+                          { layout2char( layout ), op2char( trans ) },
+                          m, n, 0, Gflop< double >::omatcopy( m, n ) );
+
+    internal::omatcopy( layout, trans, m, n, alpha, A, lda, B, ldb );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup copy
+void omatcopy(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    std::complex<float> alpha,
+    std::complex<float> const *A, int64_t lda,
+    std::complex<float>       *B, int64_t ldb )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "omatcopy", 'c',
+                          { layout2char( layout ), op2char( trans ) },
+                          m, n, 0,
+                          Gflop< std::complex<float> >::omatcopy( m, n ) );
+
+    internal::omatcopy( layout, trans, m, n, alpha, A, lda, B, ldb );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup copy
+void omatcopy(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    std::complex<double> alpha,
+    std::complex<double> const *A, int64_t lda,
+    std::complex<double>       *B, int64_t ldb )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "omatcopy", 'z',
+                          { layout2char( layout ), op2char( trans ) },
+                          m, n, 0,
+                          Gflop< std::complex<double> >::omatcopy( m, n ) );
+
+    internal::omatcopy( layout, trans, m, n, alpha, A, lda, B, ldb );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup copy
+void imatcopy(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    float alpha,
+    float *AB, int64_t lda, int64_t ldb )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "imatcopy", 's',
+                          { layout2char( layout ), op2char( trans ) },
+                          m, n, 0, Gflop< float >::imatcopy( m, n ) );
+
+    internal::imatcopy( layout, trans, m, n, alpha, AB, lda, ldb );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup copy
+void imatcopy(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    double alpha,
+    double *AB, int64_t lda, int64_t ldb )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "imatcopy", 'd',
+                          { layout2char( layout ), op2char( trans ) },
+                          m, n, 0, Gflop< double >::imatcopy( m, n ) );
+
+    internal::imatcopy( layout, trans, m, n, alpha, AB, lda, ldb );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup copy
+void imatcopy(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    std::complex<float> alpha,
+    std::complex<float> *AB, int64_t lda, int64_t ldb )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "imatcopy", 'c',
+                          { layout2char( layout ), op2char( trans ) },
+                          m, n, 0,
+                          Gflop< std::complex<float> >::imatcopy( m, n ) );
+
+    internal::imatcopy( layout, trans, m, n, alpha, AB, lda, ldb );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup copy
+void imatcopy(
+    blas::Layout layout,
+    blas::Op trans,
+    int64_t m, int64_t n,
+    std::complex<double> alpha,
+    std::complex<double> *AB, int64_t lda, int64_t ldb )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "imatcopy", 'z',
+                          { layout2char( layout ), op2char( trans ) },
+                          m, n, 0,
+                          Gflop< std::complex<double> >::imatcopy( m, n ) );
+
+    internal::imatcopy( layout, trans, m, n, alpha, AB, lda, ldb );
+}
+
+}  // namespace blas
@@ -0,0 +1,603 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace blas {
+namespace internal {
+
+// Reducing across columns, e.g., row norms of a ColMajor matrix, each thread
+// accumulates a block of norms_nb outputs, which stays in L1 cache, while
+// reading down the columns of A. Threads are used if A has at least
+// norms_parallel_min entries.
+const int64_t norms_nb           = 256;
+const int64_t norms_parallel_min = 128*128;
+
+//------------------------------------------------------------------------------
+/// Largest of |Re(x)|, |Im(x)|, which bounds |x| within a factor sqrt(2);
+/// used to scale the 2-norm.
+template <typename T>
+inline T norms_absmax( T x )
+{
+    return std::abs( x );
+}
+
+template <typename T>
+inline T norms_absmax( std::complex<T> x )
+{
+    return std::max( std::abs( real( x ) ), std::abs( imag( x ) ) );
+}
+
+//------------------------------------------------------------------------------
+/// |x|^2, without scaling.
+template <typename T>
+inline real_type<T> norms_abssq( T x )
+{
+    return real( x ) * real( x ) + imag( x ) * imag( x );
+}
+
+//------------------------------------------------------------------------------
+/// @return true if sum |x_i|^2 may over- or underflow, given amax = max_i
+/// max( |Re(x_i)|, |Im(x_i)| ), so the 2-norm must be recomputed scaled.
+/// Thresholds are Blue's: squares of entries in [tsml, tbig] neither
+/// underflow nor, summed, overflow.
+template <typename real_t>
+inline bool norms_needs_scaling( real_t amax )
+{
+    typedef std::numeric_limits<real_t> limits;
+    static const real_t tsml
+        = std::pow( real_t( limits::radix ),
+                    std::ceil( (limits::min_exponent - 1) * 0.5 ) );
+    static const real_t tbig
+        = std::pow( real_t( limits::radix ),
+                    std::floor( (limits::max_exponent
+                                 - limits::digits + 1) * 0.5 ) );
+    return (amax > 0 && amax < tsml) || amax > tbig;
+}
+
+//------------------------------------------------------------------------------
+/// @return 2-norm from ssq = sum |x_i|^2 and amax, recomputing
+/// (sum |x_i / amax|^2)^{1/2} amax over the len entries x_i = x[ i*incx ]
+/// if ssq may have over- or underflowed. Inf (NaN) entries give inf (NaN).
+template <typename T>
+real_type<T> norms_nrm2_finish(
+    real_type<T> ssq, real_type<T> amax,
+    int64_t len, T const* x, int64_t incx )
+{
+    typedef real_type<T> real_t;
+    if (std::isinf( amax ) || ! norms_needs_scaling( amax ))
+        return std::sqrt( ssq );
+
+    // divide, since 1 / amax overflows if amax is subnormal
+    real_t sum = 0;
+    for (int64_t i = 0; i < len; ++i)
+        sum += norms_abssq( x[ i*incx ] / amax );
+    return std::sqrt( sum ) * amax;
+}
+
+//------------------------------------------------------------------------------
+/// @return norm of the contiguous vector x of length len.
+template <typename T>
+real_type<T> norm_contig( blas::Norm norm, int64_t len, T const* x )
+{
+    typedef real_type<T> real_t;
+    real_t sum = 0, amax = 0;
+    int nnan = 0;
+    switch (norm) {
+        case Norm::One:
+            #pragma omp simd reduction(+: sum)
+            for (int64_t i = 0; i < len; ++i)
+                sum += std::abs( x[ i ] );
+            return sum;
+
+        case Norm::Max:
+            #pragma omp simd reduction(max: amax) reduction(+: nnan)
+            for (int64_t i = 0; i < len; ++i) {
+                real_t a = std::abs( x[ i ] );
+                nnan += (a != a);
+                amax = (a > amax ? a : amax);
+            }
+            return (nnan ? std::numeric_limits<real_t>::quiet_NaN() : amax);
+
+        case Norm::Two:
+            #pragma omp simd reduction(+: sum) reduction(max: amax)
+            for (int64_t i = 0; i < len; ++i) {
+                real_t a = norms_absmax( x[ i ] );
+                sum += norms_abssq( x[ i ] );
+                amax = (a > amax ? a : amax);
+            }
+            return norms_nrm2_finish( sum, amax, len, x, 1 );
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/// values[ i ] = norm of row i of the ColMajor m-by-n matrix A,
+/// for i in [i0, i1), with i1 - i0 <= norms_nb.
+template <typename T>
+void norm_rows_block(
+    blas::Norm norm, int64_t i0, int64_t i1, int64_t n,
+    T const* A, int64_t lda, real_type<T>* values )
+{
+    typedef real_type<T> real_t;
+    const int64_t mb = i1 - i0;
+    real_t sum[ norms_nb ], amax[ norms_nb ];
+    int nnan[ norms_nb ];
+    std::fill( sum,  sum  + mb, real_t( 0 ) );
+    std::fill( amax, amax + mb, real_t( 0 ) );
+    std::fill( nnan, nnan + mb, 0 );
+
+    for (int64_t j = 0; j < n; ++j) {
+        T const* Aj = &A[ i0 + j*lda ];
+        switch (norm) {
+            case Norm::One:
+                #pragma omp simd
+                for (int64_t i = 0; i < mb; ++i)
+                    sum[ i ] += std::abs( Aj[ i ] );
+                break;
+
+            case Norm::Max:
+                #pragma omp simd
+                for (int64_t i = 0; i < mb; ++i) {
+                    real_t a = std::abs( Aj[ i ] );
+                    nnan[ i ] += (a != a);
+                    amax[ i ] = (a > amax[ i ] ? a : amax[ i ]);
+                }
+                break;
+
+            case Norm::Two:
+                #pragma omp simd
+                for (int64_t i = 0; i < mb; ++i) {
+                    real_t a = norms_absmax( Aj[ i ] );
+                    sum[ i ] += norms_abssq( Aj[ i ] );
+                    amax[ i ] = (a > amax[ i ] ? a : amax[ i ]);
+                }
+                break;
+        }
+    }
+
+    for (int64_t i = 0; i < mb; ++i) {
+        switch (norm) {
+            case Norm::One:
+                values[ i0 + i ] = sum[ i ];
+                break;
+            case Norm::Max:
+                values[ i0 + i ] = (nnan[ i ]
+                                     ? std::numeric_limits<real_t>::quiet_NaN()
+                                     : amax[ i ]);
+                break;
+            case Norm::Two:
+                values[ i0 + i ] = norms_nrm2_finish(
+                    sum[ i ], amax[ i ], n, &A[ i0 + i ], lda );
+                break;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @return iamax of the contiguous vector x of length len, as blas::iamax:
+/// the first index of the max of abs1( x_i ), or, if x has a NaN, the first
+/// index of a NaN, as in the reference i?amax; -1 if len = 0.
+/// Each chunk of norms_nb entries is searched for its max and for NaN, which
+/// vectorizes, then, only if that exceeds the max so far or has a NaN, for
+/// the first index of it, while the chunk is still in L1 cache.
+template <typename T>
+int64_t iamax_contig( int64_t len, T const* x )
+{
+    typedef real_type<T> real_t;
+    if (len == 0)
+        return -1;
+
+    real_t result = abs1( x[ 0 ] );
+    if (result != result)
+        return 0;
+    int64_t index = 0;
+    for (int64_t i0 = 0; i0 < len; i0 += norms_nb) {
+        int64_t i1 = std::min( i0 + norms_nb, len );
+        real_t cmax = -1;
+        int nnan = 0;
+        #pragma omp simd reduction(max: cmax) reduction(+: nnan)
+        for (int64_t i = i0; i < i1; ++i) {
+            real_t tmp = abs1( x[ i ] );
+            cmax = (tmp > cmax ? tmp : cmax);
+            nnan += (tmp != tmp);
+        }
+        if (nnan > 0) {
+            for (index = i0; abs1( x[ index ] ) == abs1( x[ index ] ); ++index) {}
+            return index;
+        }
+        if (cmax > result) {
+            result = cmax;
+            for (index = i0; abs1( x[ index ] ) != cmax; ++index) {}
+        }
+    }
+    return index;
+}
+
+//------------------------------------------------------------------------------
+/// indices[ i ] = iamax of row i of the ColMajor m-by-n matrix A,
+/// for i in [i0, i1), with i1 - i0 <= norms_nb; see iamax_contig.
+/// Once a row's max is NaN, no entry compares greater, so the first
+/// NaN is kept.
+template <typename T>
+void iamax_rows_block(
+    int64_t i0, int64_t i1, int64_t n,
+    T const* A, int64_t lda, int64_t* indices )
+{
+    typedef real_type<T> real_t;
+    const int64_t mb = i1 - i0;
+    if (n == 0) {
+        std::fill( &indices[ i0 ], &indices[ i1 ], -1 );
+        return;
+    }
+
+    real_t result[ norms_nb ];
+    for (int64_t i = 0; i < mb; ++i)
+        result[ i ] = abs1( A[ i0 + i ] );
+    std::fill( &indices[ i0 ], &indices[ i1 ], 0 );
+
+    for (int64_t j = 1; j < n; ++j) {
+        T const* Aj = &A[ i0 + j*lda ];
+        #pragma omp simd
+        for (int64_t i = 0; i < mb; ++i) {
+            real_t tmp = abs1( Aj[ i ] );
+            real_t r = result[ i ];
+            bool greater = (tmp > r) || (tmp != tmp && r == r);
+            result[ i ] = (greater ? tmp : r);
+            indices[ i0 + i ] = (greater ? j : indices[ i0 + i ]);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Checks arguments common to the norms and iamax routines, and returns
+/// the ColMajor view of A: for RowMajor, m and n are swapped, and columns
+/// become rows.
+inline void norms_check(
+    blas::Layout layout, int64_t& m, int64_t& n, int64_t lda, bool& cols )
+{
+    blas_error_if( layout != Layout::ColMajor &&
+                   layout != Layout::RowMajor );
+    blas_error_if( m < 0 );
+    blas_error_if( n < 0 );
+    if (layout == Layout::ColMajor)
+        blas_error_if( lda < m );
+    else
+        blas_error_if( lda < n );
+
+    if (layout == Layout::RowMajor) {
+        std::swap( m, n );
+        cols = ! cols;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Column norms (cols = true) or row norms (cols = false) of the m-by-n
+/// matrix A.
+template <typename T>
+void norms(
+    blas::Layout layout,
+    blas::Norm norm,
+    bool cols,
+    int64_t m, int64_t n,
+    T const *A, int64_t lda,
+    real_type<T> *values )
+{
+    blas_error_if( norm != Norm::One &&
+                   norm != Norm::Two &&
+                   norm != Norm::Max );
+    norms_check( layout, m, n, lda, cols );
+
+    bool parallel = m*n >= norms_parallel_min;
+    if (cols) {
+        // unit stride columns
+        #pragma omp parallel for schedule(static) if (parallel)
+        for (int64_t j = 0; j < n; ++j)
+            values[ j ] = norm_contig( norm, m, &A[ j*lda ] );
+    }
+    else {
+        const int64_t nb = norms_nb;
+        #pragma omp parallel for schedule(static) if (parallel)
+        for (int64_t i = 0; i < m; i += nb)
+            norm_rows_block( norm, i, std::min( i + nb, m ), n, A, lda, values );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Column iamax (cols = true) or row iamax (cols = false) of the m-by-n
+/// matrix A.
+template <typename T>
+void iamax(
+    blas::Layout layout,
+    bool cols,
+    int64_t m, int64_t n,
+    T const *A, int64_t lda,
+    int64_t *indices )
+{
+    norms_check( layout, m, n, lda, cols );
+
+    bool parallel = m*n >= norms_parallel_min;
+    if (cols) {
+        // unit stride columns
+        #pragma omp parallel for schedule(static) if (parallel)
+        for (int64_t j = 0; j < n; ++j)
+            indices[ j ] = iamax_contig( m, &A[ j*lda ] );
+    }
+    else {
+        const int64_t nb = norms_nb;
+        #pragma omp parallel for schedule(static) if (parallel)
+        for (int64_t i = 0; i < m; i += nb)
+            iamax_rows_block( i, std::min( i + nb, m ), n, A, lda, indices );
+    }
+}
+
+}  // namespace internal
+
+// =============================================================================
+// Overloaded wrappers for s, d, c, z precisions.
+
+// -----------------------------------------------------------------------------
+/// @ingroup nrm2
+void col_norms(
+    blas::Layout layout,
+    blas::Norm norm,
+    int64_t m, int64_t n,
+    float const *A, int64_t lda,
+    float *values )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "col_norms", 's',
+                          { layout2char( layout ), norm2char( norm ) },
+                          m, n, 0, Gflop< float >::nrm2( double( m )*n ) );
+
+    internal::norms( layout, norm, true, m, n, A, lda, values );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup nrm2
+void col_norms(
+    blas::Layout layout,
+    blas::Norm norm,
+    int64_t m, int64_t n,
+    double const *A, int64_t lda,
+    double *values )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "col_norms", 'd',
+                          { layout2char( layout ), norm2char( norm ) },
+                          m, n, 0, Gflop< double >::nrm2( double( m )*n ) );
+
+    internal::norms( layout, norm, true, m, n, A, lda, values );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup nrm2
+void col_norms(
+    blas::Layout layout,
+    blas::Norm norm,
+    int64_t m, int64_t n,
+    std::complex<float> const *A, int64_t lda,
+    float *values )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "col_norms", 'c',
+                          { layout2char( layout ), norm2char( norm ) },
+                          m, n, 0, Gflop< std::complex<float> >::nrm2( double( m )*n ) );
+
+    internal::norms( layout, norm, true, m, n, A, lda, values );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup nrm2
+void col_norms(
+    blas::Layout layout,
+    blas::Norm norm,
+    int64_t m, int64_t n,
+    std::complex<double> const *A, int64_t lda,
+    double *values )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "col_norms", 'z',
+                          { layout2char( layout ), norm2char( norm ) },
+                          m, n, 0, Gflop< std::complex<double> >::nrm2( double( m )*n ) );
+
+    internal::norms( layout, norm, true, m, n, A, lda, values );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup nrm2
+void row_norms(
+    blas::Layout layout,
+    blas::Norm norm,
+    int64_t m, int64_t n,
+    float const *A, int64_t lda,
+    float *values )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "row_norms", 's',
+                          { layout2char( layout ), norm2char( norm ) },
+                          m, n, 0, Gflop< float >::nrm2( double( m )*n ) );
+
+    internal::norms( layout, norm, false, m, n, A, lda, values );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup nrm2
+void row_norms(
+    blas::Layout layout,
+    blas::Norm norm,
+    int64_t m, int64_t n,
+    double const *A, int64_t lda,
+    double *values )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "row_norms", 'd',
+                          { layout2char( layout ), norm2char( norm ) },
+                          m, n, 0, Gflop< double >::nrm2( double( m )*n ) );
+
+    internal::norms( layout, norm, false, m, n, A, lda, values );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup nrm2
+void row_norms(
+    blas::Layout layout,
+    blas::Norm norm,
+    int64_t m, int64_t n,
+    std::complex<float> const *A, int64_t lda,
+    float *values )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "row_norms", 'c',
+                          { layout2char( layout ), norm2char( norm ) },
+                          m, n, 0, Gflop< std::complex<float> >::nrm2( double( m )*n ) );
+
+    internal::norms( layout, norm, false, m, n, A, lda, values );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup nrm2
+void row_norms(
+    blas::Layout layout,
+    blas::Norm norm,
+    int64_t m, int64_t n,
+    std::complex<double> const *A, int64_t lda,
+    double *values )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "row_norms", 'z',
+                          { layout2char( layout ), norm2char( norm ) },
+                          m, n, 0, Gflop< std::complex<double> >::nrm2( double( m )*n ) );
+
+    internal::norms( layout, norm, false, m, n, A, lda, values );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup iamax
+void col_iamax(
+    blas::Layout layout,
+    int64_t m, int64_t n,
+    float const *A, int64_t lda,
+    int64_t *indices )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "col_iamax", 's', { layout2char( layout ) },
+                          m, n, 0, Gflop< float >::iamax( double( m )*n ) );
+
+    internal::iamax( layout, true, m, n, A, lda, indices );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup iamax
+void col_iamax(
+    blas::Layout layout,
+    int64_t m, int64_t n,
+    double const *A, int64_t lda,
+    int64_t *indices )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "col_iamax", 'd', { layout2char( layout ) },
+                          m, n, 0, Gflop< double >::iamax( double( m )*n ) );
+
+    internal::iamax( layout, true, m, n, A, lda, indices );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup iamax
+void col_iamax(
+    blas::Layout layout,
+    int64_t m, int64_t n,
+    std::complex<float> const *A, int64_t lda,
+    int64_t *indices )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "col_iamax", 'c', { layout2char( layout ) },
+                          m, n, 0, Gflop< std::complex<float> >::iamax( double( m )*n ) );
+
+    internal::iamax( layout, true, m, n, A, lda, indices );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup iamax
+void col_iamax(
+    blas::Layout layout,
+    int64_t m, int64_t n,
+    std::complex<double> const *A, int64_t lda,
+    int64_t *indices )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "col_iamax", 'z', { layout2char( layout ) },
+                          m, n, 0, Gflop< std::complex<double> >::iamax( double( m )*n ) );
+
+    internal::iamax( layout, true, m, n, A, lda, indices );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup iamax
+void row_iamax(
+    blas::Layout layout,
+    int64_t m, int64_t n,
+    float const *A, int64_t lda,
+    int64_t *indices )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "row_iamax", 's', { layout2char( layout ) },
+                          m, n, 0, Gflop< float >::iamax( double( m )*n ) );
+
+    internal::iamax( layout, false, m, n, A, lda, indices );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup iamax
+void row_iamax(
+    blas::Layout layout,
+    int64_t m, int64_t n,
+    double const *A, int64_t lda,
+    int64_t *indices )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "row_iamax", 'd', { layout2char( layout ) },
+                          m, n, 0, Gflop< double >::iamax( double( m )*n ) );
+
+    internal::iamax( layout, false, m, n, A, lda, indices );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup iamax
+void row_iamax(
+    blas::Layout layout,
+    int64_t m, int64_t n,
+    std::complex<float> const *A, int64_t lda,
+    int64_t *indices )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "row_iamax", 'c', { layout2char( layout ) },
+                          m, n, 0, Gflop< std::complex<float> >::iamax( double( m )*n ) );
+
+    internal::iamax( layout, false, m, n, A, lda, indices );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup iamax
+void row_iamax(
+    blas::Layout layout,
+    int64_t m, int64_t n,
+    std::complex<double> const *A, int64_t lda,
+    int64_t *indices )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "row_iamax", 'z', { layout2char( layout ) },
+                          m, n, 0, Gflop< std::complex<double> >::iamax( double( m )*n ) );
+
+    internal::iamax( layout, false, m, n, A, lda, indices );
+}
+
+}  // namespace blas
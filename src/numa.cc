@@ -0,0 +1,305 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "blas/numa.hh"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#ifdef __linux__
+    #include <sched.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+namespace blas {
+namespace numa {
+
+namespace {
+
+// From linux/mempolicy.h, which not every system installs.
+const int mpol_interleave = 3;
+
+//------------------------------------------------------------------------------
+// NUMA topology, read once from /sys.
+struct Topology {
+    std::vector< std::vector<int64_t> > node_cpus;  // CPUs of each node
+    std::vector<int64_t> cpu_node;                  // node of each CPU, or -1
+};
+
+//------------------------------------------------------------------------------
+// Parses a /sys list such as "0-3,8-11" into { 0, 1, 2, 3, 8, 9, 10, 11 }.
+std::vector<int64_t> parse_list( std::string const& str )
+{
+    std::vector<int64_t> list;
+    std::istringstream in( str );
+    std::string range;
+    while (std::getline( in, range, ',' )) {
+        if (range.find_first_of( "0123456789" ) == std::string::npos)
+            continue;
+        size_t dash = range.find( '-' );
+        int64_t first = std::atoll( range.c_str() );
+        int64_t last  = (dash == std::string::npos
+                         ? first
+                         : std::atoll( range.c_str() + dash + 1 ));
+        for (int64_t i = first; i <= last; ++i)
+            list.push_back( i );
+    }
+    return list;
+}
+
+//------------------------------------------------------------------------------
+// @return first line of file, or "" if it cannot be read.
+std::string read_line( std::string const& filename )
+{
+    std::ifstream file( filename );
+    std::string line;
+    std::getline( file, line );
+    return line;
+}
+
+//------------------------------------------------------------------------------
+// Reads the topology from /sys/devices/system/node. If that fails,
+// all CPUs are on one node 0.
+Topology read_topology()
+{
+    Topology topo;
+    std::string dir = "/sys/devices/system/node/";
+    std::vector<int64_t> nodes = parse_list( read_line( dir + "online" ) );
+    if (! nodes.empty()) {
+        topo.node_cpus.resize( *std::max_element( nodes.begin(),
+                                                  nodes.end() ) + 1 );
+        for (int64_t node : nodes) {
+            topo.node_cpus[ node ] = parse_list(
+                read_line( dir + "node" + std::to_string( node ) + "/cpulist" ) );
+        }
+    }
+    else {
+        int64_t ncpu = std::max( 1u, std::thread::hardware_concurrency() );
+        topo.node_cpus.resize( 1 );
+        for (int64_t cpu = 0; cpu < ncpu; ++cpu)
+            topo.node_cpus[ 0 ].push_back( cpu );
+    }
+
+    for (size_t node = 0; node < topo.node_cpus.size(); ++node) {
+        for (int64_t cpu : topo.node_cpus[ node ]) {
+            if (cpu >= int64_t( topo.cpu_node.size() ))
+                topo.cpu_node.resize( cpu + 1, -1 );
+            topo.cpu_node[ cpu ] = node;
+        }
+    }
+    return topo;
+}
+
+//------------------------------------------------------------------------------
+Topology const& topology()
+{
+    static Topology topo = read_topology();
+    return topo;
+}
+
+#ifdef __linux__
+//------------------------------------------------------------------------------
+size_t page_size()
+{
+    static size_t size = sysconf( _SC_PAGESIZE );
+    return size;
+}
+#endif
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+/// @return number of NUMA nodes, numbered 0, ..., num_nodes() - 1.
+/// Nodes may have no CPUs, e.g., memory-only nodes or offline node ids.
+int64_t num_nodes()
+{
+    return topology().node_cpus.size();
+}
+
+//------------------------------------------------------------------------------
+/// @return NUMA node of the given CPU, or -1 if unknown.
+int64_t cpu_node( int64_t cpu )
+{
+    std::vector<int64_t> const& cpu_node = topology().cpu_node;
+    if (cpu < 0 || cpu >= int64_t( cpu_node.size() ))
+        return -1;
+    return cpu_node[ cpu ];
+}
+
+//------------------------------------------------------------------------------
+/// @return CPUs of the given NUMA node.
+/// @throws blas::Error if node is out of range.
+std::vector<int64_t> const& node_cpus( int64_t node )
+{
+    blas_error_if( node < 0 || node >= num_nodes() );
+    return topology().node_cpus[ node ];
+}
+
+//------------------------------------------------------------------------------
+/// @return NUMA node of the CPU the calling thread is running on,
+/// or -1 if unknown. Stable only if the thread is bound to a CPU or node.
+int64_t current_node()
+{
+    if (num_nodes() == 1)
+        return 0;
+    #ifdef __linux__
+        return cpu_node( sched_getcpu() );
+    #else
+        return -1;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// Looks up the NUMA node holding the page of each pointer, with one system
+/// call for all pointers.
+///
+/// @param[in] count
+///     Number of pointers.
+///
+/// @param[in] ptrs
+///     Array of count pointers.
+///
+/// @param[out] nodes
+///     Array of count nodes. nodes[ i ] is the node of ptrs[ i ],
+///     or -1 if unknown, e.g., the page has not been touched yet.
+void nodes_of( size_t count, void const* const* ptrs, int64_t* nodes )
+{
+    if (num_nodes() == 1) {
+        std::fill( nodes, nodes + count, 0 );
+        return;
+    }
+    std::fill( nodes, nodes + count, -1 );
+    #ifdef __linux__
+        std::vector<void*> pages( count );
+        std::vector<int> status( count, -1 );
+        for (size_t i = 0; i < count; ++i) {
+            uintptr_t addr = reinterpret_cast<uintptr_t>( ptrs[ i ] );
+            pages[ i ] = reinterpret_cast<void*>( addr & ~(page_size() - 1) );
+        }
+        // move_pages with nodes = null only queries; pid 0 is this process.
+        if (syscall( SYS_move_pages, 0, count, pages.data(), nullptr,
+                     status.data(), 0 ) == 0)
+        {
+            for (size_t i = 0; i < count; ++i) {
+                if (status[ i ] >= 0)
+                    nodes[ i ] = status[ i ];
+            }
+        }
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// @return NUMA node holding the page of ptr, or -1 if unknown.
+/// @see nodes_of
+int64_t node_of( void const* ptr )
+{
+    int64_t node;
+    nodes_of( 1, &ptr, &node );
+    return node;
+}
+
+//------------------------------------------------------------------------------
+/// Allocates memory placed by the given NUMA policy. The memory is
+/// page-aligned, and must be freed by blas::numa::deallocate with the
+/// same size.
+///
+/// @param[in] bytes
+///     Size in bytes. If 0, returns null.
+///
+/// @param[in] policy
+///     - FirstTouch: pages are touched by an OpenMP parallel loop with
+///       static schedule, so page j of p pages lands on the node of thread
+///       j*nthreads/p, as in a later static loop over the same data.
+///     - Interleave: pages are spread round-robin over all nodes.
+///
+/// @throws std::bad_alloc if the memory cannot be allocated.
+void* allocate( size_t bytes, Policy policy )
+{
+    if (bytes == 0)
+        return nullptr;
+
+    #ifdef __linux__
+        size_t page = page_size();
+        size_t len = (bytes + page - 1) / page * page;
+        void* ptr = mmap( nullptr, len, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+        if (ptr == MAP_FAILED)
+            throw std::bad_alloc();
+
+        int64_t nodes = num_nodes();
+        if (policy == Policy::Interleave && nodes > 1) {
+            // best effort: if mbind fails, pages are placed by first touch
+            const size_t bits = 8*sizeof(unsigned long);
+            std::vector<unsigned long> mask( (nodes + bits - 1) / bits, 0 );
+            for (int64_t node = 0; node < nodes; ++node)
+                mask[ node / bits ] |= 1ul << (node % bits);
+            syscall( SYS_mbind, ptr, len, mpol_interleave, mask.data(),
+                     mask.size()*bits + 1, 0 );
+        }
+        else if (policy == Policy::FirstTouch) {
+            char* bytes_ptr = static_cast<char*>( ptr );
+            int64_t npages = len / page;
+            #pragma omp parallel for schedule(static)
+            for (int64_t j = 0; j < npages; ++j)
+                bytes_ptr[ j*page ] = 0;
+        }
+        return ptr;
+    #else
+        return ::operator new( bytes );
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// Frees memory from blas::numa::allocate.
+///
+/// @param[in] ptr
+///     Pointer from allocate. If null, does nothing.
+///
+/// @param[in] bytes
+///     Size passed to allocate.
+void deallocate( void* ptr, size_t bytes )
+{
+    if (ptr == nullptr)
+        return;
+
+    #ifdef __linux__
+        size_t page = page_size();
+        munmap( ptr, (bytes + page - 1) / page * page );
+    #else
+        ::operator delete( ptr );
+    #endif
+}
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Groups items 0, ..., count - 1 by the NUMA node holding ptrs[ i ];
+/// group num_nodes() holds items on unknown nodes. Used by for_each_local.
+std::vector< std::vector<size_t> > group_by_node(
+    size_t count, void const* const* ptrs )
+{
+    int64_t nodes = num_nodes();
+    std::vector<int64_t> item_nodes( count );
+    nodes_of( count, ptrs, item_nodes.data() );
+
+    std::vector< std::vector<size_t> > groups( nodes + 1 );
+    for (size_t i = 0; i < count; ++i) {
+        int64_t node = item_nodes[ i ];
+        groups[ node >= 0 && node < nodes ? node : nodes ].push_back( i );
+    }
+    return groups;
+}
+
+}  // namespace internal
+
+}  // namespace numa
+}  // namespace blas
@@ -0,0 +1,518 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "blas.hh"
+#include "blas/profile.hh"
+
+#include <cerrno>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace blas {
+namespace profile {
+
+namespace internal {
+
+std::atomic<int> g_mode( 0 );
+
+}  // namespace internal
+
+namespace {
+
+// Histogram bin i counts calls taking [2^(i-1), 2^i) microseconds;
+// bin 0 counts calls under 1 microsecond; the last bin is open ended.
+const int num_bins = 32;
+
+//------------------------------------------------------------------------------
+// Identifies one shape of one routine.
+struct Key
+{
+    std::string routine;
+    char        precision;
+    std::string opts;
+    int64_t     m, n, k, batch;
+
+    bool operator < ( Key const& other ) const
+    {
+        return std::tie( routine, precision, opts, m, n, k, batch )
+             < std::tie( other.routine, other.precision, other.opts,
+                         other.m, other.n, other.k, other.batch );
+    }
+};
+
+//------------------------------------------------------------------------------
+// Aggregate statistics of all calls with the same Key.
+struct Stats
+{
+    int64_t count     = 0;
+    double  time      = 0;
+    double  min_time  = 0;
+    double  max_time  = 0;
+    double  gflop     = 0;
+    int64_t histogram[ num_bins ] = {};
+};
+
+typedef std::map< Key, Stats > Table;
+
+//------------------------------------------------------------------------------
+// Function-local statics so they are constructed before first use,
+// regardless of static initialization order.
+Table& table()
+{
+    static Table s_table;
+    return s_table;
+}
+
+std::mutex& table_mutex()
+{
+    static std::mutex s_mutex;
+    return s_mutex;
+}
+
+//------------------------------------------------------------------------------
+// One span (ph = 'X') or instant event (ph = 'i') in the trace.
+struct Event
+{
+    const char* name;
+    char        ph;
+    char        precision;
+    char        opts[ Scope::max_opts + 1 ];
+    int64_t     m, n, k, batch;
+    double      gflop;
+    double      start;     // microseconds since g_epoch
+    double      duration;  // microseconds
+    const char* arg_name;  // for instant events; may be null
+};
+
+//------------------------------------------------------------------------------
+// Events of one thread. Each thread appends to its own buffer without
+// locking; buffers are owned by the global list, so they outlive threads.
+struct ThreadTrace
+{
+    int tid;
+    int omp_thread;
+    std::vector< Event > events;
+};
+
+typedef std::vector< std::unique_ptr< ThreadTrace > > TraceList;
+
+TraceList& trace_list()
+{
+    static TraceList s_list;
+    return s_list;
+}
+
+std::mutex& trace_mutex()
+{
+    static std::mutex s_mutex;
+    return s_mutex;
+}
+
+// Time zero of the trace.
+internal::time_point g_epoch = std::chrono::steady_clock::now();
+
+thread_local ThreadTrace* t_trace = nullptr;
+
+//------------------------------------------------------------------------------
+// Returns this thread's buffer, registering it on first use.
+ThreadTrace* thread_trace()
+{
+    if (t_trace == nullptr) {
+        std::unique_ptr< ThreadTrace > trace( new ThreadTrace );
+        #ifdef _OPENMP
+            trace->omp_thread = omp_get_thread_num();
+        #else
+            trace->omp_thread = 0;
+        #endif
+        std::lock_guard< std::mutex > lock( trace_mutex() );
+        trace->tid = int( trace_list().size() );
+        t_trace = trace.get();
+        trace_list().push_back( std::move( trace ) );
+    }
+    return t_trace;
+}
+
+//------------------------------------------------------------------------------
+double microseconds( internal::time_point time )
+{
+    return std::chrono::duration< double, std::micro >( time - g_epoch ).count();
+}
+
+//------------------------------------------------------------------------------
+int time2bin( double time )
+{
+    double usec = time * 1e6;
+    if (usec < 1)
+        return 0;
+    int bin = 1 + int( std::log2( usec ) );
+    return std::min( bin, num_bins - 1 );
+}
+
+//------------------------------------------------------------------------------
+// Lower edge of histogram bin, in seconds.
+double bin2time( int bin )
+{
+    return bin == 0 ? 0 : std::ldexp( 1e-6, bin - 1 );
+}
+
+//------------------------------------------------------------------------------
+// Writes the JSON string s, escaping quotes and backslashes.
+void write_json_string( FILE* file, std::string const& s )
+{
+    fputc( '"', file );
+    for (char c : s) {
+        if (c == '"' || c == '\\')
+            fputc( '\\', file );
+        fputc( c, file );
+    }
+    fputc( '"', file );
+}
+
+//------------------------------------------------------------------------------
+// Writes the profile at exit to the file named by $BLASPP_PROFILE.
+std::string g_filename;
+
+void dump_at_exit()
+{
+    try {
+        dump( g_filename );
+    }
+    catch (std::exception const& ex) {
+        fprintf( stderr, "BLAS++ profile: %s\n", ex.what() );
+    }
+}
+
+//------------------------------------------------------------------------------
+// Writes the trace at exit to the file named by $BLASPP_TRACE.
+std::string g_trace_filename;
+
+void dump_trace_at_exit()
+{
+    try {
+        dump_trace( g_trace_filename );
+    }
+    catch (std::exception const& ex) {
+        fprintf( stderr, "BLAS++ trace: %s\n", ex.what() );
+    }
+}
+
+//------------------------------------------------------------------------------
+// Enables profiling and tracing at load time if $BLASPP_PROFILE and
+// $BLASPP_TRACE are set.
+struct Initializer
+{
+    Initializer()
+    {
+        const char* env = getenv( "BLASPP_PROFILE" );
+        if (env != nullptr && env[0] != '\0') {
+            g_filename = env;
+            // construct table before registering, so it is destroyed after
+            table();
+            table_mutex();
+            atexit( dump_at_exit );
+            enable();
+        }
+
+        env = getenv( "BLASPP_TRACE" );
+        if (env != nullptr && env[0] != '\0') {
+            g_trace_filename = env;
+            trace_list();
+            trace_mutex();
+            atexit( dump_trace_at_exit );
+            enable_trace();
+        }
+    }
+};
+
+Initializer s_initializer;
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+/// Adds one call to the profile and trace, if enabled. Called by Scope.
+void internal::record(
+    const char* routine, char precision, const char* opts,
+    int64_t m, int64_t n, int64_t k, int64_t batch,
+    double gflop, time_point start, time_point end )
+{
+    int mode = g_mode.load( std::memory_order_relaxed );
+    if (mode & tracing) {
+        Event event;
+        event.name      = routine;
+        event.ph        = 'X';
+        event.precision = precision;
+        strncpy( event.opts, opts, sizeof(event.opts) );
+        event.opts[ Scope::max_opts ] = '\0';
+        event.m         = m;
+        event.n         = n;
+        event.k         = k;
+        event.batch     = batch;
+        event.gflop     = gflop;
+        event.start     = microseconds( start );
+        event.duration  = microseconds( end ) - event.start;
+        event.arg_name  = nullptr;
+        thread_trace()->events.push_back( event );
+    }
+    if (! (mode & profiling))
+        return;
+
+    double time = std::chrono::duration< double >( end - start ).count();
+    Key key = { routine, precision, opts, m, n, k, batch };
+    int bin = time2bin( time );
+
+    std::lock_guard< std::mutex > lock( table_mutex() );
+    Stats& stats = table()[ key ];
+    if (stats.count == 0) {
+        stats.min_time = time;
+        stats.max_time = time;
+    }
+    else {
+        stats.min_time = std::min( stats.min_time, time );
+        stats.max_time = std::max( stats.max_time, time );
+    }
+    stats.count += 1;
+    stats.time  += time;
+    stats.gflop += gflop;
+    stats.histogram[ bin ] += 1;
+}
+
+//------------------------------------------------------------------------------
+/// Enables or disables profiling. Disabling keeps calls recorded so far.
+void enable( bool on )
+{
+    if (on)
+        internal::g_mode.fetch_or( internal::profiling );
+    else
+        internal::g_mode.fetch_and( ~internal::profiling );
+}
+
+//------------------------------------------------------------------------------
+/// Discards all calls recorded so far.
+void reset()
+{
+    std::lock_guard< std::mutex > lock( table_mutex() );
+    table().clear();
+}
+
+//------------------------------------------------------------------------------
+/// Writes the profile as CSV, one line per shape. Times are in seconds;
+/// gflops is total Gflop / total time. The histogram column lists
+/// nonzero bins as `lower_edge_in_seconds:count`, separated by spaces.
+void write_csv( FILE* file )
+{
+    std::lock_guard< std::mutex > lock( table_mutex() );
+    fprintf( file, "routine,precision,opts,m,n,k,batch,count,"
+                   "time,min_time,max_time,avg_time,gflops,histogram\n" );
+    for (auto const& entry : table()) {
+        Key   const& key   = entry.first;
+        Stats const& stats = entry.second;
+        double gflops = stats.time > 0 ? stats.gflop / stats.time : 0;
+        fprintf( file, "%s,%c,%s,%lld,%lld,%lld,%lld,%lld,"
+                       "%.6e,%.6e,%.6e,%.6e,%.4f,",
+                 key.routine.c_str(), key.precision, key.opts.c_str(),
+                 (long long) key.m, (long long) key.n, (long long) key.k,
+                 (long long) key.batch, (long long) stats.count,
+                 stats.time, stats.min_time, stats.max_time,
+                 stats.time / stats.count, gflops );
+        const char* sep = "";
+        for (int bin = 0; bin < num_bins; ++bin) {
+            if (stats.histogram[ bin ] > 0) {
+                fprintf( file, "%s%.3g:%lld", sep, bin2time( bin ),
+                         (long long) stats.histogram[ bin ] );
+                sep = " ";
+            }
+        }
+        fprintf( file, "\n" );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Writes the profile as a JSON array, one object per shape, with the same
+/// fields as write_csv. The histogram is an array of
+/// `[ lower_edge_in_seconds, count ]` pairs for nonzero bins.
+void write_json( FILE* file )
+{
+    std::lock_guard< std::mutex > lock( table_mutex() );
+    fprintf( file, "[" );
+    const char* sep = "\n";
+    for (auto const& entry : table()) {
+        Key   const& key   = entry.first;
+        Stats const& stats = entry.second;
+        double gflops = stats.time > 0 ? stats.gflop / stats.time : 0;
+        fprintf( file, "%s  { \"routine\": ", sep );
+        write_json_string( file, key.routine );
+        fprintf( file, ", \"precision\": \"%c\", \"opts\": ", key.precision );
+        write_json_string( file, key.opts );
+        fprintf( file, ",\n    \"m\": %lld, \"n\": %lld, \"k\": %lld, "
+                       "\"batch\": %lld, \"count\": %lld,\n"
+                       "    \"time\": %.6e, \"min_time\": %.6e, "
+                       "\"max_time\": %.6e, \"avg_time\": %.6e, "
+                       "\"gflops\": %.4f,\n"
+                       "    \"histogram\": [",
+                 (long long) key.m, (long long) key.n, (long long) key.k,
+                 (long long) key.batch, (long long) stats.count,
+                 stats.time, stats.min_time, stats.max_time,
+                 stats.time / stats.count, gflops );
+        const char* bin_sep = " ";
+        for (int bin = 0; bin < num_bins; ++bin) {
+            if (stats.histogram[ bin ] > 0) {
+                fprintf( file, "%s[ %.3g, %lld ]", bin_sep, bin2time( bin ),
+                         (long long) stats.histogram[ bin ] );
+                bin_sep = ", ";
+            }
+        }
+        fprintf( file, " ] }" );
+        sep = ",\n";
+    }
+    fprintf( file, "\n]\n" );
+}
+
+//------------------------------------------------------------------------------
+/// Writes the profile to a file: JSON if filename ends in `.json`,
+/// otherwise CSV. If filename is "1", writes CSV to stderr.
+void dump( std::string const& filename )
+{
+    if (filename == "1") {
+        write_csv( stderr );
+        return;
+    }
+
+    FILE* file = fopen( filename.c_str(), "w" );
+    blas_error_if_msg( file == nullptr, "can't open %s: %s",
+                       filename.c_str(), strerror( errno ) );
+    size_t len = filename.size();
+    if (len >= 5 && filename.compare( len - 5, 5, ".json" ) == 0)
+        write_json( file );
+    else
+        write_csv( file );
+    fclose( file );
+}
+
+//------------------------------------------------------------------------------
+/// Enables or disables tracing. Disabling keeps events recorded so far.
+void enable_trace( bool on )
+{
+    if (on)
+        internal::g_mode.fetch_or( internal::tracing );
+    else
+        internal::g_mode.fetch_and( ~internal::tracing );
+}
+
+//------------------------------------------------------------------------------
+/// Discards all trace events recorded so far. Must not be called while
+/// other threads are making BLAS++ calls.
+void reset_trace()
+{
+    std::lock_guard< std::mutex > lock( trace_mutex() );
+    for (auto& trace : trace_list())
+        trace->events.clear();
+}
+
+//------------------------------------------------------------------------------
+/// Adds an instant event to the trace, if tracing is enabled.
+///
+/// @param[in] name
+///     Event name; must be a string literal or otherwise outlive the trace.
+///
+/// @param[in] arg_name
+///     Optional argument name, e.g., "stream"; null for none.
+///
+/// @param[in] arg
+///     Argument value, if arg_name is not null.
+///
+void mark( const char* name, const char* arg_name, int64_t arg )
+{
+    if (! tracing())
+        return;
+
+    Event event = {};
+    event.name     = name;
+    event.ph       = 'i';
+    event.start    = microseconds( std::chrono::steady_clock::now() );
+    event.arg_name = arg_name;
+    event.m        = arg;
+    thread_trace()->events.push_back( event );
+}
+
+//------------------------------------------------------------------------------
+/// Writes the trace in the Chrome trace event format (JSON object format).
+/// Each thread that made a BLAS++ call is one row, named by its OpenMP
+/// thread number; spans carry precision, options, dimensions, batch count,
+/// and Gflop/s as arguments. Must not be called while other threads are
+/// making BLAS++ calls.
+void write_trace( FILE* file )
+{
+    std::lock_guard< std::mutex > lock( trace_mutex() );
+    int pid = int( getpid() );
+    fprintf( file, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [" );
+    const char* sep = "\n";
+    for (auto const& trace : trace_list()) {
+        fprintf( file, "%s{ \"name\": \"thread_name\", \"ph\": \"M\", "
+                       "\"pid\": %d, \"tid\": %d, "
+                       "\"args\": { \"name\": \"thread %d (omp %d)\" } }",
+                 sep, pid, trace->tid, trace->tid, trace->omp_thread );
+        sep = ",\n";
+        for (auto const& event : trace->events) {
+            fprintf( file, "%s{ \"name\": ", sep );
+            write_json_string( file, event.name );
+            if (event.ph == 'X') {
+                double gflops = event.duration > 0
+                              ? event.gflop / (event.duration * 1e-6) : 0;
+                fprintf( file, ", \"cat\": \"blas\", \"ph\": \"X\", "
+                               "\"ts\": %.3f, \"dur\": %.3f, "
+                               "\"pid\": %d, \"tid\": %d, "
+                               "\"args\": { \"precision\": \"%c\", "
+                               "\"opts\": ",
+                         event.start, event.duration, pid, trace->tid,
+                         event.precision );
+                write_json_string( file, event.opts );
+                fprintf( file, ", \"m\": %lld, \"n\": %lld, \"k\": %lld, "
+                               "\"batch\": %lld, \"gflops\": %.4f } }",
+                         (long long) event.m, (long long) event.n,
+                         (long long) event.k, (long long) event.batch,
+                         gflops );
+            }
+            else {
+                fprintf( file, ", \"cat\": \"blas\", \"ph\": \"i\", "
+                               "\"s\": \"t\", \"ts\": %.3f, "
+                               "\"pid\": %d, \"tid\": %d",
+                         event.start, pid, trace->tid );
+                if (event.arg_name != nullptr) {
+                    fprintf( file, ", \"args\": { " );
+                    write_json_string( file, event.arg_name );
+                    fprintf( file, ": %lld }", (long long) event.m );
+                }
+                fprintf( file, " }" );
+            }
+        }
+    }
+    fprintf( file, "\n]}\n" );
+}
+
+//------------------------------------------------------------------------------
+/// Writes the trace to a file; see write_trace.
+void dump_trace( std::string const& filename )
+{
+    FILE* file = fopen( filename.c_str(), "w" );
+    blas_error_if_msg( file == nullptr, "can't open %s: %s",
+                       filename.c_str(), strerror( errno ) );
+    write_trace( file );
+    fclose( file );
+}
+
+}  // namespace profile
+}  // namespace blas
@@ -0,0 +1,431 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "blas.hh"
+#include "blas/repro.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+namespace blas {
+namespace repro {
+
+std::atomic<bool> internal::g_enabled( false );
+
+//------------------------------------------------------------------------------
+/// Enables or disables reproducible mode for blas::dot, blas::dotu,
+/// blas::asum, and blas::nrm2.
+void enable( bool on )
+{
+    internal::g_enabled.store( on, std::memory_order_relaxed );
+}
+
+namespace {
+
+//------------------------------------------------------------------------------
+// Enables reproducible mode at load time if $BLASPP_REPRO is 1 or y.
+struct Initializer
+{
+    Initializer()
+    {
+        const char* env = getenv( "BLASPP_REPRO" );
+        if (env != nullptr && (env[0] == '1' || env[0] == 'y'))
+            enable();
+    }
+};
+
+Initializer s_initializer;
+
+//------------------------------------------------------------------------------
+/// Sets [begin, end) to this thread's contiguous block of 0, ..., n-1.
+inline void thread_range( int64_t n, int64_t* begin, int64_t* end )
+{
+    #ifdef _OPENMP
+        int64_t nt  = omp_get_num_threads();
+        int64_t tid = omp_get_thread_num();
+    #else
+        int64_t nt  = 1;
+        int64_t tid = 0;
+    #endif
+    *begin = n * tid / nt;
+    *end   = n * (tid + 1) / nt;
+}
+
+//------------------------------------------------------------------------------
+/// Max |v| over the values v = values( i, q ), for i in [begin, end),
+/// q = 0, ..., nv-1, in vmax; nan0 is nan if any value is inf or nan,
+/// otherwise 0.
+///
+/// The block loops are separate functions taking Values by value, rather
+/// than inline in the parallel region, where gcc reads the captures
+/// through the shared variables and doesn't vectorize the loads.
+template <int nv, typename Values>
+void max_abs_block(
+    int64_t begin, int64_t end, Values values, double* vmax, double* nan0 )
+{
+    double tmax = 0, t0 = 0;
+    #pragma omp simd reduction(max: tmax) reduction(+: t0)
+    for (int64_t i = begin; i < end; ++i) {
+        for (int q = 0; q < nv; ++q) {
+            double a = std::abs( values( i, q ) );
+            t0 += a * 0;
+            tmax = (a > tmax ? a : tmax);
+        }
+    }
+    *vmax = tmax;
+    *nan0 = t0;
+}
+
+//------------------------------------------------------------------------------
+/// Max |v|, over the nv*n values v = values( i, q ), for i = 0, ..., n-1,
+/// q = 0, ..., nv-1. Sets nonfinite if any value is inf or NaN.
+template <int nv, typename Values>
+double max_abs( int64_t n, Values values, bool* nonfinite )
+{
+    double vmax = 0, nan0 = 0;
+    #pragma omp parallel reduction(max: vmax) reduction(+: nan0)
+    {
+        int64_t begin, end;
+        thread_range( n, &begin, &end );
+        max_abs_block<nv>( begin, end, values, &vmax, &nan0 );
+    }
+    *nonfinite = (nan0 != 0);
+    return vmax;
+}
+
+//------------------------------------------------------------------------------
+/// Adds the folds of the values v = values( i, q ), for i in [begin, end),
+/// q = 0, ..., nv-1, to T[ 0:2 ]; see sum.
+template <int nv, typename Values>
+void sum_block(
+    int64_t begin, int64_t end, Values values,
+    double scale, double s1, double s2, double s3, double T[ 3 ] )
+{
+    double t1 = 0, t2 = 0, t3 = 0;
+    #pragma omp simd reduction(+: t1, t2, t3)
+    for (int64_t i = begin; i < end; ++i) {
+        for (int q = 0; q < nv; ++q) {
+            double r = values( i, q ) * scale;
+            double q1 = (s1 + r) - s1;
+            r -= q1;
+            double q2 = (s2 + r) - s2;
+            r -= q2;
+            double q3 = (s3 + r) - s3;
+            t1 += q1;
+            t2 += q2;
+            t3 += q3;
+        }
+    }
+    T[ 0 ] = t1;
+    T[ 1 ] = t2;
+    T[ 2 ] = t3;
+}
+
+//------------------------------------------------------------------------------
+/// Reproducible sum of the nv*n values v = values( i, q ),
+/// for i = 0, ..., n-1, q = 0, ..., nv-1; see blas::repro.
+///
+/// Each value is scaled by a power of two, to avoid overflow in the
+/// extraction, then split against sigma_k = 2^e_k into parts q_k, by
+/// q_k = (sigma_k + r) - sigma_k, r -= q_k (Rump, Ogita, and Oishi,
+/// ExtractVector). With sigma_1 >= 2^L max |v|, where 2^L >= nv*n + 2,
+/// the q_1 are multiples of ulp( sigma_1 ) whose sum is exact in any
+/// order, and |r| <= ulp( sigma_1 ), so sigma_2 = 2^L ulp( sigma_1 ), etc.
+/// Since the scaling is exact, fma( v, scale, sigma ) rounds the same as
+/// the separate operations, so the result doesn't depend on whether the
+/// compiler contracts them.
+template <int nv, typename Values>
+double sum( int64_t n, Values values )
+{
+    if (n == 0)
+        return 0;
+
+    bool nonfinite;
+    double vmax = max_abs<nv>( n, values, &nonfinite );
+    if (nonfinite) {
+        // inf or nan: sum sequentially in index order
+        double s = 0;
+        for (int64_t i = 0; i < n; ++i) {
+            for (int q = 0; q < nv; ++q)
+                s += values( i, q );
+        }
+        return s;
+    }
+    if (vmax == 0)
+        return 0;
+
+    const int p       = std::numeric_limits<double>::digits;  // 53
+    const int max_exp = std::numeric_limits<double>::max_exponent;
+    const int min_exp = std::numeric_limits<double>::min_exponent;
+
+    int L = 1;
+    while ((int64_t( 1 ) << L) < nv*n + 2)
+        ++L;
+
+    // vmax < 2^e_max
+    int e_max;
+    std::frexp( vmax, &e_max );
+
+    // scale so 2 sigma_1 doesn't overflow
+    int e1 = e_max + L;
+    int shift = std::max( 0, e1 - (max_exp - 2) );
+    e1 -= shift;
+    double scale = std::ldexp( 1.0, -shift );
+
+    // later folds are clamped so ulp( sigma_k ) stays normal;
+    // this only extracts zeros
+    int e_min = min_exp - 2 + p;
+    int e2 = std::max( e1 + L + 1 - p, e_min );
+    int e3 = std::max( e2 + L + 1 - p, e_min );
+    double s1 = std::ldexp( 1.0, e1 );
+    double s2 = std::ldexp( 1.0, e2 );
+    double s3 = std::ldexp( 1.0, e3 );
+
+    // partial sums are exact, so reducing them in any order is too
+    double T1 = 0, T2 = 0, T3 = 0;
+    #pragma omp parallel reduction(+: T1, T2, T3)
+    {
+        int64_t begin, end;
+        double T[ 3 ];
+        thread_range( n, &begin, &end );
+        sum_block<nv>( begin, end, values, scale, s1, s2, s3, T );
+        T1 = T[ 0 ];
+        T2 = T[ 1 ];
+        T3 = T[ 2 ];
+    }
+    return std::ldexp( (T1 + T2) + T3, shift );
+}
+
+//------------------------------------------------------------------------------
+/// @return offset of the first entry of x, for incx < 0.
+inline int64_t first( int64_t n, int64_t incx )
+{
+    return (incx > 0 ? 0 : (-n + 1)*incx);
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+T dot_real(
+    int64_t n,
+    T const *x, int64_t incx,
+    T const *y, int64_t incy )
+{
+    blas_error_if( n < 0 );
+    blas_error_if( incx == 0 );
+    blas_error_if( incy == 0 );
+
+    x += first( n, incx );
+    y += first( n, incy );
+    if (incx == 1 && incy == 1) {
+        // unit stride, for the compiler to vectorize without gathers
+        return T( sum<1>( n, [=]( int64_t i, int ) {
+            return double( x[ i ] ) * double( y[ i ] );
+        }));
+    }
+    return T( sum<1>( n, [=]( int64_t i, int ) {
+        return double( x[ i*incx ] ) * double( y[ i*incy ] );
+    }));
+}
+
+//------------------------------------------------------------------------------
+/// conj = true for x^H y, false for x^T y.
+/// Re = sum a c -+ b d, Im = sum a d +- b c, for x_i = a + bi, y_i = c + di.
+template <typename T>
+std::complex<T> dot_complex(
+    bool conj,
+    int64_t n,
+    std::complex<T> const *x, int64_t incx,
+    std::complex<T> const *y, int64_t incy )
+{
+    blas_error_if( n < 0 );
+    blas_error_if( incx == 0 );
+    blas_error_if( incy == 0 );
+
+    T const* xr = reinterpret_cast< T const* >( x + first( n, incx ) );
+    T const* yr = reinterpret_cast< T const* >( y + first( n, incy ) );
+    double sign = (conj ? -1.0 : 1.0);
+    double re = sum<2>( n, [=]( int64_t i, int q ) {
+        return q == 0
+            ? double( xr[ 2*i*incx     ] ) * double( yr[ 2*i*incy     ] )
+            : -sign * (double( xr[ 2*i*incx + 1 ] )
+                       * double( yr[ 2*i*incy + 1 ] ));
+    });
+    double im = sum<2>( n, [=]( int64_t i, int q ) {
+        return q == 0
+            ? double( xr[ 2*i*incx     ] ) * double( yr[ 2*i*incy + 1 ] )
+            : sign * (double( xr[ 2*i*incx + 1 ] )
+                      * double( yr[ 2*i*incy     ] ));
+    });
+    return std::complex<T>( T( re ), T( im ) );
+}
+
+//------------------------------------------------------------------------------
+/// T is the real type; nv = 2 for complex x, stored as pairs of T.
+template <int nv, typename T>
+T asum_generic( int64_t n, T const *x, int64_t incx )
+{
+    blas_error_if( n < 0 );
+    blas_error_if( incx <= 0 );
+
+    if (incx == 1) {
+        // unit stride, for the compiler to vectorize without gathers
+        return T( sum<nv>( n, [=]( int64_t i, int q ) {
+            return std::abs( double( x[ nv*i + q ] ) );
+        }));
+    }
+    return T( sum<nv>( n, [=]( int64_t i, int q ) {
+        return std::abs( double( x[ nv*i*incx + q ] ) );
+    }));
+}
+
+//------------------------------------------------------------------------------
+/// T is the real type; nv = 2 for complex x, stored as pairs of T.
+/// Scales x by a power of two near 1 / max |x_i|, so the squares
+/// neither overflow nor underflow, except for negligible entries.
+template <int nv, typename T>
+T nrm2_generic( int64_t n, T const *x, int64_t incx )
+{
+    blas_error_if( n < 0 );
+    blas_error_if( incx <= 0 );
+
+    bool nonfinite;
+    double xmax = max_abs<nv>( n, [=]( int64_t i, int q ) {
+        return double( x[ nv*i*incx + q ] );
+    }, &nonfinite );
+    if (xmax == 0 && ! nonfinite)
+        return 0;
+
+    int e = 0;
+    if (! nonfinite)
+        std::frexp( xmax, &e );
+    double scale = std::ldexp( 1.0, -e );
+    double ssq = sum<nv>( n, [=]( int64_t i, int q ) {
+        double xs = double( x[ nv*i*incx + q ] ) * scale;
+        return xs*xs;
+    });
+    return T( std::ldexp( std::sqrt( ssq ), e ) );
+}
+
+}  // namespace
+
+// =============================================================================
+// Overloaded routines for s, d, c, z precisions.
+
+//------------------------------------------------------------------------------
+float dot(
+    int64_t n,
+    float const *x, int64_t incx,
+    float const *y, int64_t incy )
+{
+    return dot_real( n, x, incx, y, incy );
+}
+
+double dot(
+    int64_t n,
+    double const *x, int64_t incx,
+    double const *y, int64_t incy )
+{
+    return dot_real( n, x, incx, y, incy );
+}
+
+std::complex<float> dot(
+    int64_t n,
+    std::complex<float> const *x, int64_t incx,
+    std::complex<float> const *y, int64_t incy )
+{
+    return dot_complex( true, n, x, incx, y, incy );
+}
+
+std::complex<double> dot(
+    int64_t n,
+    std::complex<double> const *x, int64_t incx,
+    std::complex<double> const *y, int64_t incy )
+{
+    return dot_complex( true, n, x, incx, y, incy );
+}
+
+//------------------------------------------------------------------------------
+std::complex<float> dotu(
+    int64_t n,
+    std::complex<float> const *x, int64_t incx,
+    std::complex<float> const *y, int64_t incy )
+{
+    return dot_complex( false, n, x, incx, y, incy );
+}
+
+std::complex<double> dotu(
+    int64_t n,
+    std::complex<double> const *x, int64_t incx,
+    std::complex<double> const *y, int64_t incy )
+{
+    return dot_complex( false, n, x, incx, y, incy );
+}
+
+//------------------------------------------------------------------------------
+float asum(
+    int64_t n,
+    float const *x, int64_t incx )
+{
+    return asum_generic<1>( n, x, incx );
+}
+
+double asum(
+    int64_t n,
+    double const *x, int64_t incx )
+{
+    return asum_generic<1>( n, x, incx );
+}
+
+float asum(
+    int64_t n,
+    std::complex<float> const *x, int64_t incx )
+{
+    return asum_generic<2>( n, reinterpret_cast< float const* >( x ), incx );
+}
+
+double asum(
+    int64_t n,
+    std::complex<double> const *x, int64_t incx )
+{
+    return asum_generic<2>( n, reinterpret_cast< double const* >( x ), incx );
+}
+
+//------------------------------------------------------------------------------
+float nrm2(
+    int64_t n,
+    float const *x, int64_t incx )
+{
+    return nrm2_generic<1>( n, x, incx );
+}
+
+double nrm2(
+    int64_t n,
+    double const *x, int64_t incx )
+{
+    return nrm2_generic<1>( n, x, incx );
+}
+
+float nrm2(
+    int64_t n,
+    std::complex<float> const *x, int64_t incx )
+{
+    return nrm2_generic<2>( n, reinterpret_cast< float const* >( x ), incx );
+}
+
+double nrm2(
+    int64_t n,
+    std::complex<double> const *x, int64_t incx )
+{
+    return nrm2_generic<2>( n, reinterpret_cast< double const* >( x ), incx );
+}
+
+}  // namespace repro
+}  // namespace blas
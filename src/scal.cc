@@ -5,6 +5,8 @@
 
 #include "blas/fortran.h"
 #include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 
 #include <limits>
 
@@ -24,6 +26,10 @@ void scal(
     blas_error_if( n < 0 );      // standard BLAS returns, doesn't fail
     blas_error_if( incx <= 0 );  // standard BLAS returns, doesn't fail
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "scal", 's', {},
+                          n, 0, 0, Gflop< float >::scal( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n    > std::numeric_limits<blas_int>::max() );
@@ -46,6 +52,10 @@ void scal(
     blas_error_if( n < 0 );      // standard BLAS returns, doesn't fail
     blas_error_if( incx <= 0 );  // standard BLAS returns, doesn't fail
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "scal", 'd', {},
+                          n, 0, 0, Gflop< double >::scal( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n    > std::numeric_limits<blas_int>::max() );
@@ -68,6 +78,10 @@ void scal(
     blas_error_if( n < 0 );      // standard BLAS returns, doesn't fail
     blas_error_if( incx <= 0 );  // standard BLAS returns, doesn't fail
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "scal", 'c', {},
+                          n, 0, 0, Gflop< std::complex<float> >::scal( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n    > std::numeric_limits<blas_int>::max() );
@@ -92,6 +106,10 @@ void scal(
     blas_error_if( n < 0 );      // standard BLAS returns, doesn't fail
     blas_error_if( incx <= 0 );  // standard BLAS returns, doesn't fail
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "scal", 'z', {},
+                          n, 0, 0, Gflop< std::complex<double> >::scal( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n    > std::numeric_limits<blas_int>::max() );
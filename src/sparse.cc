@@ -0,0 +1,455 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "blas/sparse.hh"
+#include "blas/profile.hh"
+
+#include <algorithm>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+namespace blas {
+namespace sparse {
+namespace internal {
+
+// Below this many multiply-adds, kernels run on one thread.
+const int64_t sparse_parallel_min = 20000;
+
+//------------------------------------------------------------------------------
+/// Dense operand with row stride rs and column stride cs:
+/// entry (i, r) is data[ i*rs + r*cs ].
+template <typename T>
+struct Dense {
+    T* data;
+    int64_t rs, cs;
+};
+
+//------------------------------------------------------------------------------
+/// C = alpha op(A) B + beta C, when output rows are the compressed rows of
+/// A, i.e., CSR or BSR with NoTrans, or CSC with Trans. Output row
+/// I*bs + ci is the dot product of compressed row I, entry ci of each
+/// block, with B. Computes compressed rows [ begin, end ).
+template <typename T>
+void gemm_gather(
+    Matrix<T> const& A, bool do_conj, int64_t begin, int64_t end, int64_t n,
+    T alpha, Dense<T const> B, T beta, Dense<T> C )
+{
+    int64_t bs  = A.block_size();
+    int64_t bs2 = bs*bs;
+    int64_t const* ptr = A.ptr();
+    int64_t const* ind = A.ind();
+    T const* val = A.values();
+    bool contiguous = (B.cs == 1 && C.cs == 1);
+
+    for (int64_t I = begin; I < end; ++I) {
+        for (int64_t ci = 0; ci < bs; ++ci) {
+            T* Ci = C.data + (I*bs + ci)*C.rs;
+            if (contiguous) {
+                // scale row of C, then add alpha a_ij B( j, : )
+                if (beta == T( 0 )) {
+                    std::fill( Ci, Ci + n, T( 0 ) );
+                }
+                else if (beta != T( 1 )) {
+                    for (int64_t r = 0; r < n; ++r)
+                        Ci[ r ] *= beta;
+                }
+                for (int64_t p = ptr[ I ]; p < ptr[ I+1 ]; ++p) {
+                    for (int64_t oj = 0; oj < bs; ++oj) {
+                        T a = alpha * conj_if( do_conj,
+                                               val[ p*bs2 + ci + oj*bs ] );
+                        T const* Bj = B.data + (ind[ p ]*bs + oj)*B.rs;
+                        #pragma omp simd
+                        for (int64_t r = 0; r < n; ++r)
+                            Ci[ r ] += a * Bj[ r ];
+                    }
+                }
+            }
+            else {
+                for (int64_t r = 0; r < n; ++r) {
+                    T sum = 0;
+                    T const* Br = B.data + r*B.cs;
+                    for (int64_t p = ptr[ I ]; p < ptr[ I+1 ]; ++p) {
+                        for (int64_t oj = 0; oj < bs; ++oj) {
+                            sum += conj_if( do_conj, val[ p*bs2 + ci + oj*bs ] )
+                                   * Br[ (ind[ p ]*bs + oj)*B.rs ];
+                        }
+                    }
+                    T& c = Ci[ r*C.cs ];
+                    c = (beta == T( 0 ) ? alpha*sum : alpha*sum + beta*c);
+                }
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// C = alpha op(A) B + beta C, when output rows are the indices of A,
+/// i.e., CSR or BSR with Trans, or CSC with NoTrans. Computes output
+/// block rows [ begin, end ): each compressed row is searched for its
+/// entries in that range, so threads write disjoint rows of C.
+template <typename T>
+void gemm_scatter(
+    Matrix<T> const& A, bool do_conj, int64_t begin, int64_t end, int64_t n,
+    T alpha, Dense<T const> B, T beta, Dense<T> C )
+{
+    int64_t bs  = A.block_size();
+    int64_t bs2 = bs*bs;
+    int64_t const* ptr = A.ptr();
+    int64_t const* ind = A.ind();
+    T const* val = A.values();
+    bool contiguous = (B.cs == 1 && C.cs == 1);
+
+    for (int64_t o = begin*bs; o < end*bs; ++o) {
+        T* Co = C.data + o*C.rs;
+        for (int64_t r = 0; r < n; ++r) {
+            T& c = Co[ r*C.cs ];
+            c = (beta == T( 0 ) ? T( 0 ) : beta*c);
+        }
+    }
+
+    int64_t ncomp = A.compressed();
+    for (int64_t I = 0; I < ncomp; ++I) {
+        int64_t p = std::lower_bound( ind + ptr[ I ], ind + ptr[ I+1 ], begin )
+                    - ind;
+        for (; p < ptr[ I+1 ] && ind[ p ] < end; ++p) {
+            for (int64_t oj = 0; oj < bs; ++oj) {
+                T* Co = C.data + (ind[ p ]*bs + oj)*C.rs;
+                for (int64_t ci = 0; ci < bs; ++ci) {
+                    T a = alpha * conj_if( do_conj, val[ p*bs2 + ci + oj*bs ] );
+                    T const* Bi = B.data + (I*bs + ci)*B.rs;
+                    if (contiguous) {
+                        #pragma omp simd
+                        for (int64_t r = 0; r < n; ++r)
+                            Co[ r ] += a * Bi[ r ];
+                    }
+                    else {
+                        for (int64_t r = 0; r < n; ++r)
+                            Co[ r*C.cs ] += a * Bi[ r*B.cs ];
+                    }
+                }
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @return first compressed row of part t of nparts, splitting rows so each
+/// part has about the same number of nonzeros plus rows, i.e., the least
+/// I with ptr[ I ] + I >= t (nnz + ncomp) / nparts.
+inline int64_t balanced_split(
+    int64_t const* ptr, int64_t ncomp, int64_t t, int64_t nparts )
+{
+    int64_t total  = ptr[ ncomp ] + ncomp;
+    int64_t target = int64_t( double( total ) * t / nparts );
+    int64_t lo = 0, hi = ncomp;
+    while (lo < hi) {
+        int64_t mid = lo + (hi - lo) / 2;
+        if (ptr[ mid ] + mid < target)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+//------------------------------------------------------------------------------
+/// C = alpha op(A) B + beta C, for op(A) mo-by-mi and B, C with n columns.
+template <typename T>
+void gemm(
+    blas::Op trans, int64_t n,
+    T alpha, Matrix<T> const& A, Dense<T const> B, T beta, Dense<T> C )
+{
+    bool compressed_rows = (A.format() != Format::CSC);
+    bool gather = (compressed_rows == (trans == Op::NoTrans));
+    bool do_conj = (trans == Op::ConjTrans);
+    int64_t bs = A.block_size();
+    int64_t ncomp = A.compressed();
+    int64_t nother = (compressed_rows ? A.n() : A.m()) / bs;
+    int64_t work = (A.nnz() + ncomp) * std::max( n, int64_t( 1 ) );
+
+    #pragma omp parallel if (work >= sparse_parallel_min)
+    {
+        #ifdef _OPENMP
+            int64_t t  = omp_get_thread_num();
+            int64_t nt = omp_get_num_threads();
+        #else
+            int64_t t  = 0;
+            int64_t nt = 1;
+        #endif
+        if (gather) {
+            int64_t begin = balanced_split( A.ptr(), ncomp, t,     nt );
+            int64_t end   = balanced_split( A.ptr(), ncomp, t + 1, nt );
+            gemm_gather( A, do_conj, begin, end, n, alpha, B, beta, C );
+        }
+        else {
+            int64_t begin = nother * t / nt;
+            int64_t end   = nother * (t + 1) / nt;
+            gemm_scatter( A, do_conj, begin, end, n, alpha, B, beta, C );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Sparse gemv; checks arguments and calls gemm with one column.
+template <typename T>
+void gemv(
+    blas::Op trans,
+    T alpha,
+    Matrix<T> const& A,
+    T const *x, int64_t incx,
+    T beta,
+    T       *y, int64_t incy )
+{
+    // check arguments
+    blas_error_if( trans != Op::NoTrans &&
+                   trans != Op::Trans &&
+                   trans != Op::ConjTrans );
+    blas_error_if( incx == 0 );
+    blas_error_if( incy == 0 );
+
+    int64_t lenx = (trans == Op::NoTrans ? A.n() : A.m());
+    int64_t leny = (trans == Op::NoTrans ? A.m() : A.n());
+
+    // quick return
+    if (leny == 0)
+        return;
+
+    if (incx < 0)
+        x -= (lenx - 1) * incx;
+    if (incy < 0)
+        y -= (leny - 1) * incy;
+
+    Dense<T const> xd = { x, incx, 0 };
+    Dense<T>       yd = { y, incy, 0 };
+    gemm( trans, 1, alpha, A, xd, beta, yd );
+}
+
+//------------------------------------------------------------------------------
+/// Sparse gemm; checks arguments and sets strides of B and C.
+template <typename T>
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    int64_t n,
+    T alpha,
+    Matrix<T> const& A,
+    T const *B, int64_t ldb,
+    T beta,
+    T       *C, int64_t ldc )
+{
+    // check arguments
+    blas_error_if( layout != Layout::ColMajor &&
+                   layout != Layout::RowMajor );
+    blas_error_if( transA != Op::NoTrans &&
+                   transA != Op::Trans &&
+                   transA != Op::ConjTrans );
+    blas_error_if( n < 0 );
+
+    int64_t mi = (transA == Op::NoTrans ? A.n() : A.m());
+    int64_t mo = (transA == Op::NoTrans ? A.m() : A.n());
+    if (layout == Layout::ColMajor) {
+        blas_error_if( ldb < mi );
+        blas_error_if( ldc < mo );
+    }
+    else {
+        blas_error_if( ldb < n );
+        blas_error_if( ldc < n );
+    }
+
+    // quick return
+    if (mo == 0 || n == 0)
+        return;
+
+    Dense<T const> Bd;
+    Dense<T> Cd;
+    if (layout == Layout::ColMajor) {
+        Bd = { B, 1, ldb };
+        Cd = { C, 1, ldc };
+    }
+    else {
+        Bd = { B, ldb, 1 };
+        Cd = { C, ldc, 1 };
+    }
+    gemm( transA, n, alpha, A, Bd, beta, Cd );
+}
+
+}  // namespace internal
+
+// =============================================================================
+// Overloaded wrappers for s, d, c, z precisions.
+
+namespace {
+
+// Flops for y = alpha op(A) x + beta y with n columns: a multiply and add
+// per stored entry and column, as for dense gemm.
+template <typename T>
+double gflop( Matrix<T> const& A, int64_t n )
+{
+    double ops = is_complex<T>::value ? 8 : 2;
+    return 1e-9 * ops * A.nnz() * n;
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemv
+void gemv(
+    blas::Op trans,
+    float alpha,
+    Matrix<float> const& A,
+    float const *x, int64_t incx,
+    float beta,
+    float       *y, int64_t incy )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "sparse_gemv", 's',
+                          { format2char( A.format() ), op2char( trans ) },
+                          A.m(), A.n(), 0, gflop( A, 1 ) );
+
+    internal::gemv( trans, alpha, A, x, incx, beta, y, incy );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemv
+void gemv(
+    blas::Op trans,
+    double alpha,
+    Matrix<double> const& A,
+    double const *x, int64_t incx,
+    double beta,
+    double       *y, int64_t incy )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "sparse_gemv", 'd',
+                          { format2char( A.format() ), op2char( trans ) },
+                          A.m(), A.n(), 0, gflop( A, 1 ) );
+
+    internal::gemv( trans, alpha, A, x, incx, beta, y, incy );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemv
+void gemv(
+    blas::Op trans,
+    std::complex<float> alpha,
+    Matrix< std::complex<float> > const& A,
+    std::complex<float> const *x, int64_t incx,
+    std::complex<float> beta,
+    std::complex<float>       *y, int64_t incy )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "sparse_gemv", 'c',
+                          { format2char( A.format() ), op2char( trans ) },
+                          A.m(), A.n(), 0, gflop( A, 1 ) );
+
+    internal::gemv( trans, alpha, A, x, incx, beta, y, incy );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemv
+void gemv(
+    blas::Op trans,
+    std::complex<double> alpha,
+    Matrix< std::complex<double> > const& A,
+    std::complex<double> const *x, int64_t incx,
+    std::complex<double> beta,
+    std::complex<double>       *y, int64_t incy )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "sparse_gemv", 'z',
+                          { format2char( A.format() ), op2char( trans ) },
+                          A.m(), A.n(), 0, gflop( A, 1 ) );
+
+    internal::gemv( trans, alpha, A, x, incx, beta, y, incy );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    int64_t n,
+    float alpha,
+    Matrix<float> const& A,
+    float const *B, int64_t ldb,
+    float beta,
+    float       *C, int64_t ldc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "sparse_gemm", 's',
+                          { layout2char( layout ), format2char( A.format() ),
+                            op2char( transA ) },
+                          A.m(), n, A.n(), gflop( A, n ) );
+
+    internal::gemm( layout, transA, n, alpha, A, B, ldb, beta, C, ldc );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    int64_t n,
+    double alpha,
+    Matrix<double> const& A,
+    double const *B, int64_t ldb,
+    double beta,
+    double       *C, int64_t ldc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "sparse_gemm", 'd',
+                          { layout2char( layout ), format2char( A.format() ),
+                            op2char( transA ) },
+                          A.m(), n, A.n(), gflop( A, n ) );
+
+    internal::gemm( layout, transA, n, alpha, A, B, ldb, beta, C, ldc );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    int64_t n,
+    std::complex<float> alpha,
+    Matrix< std::complex<float> > const& A,
+    std::complex<float> const *B, int64_t ldb,
+    std::complex<float> beta,
+    std::complex<float>       *C, int64_t ldc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "sparse_gemm", 'c',
+                          { layout2char( layout ), format2char( A.format() ),
+                            op2char( transA ) },
+                          A.m(), n, A.n(), gflop( A, n ) );
+
+    internal::gemm( layout, transA, n, alpha, A, B, ldb, beta, C, ldc );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gemm
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    int64_t n,
+    std::complex<double> alpha,
+    Matrix< std::complex<double> > const& A,
+    std::complex<double> const *B, int64_t ldb,
+    std::complex<double> beta,
+    std::complex<double>       *C, int64_t ldc )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "sparse_gemm", 'z',
+                          { layout2char( layout ), format2char( A.format() ),
+                            op2char( transA ) },
+                          A.m(), n, A.n(), gflop( A, n ) );
+
+    internal::gemm( layout, transA, n, alpha, A, B, ldb, beta, C, ldc );
+}
+
+}  // namespace sparse
+}  // namespace blas
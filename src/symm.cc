@@ -5,6 +5,8 @@
 
 #include "blas/fortran.h"
 #include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 
 #include <limits>
 
@@ -52,6 +54,12 @@ void symm(
         blas_error_if( ldc < n );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "symm", 's',
+                          { layout2char( layout ), side2char( side ),
+                            uplo2char( uplo ) },
+                          m, n, 0, Gflop< float >::symm( side, m, n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( m   > std::numeric_limits<blas_int>::max() );
@@ -119,6 +127,12 @@ void symm(
         blas_error_if( ldc < n );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "symm", 'd',
+                          { layout2char( layout ), side2char( side ),
+                            uplo2char( uplo ) },
+                          m, n, 0, Gflop< double >::symm( side, m, n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( m   > std::numeric_limits<blas_int>::max() );
@@ -186,6 +200,13 @@ void symm(
         blas_error_if( ldc < n );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "symm", 'c',
+                          { layout2char( layout ), side2char( side ),
+                            uplo2char( uplo ) },
+                          m, n, 0,
+                          Gflop< std::complex<float> >::symm( side, m, n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( m   > std::numeric_limits<blas_int>::max() );
@@ -257,6 +278,13 @@ void symm(
         blas_error_if( ldc < n );
     }
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "symm", 'z',
+                          { layout2char( layout ), side2char( side ),
+                            uplo2char( uplo ) },
+                          m, n, 0,
+                          Gflop< std::complex<double> >::symm( side, m, n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( m   > std::numeric_limits<blas_int>::max() );
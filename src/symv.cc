@@ -5,6 +5,8 @@
 
 #include "blas/fortran.h"
 #include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 
 #include <limits>
 
@@ -35,6 +37,11 @@ void symv(
     blas_error_if( incx == 0 );
     blas_error_if( incy == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "symv", 's',
+                          { layout2char( layout ), uplo2char( uplo ) },
+                          n, 0, 0, Gflop< float >::symv( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n              > std::numeric_limits<blas_int>::max() );
@@ -80,6 +87,11 @@ void symv(
     blas_error_if( incx == 0 );
     blas_error_if( incy == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "symv", 'd',
+                          { layout2char( layout ), uplo2char( uplo ) },
+                          n, 0, 0, Gflop< double >::symv( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n              > std::numeric_limits<blas_int>::max() );
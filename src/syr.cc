@@ -5,6 +5,8 @@
 
 #include "blas/fortran.h"
 #include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 
 #include <limits>
 
@@ -32,6 +34,11 @@ void syr(
     blas_error_if( lda < n );
     blas_error_if( incx == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "syr", 's',
+                          { layout2char( layout ), uplo2char( uplo ) },
+                          n, 0, 0, Gflop< float >::syr( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n              > std::numeric_limits<blas_int>::max() );
@@ -71,6 +78,11 @@ void syr(
     blas_error_if( lda < n );
     blas_error_if( incx == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "syr", 'd',
+                          { layout2char( layout ), uplo2char( uplo ) },
+                          n, 0, 0, Gflop< double >::syr( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n              > std::numeric_limits<blas_int>::max() );
@@ -5,6 +5,8 @@
 
 #include "blas/fortran.h"
 #include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 
 #include <limits>
 
@@ -34,6 +36,11 @@ void syr2(
     blas_error_if( incx == 0 );
     blas_error_if( incy == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "syr2", 's',
+                          { layout2char( layout ), uplo2char( uplo ) },
+                          n, 0, 0, Gflop< float >::syr2( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n              > std::numeric_limits<blas_int>::max() );
@@ -77,6 +84,11 @@ void syr2(
     blas_error_if( incx == 0 );
     blas_error_if( incy == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "syr2", 'd',
+                          { layout2char( layout ), uplo2char( uplo ) },
+                          n, 0, 0, Gflop< double >::syr2( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n              > std::numeric_limits<blas_int>::max() );
@@ -120,6 +132,11 @@ void syr2(
     blas_error_if( incx == 0 );
     blas_error_if( incy == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "syr2", 'c',
+                          { layout2char( layout ), uplo2char( uplo ) },
+                          n, 0, 0, Gflop< std::complex<float> >::syr2( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n              > std::numeric_limits<blas_int>::max() );
@@ -209,6 +226,11 @@ void syr2(
     blas_error_if( incx == 0 );
     blas_error_if( incy == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "syr2", 'z',
+                          { layout2char( layout ), uplo2char( uplo ) },
+                          n, 0, 0, Gflop< std::complex<double> >::syr2( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n              > std::numeric_limits<blas_int>::max() );
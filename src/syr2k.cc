@@ -5,6 +5,8 @@
 
 #include "blas/fortran.h"
 #include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 
 #include <limits>
 
@@ -48,6 +50,12 @@ void syr2k(
 
     blas_error_if( ldc < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "syr2k", 's',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( trans ) },
+                          n, 0, k, Gflop< float >::syr2k( n, k ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n   > std::numeric_limits<blas_int>::max() );
@@ -110,6 +118,12 @@ void syr2k(
 
     blas_error_if( ldc < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "syr2k", 'd',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( trans ) },
+                          n, 0, k, Gflop< double >::syr2k( n, k ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n   > std::numeric_limits<blas_int>::max() );
@@ -171,6 +185,13 @@ void syr2k(
 
     blas_error_if( ldc < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "syr2k", 'c',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( trans ) },
+                          n, 0, k,
+                          Gflop< std::complex<float> >::syr2k( n, k ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n   > std::numeric_limits<blas_int>::max() );
@@ -236,6 +257,13 @@ void syr2k(
 
     blas_error_if( ldc < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "syr2k", 'z',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( trans ) },
+                          n, 0, k,
+                          Gflop< std::complex<double> >::syr2k( n, k ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n   > std::numeric_limits<blas_int>::max() );
@@ -5,6 +5,8 @@
 
 #include "blas/fortran.h"
 #include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 
 #include <limits>
 
@@ -43,6 +45,12 @@ void syrk(
 
     blas_error_if( ldc < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "syrk", 's',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( trans ) },
+                          n, 0, k, Gflop< float >::syrk( n, k ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n   > std::numeric_limits<blas_int>::max() );
@@ -99,6 +107,12 @@ void syrk(
 
     blas_error_if( ldc < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "syrk", 'd',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( trans ) },
+                          n, 0, k, Gflop< double >::syrk( n, k ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n   > std::numeric_limits<blas_int>::max() );
@@ -154,6 +168,12 @@ void syrk(
 
     blas_error_if( ldc < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "syrk", 'c',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( trans ) },
+                          n, 0, k, Gflop< std::complex<float> >::syrk( n, k ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n   > std::numeric_limits<blas_int>::max() );
@@ -212,6 +232,13 @@ void syrk(
 
     blas_error_if( ldc < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "syrk", 'z',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( trans ) },
+                          n, 0, k,
+                          Gflop< std::complex<double> >::syrk( n, k ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n   > std::numeric_limits<blas_int>::max() );
@@ -0,0 +1,100 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "blas/threads.hh"
+
+#include <algorithm>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+#if defined(HAVE_MKL)
+    #include <mkl_service.h>
+#elif defined(HAVE_OPENBLAS)
+    extern "C" {
+        void openblas_set_num_threads( int num_threads );
+        int  openblas_get_num_threads( void );
+    }
+#endif
+
+namespace blas {
+
+//------------------------------------------------------------------------------
+/// @return number of threads for BLAS++ parallel regions started by the
+/// calling thread, i.e., omp_get_max_threads(), or 1 without OpenMP.
+int64_t get_num_threads()
+{
+    #ifdef _OPENMP
+        return omp_get_max_threads();
+    #else
+        return 1;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// @return number of threads for each problem in a batch, so that
+/// problems running concurrently times threads per problem does not
+/// exceed get_num_threads(). For large batches this is 1; for a batch of
+/// one problem, all threads.
+///
+/// @param[in] batch
+///     Number of problems in the batch.
+int64_t batch_threads( size_t batch )
+{
+    int64_t nthreads = get_num_threads();
+    return std::max( int64_t( 1 ),
+                     nthreads / std::max( int64_t( 1 ), int64_t( batch ) ) );
+}
+
+//------------------------------------------------------------------------------
+/// Sets thread counts for calls from the calling thread; see ThreadScope.
+///
+/// @param[in] num_threads
+///     Number of threads. num_threads >= 1.
+ThreadScope::ThreadScope( int64_t num_threads ):
+    omp_threads_( 0 ),
+    vendor_threads_( 0 )
+{
+    blas_error_if( num_threads < 1 );
+
+    #ifdef _OPENMP
+        omp_threads_ = omp_get_max_threads();
+        omp_set_num_threads( num_threads );
+    #endif
+
+    #if defined(HAVE_MKL)
+        // returns previous thread-local count; 0 means the global count
+        vendor_threads_ = mkl_set_num_threads_local( num_threads );
+    #elif defined(HAVE_OPENBLAS)
+        #ifdef _OPENMP
+            bool in_parallel = omp_in_parallel();
+        #else
+            bool in_parallel = false;
+        #endif
+        if (! in_parallel) {
+            vendor_threads_ = openblas_get_num_threads();
+            openblas_set_num_threads( num_threads );
+        }
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// Restores the thread counts from before the ThreadScope.
+ThreadScope::~ThreadScope()
+{
+    #ifdef _OPENMP
+        omp_set_num_threads( omp_threads_ );
+    #endif
+
+    #if defined(HAVE_MKL)
+        mkl_set_num_threads_local( vendor_threads_ );
+    #elif defined(HAVE_OPENBLAS)
+        if (vendor_threads_ > 0)
+            openblas_set_num_threads( vendor_threads_ );
+    #endif
+}
+
+}  // namespace blas
@@ -0,0 +1,663 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
+
+#include <algorithm>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+namespace blas {
+namespace tiled {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Tiles of op(X), where X is column-major with leading dimension ld,
+/// and op(X) has rows-by-cols entries in nb-by-nb tiles.
+template <typename T>
+struct Tiles {
+    T* data;
+    int64_t ld;
+    Op op;
+    int64_t rows, cols, nb;
+
+    int64_t mt() const { return (rows + nb - 1) / nb; }
+    int64_t nt() const { return (cols + nb - 1) / nb; }
+
+    /// @return rows of tile row i of op(X).
+    int64_t tile_rows( int64_t i ) const { return std::min( nb, rows - i*nb ); }
+
+    /// @return cols of tile column j of op(X).
+    int64_t tile_cols( int64_t j ) const { return std::min( nb, cols - j*nb ); }
+
+    /// @return pointer to X's tile holding op(X) tile (i, j); the same tile
+    /// of X, and so the same dependency, whatever op is.
+    T* operator() ( int64_t i, int64_t j ) const
+    {
+        return (op == Op::NoTrans ? data + i*nb + j*nb*ld
+                                  : data + j*nb + i*nb*ld);
+    }
+};
+
+template <typename T>
+Tiles<T> tiles( T* data, int64_t ld, Op op, int64_t rows, int64_t cols,
+                int64_t nb )
+{
+    Tiles<T> t = { data, ld, op, rows, cols, nb };
+    return t;
+}
+
+//------------------------------------------------------------------------------
+/// Runs submit(), which creates tasks: directly if already in a parallel
+/// region, so tasks overlap with those of other calls; otherwise in a new
+/// parallel region, whose end waits for the tasks, with the vendor BLAS
+/// single threaded in tasks; see blas::tiled.
+template <typename Submit>
+void run( Submit submit )
+{
+    #ifdef _OPENMP
+        if (omp_in_parallel()) {
+            submit();
+            return;
+        }
+    #endif
+    int64_t nthreads = get_num_threads();
+    ThreadScope thread_scope( 1 );
+    #pragma omp parallel num_threads( nthreads )
+    #pragma omp master
+    submit();
+}
+
+//------------------------------------------------------------------------------
+/// Creates tasks for column-major C = alpha op(A) op(B) + beta C.
+template <typename T>
+void gemm_tasks(
+    T alpha, Tiles<T const> A, Tiles<T const> B,
+    T beta, Tiles<T> C )
+{
+    // with k = 0, one "k tile" of size 0 scales C by beta
+    int64_t kt = std::max( A.nt(), int64_t( 1 ) );
+    for (int64_t i = 0; i < C.mt(); ++i) {
+        for (int64_t j = 0; j < C.nt(); ++j) {
+            for (int64_t l = 0; l < kt; ++l) {
+                int64_t mb = C.tile_rows( i );
+                int64_t nb = C.tile_cols( j );
+                int64_t kb = (A.cols == 0 ? 0 : A.tile_cols( l ));
+                T const* a = A( i, l );
+                T const* b = B( l, j );
+                T* c = C( i, j );
+                T beta_l = (l == 0 ? beta : T( 1 ));
+                #pragma omp task depend( in: a[0], b[0] ) depend( inout: c[0] )
+                blas::gemm( Layout::ColMajor, A.op, B.op, mb, nb, kb,
+                            alpha, a, A.ld, b, B.ld, beta_l, c, C.ld );
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Creates tasks for column-major C = alpha op(A) op(A)^T + beta C,
+/// updating only the uplo triangle of C.
+template <typename T>
+void syrk_tasks(
+    Uplo uplo, T alpha, Tiles<T const> A, T beta, Tiles<T> C )
+{
+    // op(A)^T, as a gemm operand
+    Op transAt = (A.op == Op::NoTrans ? Op::Trans : Op::NoTrans);
+    int64_t kt = std::max( A.nt(), int64_t( 1 ) );
+    for (int64_t j = 0; j < C.nt(); ++j) {
+        int64_t i_begin = (uplo == Uplo::Lower ? j : 0);
+        int64_t i_end   = (uplo == Uplo::Lower ? C.mt() : j + 1);
+        for (int64_t i = i_begin; i < i_end; ++i) {
+            for (int64_t l = 0; l < kt; ++l) {
+                int64_t mb = C.tile_rows( i );
+                int64_t nb = C.tile_cols( j );
+                int64_t kb = (A.cols == 0 ? 0 : A.tile_cols( l ));
+                T const* ai = A( i, l );
+                T const* aj = A( j, l );
+                T* c = C( i, j );
+                T beta_l = (l == 0 ? beta : T( 1 ));
+                if (i == j) {
+                    #pragma omp task depend( in: ai[0] ) depend( inout: c[0] )
+                    blas::syrk( Layout::ColMajor, uplo, A.op, nb, kb,
+                                alpha, ai, A.ld, beta_l, c, C.ld );
+                }
+                else {
+                    #pragma omp task depend( in: ai[0], aj[0] ) depend( inout: c[0] )
+                    blas::gemm( Layout::ColMajor, A.op, transAt, mb, nb, kb,
+                                alpha, ai, A.ld, aj, A.ld, beta_l, c, C.ld );
+                }
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Creates tasks for column-major op(A) X = alpha B (side = Left) or
+/// X op(A) = alpha B (side = Right), overwriting B. After the solve with a
+/// diagonal tile of op(A), the remaining tiles of B are updated by gemm;
+/// alpha is applied at each tile's first update.
+template <typename T>
+void trsm_tasks(
+    Side side, Uplo uplo, Diag diag, T alpha,
+    Tiles<T const> A, Tiles<T> B )
+{
+    // op(A) is lower if exactly one of uplo is lower and op is no-trans
+    bool lower = ((uplo == Uplo::Lower) == (A.op == Op::NoTrans));
+    bool forward = (lower == (side == Side::Left));
+    int64_t nt = A.mt();
+    T one = 1;
+    for (int64_t kk = 0; kk < nt; ++kk) {
+        int64_t k = (forward ? kk : nt - 1 - kk);
+        T alpha_k = (kk == 0 ? alpha : one);
+        int64_t kb = A.tile_rows( k );
+        T const* akk = A( k, k );
+        if (side == Side::Left) {
+            for (int64_t j = 0; j < B.nt(); ++j) {
+                int64_t nb = B.tile_cols( j );
+                T* bkj = B( k, j );
+                #pragma omp task depend( in: akk[0] ) depend( inout: bkj[0] )
+                blas::trsm( Layout::ColMajor, side, uplo, A.op, diag, kb, nb,
+                            alpha_k, akk, A.ld, bkj, B.ld );
+            }
+            // rows i not yet solved: i > k if forward, else i < k
+            for (int64_t ii = kk + 1; ii < nt; ++ii) {
+                int64_t i = (forward ? ii : nt - 1 - ii);
+                int64_t mb = A.tile_rows( i );
+                T const* aik = A( i, k );
+                for (int64_t j = 0; j < B.nt(); ++j) {
+                    int64_t nb = B.tile_cols( j );
+                    T const* bkj = B( k, j );
+                    T* bij = B( i, j );
+                    #pragma omp task depend( in: aik[0], bkj[0] ) depend( inout: bij[0] )
+                    blas::gemm( Layout::ColMajor, A.op, Op::NoTrans, mb, nb, kb,
+                                -one, aik, A.ld, bkj, B.ld, alpha_k, bij, B.ld );
+                }
+            }
+        }
+        else {
+            for (int64_t i = 0; i < B.mt(); ++i) {
+                int64_t mb = B.tile_rows( i );
+                T* bik = B( i, k );
+                #pragma omp task depend( in: akk[0] ) depend( inout: bik[0] )
+                blas::trsm( Layout::ColMajor, side, uplo, A.op, diag, mb, kb,
+                            alpha_k, akk, A.ld, bik, B.ld );
+            }
+            // columns j not yet solved: j > k if forward, else j < k
+            for (int64_t jj = kk + 1; jj < nt; ++jj) {
+                int64_t j = (forward ? jj : nt - 1 - jj);
+                int64_t nb = A.tile_cols( j );
+                T const* akj = A( k, j );
+                for (int64_t i = 0; i < B.mt(); ++i) {
+                    int64_t mb = B.tile_rows( i );
+                    T const* bik = B( i, k );
+                    T* bij = B( i, j );
+                    #pragma omp task depend( in: akj[0], bik[0] ) depend( inout: bij[0] )
+                    blas::gemm( Layout::ColMajor, Op::NoTrans, A.op, mb, nb, kb,
+                                -one, bik, B.ld, akj, A.ld, alpha_k, bij, B.ld );
+                }
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    T alpha,
+    T const *A, int64_t lda,
+    T const *B, int64_t ldb,
+    T beta,
+    T       *C, int64_t ldc,
+    int64_t nb )
+{
+    // check arguments
+    blas_error_if( layout != Layout::ColMajor &&
+                   layout != Layout::RowMajor );
+    blas_error_if( transA != Op::NoTrans &&
+                   transA != Op::Trans &&
+                   transA != Op::ConjTrans );
+    blas_error_if( transB != Op::NoTrans &&
+                   transB != Op::Trans &&
+                   transB != Op::ConjTrans );
+    blas_error_if( m < 0 );
+    blas_error_if( n < 0 );
+    blas_error_if( k < 0 );
+    blas_error_if( nb <= 0 );
+
+    if ((transA == Op::NoTrans) ^ (layout == Layout::RowMajor))
+        blas_error_if( lda < m );
+    else
+        blas_error_if( lda < k );
+
+    if ((transB == Op::NoTrans) ^ (layout == Layout::RowMajor))
+        blas_error_if( ldb < k );
+    else
+        blas_error_if( ldb < n );
+
+    if (layout == Layout::ColMajor)
+        blas_error_if( ldc < m );
+    else
+        blas_error_if( ldc < n );
+
+    // row-major: compute C^T = op(B)^T op(A)^T in column-major
+    if (layout == Layout::RowMajor) {
+        std::swap( transA, transB );
+        std::swap( m, n );
+        std::swap( A, B );
+        std::swap( lda, ldb );
+    }
+
+    Tiles<T const> At = tiles( A, lda, transA, m, k, nb );
+    Tiles<T const> Bt = tiles( B, ldb, transB, k, n, nb );
+    Tiles<T>       Ct = tiles( C, ldc, Op::NoTrans, m, n, nb );
+    run( [&]() { gemm_tasks( alpha, At, Bt, beta, Ct ); } );
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+void syrk(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op trans,
+    int64_t n, int64_t k,
+    T alpha,
+    T const *A, int64_t lda,
+    T beta,
+    T       *C, int64_t ldc,
+    int64_t nb )
+{
+    // check arguments
+    blas_error_if( layout != Layout::ColMajor &&
+                   layout != Layout::RowMajor );
+    blas_error_if( uplo != Uplo::Lower &&
+                   uplo != Uplo::Upper );
+    if (is_complex<T>::value) {
+        blas_error_if( trans != Op::NoTrans &&
+                       trans != Op::Trans );
+    }
+    else {
+        blas_error_if( trans != Op::NoTrans &&
+                       trans != Op::Trans &&
+                       trans != Op::ConjTrans );
+    }
+    blas_error_if( n < 0 );
+    blas_error_if( k < 0 );
+    blas_error_if( nb <= 0 );
+
+    if ((trans == Op::NoTrans) ^ (layout == Layout::RowMajor))
+        blas_error_if( lda < n );
+    else
+        blas_error_if( lda < k );
+
+    blas_error_if( ldc < n );
+
+    if (layout == Layout::RowMajor) {
+        // swap lower <=> upper
+        // A => A^T; A^T => A; A^H => A
+        uplo = (uplo == Uplo::Lower ? Uplo::Upper : Uplo::Lower);
+        trans = (trans == Op::NoTrans ? Op::Trans : Op::NoTrans);
+    }
+    else if (trans == Op::ConjTrans) {
+        // real A^H = A^T
+        trans = Op::Trans;
+    }
+
+    Tiles<T const> At = tiles( A, lda, trans, n, k, nb );
+    Tiles<T>       Ct = tiles( C, ldc, Op::NoTrans, n, n, nb );
+    run( [&]() { syrk_tasks( uplo, alpha, At, beta, Ct ); } );
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+void trsm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    int64_t m, int64_t n,
+    T alpha,
+    T const *A, int64_t lda,
+    T       *B, int64_t ldb,
+    int64_t nb )
+{
+    // check arguments
+    blas_error_if( layout != Layout::ColMajor &&
+                   layout != Layout::RowMajor );
+    blas_error_if( side != Side::Left &&
+                   side != Side::Right );
+    blas_error_if( uplo != Uplo::Lower &&
+                   uplo != Uplo::Upper );
+    blas_error_if( trans != Op::NoTrans &&
+                   trans != Op::Trans &&
+                   trans != Op::ConjTrans );
+    blas_error_if( diag != Diag::NonUnit &&
+                   diag != Diag::Unit );
+    blas_error_if( m < 0 );
+    blas_error_if( n < 0 );
+    blas_error_if( nb <= 0 );
+
+    if (side == Side::Left)
+        blas_error_if( lda < m );
+    else
+        blas_error_if( lda < n );
+
+    if (layout == Layout::ColMajor)
+        blas_error_if( ldb < m );
+    else
+        blas_error_if( ldb < n );
+
+    if (layout == Layout::RowMajor) {
+        // swap lower <=> upper, left <=> right, m <=> n
+        uplo = (uplo == Uplo::Lower ? Uplo::Upper : Uplo::Lower);
+        side = (side == Side::Left ? Side::Right : Side::Left);
+        std::swap( m, n );
+    }
+
+    int64_t na = (side == Side::Left ? m : n);
+    Tiles<T const> At = tiles( A, lda, trans, na, na, nb );
+    Tiles<T>       Bt = tiles( B, ldb, Op::NoTrans, m, n, nb );
+    run( [&]() { trsm_tasks( side, uplo, diag, alpha, At, Bt ); } );
+}
+
+}  // namespace internal
+
+//------------------------------------------------------------------------------
+/// Waits for all tasks created by tiled routines in the current region.
+void wait()
+{
+    #pragma omp taskwait
+}
+
+// =============================================================================
+// Overloaded wrappers for s, d, c, z precisions.
+
+// -----------------------------------------------------------------------------
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    float alpha,
+    float const *A, int64_t lda,
+    float const *B, int64_t ldb,
+    float beta,
+    float       *C, int64_t ldc,
+    int64_t nb )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "tiled_gemm", 's',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, k, Gflop< float >::gemm( m, n, k ) );
+
+    internal::gemm( layout, transA, transB, m, n, k,
+                    alpha, A, lda, B, ldb, beta, C, ldc, nb );
+}
+
+// -----------------------------------------------------------------------------
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    double alpha,
+    double const *A, int64_t lda,
+    double const *B, int64_t ldb,
+    double beta,
+    double       *C, int64_t ldc,
+    int64_t nb )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "tiled_gemm", 'd',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, k, Gflop< double >::gemm( m, n, k ) );
+
+    internal::gemm( layout, transA, transB, m, n, k,
+                    alpha, A, lda, B, ldb, beta, C, ldc, nb );
+}
+
+// -----------------------------------------------------------------------------
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<float> alpha,
+    std::complex<float> const *A, int64_t lda,
+    std::complex<float> const *B, int64_t ldb,
+    std::complex<float> beta,
+    std::complex<float>       *C, int64_t ldc,
+    int64_t nb )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "tiled_gemm", 'c',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, k, Gflop< std::complex<float> >::gemm( m, n, k ) );
+
+    internal::gemm( layout, transA, transB, m, n, k,
+                    alpha, A, lda, B, ldb, beta, C, ldc, nb );
+}
+
+// -----------------------------------------------------------------------------
+void gemm(
+    blas::Layout layout,
+    blas::Op transA,
+    blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    std::complex<double> alpha,
+    std::complex<double> const *A, int64_t lda,
+    std::complex<double> const *B, int64_t ldb,
+    std::complex<double> beta,
+    std::complex<double>       *C, int64_t ldc,
+    int64_t nb )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "tiled_gemm", 'z',
+                          { layout2char( layout ), op2char( transA ),
+                            op2char( transB ) },
+                          m, n, k, Gflop< std::complex<double> >::gemm( m, n, k ) );
+
+    internal::gemm( layout, transA, transB, m, n, k,
+                    alpha, A, lda, B, ldb, beta, C, ldc, nb );
+}
+
+// -----------------------------------------------------------------------------
+void syrk(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op trans,
+    int64_t n, int64_t k,
+    float alpha,
+    float const *A, int64_t lda,
+    float beta,
+    float       *C, int64_t ldc,
+    int64_t nb )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "tiled_syrk", 's',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( trans ) },
+                          n, 0, k, Gflop< float >::syrk( n, k ) );
+
+    internal::syrk( layout, uplo, trans, n, k,
+                    alpha, A, lda, beta, C, ldc, nb );
+}
+
+// -----------------------------------------------------------------------------
+void syrk(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op trans,
+    int64_t n, int64_t k,
+    double alpha,
+    double const *A, int64_t lda,
+    double beta,
+    double       *C, int64_t ldc,
+    int64_t nb )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "tiled_syrk", 'd',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( trans ) },
+                          n, 0, k, Gflop< double >::syrk( n, k ) );
+
+    internal::syrk( layout, uplo, trans, n, k,
+                    alpha, A, lda, beta, C, ldc, nb );
+}
+
+// -----------------------------------------------------------------------------
+void syrk(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op trans,
+    int64_t n, int64_t k,
+    std::complex<float> alpha,
+    std::complex<float> const *A, int64_t lda,
+    std::complex<float> beta,
+    std::complex<float>       *C, int64_t ldc,
+    int64_t nb )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "tiled_syrk", 'c',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( trans ) },
+                          n, 0, k, Gflop< std::complex<float> >::syrk( n, k ) );
+
+    internal::syrk( layout, uplo, trans, n, k,
+                    alpha, A, lda, beta, C, ldc, nb );
+}
+
+// -----------------------------------------------------------------------------
+void syrk(
+    blas::Layout layout,
+    blas::Uplo uplo,
+    blas::Op trans,
+    int64_t n, int64_t k,
+    std::complex<double> alpha,
+    std::complex<double> const *A, int64_t lda,
+    std::complex<double> beta,
+    std::complex<double>       *C, int64_t ldc,
+    int64_t nb )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "tiled_syrk", 'z',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( trans ) },
+                          n, 0, k, Gflop< std::complex<double> >::syrk( n, k ) );
+
+    internal::syrk( layout, uplo, trans, n, k,
+                    alpha, A, lda, beta, C, ldc, nb );
+}
+
+// -----------------------------------------------------------------------------
+void trsm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    int64_t m, int64_t n,
+    float alpha,
+    float const *A, int64_t lda,
+    float       *B, int64_t ldb,
+    int64_t nb )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "tiled_trsm", 's',
+                          { layout2char( layout ), side2char( side ),
+                            uplo2char( uplo ), op2char( trans ),
+                            diag2char( diag ) },
+                          m, n, 0, Gflop< float >::trsm( side, m, n ) );
+
+    internal::trsm( layout, side, uplo, trans, diag, m, n,
+                    alpha, A, lda, B, ldb, nb );
+}
+
+// -----------------------------------------------------------------------------
+void trsm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    int64_t m, int64_t n,
+    double alpha,
+    double const *A, int64_t lda,
+    double       *B, int64_t ldb,
+    int64_t nb )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "tiled_trsm", 'd',
+                          { layout2char( layout ), side2char( side ),
+                            uplo2char( uplo ), op2char( trans ),
+                            diag2char( diag ) },
+                          m, n, 0, Gflop< double >::trsm( side, m, n ) );
+
+    internal::trsm( layout, side, uplo, trans, diag, m, n,
+                    alpha, A, lda, B, ldb, nb );
+}
+
+// -----------------------------------------------------------------------------
+void trsm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    int64_t m, int64_t n,
+    std::complex<float> alpha,
+    std::complex<float> const *A, int64_t lda,
+    std::complex<float>       *B, int64_t ldb,
+    int64_t nb )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "tiled_trsm", 'c',
+                          { layout2char( layout ), side2char( side ),
+                            uplo2char( uplo ), op2char( trans ),
+                            diag2char( diag ) },
+                          m, n, 0, Gflop< std::complex<float> >::trsm( side, m, n ) );
+
+    internal::trsm( layout, side, uplo, trans, diag, m, n,
+                    alpha, A, lda, B, ldb, nb );
+}
+
+// -----------------------------------------------------------------------------
+void trsm(
+    blas::Layout layout,
+    blas::Side side,
+    blas::Uplo uplo,
+    blas::Op trans,
+    blas::Diag diag,
+    int64_t m, int64_t n,
+    std::complex<double> alpha,
+    std::complex<double> const *A, int64_t lda,
+    std::complex<double>       *B, int64_t ldb,
+    int64_t nb )
+{
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "tiled_trsm", 'z',
+                          { layout2char( layout ), side2char( side ),
+                            uplo2char( uplo ), op2char( trans ),
+                            diag2char( diag ) },
+                          m, n, 0, Gflop< std::complex<double> >::trsm( side, m, n ) );
+
+    internal::trsm( layout, side, uplo, trans, diag, m, n,
+                    alpha, A, lda, B, ldb, nb );
+}
+
+}  // namespace tiled
+}  // namespace blas
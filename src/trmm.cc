@@ -5,6 +5,8 @@
 
 #include "blas/fortran.h"
 #include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 
 #include <limits>
 
@@ -52,6 +54,13 @@ void trmm(
     else
         blas_error_if( ldb < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "trmm", 's',
+                          { layout2char( layout ), side2char( side ),
+                            uplo2char( uplo ), op2char( trans ),
+                            diag2char( diag ) },
+                          m, n, 0, Gflop< float >::trmm( side, m, n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( m   > std::numeric_limits<blas_int>::max() );
@@ -119,6 +128,13 @@ void trmm(
     else
         blas_error_if( ldb < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "trmm", 'd',
+                          { layout2char( layout ), side2char( side ),
+                            uplo2char( uplo ), op2char( trans ),
+                            diag2char( diag ) },
+                          m, n, 0, Gflop< double >::trmm( side, m, n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( m   > std::numeric_limits<blas_int>::max() );
@@ -186,6 +202,14 @@ void trmm(
     else
         blas_error_if( ldb < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "trmm", 'c',
+                          { layout2char( layout ), side2char( side ),
+                            uplo2char( uplo ), op2char( trans ),
+                            diag2char( diag ) },
+                          m, n, 0,
+                          Gflop< std::complex<float> >::trmm( side, m, n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( m   > std::numeric_limits<blas_int>::max() );
@@ -255,6 +279,14 @@ void trmm(
     else
         blas_error_if( ldb < n );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "trmm", 'z',
+                          { layout2char( layout ), side2char( side ),
+                            uplo2char( uplo ), op2char( trans ),
+                            diag2char( diag ) },
+                          m, n, 0,
+                          Gflop< std::complex<double> >::trmm( side, m, n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( m   > std::numeric_limits<blas_int>::max() );
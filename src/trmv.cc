@@ -5,6 +5,8 @@
 
 #include "blas/fortran.h"
 #include "blas.hh"
+#include "blas/flops.hh"
+#include "blas/profile.hh"
 
 #include <limits>
 
@@ -38,6 +40,12 @@ void trmv(
     blas_error_if( lda < n );
     blas_error_if( incx == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "trmv", 's',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( trans ), diag2char( diag ) },
+                          n, 0, 0, Gflop< float >::trmv( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n              > std::numeric_limits<blas_int>::max() );
@@ -87,6 +95,12 @@ void trmv(
     blas_error_if( lda < n );
     blas_error_if( incx == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "trmv", 'd',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( trans ), diag2char( diag ) },
+                          n, 0, 0, Gflop< double >::trmv( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n              > std::numeric_limits<blas_int>::max() );
@@ -136,6 +150,12 @@ void trmv(
     blas_error_if( lda < n );
     blas_error_if( incx == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "trmv", 'c',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( trans ), diag2char( diag ) },
+                          n, 0, 0, Gflop< std::complex<float> >::trmv( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n              > std::numeric_limits<blas_int>::max() );
@@ -206,6 +226,12 @@ void trmv(
     blas_error_if( lda < n );
     blas_error_if( incx == 0 );
 
+    // record call, if profiling is enabled; see blas::profile
+    profile::Scope scope( "trmv", 'z',
+                          { layout2char( layout ), uplo2char( uplo ),
+                            op2char( trans ), diag2char( diag ) },
+                          n, 0, 0, Gflop< std::complex<double> >::trmv( n ) );
+
     // check for overflow in native BLAS integer type, if smaller than int64_t
     if (sizeof(int64_t) > sizeof(blas_int)) {
         blas_error_if( n              > std::numeric_limits<blas_int>::max() );
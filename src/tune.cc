@@ -0,0 +1,490 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "blas.hh"
+#include "blas/tune.hh"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include <stdlib.h>
+#include <string.h>
+
+namespace blas {
+namespace tune {
+
+namespace {
+
+const int num_routines   = int( Routine::num_routines );
+const int num_precisions = 4;
+const int num_ops        = 9;
+
+const char precisions[] = { 's', 'd', 'c', 'z' };
+const Op   ops[]        = { Op::NoTrans, Op::Trans, Op::ConjTrans };
+
+// Crossover table; zero means always use the vendor BLAS.
+// Entries are atomic, since every gemm, gemv, and dot call reads them while
+// set_crossover, load, or reset may write them in another thread. Entries
+// are independent, so relaxed loads and stores suffice.
+std::atomic<int64_t> g_crossover[ num_routines ][ num_precisions ][ num_ops ];
+
+//------------------------------------------------------------------------------
+inline int64_t get_entry( int r, int p, int index )
+{
+    return g_crossover[ r ][ p ][ index ].load( std::memory_order_relaxed );
+}
+
+//------------------------------------------------------------------------------
+inline void set_entry( int r, int p, int index, int64_t size )
+{
+    g_crossover[ r ][ p ][ index ].store( size, std::memory_order_relaxed );
+}
+
+// 0 = not yet initialized, 1 = initializing or benchmarking, 2 = ready.
+// While not ready, all calls use the vendor BLAS. This makes it safe for
+// the benchmark to call BLAS++ routines while it fills in the table.
+std::atomic<int> g_state( 0 );
+
+//------------------------------------------------------------------------------
+int precision2index( char precision )
+{
+    switch (precision) {
+        case 's': return 0;
+        case 'd': return 1;
+        case 'c': return 2;
+        case 'z': return 3;
+    }
+    blas_error_if_msg( true, "unknown precision '%c'", precision );
+    return -1;
+}
+
+//------------------------------------------------------------------------------
+int op2index( Op op )
+{
+    switch (op) {
+        case Op::NoTrans:   return 0;
+        case Op::Trans:     return 1;
+        case Op::ConjTrans: return 2;
+    }
+    blas_error_if_msg( true, "unknown op '%c'", op2char( op ) );
+    return -1;
+}
+
+//------------------------------------------------------------------------------
+// Maps the transpose operations of a call to a column of the table.
+// gemm uses opA and opB; gemv uses only opA; dot uses neither.
+int ops2index( Routine routine, Op opA, Op opB )
+{
+    switch (routine) {
+        case Routine::gemm: return 3*op2index( opA ) + op2index( opB );
+        case Routine::gemv: return op2index( opA );
+        default:            return 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Number of distinct ops columns used by routine.
+int num_ops_used( Routine routine )
+{
+    switch (routine) {
+        case Routine::gemm: return 9;
+        case Routine::gemv: return 3;
+        default:            return 1;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Inverse of ops2index, as a string for the tuning file.
+std::string index2ops( Routine routine, int index )
+{
+    switch (routine) {
+        case Routine::gemm:
+            return std::string( 1, tolower( op2char( ops[ index / 3 ] ) ) )
+                 + std::string( 1, tolower( op2char( ops[ index % 3 ] ) ) );
+        case Routine::gemv:
+            return std::string( 1, tolower( op2char( ops[ index ] ) ) );
+        default:
+            return "-";
+    }
+}
+
+//------------------------------------------------------------------------------
+// Reads the table from a file, without touching g_state.
+void load_table( std::string const& filename )
+{
+    std::ifstream file( filename );
+    blas_error_if_msg( ! file, "cannot open tuning file %s",
+                       filename.c_str() );
+
+    std::string line;
+    int lineno = 0;
+    while (std::getline( file, line )) {
+        ++lineno;
+        size_t hash = line.find( '#' );
+        if (hash != std::string::npos)
+            line.erase( hash );
+
+        std::istringstream tokens( line );
+        std::string routine_str, ops_str;
+        char precision;
+        int64_t size;
+        if (! (tokens >> routine_str))
+            continue;  // blank or comment line
+        blas_error_if_msg( ! (tokens >> precision >> ops_str >> size),
+                           "%s:%d: expected routine, precision, op, crossover",
+                           filename.c_str(), lineno );
+
+        int r = 0;
+        while (r < num_routines
+               && routine_str != routine2str( Routine( r ) ))
+            ++r;
+        blas_error_if_msg( r == num_routines, "%s:%d: unknown routine %s",
+                           filename.c_str(), lineno, routine_str.c_str() );
+        Routine routine = Routine( r );
+
+        Op opA = Op::NoTrans, opB = Op::NoTrans;
+        if (routine == Routine::gemm) {
+            blas_error_if_msg( ops_str.size() != 2, "%s:%d: expected 2 ops",
+                               filename.c_str(), lineno );
+            opA = char2op( ops_str[0] );
+            opB = char2op( ops_str[1] );
+        }
+        else if (routine == Routine::gemv) {
+            blas_error_if_msg( ops_str.size() != 1, "%s:%d: expected 1 op",
+                               filename.c_str(), lineno );
+            opA = char2op( ops_str[0] );
+        }
+
+        int p = precision2index( (char) tolower( precision ) );
+        set_entry( r, p, ops2index( routine, opA, opB ), size );
+    }
+}
+
+//------------------------------------------------------------------------------
+// @return minimum time per call of func, in seconds.
+template <typename Func>
+double time_call( Func func, int64_t flops )
+{
+    typedef std::chrono::steady_clock clock;
+
+    // enough repetitions for about 1e6 flops, so timer resolution is ok
+    int64_t reps = std::max( int64_t( 1 ),
+                             int64_t( 1000000 ) / std::max( int64_t( 1 ), flops ) );
+    double best = std::numeric_limits<double>::max();
+    func();  // warmup
+    for (int trial = 0; trial < 3; ++trial) {
+        auto start = clock::now();
+        for (int64_t rep = 0; rep < reps; ++rep)
+            func();
+        std::chrono::duration<double> elapsed = clock::now() - start;
+        best = std::min( best, elapsed.count() / reps );
+    }
+    return best;
+}
+
+//------------------------------------------------------------------------------
+// Sizes to benchmark; crossovers are between consecutive sizes.
+std::vector<int64_t> benchmark_sizes( int64_t max_size )
+{
+    const int64_t all_sizes[] = {
+        1, 2, 3, 4, 5, 6, 8, 10, 12, 16, 20, 24, 32, 40, 48, 64, 80, 96, 128,
+        160, 192, 256 };
+    std::vector<int64_t> sizes;
+    for (int64_t size : all_sizes) {
+        if (size <= max_size)
+            sizes.push_back( size );
+    }
+    return sizes;
+}
+
+//------------------------------------------------------------------------------
+// @return first size at which the vendor BLAS is at least as fast as the
+// in-library kernel, or max_size + 1 if the kernel always wins.
+template <typename KernelFunc, typename VendorFunc>
+int64_t find_crossover( std::vector<int64_t> const& sizes,
+                        KernelFunc kernel, VendorFunc vendor,
+                        int64_t (*flops)( int64_t ) )
+{
+    for (int64_t size : sizes) {
+        double t_kernel = time_call( [&]() { kernel( size ); }, flops( size ) );
+        double t_vendor = time_call( [&]() { vendor( size ); }, flops( size ) );
+        if (t_vendor <= t_kernel)
+            return size;
+    }
+    return sizes.empty() ? 0 : sizes.back() + 1;
+}
+
+int64_t flops_gemm( int64_t size ) { return 2*size*size*size; }
+int64_t flops_gemv( int64_t size ) { return 2*size*size; }
+int64_t flops_dot ( int64_t size ) { return 2*size; }
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void benchmark_precision( char precision, int64_t max_size )
+{
+    const scalar_t alpha = 1, beta = 0;
+    int p = precision2index( precision );
+    std::vector<int64_t> sizes = benchmark_sizes( max_size );
+    int64_t ld = std::max( int64_t( 1 ), max_size );
+    std::vector<scalar_t> A( ld*ld, scalar_t( 0.5 ) );
+    std::vector<scalar_t> B( ld*ld, scalar_t( 0.25 ) );
+    std::vector<scalar_t> C( ld*ld, scalar_t( 0 ) );
+    bool is_cmplx = is_complex<scalar_t>::value;
+
+    // gemm; for real types, ConjTrans is the same as Trans
+    for (int ia = 0; ia < 3; ++ia) {
+        for (int ib = 0; ib < 3; ++ib) {
+            int index = 3*ia + ib;
+            if (! is_cmplx && (ia == 2 || ib == 2)) {
+                int real_index = 3*std::min( ia, 1 ) + std::min( ib, 1 );
+                set_entry( int( Routine::gemm ), p, index,
+                           get_entry( int( Routine::gemm ), p, real_index ) );
+                continue;
+            }
+            Op opA = ops[ ia ], opB = ops[ ib ];
+            set_entry( int( Routine::gemm ), p, index, find_crossover(
+                sizes,
+                [&]( int64_t s ) {
+                    gemm< scalar_t, scalar_t, scalar_t >(
+                        Layout::ColMajor, opA, opB, s, s, s,
+                        alpha, A.data(), s, B.data(), s, beta, C.data(), s );
+                },
+                [&]( int64_t s ) {
+                    gemm( Layout::ColMajor, opA, opB, s, s, s,
+                          alpha, A.data(), s, B.data(), s, beta, C.data(), s );
+                },
+                flops_gemm ) );
+        }
+    }
+
+    // gemv
+    for (int ia = 0; ia < 3; ++ia) {
+        if (! is_cmplx && ia == 2) {
+            set_entry( int( Routine::gemv ), p, 2,
+                       get_entry( int( Routine::gemv ), p, 1 ) );
+            continue;
+        }
+        Op opA = ops[ ia ];
+        set_entry( int( Routine::gemv ), p, ia, find_crossover(
+            sizes,
+            [&]( int64_t s ) {
+                gemv< scalar_t, scalar_t, scalar_t >(
+                    Layout::ColMajor, opA, s, s,
+                    alpha, A.data(), s, B.data(), 1, beta, C.data(), 1 );
+            },
+            [&]( int64_t s ) {
+                gemv( Layout::ColMajor, opA, s, s,
+                      alpha, A.data(), s, B.data(), 1, beta, C.data(), 1 );
+            },
+            flops_gemv ) );
+    }
+
+    // dot; use larger vectors than for gemm and gemv
+    std::vector<int64_t> dot_sizes;
+    for (int64_t size : sizes)
+        dot_sizes.push_back( size*size );
+    // accumulate results so the compiler cannot discard the kernel
+    scalar_t sum = 0;
+    set_entry( int( Routine::dot ), p, 0, find_crossover(
+        dot_sizes,
+        [&]( int64_t s ) {
+            sum += dot< scalar_t, scalar_t >( s, A.data(), 1, B.data(), 1 );
+        },
+        [&]( int64_t s ) {
+            sum += dot( s, A.data(), 1, B.data(), 1 );
+        },
+        flops_dot ) );
+    C[ 0 ] = sum;
+}
+
+//------------------------------------------------------------------------------
+// Measures all crossovers, without touching g_state.
+void benchmark_table( int64_t max_size )
+{
+    benchmark_precision< float                >( 's', max_size );
+    benchmark_precision< double               >( 'd', max_size );
+    benchmark_precision< std::complex<float>  >( 'c', max_size );
+    benchmark_precision< std::complex<double> >( 'z', max_size );
+}
+
+//------------------------------------------------------------------------------
+// Called once, on first use. Loads $BLASPP_TUNE_FILE; if that fails, prints
+// why to stderr, and if $BLASPP_TUNE is set, benchmarks and saves the table.
+void initialize()
+{
+    int expected = 0;
+    if (! g_state.compare_exchange_strong( expected, 1 ))
+        return;  // another thread is initializing
+
+    const char* filename = getenv( "BLASPP_TUNE_FILE" );
+    const char* tune = getenv( "BLASPP_TUNE" );
+    bool loaded = false;
+    if (filename != nullptr) {
+        try {
+            load_table( filename );
+            loaded = true;
+        }
+        catch (Error const& ex) {
+            fprintf( stderr, "BLAS++: %s\n", ex.what() );
+            reset();
+        }
+    }
+    if (! loaded && tune != nullptr
+        && (strcmp( tune, "1" ) == 0 || tolower( tune[0] ) == 'y'))
+    {
+        benchmark_table( 128 );
+        if (filename != nullptr) {
+            try {
+                save( filename );
+            }
+            catch (Error const& ex) {
+                fprintf( stderr, "BLAS++: %s\n", ex.what() );
+            }
+        }
+    }
+    g_state.store( 2, std::memory_order_release );
+}
+
+//------------------------------------------------------------------------------
+void ensure_initialized()
+{
+    if (g_state.load( std::memory_order_acquire ) == 0)
+        initialize();
+}
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+/// @return name of routine, as used in the tuning file.
+const char* routine2str( Routine routine )
+{
+    switch (routine) {
+        case Routine::gemm: return "gemm";
+        case Routine::gemv: return "gemv";
+        case Routine::dot:  return "dot";
+        default:            return "";
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @return crossover size for routine, below which the in-library kernel
+/// is used instead of the vendor BLAS.
+/// On first call, loads the tuning table; see blas::tune.
+///
+/// @param[in] routine
+///     Routine being called.
+///
+/// @param[in] precision
+///     Precision: 's', 'd', 'c', or 'z'.
+///
+/// @param[in] opA
+///     Transpose of A (gemm, gemv); ignored for dot.
+///
+/// @param[in] opB
+///     Transpose of B (gemm); ignored for gemv and dot.
+///
+int64_t crossover( Routine routine, char precision, Op opA, Op opB )
+{
+    int state = g_state.load( std::memory_order_acquire );
+    if (state == 0) {
+        initialize();
+        state = g_state.load( std::memory_order_acquire );
+    }
+    // while initializing or benchmarking, use the vendor BLAS
+    if (state != 2)
+        return 0;
+
+    return get_entry( int( routine ), precision2index( precision ),
+                      ops2index( routine, opA, opB ) );
+}
+
+//------------------------------------------------------------------------------
+/// Sets crossover size for routine; see crossover().
+/// Setting size = 0 always uses the vendor BLAS.
+///
+void set_crossover( Routine routine, char precision,
+                    Op opA, Op opB, int64_t size )
+{
+    blas_error_if( size < 0 );
+    ensure_initialized();
+    set_entry( int( routine ), precision2index( precision ),
+               ops2index( routine, opA, opB ), size );
+}
+
+//------------------------------------------------------------------------------
+/// Resets all crossovers to 0, so the vendor BLAS is always used.
+///
+void reset()
+{
+    for (int r = 0; r < num_routines; ++r) {
+        for (int p = 0; p < num_precisions; ++p) {
+            for (int index = 0; index < num_ops; ++index)
+                set_entry( r, p, index, 0 );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Loads crossovers from a tuning file. Throws Error if the file cannot
+/// be read or parsed. Entries not in the file are unchanged.
+///
+void load( std::string const& filename )
+{
+    ensure_initialized();
+    load_table( filename );
+}
+
+//------------------------------------------------------------------------------
+/// Saves all crossovers to a tuning file. Throws Error if the file cannot
+/// be written.
+///
+void save( std::string const& filename )
+{
+    std::ofstream file( filename );
+    blas_error_if_msg( ! file, "cannot write tuning file %s",
+                       filename.c_str() );
+
+    file << "# BLAS++ tuning table: calls smaller than crossover use the\n"
+         << "# in-library kernel instead of the vendor BLAS.\n"
+         << "# routine  precision  op  crossover\n";
+    for (int r = 0; r < num_routines; ++r) {
+        Routine routine = Routine( r );
+        for (int p = 0; p < num_precisions; ++p) {
+            for (int index = 0; index < num_ops_used( routine ); ++index) {
+                file << routine2str( routine ) << "  "
+                     << precisions[ p ] << "  "
+                     << index2ops( routine, index ) << "  "
+                     << get_entry( r, p, index ) << "\n";
+            }
+        }
+    }
+    blas_error_if_msg( ! file, "error writing tuning file %s",
+                       filename.c_str() );
+}
+
+//------------------------------------------------------------------------------
+/// Measures crossovers for all routines, precisions, and transpose
+/// combinations, comparing the in-library kernels with the vendor BLAS on
+/// square problems up to max_size. Takes a few seconds.
+/// Other threads calling BLAS++ meanwhile use the vendor BLAS.
+///
+void benchmark( int64_t max_size )
+{
+    blas_error_if( max_size < 1 );
+    ensure_initialized();
+
+    int expected = 2;
+    blas_error_if_msg( ! g_state.compare_exchange_strong( expected, 1 ),
+                       "tuning is already in progress" );
+    benchmark_table( max_size );
+    g_state.store( 2, std::memory_order_release );
+}
+
+}  // namespace tune
+}  // namespace blas
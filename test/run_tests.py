@@ -17,6 +17,9 @@
 # with single, double and default sizes
 #     ./run_tests.py --blas1 --type s,d
 #
+# run tuning and other auxiliary tests
+#     ./run_tests.py --aux
+#
 # run gemm, gemv with small, medium sizes
 #     ./run_tests.py -s -m gemm gemv
 
@@ -59,6 +62,7 @@ categories = [
     group_cat.add_argument( '--blas2', action='store_true', help='run Level 2 BLAS tests' ),
     group_cat.add_argument( '--blas3', action='store_true', help='run Level 3 BLAS tests' ),
     group_cat.add_argument( '--batch-blas3', action='store_true', help='run Level 3 Batch BLAS tests' ),
+    group_cat.add_argument( '--aux', action='store_true', help='run auxiliary tests' ),
 ]
 # map category objects to category names: ['lu', 'chol', ...]
 categories = list( map( lambda x: x.dest, categories ) )
@@ -251,12 +255,19 @@ if (opts.blas1):
     [ 'rotm',  dtype_real + n + incx + incy ],
     [ 'scal',  dtype      + n + incx_pos ],
     [ 'swap',  dtype      + n + incx + incy ],
+    [ 'asum-repro', dtype + n + incx_pos ],
+    [ 'dot-repro',  dtype + n + incx + incy ],
+    [ 'nrm2-repro', dtype + n + incx_pos ],
     ]
 
 # Level 2
 if (opts.blas2):
     cmds += [
     [ 'gemv',  dtype      + layout + align + trans + mn + incx + incy ],
+    [ 'gemv-fp16', layout + align + trans + incx + incy + ' --dim 50x40' ],
+    [ 'gemv-bf16', layout + align + trans + incx + incy + ' --dim 50x40' ],
+    [ 'gemv-s8',   layout + align + trans + incx + incy + ' --dim 50x40' ],
+    [ 'gemv-u8',   layout + align + trans + incx + incy + ' --dim 50x40' ],
     [ 'ger',   dtype      + layout + align + mn + incx + incy ],
     [ 'geru',  dtype      + layout + align + mn + incx + incy ],
     [ 'hemv',  dtype      + layout + align + uplo + n + incx + incy ],
@@ -267,12 +278,36 @@ if (opts.blas2):
     [ 'syr2',  dtype      + layout + align + uplo + n + incx + incy ],
     [ 'trmv',  dtype      + layout + align + uplo + trans + diag + n + incx ],
     [ 'trsv',  dtype      + layout + align + uplo + trans + diag + n + incx ],
+    [ 'sparse-gemv', dtype + trans + incx + incy + ' --format r,c,b --bs 3 --density 0.2 --dim 50x40' ],
+    [ 'omatcopy', dtype + layout + align + trans + ' --dim 50x40' ],
+    [ 'imatcopy', dtype + layout + align + trans + ' --dim 50x40' ],
+    [ 'geam',     dtype + layout + align + transA + transB + ' --dim 50x40' ],
+    [ 'col-norms', dtype + layout + align + ' --norm 1,2,m --dim 50x40' ],
+    [ 'row-norms', dtype + layout + align + ' --norm 1,2,m --dim 50x40' ],
+    [ 'col-iamax', dtype + layout + align + ' --dim 50x40' ],
+    [ 'row-iamax', dtype + layout + align + ' --dim 50x40' ],
+    [ 'fixed-gemv', dtype + layout + trans + ' --dim 1:6:1 --dim 8 --dim 2x3 --dim 6x1' ],
+    [ 'fixed-trsv', dtype + layout + uplo + trans + diag + ' --dim 1:6:1 --dim 8' ],
     ]
 
 # Level 3
 if (opts.blas3):
     cmds += [
     [ 'gemm',  dtype         + layout + align + transA + transB + mnk ],
+    [ 'gemm-ksplit', dtype   + layout + transA + transB + ' --dim 40x30x40000' ],
+    [ 'gemm-fp16', layout + align + transA + transB + ' --dim 50x40x30' ],
+    [ 'gemm-bf16', layout + align + transA + transB + ' --dim 50x40x30' ],
+    [ 'gemm-s8',   layout + align + transA + transB + ' --dim 50x40x30' ],
+    [ 'gemm-u8',   layout + align + transA + transB + ' --dim 50x40x30' ],
+    [ 'gemm-strided', dtype + layout + align + transA + transB + incx_pos + incy_pos + ' --dim 50x40x30' ],
+    [ 'gemm-pack', dtype   + batch + layout + align + transA + transB + ' --dim 50x40x30' ],
+    [ 'gemm3m',    dtype_complex + layout + align + transA + transB + ' --dim 50x40x30' ],
+    [ 'gemm-strassen', dtype + layout + align + transA + transB + ' --levels 1 --dim 50x40x30' ],
+    [ 'gemm-strassen', ' --type d --levels 1 --dim 1536' ],  # large enough to recurse
+    [ 'gemm-ooc',  dtype + layout + align + transA + transB + ' --nb 16 --dim 50x40x30' ],
+    [ 'gemmt',     dtype + layout + align + uplo + transA + transB + ' --dim 50x40x30' ],
+    [ 'gemm-epilogue', dtype + layout + align + transA + transB + ' --act i,r,c,s,t --dim 50x40x30' ],
+    [ 'fixed-gemm', dtype + layout + transA + transB + ' --dim 1:6:1 --dim 8 --dim 2x3x4 --dim 6x1x3' ],
     [ 'hemm',  dtype         + layout + align + side + uplo + mn ],
     [ 'symm',  dtype         + layout + align + side + uplo + mn ],
     [ 'trmm',  dtype         + layout + align + side + uplo + trans + diag + mn ],
@@ -285,12 +320,18 @@ if (opts.blas3):
     [ 'her2k', dtype_complex + layout + align + uplo + trans_nc + mn ],
     [ 'syr2k', dtype_real    + layout + align + uplo + trans    + mn ],
     [ 'syr2k', dtype_complex + layout + align + uplo + trans_nt + mn ],
+    [ 'tiled-gemm', dtype         + layout + align + transA + transB + ' --nb 16 --dim 50x40x30' ],
+    [ 'tiled-syrk', dtype_real    + layout + align + uplo + trans    + ' --nb 16 --dim 50x40' ],
+    [ 'tiled-syrk', dtype_complex + layout + align + uplo + trans_nt + ' --nb 16 --dim 50x40' ],
+    [ 'tiled-trsm', dtype         + layout + align + side + uplo + trans + diag + ' --nb 16 --dim 50x40' ],
+    [ 'sparse-gemm', dtype + layout + align + transA + ' --format r,c,b --bs 3 --density 0.2 --dim 50x40x30' ],
     ]
 
 # Batch Level 3
 if (opts.batch_blas3):
     cmds += [
     [ 'batch-gemm',  dtype         + batch + layout + align + transA + transB + mnk ],
+    [ 'batch-gemmt', dtype         + batch + layout + align + uplo + transA + transB + ' --dim 50x40x30' ],
     [ 'batch-hemm',  dtype         + batch + layout + align + side + uplo + mn ],
     [ 'batch-symm',  dtype         + batch + layout + align + side + uplo + mn ],
     [ 'batch-trmm',  dtype         + batch + layout + align + side + uplo + trans + diag + mn ],
@@ -305,6 +346,15 @@ if (opts.batch_blas3):
     [ 'batch-syr2k', dtype_complex + batch + layout + align + uplo + trans_nt + mn ],
     ]
 
+# auxiliary
+if (opts.aux):
+    cmds += [
+    [ 'tune',      dtype + layout + align + transA + transB + ' --dim 20x30x40' ],
+    [ 'tune-gemv', dtype + layout + align + trans + incx + incy + ' --dim 30x40' ],
+    [ 'tune-dot',  dtype + incx + incy + ' --dim 50' ],
+    [ 'numa',      dtype + batch + layout + align + transA + transB + ' --policy f,i --dim 50x40x30' ],
+    ]
+
 # ------------------------------------------------------------------------------
 # when output is redirected to file instead of TTY console,
 # print extra messages to stderr on TTY console.
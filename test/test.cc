@@ -3,13 +3,17 @@
 // This program is free software: you can redistribute it and/or modify it under
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
+#include <cmath>
 #include <complex>
+#include <map>
+#include <vector>
 
 #include <stdio.h>
 #include <string.h>
 #include <unistd.h>
 
 #include "test.hh"
+#include "blas/flops.hh"
 
 // -----------------------------------------------------------------------------
 using testsweeper::ParamType;
@@ -58,6 +62,11 @@ std::vector< testsweeper::routines_t > routines = {
     { "rotmg",  test_rotmg,  Section::blas1   },
     { "scal",   test_scal,   Section::blas1   },
     { "swap",   test_swap,   Section::blas1   },
+    { "",       nullptr,     Section::newline },
+
+    { "asum-repro", test_asum_repro, Section::blas1   },
+    { "dot-repro",  test_dot_repro,  Section::blas1   },
+    { "nrm2-repro", test_nrm2_repro, Section::blas1   },
 
     // Level 2 BLAS
     { "gemv",   test_gemv,   Section::blas2   },
@@ -65,6 +74,12 @@ std::vector< testsweeper::routines_t > routines = {
     { "geru",   test_geru,   Section::blas2   },
     { "",       nullptr,     Section::newline },
 
+    { "gemv-fp16",  test_gemv_fp16,  Section::blas2   },
+    { "gemv-bf16",  test_gemv_bf16,  Section::blas2   },
+    { "gemv-s8",    test_gemv_s8,    Section::blas2   },
+    { "gemv-u8",    test_gemv_u8,    Section::blas2   },
+    { "",       nullptr,     Section::newline },
+
     { "hemv",   test_hemv,   Section::blas2   },
     { "her",    test_her,    Section::blas2   },
     { "her2",   test_her2,   Section::blas2   },
@@ -79,8 +94,39 @@ std::vector< testsweeper::routines_t > routines = {
     { "trsv",   test_trsv,   Section::blas2   },
     { "",       nullptr,     Section::newline },
 
+    { "sparse-gemv", test_sparse_gemv, Section::blas2 },
+    { "",       nullptr,     Section::newline },
+
+    { "omatcopy",   test_omatcopy,   Section::blas2   },
+    { "imatcopy",   test_imatcopy,   Section::blas2   },
+    { "geam",       test_geam,       Section::blas2   },
+    { "",       nullptr,     Section::newline },
+
+    { "col-norms",  test_col_norms,  Section::blas2   },
+    { "row-norms",  test_row_norms,  Section::blas2   },
+    { "col-iamax",  test_col_iamax,  Section::blas2   },
+    { "row-iamax",  test_row_iamax,  Section::blas2   },
+    { "",       nullptr,     Section::newline },
+
+    { "fixed-gemv", test_fixed_gemv, Section::blas2   },
+    { "fixed-trsv", test_fixed_trsv, Section::blas2   },
+    { "",       nullptr,     Section::newline },
+
     // Level 3 BLAS
     { "gemm",   test_gemm,   Section::blas3   },
+    { "gemm-fp16",  test_gemm_fp16,  Section::blas3   },
+    { "gemm-bf16",  test_gemm_bf16,  Section::blas3   },
+    { "gemm-s8",    test_gemm_s8,    Section::blas3   },
+    { "gemm-u8",    test_gemm_u8,    Section::blas3   },
+    { "gemm-pack",  test_gemm_pack,  Section::blas3   },
+    { "gemm-ooc",   test_gemm_ooc,   Section::blas3   },
+    { "gemm-strided", test_gemm_strided, Section::blas3 },
+    { "gemm-ksplit", test_gemm_ksplit, Section::blas3 },
+    { "gemm3m",     test_gemm3m,     Section::blas3   },
+    { "gemm-strassen", test_gemm_strassen, Section::blas3 },
+    { "gemmt",      test_gemmt,      Section::blas3   },
+    { "gemm-epilogue", test_gemm_epilogue, Section::blas3 },
+    { "fixed-gemm", test_fixed_gemm, Section::blas3   },
     { "",       nullptr,     Section::newline },
 
     { "hemm",   test_hemm,   Section::blas3   },
@@ -97,7 +143,16 @@ std::vector< testsweeper::routines_t > routines = {
     { "trsm",   test_trsm,   Section::blas3   },
     { "",       nullptr,     Section::newline },
 
+    { "tiled-gemm", test_tiled_gemm, Section::blas3   },
+    { "tiled-syrk", test_tiled_syrk, Section::blas3   },
+    { "tiled-trsm", test_tiled_trsm, Section::blas3   },
+    { "",       nullptr,     Section::newline },
+
+    { "sparse-gemm", test_sparse_gemm, Section::blas3 },
+    { "",       nullptr,     Section::newline },
+
     { "batch-gemm",   test_batch_gemm,   Section::blas3   },
+    { "batch-gemmt",  test_batch_gemmt,  Section::blas3   },
     { "",             nullptr,           Section::newline },
 
     { "batch-hemm",   test_batch_hemm,   Section::blas3   },
@@ -116,6 +171,7 @@ std::vector< testsweeper::routines_t > routines = {
 
 #ifdef BLASPP_WITH_CUBLAS
     { "dev-gemm"      ,   test_gemm_device      ,   Section::device_blas3   },
+    { "dev-geam"      ,   test_geam_device      ,   Section::device_blas3   },
     { "",                 nullptr,                  Section::newline },
 
     { "dev-hemm"      ,   test_hemm_device      ,   Section::device_blas3   },
@@ -153,6 +209,10 @@ std::vector< testsweeper::routines_t > routines = {
     // auxiliary
     { "error",  test_error,  Section::aux     },
     { "max",    test_max,    Section::aux     },
+    { "tune",   test_tune,   Section::aux     },
+    { "tune-gemv", test_tune_gemv, Section::aux   },
+    { "tune-dot",  test_tune_dot,  Section::aux   },
+    { "numa",   test_numa,   Section::aux     },
     { "util",   test_util,   Section::aux     },
 };
 
@@ -176,6 +236,9 @@ Params::Params():
     verbose   ( "verbose", 0,    ParamType::Value,   0,   0,   10, "verbose level" ),
     cache     ( "cache",   0,    ParamType::Value,  20,   1, 1024, "total cache size, in MiB" ),
 
+    //          name,       w,    type,         default, valid, help
+    roofline  ( "roofline", 0,    ParamType::Value, 'n', "ny",  "report arithmetic intensity and percent of roofline" ),
+
     // ----- routine parameters
     //          name,      w,    type,            def,                    char2enum,         enum2char,         enum2str,         help
     datatype  ( "type",    4,    ParamType::List, DataType::Double,       char2datatype,     datatype2char,     datatype2str,     "s=single (float), d=double, c=complex-single, z=complex-double" ),
@@ -195,6 +258,15 @@ Params::Params():
     incy      ( "incy",    4,    ParamType::List,   1, -1000,    1000, "stride of y vector" ),
     align     ( "align",   0,    ParamType::List,   1,     1,    1024, "column alignment (sets lda, ldb, etc. to multiple of align)" ),
     batch     ( "batch",   6,    ParamType::List, 100,     0, 1000000, "batch size" ),
+    shared    ( "shared",  6,    ParamType::List, 'n', "nab", "operand shared by all problems in batch: n=none, a=A, b=B" ),
+    levels    ( "levels",  6,    ParamType::List,   1,     0,      10, "levels of recursion, e.g., for Strassen gemm" ),
+    policy    ( "policy",  6,    ParamType::List, 'f', "fi", "NUMA placement: f=first-touch, i=interleave" ),
+    nb        ( "nb",      4,    ParamType::List, 256,     1,  100000, "tile size for tiled routines" ),
+    format    ( "format",  6,    ParamType::List, 'r', "rcb", "sparse format: r=CSR, c=CSC, b=BSR" ),
+    bs        ( "bs",      4,    ParamType::List,   4,     1,    1000, "block size for BSR sparse format" ),
+    density   ( "density", 7, 3, ParamType::List, 0.05,    0,       1, "fraction of sparse entries (blocks) that are nonzero" ),
+    activation( "act",     8,    ParamType::List, blas::Activation::Identity, blas::char2activation, blas::activation2char, blas::activation2str, "gemm epilogue activation: i=identity, r=relu, c=clamp, s=sigmoid, t=tanh" ),
+    norm      ( "norm",    4,    ParamType::List, blas::Norm::Two, blas::char2norm, blas::norm2char, blas::norm2str, "column or row norm: 1=one, 2=two, m=max" ),
     device    ( "device",  6,    ParamType::List,   0,     0,     100, "device id" ),
 
     // ----- output parameters
@@ -209,6 +281,12 @@ Params::Params():
     ref_gflops( "Ref.\nGflop/s",    11, 4, ParamType::Output, testsweeper::no_data_flag,   0,   0, "reference Gflop/s rate" ),
     ref_gbytes( "Ref.\nGbyte/s",    11, 4, ParamType::Output, testsweeper::no_data_flag,   0,   0, "reference Gbyte/s rate" ),
 
+    intensity ( "flop/\nbyte",        8, 2, ParamType::Output, testsweeper::no_data_flag,   0,   0, "arithmetic intensity, Gflop / Gbyte" ),
+    roof      ( "% of\nroofline",     8, 1, ParamType::Output, testsweeper::no_data_flag,   0,   0, "percent of roofline achieved" ),
+
+    //          name,                w,    type,              default, valid, help
+    bound     ( "bound",             5,    ParamType::Output,     '-', "-mc", "m=memory bound, c=compute bound" ),
+
     // default -1 means "no check"
     okay      ( "status",              6,    ParamType::Output,  -1,   0,   0, "success indicator" )
 {
@@ -222,10 +300,114 @@ Params::Params():
     repeat();
     verbose();
     cache();
+    roofline();
 
     // routine's parameters are marked by the test routine; see main
 }
 
+// -----------------------------------------------------------------------------
+// Roofline model: attainable Gflop/s = min( peak Gflop/s,
+// arithmetic intensity * bandwidth ), where arithmetic intensity is
+// Gflop / Gbyte, from blas/flops.hh. Machine limits are measured once.
+
+double roofline_gbytes = 0;            // stream bandwidth, Gbyte/s
+std::map< char, double > roofline_gflops;  // peak Gflop/s, by datatype
+
+// -----------------------------------------------------------------------------
+// Measures sustainable memory bandwidth using the STREAM triad,
+// a = b + s*c, on arrays 4x the cache size, so they aren't cached.
+// Counts 3 words of traffic per element; returns the best of 5 trials.
+double measure_bandwidth( int64_t cache_mib )
+{
+    int64_t n = 4 * cache_mib * 1024 * 1024 / sizeof(double);
+    std::vector<double> a( n ), b( n, 1.0 ), c( n, 2.0 );
+    double s = 3.0;
+    double best = 0;
+    for (int trial = 0; trial < 5; ++trial) {
+        double time = testsweeper::get_wtime();
+        #pragma omp parallel for
+        for (int64_t i = 0; i < n; ++i) {
+            a[ i ] = b[ i ] + s*c[ i ];
+        }
+        time = testsweeper::get_wtime() - time;
+        best = std::max( best, 1e-9 * 3 * n * sizeof(double) / time );
+    }
+    // use result so the loop isn't optimized away
+    if (a[ n/2 ] != 7.0)
+        printf( "stream triad error\n" );
+    return best;
+}
+
+// -----------------------------------------------------------------------------
+// Measures peak Gflop/s as the best of 3 vendor gemm calls on square
+// matrices large enough to be compute bound. The library isn't compiled
+// for the host's widest FMA instructions, so a hand-written FMA loop here
+// would underestimate what the vendor BLAS reaches.
+template< typename T >
+double measure_peak()
+{
+    int64_t n = 1024;
+    std::vector<T> A( n*n, T( 1.0 ) ), B( n*n, T( 0.5 ) ), C( n*n );
+    double gflop = blas::Gflop< T >::gemm( n, n, n );
+    double best = 0;
+    for (int trial = 0; trial < 3; ++trial) {
+        double time = testsweeper::get_wtime();
+        blas::gemm( blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::NoTrans,
+                    n, n, n, T( 1.0 ), A.data(), n, B.data(), n,
+                    T( 0.0 ), C.data(), n );
+        time = testsweeper::get_wtime() - time;
+        best = std::max( best, gflop / time );
+    }
+    return best;
+}
+
+// -----------------------------------------------------------------------------
+void measure_roofline( int64_t cache_mib )
+{
+    roofline_gbytes = measure_bandwidth( cache_mib );
+    roofline_gflops[ 's' ] = measure_peak< float >();
+    roofline_gflops[ 'd' ] = measure_peak< double >();
+    roofline_gflops[ 'c' ] = measure_peak< std::complex<float> >();
+    roofline_gflops[ 'z' ] = measure_peak< std::complex<double> >();
+    printf( "roofline: bandwidth %.1f Gbyte/s; "
+            "peak %.1f (s), %.1f (d), %.1f (c), %.1f (z) Gflop/s\n",
+            roofline_gbytes,
+            roofline_gflops[ 's' ], roofline_gflops[ 'd' ],
+            roofline_gflops[ 'c' ], roofline_gflops[ 'z' ] );
+}
+
+// -----------------------------------------------------------------------------
+// Sets intensity, percent of roofline, and bound from the Gflop/s and
+// Gbyte/s the tester measured. Testers that don't report both are skipped,
+// as are testers whose element type isn't given by --type, e.g., gemm-fp16,
+// and types whose peak wasn't measured.
+void set_roofline( Params& params, std::string const& routine )
+{
+    double gflops = params.gflops.value();
+    double gbytes = params.gbytes.value();
+    if (std::isnan( gflops ) || std::isnan( gbytes ) || gbytes <= 0)
+        return;
+
+    for (const char* suffix : { "-fp16", "-bf16", "-s8", "-u8" }) {
+        size_t len = strlen( suffix );
+        if (routine.size() >= len
+            && routine.compare( routine.size() - len, len, suffix ) == 0)
+            return;
+    }
+
+    char type = datatype2char( params.datatype() );
+    auto iter = roofline_gflops.find( type );
+    if (iter == roofline_gflops.end() || iter->second <= 0)
+        return;
+
+    double peak      = iter->second;
+    double intensity = gflops / gbytes;
+    double memory    = intensity * roofline_gbytes;
+    params.intensity() = intensity;
+    params.roof()      = 100 * gflops / std::min( peak, memory );
+    params.bound()     = (memory < peak ? 'm' : 'c');
+}
+
 // -----------------------------------------------------------------------------
 int main( int argc, char** argv )
 {
@@ -290,6 +472,14 @@ int main( int argc, char** argv )
             params.align.width( 5 );
         }
 
+        // measure machine limits and show roofline columns
+        if (params.roofline() == 'y') {
+            measure_roofline( params.cache() );
+            params.intensity();
+            params.roof();
+            params.bound();
+        }
+
         // run tests
         int repeat = params.repeat();
         testsweeper::DataType last = params.datatype();
@@ -309,6 +499,9 @@ int main( int argc, char** argv )
                     params.okay() = false;
                 }
 
+                if (params.roofline() == 'y')
+                    set_roofline( params, routine );
+
                 params.print();
                 fflush( stdout );
                 status += ! params.okay();
@@ -29,6 +29,7 @@ public:
     testsweeper::ParamInt    repeat;
     testsweeper::ParamInt    verbose;
     testsweeper::ParamInt    cache;
+    testsweeper::ParamChar   roofline;
 
     // ----- routine parameters
     testsweeper::ParamEnum< testsweeper::DataType > datatype;
@@ -47,6 +48,15 @@ public:
     testsweeper::ParamInt    incy;
     testsweeper::ParamInt    align;
     testsweeper::ParamInt    batch;
+    testsweeper::ParamChar   shared;
+    testsweeper::ParamInt    levels;
+    testsweeper::ParamChar   policy;
+    testsweeper::ParamInt    nb;
+    testsweeper::ParamChar   format;
+    testsweeper::ParamInt    bs;
+    testsweeper::ParamDouble density;
+    testsweeper::ParamEnum< blas::Activation >  activation;
+    testsweeper::ParamEnum< blas::Norm >        norm;
     testsweeper::ParamInt    device;
 
     // ----- output parameters
@@ -59,6 +69,10 @@ public:
     testsweeper::ParamDouble     ref_gflops;
     testsweeper::ParamDouble     ref_gbytes;
 
+    testsweeper::ParamDouble     intensity;
+    testsweeper::ParamDouble     roof;
+    testsweeper::ParamChar       bound;
+
     testsweeper::ParamOkay       okay;
 };
 
@@ -98,10 +112,17 @@ void test_rotm  ( Params& params, bool run );
 void test_rotmg ( Params& params, bool run );
 void test_scal  ( Params& params, bool run );
 void test_swap  ( Params& params, bool run );
+void test_asum_repro( Params& params, bool run );
+void test_dot_repro ( Params& params, bool run );
+void test_nrm2_repro( Params& params, bool run );
 
 // -----------------------------------------------------------------------------
 // Level 2 BLAS
 void test_gemv  ( Params& params, bool run );
+void test_gemv_fp16 ( Params& params, bool run );
+void test_gemv_bf16 ( Params& params, bool run );
+void test_gemv_s8   ( Params& params, bool run );
+void test_gemv_u8   ( Params& params, bool run );
 void test_ger   ( Params& params, bool run );
 void test_geru  ( Params& params, bool run );
 void test_hemv  ( Params& params, bool run );
@@ -112,10 +133,33 @@ void test_syr   ( Params& params, bool run );
 void test_syr2  ( Params& params, bool run );
 void test_trmv  ( Params& params, bool run );
 void test_trsv  ( Params& params, bool run );
+void test_sparse_gemv( Params& params, bool run );
+void test_omatcopy  ( Params& params, bool run );
+void test_imatcopy  ( Params& params, bool run );
+void test_geam      ( Params& params, bool run );
+void test_col_norms ( Params& params, bool run );
+void test_row_norms ( Params& params, bool run );
+void test_col_iamax ( Params& params, bool run );
+void test_row_iamax ( Params& params, bool run );
+void test_fixed_gemv( Params& params, bool run );
+void test_fixed_trsv( Params& params, bool run );
 
 // -----------------------------------------------------------------------------
 // Level 3 BLAS
 void test_gemm  ( Params& params, bool run );
+void test_gemm_fp16 ( Params& params, bool run );
+void test_gemm_bf16 ( Params& params, bool run );
+void test_gemm_s8   ( Params& params, bool run );
+void test_gemm_u8   ( Params& params, bool run );
+void test_gemm_pack ( Params& params, bool run );
+void test_gemm_ooc  ( Params& params, bool run );
+void test_gemm_strided( Params& params, bool run );
+void test_gemm_ksplit( Params& params, bool run );
+void test_gemm3m    ( Params& params, bool run );
+void test_gemm_strassen( Params& params, bool run );
+void test_gemmt     ( Params& params, bool run );
+void test_gemm_epilogue( Params& params, bool run );
+void test_fixed_gemm( Params& params, bool run );
 void test_hemm  ( Params& params, bool run );
 void test_her2k ( Params& params, bool run );
 void test_herk  ( Params& params, bool run );
@@ -124,10 +168,15 @@ void test_syr2k ( Params& params, bool run );
 void test_syrk  ( Params& params, bool run );
 void test_trmm  ( Params& params, bool run );
 void test_trsm  ( Params& params, bool run );
+void test_tiled_gemm( Params& params, bool run );
+void test_tiled_syrk( Params& params, bool run );
+void test_tiled_trsm( Params& params, bool run );
+void test_sparse_gemm( Params& params, bool run );
 
 // -----------------------------------------------------------------------------
 // Level 3 Batch BLAS
 void test_batch_gemm  ( Params& params, bool run );
+void test_batch_gemmt ( Params& params, bool run );
 void test_batch_hemm  ( Params& params, bool run );
 void test_batch_her2k ( Params& params, bool run );
 void test_batch_herk  ( Params& params, bool run );
@@ -141,6 +190,7 @@ void test_batch_trsm  ( Params& params, bool run );
 // Level 3 GPU BLAS
 #ifdef BLASPP_WITH_CUBLAS
 void test_gemm_device  ( Params& params, bool run );
+void test_geam_device  ( Params& params, bool run );
 void test_trsm_device  ( Params& params, bool run );
 void test_trmm_device  ( Params& params, bool run );
 void test_hemm_device  ( Params& params, bool run );
@@ -165,6 +215,10 @@ void test_batch_syr2k_device( Params& params, bool run );
 // auxiliary
 void test_error ( Params& params, bool run );
 void test_max   ( Params& params, bool run );
+void test_tune  ( Params& params, bool run );
+void test_tune_gemv( Params& params, bool run );
+void test_tune_dot ( Params& params, bool run );
+void test_numa  ( Params& params, bool run );
 void test_util  ( Params& params, bool run );
 
 #endif  //  #ifndef TEST_HH
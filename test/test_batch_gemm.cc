@@ -32,13 +32,16 @@ void test_batch_gemm_work( Params& params, bool run )
     int64_t n_       = params.dim.n();
     int64_t k_       = params.dim.k();
     size_t  batch   = params.batch();
+    char    shared  = params.shared();
     int64_t align   = params.align();
     int64_t verbose = params.verbose();
 
     // mark non-standard output values
     params.gflops();
+    params.gbytes();
     params.ref_time();
     params.ref_gflops();
+    params.ref_gbytes();
 
     if (! run)
         return;
@@ -80,6 +83,12 @@ void test_batch_gemm_work( Params& params, bool run )
         Crefarray[i] = Cref + i * size_C;
     }
 
+    // one A or one B shared by all problems
+    if (shared == 'a')
+        Aarray.resize( 1 );
+    else if (shared == 'b')
+        Barray.resize( 1 );
+
     // info
     std::vector<int64_t> info( batch );
 
@@ -109,8 +118,8 @@ void test_batch_gemm_work( Params& params, bool run )
     real_t* Cnorm = new real_t[ batch ];
 
     for (size_t i = 0; i < batch; ++i) {
-        Anorm[i] = lapack_lange( "f", Am, An, Aarray[i], lda_, work );
-        Bnorm[i] = lapack_lange( "f", Bm, Bn, Barray[i], ldb_, work );
+        Anorm[i] = lapack_lange( "f", Am, An, Aarray[ shared == 'a' ? 0 : i ], lda_, work );
+        Bnorm[i] = lapack_lange( "f", Bm, Bn, Barray[ shared == 'b' ? 0 : i ], ldb_, work );
         Cnorm[i] = lapack_lange( "f", Cm, Cn, Carray[i], ldc_, work );
     }
 
@@ -126,8 +135,10 @@ void test_batch_gemm_work( Params& params, bool run )
     time = get_wtime() - time;
 
     double gflop = batch * Gflop < scalar_t >::gemm( m_, n_, k_ );
+    double gbyte = batch * Gbyte < scalar_t >::gemm( m_, n_, k_ );
     params.time()   = time;
     params.gflops() = gflop / time;
+    params.gbytes() = gbyte / time;
 
     if (params.ref() == 'y' || params.check() == 'y') {
         // run reference
@@ -137,12 +148,13 @@ void test_batch_gemm_work( Params& params, bool run )
             cblas_gemm( cblas_layout_const(layout),
                         cblas_trans_const(transA_),
                         cblas_trans_const(transB_),
-                        m_, n_, k_, alpha_, Aarray[i], lda_, Barray[i], ldb_, beta_, Crefarray[i], ldc_ );
+                        m_, n_, k_, alpha_, Aarray[ shared == 'a' ? 0 : i ], lda_, Barray[ shared == 'b' ? 0 : i ], ldb_, beta_, Crefarray[i], ldc_ );
         }
         time = get_wtime() - time;
 
         params.ref_time()   = time;
         params.ref_gflops() = gflop / time;
+        params.ref_gbytes() = gbyte / time;
 
         // check error compared to reference
         real_t err, error = 0;
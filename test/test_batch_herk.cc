@@ -33,8 +33,11 @@ void test_batch_herk_work( Params& params, bool run )
     int64_t verbose     = params.verbose();
 
     // mark non-standard output values
+    params.gflops();
+    params.gbytes();
     params.ref_time();
     params.ref_gflops();
+    params.ref_gbytes();
 
     if (! run)
         return;
@@ -103,8 +106,10 @@ void test_batch_herk_work( Params& params, bool run )
     time = get_wtime() - time;
 
     double gflop = batch * Gflop < scalar_t >::herk( n_, k_ );
+    double gbyte = batch * Gbyte < scalar_t >::herk( n_, k_ );
     params.time()   = time;
     params.gflops() = gflop / time;
+    params.gbytes() = gbyte / time;
 
     if (params.ref() == 'y' || params.check() == 'y') {
         // run reference
@@ -120,6 +125,7 @@ void test_batch_herk_work( Params& params, bool run )
 
         params.ref_time()   = time;
         params.ref_gflops() = gflop / time;
+        params.ref_gbytes() = gbyte / time;
 
         // check error compared to reference
         real_t err, error = 0;
@@ -33,8 +33,11 @@ void test_batch_symm_work( Params& params, bool run )
     int64_t verbose     = params.verbose();
 
     // mark non-standard output values
+    params.gflops();
+    params.gbytes();
     params.ref_time();
     params.ref_gflops();
+    params.ref_gbytes();
 
     // adjust header to msec
     params.time.name( "BLAS++\ntime (ms)" );
@@ -117,8 +120,10 @@ void test_batch_symm_work( Params& params, bool run )
     time = get_wtime() - time;
 
     double gflop = batch * Gflop < scalar_t >::symm( side_, m_, n_ );
+    double gbyte = batch * Gbyte < scalar_t >::symm( side_, m_, n_ );
     params.time()   = time * 1000;  // msec
     params.gflops() = gflop / time;
+    params.gbytes() = gbyte / time;
 
     if (params.ref() == 'y' || params.check() == 'y') {
         // run reference
@@ -134,6 +139,7 @@ void test_batch_symm_work( Params& params, bool run )
 
         params.ref_time()   = time * 1000;  // msec
         params.ref_gflops() = gflop / time;
+        params.ref_gbytes() = gbyte / time;
 
         // check error compared to reference
         real_t err, error = 0;
@@ -34,8 +34,11 @@ void test_batch_trsm_work( Params& params, bool run )
     int64_t verbose     = params.verbose();
 
     // mark non-standard output values
+    params.gflops();
+    params.gbytes();
     params.ref_time();
     params.ref_gflops();
+    params.ref_gbytes();
 
     if (! run)
         return;
@@ -144,8 +147,10 @@ void test_batch_trsm_work( Params& params, bool run )
     time = get_wtime() - time;
 
     double gflop = batch * Gflop < scalar_t >::trsm( side_, m_, n_ );
+    double gbyte = batch * Gbyte < scalar_t >::trsm( side_, m_, n_ );
     params.time()   = time;
     params.gflops() = gflop / time;
+    params.gbytes() = gbyte / time;
 
     if (params.check() == 'y') {
         // run reference
@@ -163,6 +168,7 @@ void test_batch_trsm_work( Params& params, bool run )
 
         params.ref_time()   = time;
         params.ref_gflops() = gflop / time;
+        params.ref_gbytes() = gbyte / time;
 
         // check error compared to reference
         // Am is reduction dimension
@@ -0,0 +1,426 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "cblas.hh"
+#include "lapack_wrappers.hh"
+#include "blas/flops.hh"
+#include "print_matrix.hh"
+
+#include <limits>
+#include <vector>
+
+// The fixed-size routines take their dimensions, layout, and options as
+// template parameters; the functions below dispatch the runtime values to
+// them. Instantiated sizes are
+//  - gemm: m = n = k in 1-6, 8, and (m, n, k) = (2, 3, 4), (6, 1, 3);
+//  - gemv: m = n in 1-6, 8, and (m, n) = (2, 3), (6, 1);
+//  - trsv: n in 1-6, 8.
+// Other sizes have no instantiation and are reported as "no check".
+
+// -----------------------------------------------------------------------------
+template< typename T, int64_t m, int64_t n, int64_t k,
+          blas::Layout layout, blas::Op transA >
+void fixed_gemm( blas::Op transB, T alpha, T const* A, T const* B,
+                 T beta, T* C )
+{
+    using blas::Op;
+    switch (transB) {
+        case Op::NoTrans:
+            blas::fixed::gemm< m, n, k, layout, transA, Op::NoTrans >(
+                alpha, A, B, beta, C );
+            break;
+        case Op::Trans:
+            blas::fixed::gemm< m, n, k, layout, transA, Op::Trans >(
+                alpha, A, B, beta, C );
+            break;
+        case Op::ConjTrans:
+            blas::fixed::gemm< m, n, k, layout, transA, Op::ConjTrans >(
+                alpha, A, B, beta, C );
+            break;
+    }
+}
+
+template< typename T, int64_t m, int64_t n, int64_t k, blas::Layout layout >
+void fixed_gemm( blas::Op transA, blas::Op transB, T alpha, T const* A,
+                 T const* B, T beta, T* C )
+{
+    using blas::Op;
+    switch (transA) {
+        case Op::NoTrans:
+            fixed_gemm< T, m, n, k, layout, Op::NoTrans >(
+                transB, alpha, A, B, beta, C );
+            break;
+        case Op::Trans:
+            fixed_gemm< T, m, n, k, layout, Op::Trans >(
+                transB, alpha, A, B, beta, C );
+            break;
+        case Op::ConjTrans:
+            fixed_gemm< T, m, n, k, layout, Op::ConjTrans >(
+                transB, alpha, A, B, beta, C );
+            break;
+    }
+}
+
+template< typename T, int64_t m, int64_t n, int64_t k >
+void fixed_gemm( blas::Layout layout, blas::Op transA, blas::Op transB,
+                 T alpha, T const* A, T const* B, T beta, T* C )
+{
+    if (layout == blas::Layout::ColMajor)
+        fixed_gemm< T, m, n, k, blas::Layout::ColMajor >(
+            transA, transB, alpha, A, B, beta, C );
+    else
+        fixed_gemm< T, m, n, k, blas::Layout::RowMajor >(
+            transA, transB, alpha, A, B, beta, C );
+}
+
+// -----------------------------------------------------------------------------
+template< typename T, int64_t m, int64_t n, blas::Layout layout >
+void fixed_gemv( blas::Op trans, T alpha, T const* A, T const* x,
+                 T beta, T* y )
+{
+    using blas::Op;
+    switch (trans) {
+        case Op::NoTrans:
+            blas::fixed::gemv< m, n, layout, Op::NoTrans >(
+                alpha, A, x, beta, y );
+            break;
+        case Op::Trans:
+            blas::fixed::gemv< m, n, layout, Op::Trans >(
+                alpha, A, x, beta, y );
+            break;
+        case Op::ConjTrans:
+            blas::fixed::gemv< m, n, layout, Op::ConjTrans >(
+                alpha, A, x, beta, y );
+            break;
+    }
+}
+
+template< typename T, int64_t m, int64_t n >
+void fixed_gemv( blas::Layout layout, blas::Op trans, T alpha, T const* A,
+                 T const* x, T beta, T* y )
+{
+    if (layout == blas::Layout::ColMajor)
+        fixed_gemv< T, m, n, blas::Layout::ColMajor >(
+            trans, alpha, A, x, beta, y );
+    else
+        fixed_gemv< T, m, n, blas::Layout::RowMajor >(
+            trans, alpha, A, x, beta, y );
+}
+
+// -----------------------------------------------------------------------------
+template< typename T, int64_t n, blas::Layout layout, blas::Uplo uplo,
+          blas::Op trans >
+void fixed_trsv( blas::Diag diag, T const* A, T* x )
+{
+    if (diag == blas::Diag::Unit)
+        blas::fixed::trsv< n, layout, uplo, trans, blas::Diag::Unit >( A, x );
+    else
+        blas::fixed::trsv< n, layout, uplo, trans, blas::Diag::NonUnit >( A, x );
+}
+
+template< typename T, int64_t n, blas::Layout layout, blas::Uplo uplo >
+void fixed_trsv( blas::Op trans, blas::Diag diag, T const* A, T* x )
+{
+    using blas::Op;
+    switch (trans) {
+        case Op::NoTrans:
+            fixed_trsv< T, n, layout, uplo, Op::NoTrans >( diag, A, x );
+            break;
+        case Op::Trans:
+            fixed_trsv< T, n, layout, uplo, Op::Trans >( diag, A, x );
+            break;
+        case Op::ConjTrans:
+            fixed_trsv< T, n, layout, uplo, Op::ConjTrans >( diag, A, x );
+            break;
+    }
+}
+
+template< typename T, int64_t n, blas::Layout layout >
+void fixed_trsv( blas::Uplo uplo, blas::Op trans, blas::Diag diag,
+                 T const* A, T* x )
+{
+    if (uplo == blas::Uplo::Lower)
+        fixed_trsv< T, n, layout, blas::Uplo::Lower >( trans, diag, A, x );
+    else
+        fixed_trsv< T, n, layout, blas::Uplo::Upper >( trans, diag, A, x );
+}
+
+template< typename T, int64_t n >
+void fixed_trsv( blas::Layout layout, blas::Uplo uplo, blas::Op trans,
+                 blas::Diag diag, T const* A, T* x )
+{
+    if (layout == blas::Layout::ColMajor)
+        fixed_trsv< T, n, blas::Layout::ColMajor >( uplo, trans, diag, A, x );
+    else
+        fixed_trsv< T, n, blas::Layout::RowMajor >( uplo, trans, diag, A, x );
+}
+
+// -----------------------------------------------------------------------------
+// Dispatches the runtime sizes to template parameters.
+// @return false if the size has no instantiation.
+template< typename T >
+bool fixed_dispatch_gemm(
+    blas::Layout layout, blas::Op transA, blas::Op transB,
+    int64_t m, int64_t n, int64_t k,
+    T alpha, T const* A, T const* B, T beta, T* C )
+{
+    auto is = [&]( int64_t m_, int64_t n_, int64_t k_ ) {
+        return m == m_ && n == n_ && k == k_;
+    };
+    if      (is( 1, 1, 1 )) fixed_gemm< T, 1, 1, 1 >( layout, transA, transB, alpha, A, B, beta, C );
+    else if (is( 2, 2, 2 )) fixed_gemm< T, 2, 2, 2 >( layout, transA, transB, alpha, A, B, beta, C );
+    else if (is( 3, 3, 3 )) fixed_gemm< T, 3, 3, 3 >( layout, transA, transB, alpha, A, B, beta, C );
+    else if (is( 4, 4, 4 )) fixed_gemm< T, 4, 4, 4 >( layout, transA, transB, alpha, A, B, beta, C );
+    else if (is( 5, 5, 5 )) fixed_gemm< T, 5, 5, 5 >( layout, transA, transB, alpha, A, B, beta, C );
+    else if (is( 6, 6, 6 )) fixed_gemm< T, 6, 6, 6 >( layout, transA, transB, alpha, A, B, beta, C );
+    else if (is( 8, 8, 8 )) fixed_gemm< T, 8, 8, 8 >( layout, transA, transB, alpha, A, B, beta, C );
+    else if (is( 2, 3, 4 )) fixed_gemm< T, 2, 3, 4 >( layout, transA, transB, alpha, A, B, beta, C );
+    else if (is( 6, 1, 3 )) fixed_gemm< T, 6, 1, 3 >( layout, transA, transB, alpha, A, B, beta, C );
+    else
+        return false;
+    return true;
+}
+
+template< typename T >
+bool fixed_dispatch_gemv(
+    blas::Layout layout, blas::Op trans, int64_t m, int64_t n,
+    T alpha, T const* A, T const* x, T beta, T* y )
+{
+    auto is = [&]( int64_t m_, int64_t n_ ) {
+        return m == m_ && n == n_;
+    };
+    if      (is( 1, 1 )) fixed_gemv< T, 1, 1 >( layout, trans, alpha, A, x, beta, y );
+    else if (is( 2, 2 )) fixed_gemv< T, 2, 2 >( layout, trans, alpha, A, x, beta, y );
+    else if (is( 3, 3 )) fixed_gemv< T, 3, 3 >( layout, trans, alpha, A, x, beta, y );
+    else if (is( 4, 4 )) fixed_gemv< T, 4, 4 >( layout, trans, alpha, A, x, beta, y );
+    else if (is( 5, 5 )) fixed_gemv< T, 5, 5 >( layout, trans, alpha, A, x, beta, y );
+    else if (is( 6, 6 )) fixed_gemv< T, 6, 6 >( layout, trans, alpha, A, x, beta, y );
+    else if (is( 8, 8 )) fixed_gemv< T, 8, 8 >( layout, trans, alpha, A, x, beta, y );
+    else if (is( 2, 3 )) fixed_gemv< T, 2, 3 >( layout, trans, alpha, A, x, beta, y );
+    else if (is( 6, 1 )) fixed_gemv< T, 6, 1 >( layout, trans, alpha, A, x, beta, y );
+    else
+        return false;
+    return true;
+}
+
+template< typename T >
+bool fixed_dispatch_trsv(
+    blas::Layout layout, blas::Uplo uplo, blas::Op trans, blas::Diag diag,
+    int64_t n, T const* A, T* x )
+{
+    switch (n) {
+        case 1: fixed_trsv< T, 1 >( layout, uplo, trans, diag, A, x ); break;
+        case 2: fixed_trsv< T, 2 >( layout, uplo, trans, diag, A, x ); break;
+        case 3: fixed_trsv< T, 3 >( layout, uplo, trans, diag, A, x ); break;
+        case 4: fixed_trsv< T, 4 >( layout, uplo, trans, diag, A, x ); break;
+        case 5: fixed_trsv< T, 5 >( layout, uplo, trans, diag, A, x ); break;
+        case 6: fixed_trsv< T, 6 >( layout, uplo, trans, diag, A, x ); break;
+        case 8: fixed_trsv< T, 8 >( layout, uplo, trans, diag, A, x ); break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Tests blas::fixed routines against the runtime routines on the same
+// problem: gemm with m-by-k op(A), k-by-n op(B); gemv with m-by-n A;
+// trsv with n-by-n A. Error is max | C - Cref | relative to max | Cref |
+// plus, for gemm and gemv, the magnitude of the inputs.
+template< typename T >
+void test_fixed_work( Params& params, bool run, std::string const& routine )
+{
+    using namespace testsweeper;
+    using namespace blas;
+    typedef real_type<T> real_t;
+
+    bool is_gemm = (routine == "fixed-gemm");
+    bool is_gemv = (routine == "fixed-gemv");
+    bool is_trsv = (routine == "fixed-trsv");
+
+    // get & mark input values
+    blas::Layout layout = params.layout();
+    blas::Op transA = (is_gemm ? params.transA() : Op::NoTrans);
+    blas::Op transB = (is_gemm ? params.transB() : Op::NoTrans);
+    blas::Op trans  = (is_gemm ? Op::NoTrans : params.trans());
+    blas::Uplo uplo = (is_trsv ? params.uplo() : Uplo::Lower);
+    blas::Diag diag = (is_trsv ? params.diag() : Diag::NonUnit);
+    T alpha         = (is_trsv ? T( 1 ) : T( params.alpha() ));
+    T beta          = (is_trsv ? T( 0 ) : T( params.beta() ));
+    int64_t m       = (is_trsv ? 0 : params.dim.m());
+    int64_t n       = params.dim.n();
+    int64_t k       = (is_gemm ? params.dim.k() : 0);
+    int64_t verbose = params.verbose();
+    if (is_trsv)
+        m = n;
+
+    // mark non-standard output values
+    params.ref_time();
+
+    if (! run)
+        return;
+
+    // setup: op(A) is Am-by-An; op(B), x are Bm-by-Bn; C, y are Cm-by-Cn
+    int64_t Am, An, Bm, Bn, Cm, Cn, inner;
+    if (is_gemm) {
+        Am = m;  An = k;
+        Bm = k;  Bn = n;
+        Cm = m;  Cn = n;
+        inner = k;
+    }
+    else {
+        // x, y are column vectors; A is m-by-n, op(A) is Ym-by-Xn
+        int64_t Ym = (trans == Op::NoTrans ? m : n);
+        int64_t Xn = (trans == Op::NoTrans ? n : m);
+        Am = Ym;  An = Xn;
+        Bm = Xn;  Bn = 1;
+        Cm = (is_trsv ? Xn : Ym);  Cn = 1;
+        inner = Xn;
+    }
+    // dense storage; A, B are stored transposed if op is not NoTrans
+    bool col = (layout == Layout::ColMajor);
+    int64_t lda = ((transA == Op::NoTrans) == col ? Am : An);
+    int64_t ldb = ((transB == Op::NoTrans) == col ? Bm : Bn);
+    int64_t ldc = (col ? Cm : Cn);
+    if (! is_gemm) {
+        // gemv, trsv A is stored m-by-n regardless of trans
+        lda = (col ? m : n);
+    }
+
+    std::vector<T> A( Am*An ), B( Bm*Bn ), C( Cm*Cn ), Cref( Cm*Cn );
+
+    int64_t idist = 1;
+    int iseed[4] = { 0, 0, 0, 1 };
+    lapack_larnv( idist, iseed, A.size(), A.data() );
+    lapack_larnv( idist, iseed, B.size(), B.data() );
+    lapack_larnv( idist, iseed, C.size(), C.data() );
+    if (is_trsv) {
+        // well conditioned: scale off-diagonal entries by 1/n
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t i = 0; i < n; ++i) {
+                if (i != j)
+                    A[ i + j*n ] /= real_t( n );
+            }
+        }
+        C = B;
+    }
+    Cref = C;
+
+    if (verbose >= 2) {
+        printf( "A = " ); print_vector( A.size(), A.data(), 1 );
+        printf( "B = " ); print_vector( B.size(), B.data(), 1 );
+    }
+
+    // run test
+    double time = get_wtime();
+    bool found;
+    if (is_gemm) {
+        found = fixed_dispatch_gemm( layout, transA, transB, m, n, k,
+                                     alpha, A.data(), B.data(), beta,
+                                     C.data() );
+    }
+    else if (is_gemv) {
+        found = fixed_dispatch_gemv( layout, trans, m, n,
+                                     alpha, A.data(), B.data(), beta,
+                                     C.data() );
+    }
+    else {
+        found = fixed_dispatch_trsv( layout, uplo, trans, diag, n,
+                                     A.data(), C.data() );
+    }
+    time = get_wtime() - time;
+    if (! found) {
+        // no instantiation for this size; status is "no check"
+        return;
+    }
+    params.time() = time;
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // run reference: runtime routines on the same problem
+        time = get_wtime();
+        if (is_gemm) {
+            blas::gemm( layout, transA, transB, m, n, k,
+                        alpha, A.data(), lda, B.data(), ldb,
+                        beta, Cref.data(), ldc );
+        }
+        else if (is_gemv) {
+            blas::gemv( layout, trans, m, n, alpha, A.data(), lda,
+                        B.data(), 1, beta, Cref.data(), 1 );
+        }
+        else {
+            blas::trsv( layout, uplo, trans, diag, n, A.data(), n,
+                        Cref.data(), 1 );
+        }
+        time = get_wtime() - time;
+        params.ref_time() = time;
+
+        if (verbose >= 2) {
+            printf( "C    = " ); print_vector( C.size(), C.data(), 1 );
+            printf( "Cref = " ); print_vector( Cref.size(), Cref.data(), 1 );
+        }
+
+        // check error compared to reference
+        real_t error = 0, Cnorm = 0;
+        for (size_t i = 0; i < C.size(); ++i) {
+            error = std::max( error, std::abs( C[ i ] - Cref[ i ] ) );
+            Cnorm = std::max( Cnorm, std::abs( Cref[ i ] ) );
+        }
+        if (! is_trsv) {
+            // entries of A, B, C are in [0, 1]
+            Cnorm += std::abs( alpha ) * inner + std::abs( beta );
+        }
+        if (Cnorm != 0)
+            error /= Cnorm;
+        params.error() = error;
+
+        real_t eps = std::numeric_limits< real_t >::epsilon();
+        params.okay() = (error < 3*std::max( inner, int64_t( 1 ) )*eps);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_fixed( Params& params, bool run, std::string const& routine )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_fixed_work< float >( params, run, routine );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_fixed_work< double >( params, run, routine );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_fixed_work< std::complex<float> >( params, run, routine );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_fixed_work< std::complex<double> >( params, run, routine );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_fixed_gemm( Params& params, bool run )
+{
+    test_fixed( params, run, "fixed-gemm" );
+}
+
+// -----------------------------------------------------------------------------
+void test_fixed_gemv( Params& params, bool run )
+{
+    test_fixed( params, run, "fixed-gemv" );
+}
+
+// -----------------------------------------------------------------------------
+void test_fixed_trsv( Params& params, bool run )
+{
+    test_fixed( params, run, "fixed-trsv" );
+}
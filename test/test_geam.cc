@@ -0,0 +1,208 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "cblas.hh"
+#include "lapack_wrappers.hh"
+#include "blas/flops.hh"
+#include "print_matrix.hh"
+
+#include <limits>
+
+// -----------------------------------------------------------------------------
+// Reference C = alpha op(A) + beta op(B), column-major, one entry at a time;
+// for RowMajor, the caller swaps m and n.
+template< typename T >
+void geam_ref(
+    blas::Op transA, blas::Op transB, int64_t m, int64_t n,
+    T alpha, T const* A, int64_t lda,
+    T beta,  T const* B, int64_t ldb,
+    T* C, int64_t ldc )
+{
+    using blas::conj;
+    for (int64_t j = 0; j < n; ++j) {
+        for (int64_t i = 0; i < m; ++i) {
+            T a = (transA == blas::Op::NoTrans ? A[ i + j*lda ] : A[ j + i*lda ]);
+            T b = (transB == blas::Op::NoTrans ? B[ i + j*ldb ] : B[ j + i*ldb ]);
+            if (transA == blas::Op::ConjTrans)
+                a = conj( a );
+            if (transB == blas::Op::ConjTrans)
+                b = conj( b );
+            C[ i + j*ldc ] = alpha*a + beta*b;
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Tests geam against geam_ref. Error is max | C - Cref |
+// relative to | alpha | max | A | + | beta | max | B |.
+template< typename T >
+void test_geam_work( Params& params, bool run )
+{
+    using namespace testsweeper;
+    using namespace blas;
+    typedef real_type<T> real_t;
+    typedef long long lld;
+
+    // get & mark input values
+    blas::Layout layout = params.layout();
+    blas::Op transA = params.transA();
+    blas::Op transB = params.transB();
+    T alpha         = params.alpha();
+    T beta          = params.beta();
+    int64_t m       = params.dim.m();
+    int64_t n       = params.dim.n();
+    int64_t align   = params.align();
+    int64_t verbose = params.verbose();
+
+    // mark non-standard output values
+    params.gbytes();
+    params.ref_time();
+    params.ref_gbytes();
+
+    if (! run)
+        return;
+
+    // setup: op(A), op(B), C are m-by-n, in layout;
+    // column-major dimensions, swapped for RowMajor
+    int64_t Am = (transA == Op::NoTrans ? m : n);
+    int64_t An = (transA == Op::NoTrans ? n : m);
+    int64_t Bm = (transB == Op::NoTrans ? m : n);
+    int64_t Bn = (transB == Op::NoTrans ? n : m);
+    int64_t Cm = m;
+    int64_t Cn = n;
+    if (layout == Layout::RowMajor) {
+        std::swap( Am, An );
+        std::swap( Bm, Bn );
+        std::swap( Cm, Cn );
+    }
+    int64_t lda = roundup( Am, align );
+    int64_t ldb = roundup( Bm, align );
+    int64_t ldc = roundup( Cm, align );
+    size_t size_A = size_t(lda)*An;
+    size_t size_B = size_t(ldb)*Bn;
+    size_t size_C = size_t(ldc)*Cn;
+    T* A    = new T[ size_A ];
+    T* B    = new T[ size_B ];
+    T* C    = new T[ size_C ];
+    T* Cref = new T[ size_C ];
+
+    int64_t idist = 1;
+    int iseed[4] = { 0, 0, 0, 1 };
+    lapack_larnv( idist, iseed, size_A, A );
+    lapack_larnv( idist, iseed, size_B, B );
+    lapack_larnv( idist, iseed, size_C, C );
+    lapack_lacpy( "g", Cm, Cn, C, ldc, Cref, ldc );
+
+    // norms for error check
+    real_t work[1];
+    real_t Anorm = lapack_lange( "m", Am, An, A, lda, work );
+    real_t Bnorm = lapack_lange( "m", Bm, Bn, B, ldb, work );
+
+    // test error exits
+    assert_throw( blas::geam( Layout(0), transA, transB,  m,  n, alpha, A, lda, beta, B, ldb, C, ldc ), blas::Error );
+    assert_throw( blas::geam( layout,    Op(0),  transB,  m,  n, alpha, A, lda, beta, B, ldb, C, ldc ), blas::Error );
+    assert_throw( blas::geam( layout,    transA, Op(0),   m,  n, alpha, A, lda, beta, B, ldb, C, ldc ), blas::Error );
+    assert_throw( blas::geam( layout,    transA, transB, -1,  n, alpha, A, lda, beta, B, ldb, C, ldc ), blas::Error );
+    assert_throw( blas::geam( layout,    transA, transB,  m, -1, alpha, A, lda, beta, B, ldb, C, ldc ), blas::Error );
+    assert_throw( blas::geam( layout,    transA, transB,  m,  n, alpha, A, Am-1, beta, B, ldb, C, ldc ), blas::Error );
+    assert_throw( blas::geam( layout,    transA, transB,  m,  n, alpha, A, lda, beta, B, Bm-1, C, ldc ), blas::Error );
+    assert_throw( blas::geam( layout,    transA, transB,  m,  n, alpha, A, lda, beta, B, ldb, C, Cm-1 ), blas::Error );
+    assert_throw( blas::geam( layout,    Op::Trans, transB, m, n, alpha, C, ldc, beta, B, ldb, C, ldc ), blas::Error );
+    assert_throw( blas::geam( layout,    transA, Op::Trans, m, n, alpha, A, lda, beta, C, ldc, C, ldc ), blas::Error );
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A Am=%5lld, An=%5lld, lda=%5lld, size=%10lld, norm %.2e\n"
+                "B Bm=%5lld, Bn=%5lld, ldb=%5lld, size=%10lld, norm %.2e\n"
+                "C Cm=%5lld, Cn=%5lld, ldc=%5lld, size=%10lld\n",
+                (lld) Am, (lld) An, (lld) lda, (lld) size_A, Anorm,
+                (lld) Bm, (lld) Bn, (lld) ldb, (lld) size_B, Bnorm,
+                (lld) Cm, (lld) Cn, (lld) ldc, (lld) size_C );
+    }
+    if (verbose >= 2) {
+        printf( "alpha = %.4e + %.4ei; beta = %.4e + %.4ei;\n",
+                real(alpha), imag(alpha),
+                real(beta),  imag(beta) );
+        printf( "A = " ); print_matrix( Am, An, A, lda );
+        printf( "B = " ); print_matrix( Bm, Bn, B, ldb );
+    }
+
+    // run test
+    testsweeper::flush_cache( params.cache() );
+    double time = get_wtime();
+    blas::geam( layout, transA, transB, m, n,
+                alpha, A, lda, beta, B, ldb, C, ldc );
+    time = get_wtime() - time;
+
+    double gbyte = Gbyte< T >::geam( m, n );
+    params.time()   = time;
+    params.gbytes() = gbyte / time;
+
+    if (verbose >= 2) {
+        printf( "C2 = " ); print_matrix( Cm, Cn, C, ldc );
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // run reference
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        geam_ref( transA, transB, Cm, Cn, alpha, A, lda, beta, B, ldb,
+                  Cref, ldc );
+        time = get_wtime() - time;
+
+        params.ref_time()   = time;
+        params.ref_gbytes() = gbyte / time;
+
+        if (verbose >= 2) {
+            printf( "Cref = " ); print_matrix( Cm, Cn, Cref, ldc );
+        }
+
+        // check error compared to reference; only rounding of the
+        // one multiply-add per entry, e.g., by fma contraction, can differ
+        real_t error = 0;
+        for (int64_t j = 0; j < Cn; ++j) {
+            for (int64_t i = 0; i < Cm; ++i)
+                error = std::max( error, std::abs( C[ i + j*ldc ] - Cref[ i + j*ldc ] ) );
+        }
+        real_t denom = std::abs( alpha ) * Anorm + std::abs( beta ) * Bnorm;
+        if (denom != 0)
+            error /= denom;
+        params.error() = error;
+        real_t eps = std::numeric_limits< real_t >::epsilon();
+        params.okay() = (error < 3*eps);
+    }
+
+    delete[] A;
+    delete[] B;
+    delete[] C;
+    delete[] Cref;
+}
+
+// -----------------------------------------------------------------------------
+void test_geam( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_geam_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_geam_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_geam_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_geam_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
@@ -10,6 +10,10 @@
 #include "print_matrix.hh"
 #include "check_gemm.hh"
 
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
 // -----------------------------------------------------------------------------
 template< typename TA, typename TB, typename TC >
 void test_gemm_work( Params& params, bool run )
@@ -34,8 +38,10 @@ void test_gemm_work( Params& params, bool run )
 
     // mark non-standard output values
     params.gflops();
+    params.gbytes();
     params.ref_time();
     params.ref_gflops();
+    params.ref_gbytes();
 
     if (! run)
         return;
@@ -129,8 +135,10 @@ void test_gemm_work( Params& params, bool run )
     time = get_wtime() - time;
 
     double gflop = Gflop < scalar_t >::gemm( m, n, k );
+    double gbyte = Gbyte < scalar_t >::gemm( m, n, k );
     params.time()   = time;
     params.gflops() = gflop / time;
+    params.gbytes() = gbyte / time;
 
     if (verbose >= 2) {
         printf( "C2 = " ); print_matrix( Cm, Cn, C, ldc );
@@ -148,6 +156,7 @@ void test_gemm_work( Params& params, bool run )
 
         params.ref_time()   = time;
         params.ref_gflops() = gflop / time;
+        params.ref_gbytes() = gbyte / time;
 
         if (verbose >= 2) {
             printf( "Cref = " ); print_matrix( Cm, Cn, Cref, ldc );
@@ -195,3 +204,25 @@ void test_gemm( Params& params, bool run )
             break;
     }
 }
+
+// -----------------------------------------------------------------------------
+// Tests gemm with at least 4 OpenMP threads, so a long k with small C,
+// e.g., --dim 40x30x40000, takes the k-split path in blas::gemm even on
+// machines with fewer cores.
+void test_gemm_ksplit( Params& params, bool run )
+{
+    #ifdef _OPENMP
+        int save = omp_get_max_threads();
+        omp_set_num_threads( std::max( save, 4 ) );
+        try {
+            test_gemm( params, run );
+        }
+        catch (...) {
+            omp_set_num_threads( save );
+            throw;
+        }
+        omp_set_num_threads( save );
+    #else
+        test_gemm( params, run );
+    #endif
+}
@@ -0,0 +1,269 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "cblas.hh"
+#include "lapack_wrappers.hh"
+#include "blas/flops.hh"
+#include "print_matrix.hh"
+#include "check_gemm.hh"
+
+#include <cmath>
+#include <limits>
+
+// -----------------------------------------------------------------------------
+template< typename T >
+T clamp_ref( T x, T lower, T upper )
+{
+    return std::min( std::max( x, lower ), upper );
+}
+
+template< typename T >
+std::complex<T> clamp_ref( std::complex<T> x, T, T )
+{
+    return x;  // not reached; ReLU, Clamp are real only
+}
+
+// -----------------------------------------------------------------------------
+// Separate pass over the Cm-by-Cn matrix C, in column-major terms, as the
+// caller would do after a plain gemm.
+// @return max( 1, max | f'(x) | ) of the activation f over C, which bounds
+// how much f amplifies errors in x; only complex Sigmoid and Tanh exceed 1.
+template< typename T >
+blas::real_type<T> epilogue_ref(
+    blas::Layout layout, blas::Epilogue<T> const& epi,
+    int64_t Cm, int64_t Cn, T* C, int64_t ldc )
+{
+    using namespace blas;
+    typedef real_type<T> real_t;
+    const real_t inf = std::numeric_limits<real_t>::infinity();
+
+    real_t slope = 1;
+    for (int64_t jj = 0; jj < Cn; ++jj) {
+        for (int64_t ii = 0; ii < Cm; ++ii) {
+            // (i, j) indices of C as m-by-n
+            int64_t i = (layout == Layout::ColMajor ? ii : jj);
+            int64_t j = (layout == Layout::ColMajor ? jj : ii);
+            T x = C[ ii + jj*ldc ] * epi.row_scale[ i ] * epi.col_scale[ j ]
+                + epi.bias[ j ];
+            switch (epi.activation) {
+                case Activation::Identity: break;
+                case Activation::ReLU:    x = clamp_ref( x, real_t( 0 ), inf ); break;
+                case Activation::Clamp:   x = clamp_ref( x, epi.lower, epi.upper ); break;
+                case Activation::Sigmoid:
+                    x = T( 1 ) / (T( 1 ) + std::exp( -x ));
+                    slope = std::max( slope, std::abs( x * (T( 1 ) - x) ) );
+                    break;
+                case Activation::Tanh:
+                    x = std::tanh( x );
+                    slope = std::max( slope, std::abs( T( 1 ) - x*x ) );
+                    break;
+            }
+            C[ ii + jj*ldc ] = x;
+        }
+    }
+    return slope;
+}
+
+// -----------------------------------------------------------------------------
+// Tests gemm with an epilogue of bias, row and column scaling, and
+// --activation, against cblas gemm followed by a separate epilogue pass,
+// which is included in Ref. time. Scaling is in (0, 1), so the gemm error
+// bound holds, scaled by the activation's slope (1 for real activations).
+template< typename T >
+void test_gemm_epilogue_work( Params& params, bool run )
+{
+    using namespace testsweeper;
+    using namespace blas;
+    typedef real_type<T> real_t;
+    typedef long long lld;
+
+    // get & mark input values
+    blas::Layout layout = params.layout();
+    blas::Op transA = params.transA();
+    blas::Op transB = params.transB();
+    blas::Activation activation = params.activation();
+    T alpha         = params.alpha();
+    T beta          = params.beta();
+    int64_t m       = params.dim.m();
+    int64_t n       = params.dim.n();
+    int64_t k       = params.dim.k();
+    int64_t align   = params.align();
+    int64_t verbose = params.verbose();
+
+    // mark non-standard output values
+    params.gflops();
+    params.ref_time();
+    params.ref_gflops();
+
+    if (! run)
+        return;
+
+    // setup
+    int64_t Am = (transA == Op::NoTrans ? m : k);
+    int64_t An = (transA == Op::NoTrans ? k : m);
+    int64_t Bm = (transB == Op::NoTrans ? k : n);
+    int64_t Bn = (transB == Op::NoTrans ? n : k);
+    int64_t Cm = m;
+    int64_t Cn = n;
+    if (layout == Layout::RowMajor) {
+        std::swap( Am, An );
+        std::swap( Bm, Bn );
+        std::swap( Cm, Cn );
+    }
+    int64_t lda = roundup( Am, align );
+    int64_t ldb = roundup( Bm, align );
+    int64_t ldc = roundup( Cm, align );
+    size_t size_A = size_t(lda)*An;
+    size_t size_B = size_t(ldb)*Bn;
+    size_t size_C = size_t(ldc)*Cn;
+    T* A    = new T[ size_A ];
+    T* B    = new T[ size_B ];
+    T* C    = new T[ size_C ];
+    T* Cref = new T[ size_C ];
+    std::vector<T> bias( n ), row_scale( m ), col_scale( n );
+
+    int64_t idist = 1;
+    int iseed[4] = { 0, 0, 0, 1 };
+    lapack_larnv( idist, iseed, size_A, A );
+    lapack_larnv( idist, iseed, size_B, B );
+    lapack_larnv( idist, iseed, size_C, C );
+    lapack_larnv( idist, iseed, n, bias.data() );
+    lapack_larnv( idist, iseed, m, row_scale.data() );
+    lapack_larnv( idist, iseed, n, col_scale.data() );
+    lapack_lacpy( "g", Cm, Cn, C, ldc, Cref, ldc );
+
+    // clamp to about the middle of the entries, which are near |alpha| k / 4
+    Epilogue<T> epilogue;
+    epilogue.bias       = bias.data();
+    epilogue.row_scale  = row_scale.data();
+    epilogue.col_scale  = col_scale.data();
+    epilogue.activation = activation;
+    epilogue.lower      = 0;
+    epilogue.upper      = std::abs( alpha ) * k / 8;
+
+    // test error exits
+    Epilogue<T> bad = epilogue;
+    bad.activation = Activation( 0 );
+    assert_throw( blas::gemm( layout, transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, bad ), blas::Error );
+    bad.activation = Activation::Clamp;
+    bad.lower = 1;
+    bad.upper = -1;
+    assert_throw( blas::gemm( layout, transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, bad ), blas::Error );
+    assert_throw( blas::gemm( Layout(0), transA, transB,  m,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc, epilogue ), blas::Error );
+    assert_throw( blas::gemm( layout,    Op(0),  transB,  m,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc, epilogue ), blas::Error );
+    assert_throw( blas::gemm( layout,    transA, transB, -1,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc, epilogue ), blas::Error );
+    assert_throw( blas::gemm( layout,    transA, transB,  m,  n,  k, alpha, A, lda, B, ldb, beta, C, Cm-1, epilogue ), blas::Error );
+
+    // ReLU and Clamp need an ordering, so are real only
+    if (is_complex<T>::value
+        && (activation == Activation::ReLU || activation == Activation::Clamp)) {
+        assert_throw( blas::gemm( layout, transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, epilogue ), blas::Error );
+        params.okay() = true;
+        delete[] A;
+        delete[] B;
+        delete[] C;
+        delete[] Cref;
+        return;
+    }
+
+    // norms for error check
+    real_t work[1];
+    real_t Anorm = lapack_lange( "f", Am, An, A, lda, work );
+    real_t Bnorm = lapack_lange( "f", Bm, Bn, B, ldb, work );
+    real_t Cnorm = lapack_lange( "f", Cm, Cn, C, ldc, work );
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A Am=%5lld, An=%5lld, lda=%5lld, size=%10lld, norm %.2e\n"
+                "B Bm=%5lld, Bn=%5lld, ldb=%5lld, size=%10lld, norm %.2e\n"
+                "C Cm=%5lld, Cn=%5lld, ldc=%5lld, size=%10lld, norm %.2e\n",
+                (lld) Am, (lld) An, (lld) lda, (lld) size_A, Anorm,
+                (lld) Bm, (lld) Bn, (lld) ldb, (lld) size_B, Bnorm,
+                (lld) Cm, (lld) Cn, (lld) ldc, (lld) size_C, Cnorm );
+    }
+    if (verbose >= 2) {
+        printf( "alpha = %.4e + %.4ei; beta = %.4e + %.4ei;\n",
+                real(alpha), imag(alpha),
+                real(beta),  imag(beta) );
+        printf( "A = "    ); print_matrix( Am, An, A, lda );
+        printf( "B = "    ); print_matrix( Bm, Bn, B, ldb );
+        printf( "C = "    ); print_matrix( Cm, Cn, C, ldc );
+    }
+
+    // run test
+    testsweeper::flush_cache( params.cache() );
+    double time = get_wtime();
+    blas::gemm( layout, transA, transB, m, n, k,
+                alpha, A, lda, B, ldb, beta, C, ldc, epilogue );
+    time = get_wtime() - time;
+
+    double gflop = Gflop < T >::gemm( m, n, k );
+    params.time()   = time;
+    params.gflops() = gflop / time;
+
+    if (verbose >= 2) {
+        printf( "C2 = " ); print_matrix( Cm, Cn, C, ldc );
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // run reference: gemm, then a separate pass over C
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        cblas_gemm( cblas_layout_const(layout),
+                    cblas_trans_const(transA),
+                    cblas_trans_const(transB),
+                    m, n, k, alpha, A, lda, B, ldb, beta, Cref, ldc );
+        real_t slope = epilogue_ref( layout, epilogue, Cm, Cn, Cref, ldc );
+        time = get_wtime() - time;
+
+        params.ref_time()   = time;
+        params.ref_gflops() = gflop / time;
+
+        if (verbose >= 2) {
+            printf( "Cref = " ); print_matrix( Cm, Cn, Cref, ldc );
+        }
+
+        // check error compared to reference
+        real_t error;
+        bool okay;
+        // scale the bound by the activation's slope
+        check_gemm( Cm, Cn, k, alpha, beta, slope*Anorm, Bnorm, slope*Cnorm,
+                    Cref, ldc, C, ldc, verbose, &error, &okay );
+        params.error() = error;
+        params.okay() = okay;
+    }
+
+    delete[] A;
+    delete[] B;
+    delete[] C;
+    delete[] Cref;
+}
+
+// -----------------------------------------------------------------------------
+void test_gemm_epilogue( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_gemm_epilogue_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_gemm_epilogue_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_gemm_epilogue_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_gemm_epilogue_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
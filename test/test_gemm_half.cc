@@ -0,0 +1,209 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "cblas.hh"
+#include "lapack_wrappers.hh"
+#include "blas/flops.hh"
+#include "print_matrix.hh"
+#include "check_gemm.hh"
+
+// -----------------------------------------------------------------------------
+// Tests gemm with half precision A, B, accumulating in float, for both
+// half precision C and float C. The reference is sgemm on the same inputs,
+// converted exactly to float. With half C, the result is rounded once to
+// half, so the error is compared to half precision unit roundoff;
+// with float C, to float unit roundoff.
+// Ignores --type.
+template< typename T >
+void test_gemm_half_work( Params& params, bool run )
+{
+    using namespace testsweeper;
+    using namespace blas;
+    typedef long long lld;
+
+    // get & mark input values
+    blas::Layout layout = params.layout();
+    blas::Op transA = params.transA();
+    blas::Op transB = params.transB();
+    float alpha     = params.alpha();
+    float beta      = params.beta();
+    int64_t m       = params.dim.m();
+    int64_t n       = params.dim.n();
+    int64_t k       = params.dim.k();
+    int64_t align   = params.align();
+    int64_t verbose = params.verbose();
+
+    // mark non-standard output values
+    params.gflops();
+    params.gbytes();
+    params.ref_time();
+    params.ref_gflops();
+    params.ref_gbytes();
+
+    if (! run)
+        return;
+
+    // setup
+    int64_t Am = (transA == Op::NoTrans ? m : k);
+    int64_t An = (transA == Op::NoTrans ? k : m);
+    int64_t Bm = (transB == Op::NoTrans ? k : n);
+    int64_t Bn = (transB == Op::NoTrans ? n : k);
+    int64_t Cm = m;
+    int64_t Cn = n;
+    if (layout == Layout::RowMajor) {
+        std::swap( Am, An );
+        std::swap( Bm, Bn );
+        std::swap( Cm, Cn );
+    }
+    int64_t lda = roundup( Am, align );
+    int64_t ldb = roundup( Bm, align );
+    int64_t ldc = roundup( Cm, align );
+    size_t size_A = size_t(lda)*An;
+    size_t size_B = size_t(ldb)*Bn;
+    size_t size_C = size_t(ldc)*Cn;
+    T* A      = new T[ size_A ];
+    T* B      = new T[ size_B ];
+    T* C      = new T[ size_C ];
+    float* Af = new float[ size_A ];
+    float* Bf = new float[ size_B ];
+    float* Cf = new float[ size_C ];
+    float* Cref = new float[ size_C ];
+    float* Cout = new float[ size_C ];
+
+    // generate in float, round to T, then convert back so reference
+    // has exactly the same inputs
+    int64_t idist = 1;
+    int iseed[4] = { 0, 0, 0, 1 };
+    lapack_larnv( idist, iseed, size_A, Af );
+    lapack_larnv( idist, iseed, size_B, Bf );
+    lapack_larnv( idist, iseed, size_C, Cf );
+    for (size_t i = 0; i < size_A; ++i) {
+        A[ i ] = Af[ i ];
+        Af[ i ] = A[ i ];
+    }
+    for (size_t i = 0; i < size_B; ++i) {
+        B[ i ] = Bf[ i ];
+        Bf[ i ] = B[ i ];
+    }
+    for (size_t i = 0; i < size_C; ++i) {
+        C[ i ] = Cf[ i ];
+        Cf[ i ] = C[ i ];
+    }
+    lapack_lacpy( "g", Cm, Cn, Cf, ldc, Cref, ldc );
+
+    // norms for error check
+    float work[1];
+    float Anorm = lapack_lange( "f", Am, An, Af, lda, work );
+    float Bnorm = lapack_lange( "f", Bm, Bn, Bf, ldb, work );
+    float Cnorm = lapack_lange( "f", Cm, Cn, Cf, ldc, work );
+
+    // test error exits
+    assert_throw( blas::gemm( Layout(0), transA, transB,  m,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( blas::gemm( layout,    Op(0),  transB,  m,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( blas::gemm( layout,    transA, Op(0),   m,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( blas::gemm( layout,    transA, transB, -1,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( blas::gemm( layout,    transA, transB,  m, -1,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( blas::gemm( layout,    transA, transB,  m,  n, -1, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+
+    assert_throw( blas::gemm( Layout::ColMajor, transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, m-1 ), blas::Error );
+    assert_throw( blas::gemm( Layout::RowMajor, transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, n-1 ), blas::Error );
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A Am=%5lld, An=%5lld, lda=%5lld, size=%10lld, norm %.2e\n"
+                "B Bm=%5lld, Bn=%5lld, ldb=%5lld, size=%10lld, norm %.2e\n"
+                "C Cm=%5lld, Cn=%5lld, ldc=%5lld, size=%10lld, norm %.2e\n",
+                (lld) Am, (lld) An, (lld) lda, (lld) size_A, Anorm,
+                (lld) Bm, (lld) Bn, (lld) ldb, (lld) size_B, Bnorm,
+                (lld) Cm, (lld) Cn, (lld) ldc, (lld) size_C, Cnorm );
+    }
+    if (verbose >= 2) {
+        printf( "alpha = %.4e; beta = %.4e;\n", alpha, beta );
+        printf( "A = "    ); print_matrix( Am, An, Af, lda );
+        printf( "B = "    ); print_matrix( Bm, Bn, Bf, ldb );
+        printf( "C = "    ); print_matrix( Cm, Cn, Cf, ldc );
+    }
+
+    // run test
+    testsweeper::flush_cache( params.cache() );
+    double time = get_wtime();
+    blas::gemm( layout, transA, transB, m, n, k,
+                alpha, A, lda, B, ldb, beta, C, ldc );
+    time = get_wtime() - time;
+
+    double gflop = Gflop < T >::gemm( m, n, k );
+    double gbyte = Gbyte < T >::gemm( m, n, k );
+    params.time()   = time;
+    params.gflops() = gflop / time;
+    params.gbytes() = gbyte / time;
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // half A, B with float C, in Cf
+        blas::gemm( layout, transA, transB, m, n, k,
+                    alpha, A, lda, B, ldb, beta, Cf, ldc );
+
+        // run reference
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        cblas_gemm( cblas_layout_const(layout),
+                    cblas_trans_const(transA),
+                    cblas_trans_const(transB),
+                    m, n, k, alpha, Af, lda, Bf, ldb, beta, Cref, ldc );
+        time = get_wtime() - time;
+
+        params.ref_time()   = time;
+        params.ref_gflops() = gflop / time;
+        params.ref_gbytes() = gbyte / time;
+
+        if (verbose >= 2) {
+            printf( "Cref = " ); print_matrix( Cm, Cn, Cref, ldc );
+        }
+
+        // check error compared to reference
+        // half C: rounded once to T
+        for (size_t i = 0; i < size_C; ++i)
+            Cout[ i ] = C[ i ];
+        float error_half, error_float;
+        bool okay;
+        check_gemm( Cm, Cn, k, alpha, beta, Anorm, Bnorm, Cnorm,
+                    Cref, ldc, Cout, ldc, verbose, &error_half, &okay );
+        float u_half = 0.5f * float( std::numeric_limits< T >::epsilon() );
+        bool okay_half = (error_half < u_half);
+
+        // float C
+        check_gemm( Cm, Cn, k, alpha, beta, Anorm, Bnorm, Cnorm,
+                    Cref, ldc, Cf, ldc, verbose, &error_float, &okay );
+        bool okay_float = okay;
+
+        if (verbose >= 1) {
+            printf( "error half C %.2e (u %.2e), float C %.2e\n",
+                    error_half, u_half, error_float );
+        }
+        params.error() = error_half;
+        params.okay() = okay_half && okay_float;
+    }
+
+    delete[] A;
+    delete[] B;
+    delete[] C;
+    delete[] Af;
+    delete[] Bf;
+    delete[] Cf;
+    delete[] Cref;
+    delete[] Cout;
+}
+
+// -----------------------------------------------------------------------------
+void test_gemm_fp16( Params& params, bool run )
+{
+    test_gemm_half_work< blas::float16 >( params, run );
+}
+
+// -----------------------------------------------------------------------------
+void test_gemm_bf16( Params& params, bool run )
+{
+    test_gemm_half_work< blas::bfloat16 >( params, run );
+}
@@ -0,0 +1,213 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "cblas.hh"
+#include "lapack_wrappers.hh"
+#include "blas/flops.hh"
+#include "print_matrix.hh"
+
+#include <limits>
+
+// -----------------------------------------------------------------------------
+// Tests gemm with 8-bit integer A, B, accumulating in int32, for both
+// int32 C and dequantized float C with row and column scales.
+// The reference is dgemm on the same inputs converted to double, which is
+// exact for integers below 2^53, so the int32 result must match exactly.
+// The float result is rounded only in the epilogue, so it is compared to
+// float precision entry-wise.
+// TA is int8_t or uint8_t; B is int8_t. Ignores --type.
+template< typename TA >
+void test_gemm_int8_work( Params& params, bool run )
+{
+    using namespace testsweeper;
+    using namespace blas;
+    typedef long long lld;
+
+    // get & mark input values
+    blas::Layout layout = params.layout();
+    blas::Op transA = params.transA();
+    blas::Op transB = params.transB();
+    int32_t alpha   = int32_t( params.alpha() );
+    int32_t beta    = int32_t( params.beta() );
+    int64_t m       = params.dim.m();
+    int64_t n       = params.dim.n();
+    int64_t k       = params.dim.k();
+    int64_t align   = params.align();
+    int64_t verbose = params.verbose();
+
+    // mark non-standard output values
+    params.gflops();
+    params.ref_time();
+    params.ref_gflops();
+
+    if (! run)
+        return;
+
+    // setup
+    int64_t Am = (transA == Op::NoTrans ? m : k);
+    int64_t An = (transA == Op::NoTrans ? k : m);
+    int64_t Bm = (transB == Op::NoTrans ? k : n);
+    int64_t Bn = (transB == Op::NoTrans ? n : k);
+    int64_t Cm = m;
+    int64_t Cn = n;
+    if (layout == Layout::RowMajor) {
+        std::swap( Am, An );
+        std::swap( Bm, Bn );
+        std::swap( Cm, Cn );
+    }
+    int64_t lda = roundup( Am, align );
+    int64_t ldb = roundup( Bm, align );
+    int64_t ldc = roundup( Cm, align );
+    size_t size_A = size_t(lda)*An;
+    size_t size_B = size_t(ldb)*Bn;
+    size_t size_C = size_t(ldc)*Cn;
+    TA*      A    = new TA[ size_A ];
+    int8_t*  B    = new int8_t[ size_B ];
+    int32_t* C    = new int32_t[ size_C ];
+    float*   Cf   = new float[ size_C ];
+    double*  Ad   = new double[ size_A ];
+    double*  Bd   = new double[ size_B ];
+    double*  Cref = new double[ size_C ];
+    double*  Cin  = new double[ size_C ];
+    float*   row_scale = new float[ m ];
+    float*   col_scale = new float[ n ];
+
+    // generate uniform integers in the range of each type
+    int64_t idist = 1;
+    int iseed[4] = { 0, 0, 0, 1 };
+    double amin = std::numeric_limits< TA >::min();
+    double arange = std::numeric_limits< TA >::max() - amin + 1;
+    lapack_larnv( idist, iseed, size_A, Ad );
+    lapack_larnv( idist, iseed, size_B, Bd );
+    lapack_larnv( idist, iseed, size_C, Cref );
+    for (size_t i = 0; i < size_A; ++i) {
+        A[ i ] = TA( std::floor( amin + arange * Ad[ i ] ) );
+        Ad[ i ] = A[ i ];
+    }
+    for (size_t i = 0; i < size_B; ++i) {
+        B[ i ] = int8_t( std::floor( -128 + 256 * Bd[ i ] ) );
+        Bd[ i ] = B[ i ];
+    }
+    for (size_t i = 0; i < size_C; ++i) {
+        C[ i ] = int32_t( std::floor( -1000 + 2000 * Cref[ i ] ) );
+        Cf[ i ] = C[ i ];
+        Cin[ i ] = C[ i ];
+    }
+    for (int64_t i = 0; i < m; ++i)
+        row_scale[ i ] = 0.5f + float( i % 7 ) / 8;
+    for (int64_t j = 0; j < n; ++j)
+        col_scale[ j ] = 0.25f + float( j % 5 ) / 16;
+
+    // test error exits
+    assert_throw( blas::gemm( Layout(0), transA, transB,  m,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( blas::gemm( layout,    Op(0),  transB,  m,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( blas::gemm( layout,    transA, Op(0),   m,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( blas::gemm( layout,    transA, transB, -1,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( blas::gemm( layout,    transA, transB,  m, -1,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( blas::gemm( layout,    transA, transB,  m,  n, -1, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+
+    assert_throw( blas::gemm( Layout::ColMajor, transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, m-1 ), blas::Error );
+    assert_throw( blas::gemm( Layout::RowMajor, transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, n-1 ), blas::Error );
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A Am=%5lld, An=%5lld, lda=%5lld, size=%10lld\n"
+                "B Bm=%5lld, Bn=%5lld, ldb=%5lld, size=%10lld\n"
+                "C Cm=%5lld, Cn=%5lld, ldc=%5lld, size=%10lld\n",
+                (lld) Am, (lld) An, (lld) lda, (lld) size_A,
+                (lld) Bm, (lld) Bn, (lld) ldb, (lld) size_B,
+                (lld) Cm, (lld) Cn, (lld) ldc, (lld) size_C );
+    }
+    if (verbose >= 2) {
+        printf( "alpha = %d; beta = %d;\n", alpha, beta );
+        printf( "A = "    ); print_matrix( Am, An, Ad, lda );
+        printf( "B = "    ); print_matrix( Bm, Bn, Bd, ldb );
+    }
+
+    // run test
+    testsweeper::flush_cache( params.cache() );
+    double time = get_wtime();
+    blas::gemm( layout, transA, transB, m, n, k,
+                alpha, A, lda, B, ldb, beta, C, ldc );
+    time = get_wtime() - time;
+
+    double gflop = Gflop < int8_t >::gemm( m, n, k );
+    params.time()   = time;
+    params.gflops() = gflop / time;
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // dequantized float C, in Cf
+        float falpha = params.alpha();
+        float fbeta  = params.beta();
+        blas::gemm( layout, transA, transB, m, n, k,
+                    falpha, A, lda, B, ldb, fbeta, Cf, ldc,
+                    row_scale, col_scale );
+
+        // run reference, Cref = A B
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        cblas_gemm( cblas_layout_const(layout),
+                    cblas_trans_const(transA),
+                    cblas_trans_const(transB),
+                    m, n, k, 1.0, Ad, lda, Bd, ldb, 0.0, Cref, ldc );
+        time = get_wtime() - time;
+
+        params.ref_time()   = time;
+        params.ref_gflops() = gflop / time;
+
+        // int32 C must be exact; float C is compared entry-wise,
+        // relative to the magnitude of its terms.
+        double error_int = 0, error_float = 0;
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t i = 0; i < m; ++i) {
+                int64_t ij = (layout == Layout::ColMajor ? i + j*ldc
+                                                         : j + i*ldc);
+                double ab = Cref[ ij ];
+                double cint = alpha*ab + beta*Cin[ ij ];
+                error_int = std::max( error_int, std::abs( C[ ij ] - cint ) );
+
+                double s = double( falpha ) * row_scale[ i ] * col_scale[ j ];
+                double cflt = s*ab + fbeta*Cin[ ij ];
+                double cmag = std::abs( s*ab ) + std::abs( fbeta*Cin[ ij ] );
+                if (cmag > 0) {
+                    error_float = std::max( error_float,
+                                            std::abs( Cf[ ij ] - cflt ) / cmag );
+                }
+            }
+        }
+
+        if (verbose >= 1) {
+            printf( "error int32 C %.2e, float C %.2e\n",
+                    error_int, error_float );
+        }
+        double eps = std::numeric_limits< float >::epsilon();
+        params.error() = error_float;
+        params.okay() = (error_int == 0 && error_float < 4*eps);
+    }
+
+    delete[] A;
+    delete[] B;
+    delete[] C;
+    delete[] Cf;
+    delete[] Ad;
+    delete[] Bd;
+    delete[] Cref;
+    delete[] Cin;
+    delete[] row_scale;
+    delete[] col_scale;
+}
+
+// -----------------------------------------------------------------------------
+void test_gemm_s8( Params& params, bool run )
+{
+    test_gemm_int8_work< int8_t >( params, run );
+}
+
+// -----------------------------------------------------------------------------
+void test_gemm_u8( Params& params, bool run )
+{
+    test_gemm_int8_work< uint8_t >( params, run );
+}
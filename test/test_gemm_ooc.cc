@@ -0,0 +1,187 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "cblas.hh"
+#include "lapack_wrappers.hh"
+#include "blas/flops.hh"
+#include "print_matrix.hh"
+#include "check_gemm.hh"
+
+#include <cstdio>
+#include <unistd.h>
+
+// -----------------------------------------------------------------------------
+// Tests out-of-core gemm, with A, B, C stored one after another in a
+// temporary file and buffers for --nb sized tiles, against in-core cblas
+// gemm. Ref. time is therefore the in-core time.
+template< typename T >
+void test_gemm_ooc_work( Params& params, bool run )
+{
+    using namespace testsweeper;
+    using namespace blas;
+    typedef real_type<T> real_t;
+
+    // get & mark input values
+    blas::Layout layout = params.layout();
+    blas::Op transA = params.transA();
+    blas::Op transB = params.transB();
+    T alpha         = params.alpha();
+    T beta          = params.beta();
+    int64_t m       = params.dim.m();
+    int64_t n       = params.dim.n();
+    int64_t k       = params.dim.k();
+    int64_t nb      = params.nb();
+    int64_t align   = params.align();
+    int64_t verbose = params.verbose();
+
+    // mark non-standard output values
+    params.gflops();
+    params.ref_time();
+    params.ref_gflops();
+
+    if (! run)
+        return;
+
+    // setup
+    int64_t Am = (transA == Op::NoTrans ? m : k);
+    int64_t An = (transA == Op::NoTrans ? k : m);
+    int64_t Bm = (transB == Op::NoTrans ? k : n);
+    int64_t Bn = (transB == Op::NoTrans ? n : k);
+    int64_t Cm = m;
+    int64_t Cn = n;
+    if (layout == Layout::RowMajor) {
+        std::swap( Am, An );
+        std::swap( Bm, Bn );
+        std::swap( Cm, Cn );
+    }
+    int64_t lda = roundup( Am, align );
+    int64_t ldb = roundup( Bm, align );
+    int64_t ldc = roundup( Cm, align );
+    size_t size_A = size_t(lda)*An;
+    size_t size_B = size_t(ldb)*Bn;
+    size_t size_C = size_t(ldc)*Cn;
+    T* A    = new T[ size_A ];
+    T* B    = new T[ size_B ];
+    T* C    = new T[ size_C ];
+    T* Cref = new T[ size_C ];
+
+    int64_t idist = 1;
+    int iseed[4] = { 0, 0, 0, 1 };
+    lapack_larnv( idist, iseed, size_A, A );
+    lapack_larnv( idist, iseed, size_B, B );
+    lapack_larnv( idist, iseed, size_C, C );
+    lapack_lacpy( "g", Cm, Cn, C, ldc, Cref, ldc );
+
+    // norms for error check
+    real_t work[1];
+    real_t Anorm = lapack_lange( "f", Am, An, A, lda, work );
+    real_t Bnorm = lapack_lange( "f", Bm, Bn, B, ldb, work );
+    real_t Cnorm = lapack_lange( "f", Cm, Cn, C, ldc, work );
+
+    // write A, B, C to the file
+    FILE* file = tmpfile();
+    assert( file != nullptr );
+    int fd = fileno( file );
+    int64_t offset_B = size_A * sizeof(T);
+    int64_t offset_C = offset_B + size_B * sizeof(T);
+    bool io_okay = true;
+    io_okay &= (pwrite( fd, A, size_A * sizeof(T), 0 )
+                == ssize_t( size_A * sizeof(T) ));
+    io_okay &= (pwrite( fd, B, size_B * sizeof(T), offset_B )
+                == ssize_t( size_B * sizeof(T) ));
+    io_okay &= (pwrite( fd, C, size_C * sizeof(T), offset_C )
+                == ssize_t( size_C * sizeof(T) ));
+
+    FileMatrix<T> fA( fd, lda );
+    FileMatrix<T> fB( fd, ldb, offset_B );
+    FileMatrix<T> fC( fd, ldc, offset_C );
+    size_t memory = 6 * nb * nb * sizeof(T);
+
+    // test error exits
+    assert_throw( blas::gemm( Layout(0), transA, transB,  m,  n,  k, alpha, fA, fB, beta, fC, memory ), blas::Error );
+    assert_throw( blas::gemm( layout,    Op(0),  transB,  m,  n,  k, alpha, fA, fB, beta, fC, memory ), blas::Error );
+    assert_throw( blas::gemm( layout,    transA, Op(0),   m,  n,  k, alpha, fA, fB, beta, fC, memory ), blas::Error );
+    assert_throw( blas::gemm( layout,    transA, transB, -1,  n,  k, alpha, fA, fB, beta, fC, memory ), blas::Error );
+    assert_throw( blas::gemm( layout,    transA, transB,  m, -1,  k, alpha, fA, fB, beta, fC, memory ), blas::Error );
+    assert_throw( blas::gemm( layout,    transA, transB,  m,  n, -1, alpha, fA, fB, beta, fC, memory ), blas::Error );
+    assert_throw( blas::gemm( layout,    transA, transB,  m,  n,  k, alpha, fA, fB, beta, fC, 0 ), blas::Error );
+
+    // run test
+    testsweeper::flush_cache( params.cache() );
+    double time = get_wtime();
+    blas::gemm( layout, transA, transB, m, n, k,
+                alpha, fA, fB, beta, fC, memory );
+    time = get_wtime() - time;
+
+    double gflop = Gflop < T >::gemm( m, n, k );
+    params.time()   = time;
+    params.gflops() = gflop / time;
+
+    io_okay &= (pread( fd, C, size_C * sizeof(T), offset_C )
+                == ssize_t( size_C * sizeof(T) ));
+    fclose( file );
+
+    if (verbose >= 2) {
+        printf( "C2 = " ); print_matrix( Cm, Cn, C, ldc );
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // run reference
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        cblas_gemm( cblas_layout_const(layout),
+                    cblas_trans_const(transA),
+                    cblas_trans_const(transB),
+                    m, n, k, alpha, A, lda, B, ldb, beta, Cref, ldc );
+        time = get_wtime() - time;
+
+        params.ref_time()   = time;
+        params.ref_gflops() = gflop / time;
+
+        if (verbose >= 2) {
+            printf( "Cref = " ); print_matrix( Cm, Cn, Cref, ldc );
+        }
+
+        // check error compared to reference
+        real_t error;
+        bool okay;
+        check_gemm( Cm, Cn, k, alpha, beta, Anorm, Bnorm, Cnorm,
+                    Cref, ldc, C, ldc, verbose, &error, &okay );
+        params.error() = error;
+        params.okay() = okay && io_okay;
+    }
+
+    delete[] A;
+    delete[] B;
+    delete[] C;
+    delete[] Cref;
+}
+
+// -----------------------------------------------------------------------------
+void test_gemm_ooc( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_gemm_ooc_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_gemm_ooc_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_gemm_ooc_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_gemm_ooc_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
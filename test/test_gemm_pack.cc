@@ -0,0 +1,217 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "cblas.hh"
+#include "lapack_wrappers.hh"
+#include "blas/flops.hh"
+#include "print_matrix.hh"
+#include "check_gemm.hh"
+
+// -----------------------------------------------------------------------------
+// Tests gemm with a pre-packed operand. The timed call is gemm with packed A,
+// after packing once; the reference is the vendor gemm, which packs A each
+// call. Also checks gemm with packed B, and batch gemm with a shared packed A
+// and --batch problems.
+template< typename T >
+void test_gemm_pack_work( Params& params, bool run )
+{
+    using namespace testsweeper;
+    using namespace blas;
+    typedef real_type<T> real_t;
+    typedef long long lld;
+
+    // get & mark input values
+    blas::Layout layout = params.layout();
+    blas::Op transA = params.transA();
+    blas::Op transB = params.transB();
+    T alpha         = params.alpha();
+    T beta          = params.beta();
+    int64_t m       = params.dim.m();
+    int64_t n       = params.dim.n();
+    int64_t k       = params.dim.k();
+    size_t  batch   = params.batch();
+    int64_t align   = params.align();
+    int64_t verbose = params.verbose();
+
+    // mark non-standard output values
+    params.gflops();
+    params.ref_time();
+    params.ref_gflops();
+
+    if (! run)
+        return;
+
+    // setup
+    int64_t Am = (transA == Op::NoTrans ? m : k);
+    int64_t An = (transA == Op::NoTrans ? k : m);
+    int64_t Bm = (transB == Op::NoTrans ? k : n);
+    int64_t Bn = (transB == Op::NoTrans ? n : k);
+    int64_t Cm = m;
+    int64_t Cn = n;
+    if (layout == Layout::RowMajor) {
+        std::swap( Am, An );
+        std::swap( Bm, Bn );
+        std::swap( Cm, Cn );
+    }
+    int64_t lda = roundup( Am, align );
+    int64_t ldb = roundup( Bm, align );
+    int64_t ldc = roundup( Cm, align );
+    size_t size_A = size_t(lda)*An;
+    size_t size_B = size_t(ldb)*Bn;
+    size_t size_C = size_t(ldc)*Cn;
+    T* A    = new T[ size_A ];
+    T* B    = new T[ size_B ];
+    T* C    = new T[ size_C ];
+    T* Cin  = new T[ size_C ];
+    T* Cref = new T[ size_C ];
+
+    int64_t idist = 1;
+    int iseed[4] = { 0, 0, 0, 1 };
+    lapack_larnv( idist, iseed, size_A, A );
+    lapack_larnv( idist, iseed, size_B, B );
+    lapack_larnv( idist, iseed, size_C, C );
+    lapack_lacpy( "g", Cm, Cn, C, ldc, Cin,  ldc );
+    lapack_lacpy( "g", Cm, Cn, C, ldc, Cref, ldc );
+
+    // norms for error check
+    real_t work[1];
+    real_t Anorm = lapack_lange( "f", Am, An, A, lda, work );
+    real_t Bnorm = lapack_lange( "f", Bm, Bn, B, ldb, work );
+    real_t Cnorm = lapack_lange( "f", Cm, Cn, C, ldc, work );
+
+    // test error exits
+    assert_throw( blas::gemm_pack( Layout(0), Side::Left, transA,  m,  n,  k, A, lda ), blas::Error );
+    assert_throw( blas::gemm_pack( layout,    Side(0),    transA,  m,  n,  k, A, lda ), blas::Error );
+    assert_throw( blas::gemm_pack( layout,    Side::Left, Op(0),   m,  n,  k, A, lda ), blas::Error );
+    assert_throw( blas::gemm_pack( layout,    Side::Left, transA, -1,  n,  k, A, lda ), blas::Error );
+    assert_throw( blas::gemm_pack( layout,    Side::Left, transA,  m,  n, -1, A, lda ), blas::Error );
+    assert_throw( blas::gemm_pack( layout,    Side::Left, transA,  m,  n,  k, A, Am-1 ), blas::Error );
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A Am=%5lld, An=%5lld, lda=%5lld, size=%10lld, norm %.2e\n"
+                "B Bm=%5lld, Bn=%5lld, ldb=%5lld, size=%10lld, norm %.2e\n"
+                "C Cm=%5lld, Cn=%5lld, ldc=%5lld, size=%10lld, norm %.2e\n",
+                (lld) Am, (lld) An, (lld) lda, (lld) size_A, Anorm,
+                (lld) Bm, (lld) Bn, (lld) ldb, (lld) size_B, Bnorm,
+                (lld) Cm, (lld) Cn, (lld) ldc, (lld) size_C, Cnorm );
+    }
+    if (verbose >= 2) {
+        printf( "alpha = %.4e + %.4ei; beta = %.4e + %.4ei;\n",
+                real(alpha), imag(alpha),
+                real(beta),  imag(beta) );
+        printf( "A = "    ); print_matrix( Am, An, A, lda );
+        printf( "B = "    ); print_matrix( Bm, Bn, B, ldb );
+        printf( "C = "    ); print_matrix( Cm, Cn, C, ldc );
+    }
+
+    // pack once, not timed
+    auto Ap = blas::gemm_pack( layout, Side::Left, transA, m, n, k, A, lda );
+
+    // packed A is for m-by-k, and can't be used as B
+    assert_throw( blas::gemm( layout, transB, m+1, n, k, alpha, Ap, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( blas::gemm( layout, transA, m, n, k, alpha, A, lda, Ap, beta, C, ldc ), blas::Error );
+
+    // run test
+    testsweeper::flush_cache( params.cache() );
+    double time = get_wtime();
+    blas::gemm( layout, transB, m, n, k, alpha, Ap, B, ldb, beta, C, ldc );
+    time = get_wtime() - time;
+
+    double gflop = Gflop < T >::gemm( m, n, k );
+    params.time()   = time;
+    params.gflops() = gflop / time;
+
+    if (verbose >= 2) {
+        printf( "C2 = " ); print_matrix( Cm, Cn, C, ldc );
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // run reference
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        cblas_gemm( cblas_layout_const(layout),
+                    cblas_trans_const(transA),
+                    cblas_trans_const(transB),
+                    m, n, k, alpha, A, lda, B, ldb, beta, Cref, ldc );
+        time = get_wtime() - time;
+
+        params.ref_time()   = time;
+        params.ref_gflops() = gflop / time;
+
+        if (verbose >= 2) {
+            printf( "Cref = " ); print_matrix( Cm, Cn, Cref, ldc );
+        }
+
+        // packed B
+        T* C2 = new T[ size_C ];
+        lapack_lacpy( "g", Cm, Cn, Cin, ldc, C2, ldc );
+        auto Bp = blas::gemm_pack( layout, Side::Right, transB, m, n, k,
+                                   B, ldb );
+        blas::gemm( layout, transA, m, n, k, alpha, A, lda, Bp, beta, C2, ldc );
+
+        // batch, with A shared, each with the same B, C
+        std::vector<T*> Barray( batch, B ), Carray( batch );
+        for (size_t i = 0; i < batch; ++i) {
+            Carray[ i ] = new T[ size_C ];
+            lapack_lacpy( "g", Cm, Cn, Cin, ldc, Carray[ i ], ldc );
+        }
+        std::vector<int64_t> info( batch );
+        blas::batch::gemm( layout, { transB }, { n }, { alpha }, Ap,
+                           Barray, { ldb }, { beta }, Carray, { ldc },
+                           batch, info );
+
+        // check error compared to reference
+        real_t error, error2;
+        bool okay, okay2;
+        check_gemm( Cm, Cn, k, alpha, beta, Anorm, Bnorm, Cnorm,
+                    Cref, ldc, C2, ldc, verbose, &error2, &okay2 );
+        for (size_t i = 0; i < batch; ++i) {
+            check_gemm( Cm, Cn, k, alpha, beta, Anorm, Bnorm, Cnorm,
+                        Cref, ldc, Carray[ i ], ldc, verbose, &error, &okay );
+            error2 = std::max( error, error2 );
+            okay2  = okay2 && okay;
+            delete[] Carray[ i ];
+        }
+        check_gemm( Cm, Cn, k, alpha, beta, Anorm, Bnorm, Cnorm,
+                    Cref, ldc, C, ldc, verbose, &error, &okay );
+        params.error() = std::max( error, error2 );
+        params.okay() = okay && okay2;
+        delete[] C2;
+    }
+
+    delete[] A;
+    delete[] B;
+    delete[] C;
+    delete[] Cin;
+    delete[] Cref;
+}
+
+// -----------------------------------------------------------------------------
+void test_gemm_pack( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_gemm_pack_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_gemm_pack_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_gemm_pack_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_gemm_pack_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
@@ -0,0 +1,220 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "cblas.hh"
+#include "lapack_wrappers.hh"
+#include "blas/flops.hh"
+#include "print_matrix.hh"
+#include "check_gemm.hh"
+
+// -----------------------------------------------------------------------------
+// Tests general stride gemm. Matrices are generated as for test_gemm, with
+// --layout, --transA, --transB setting which dimension is unit stride,
+// then spread out by |incx| for A and B, and by |incy| for C, so with
+// |incx|, |incy| > 1 no operand is unit stride in either dimension.
+// The general stride interface has no conjugation, so ConjTrans is tested
+// as Trans.
+template< typename T >
+void test_gemm_strided_work( Params& params, bool run )
+{
+    using namespace testsweeper;
+    using namespace blas;
+    typedef real_type<T> real_t;
+    typedef long long lld;
+
+    // get & mark input values
+    blas::Layout layout = params.layout();
+    blas::Op transA = params.transA();
+    blas::Op transB = params.transB();
+    T alpha         = params.alpha();
+    T beta          = params.beta();
+    int64_t m       = params.dim.m();
+    int64_t n       = params.dim.n();
+    int64_t k       = params.dim.k();
+    int64_t sab     = std::abs( params.incx() );
+    int64_t sc      = std::abs( params.incy() );
+    int64_t align   = params.align();
+    int64_t verbose = params.verbose();
+
+    // mark non-standard output values
+    params.gflops();
+    params.ref_time();
+    params.ref_gflops();
+
+    if (! run)
+        return;
+
+    if (transA == Op::ConjTrans)
+        transA = Op::Trans;
+    if (transB == Op::ConjTrans)
+        transB = Op::Trans;
+
+    // setup
+    int64_t Am = (transA == Op::NoTrans ? m : k);
+    int64_t An = (transA == Op::NoTrans ? k : m);
+    int64_t Bm = (transB == Op::NoTrans ? k : n);
+    int64_t Bn = (transB == Op::NoTrans ? n : k);
+    int64_t Cm = m;
+    int64_t Cn = n;
+    if (layout == Layout::RowMajor) {
+        std::swap( Am, An );
+        std::swap( Bm, Bn );
+        std::swap( Cm, Cn );
+    }
+    int64_t lda = roundup( Am, align );
+    int64_t ldb = roundup( Bm, align );
+    int64_t ldc = roundup( Cm, align );
+    size_t size_A = size_t(lda)*An;
+    size_t size_B = size_t(ldb)*Bn;
+    size_t size_C = size_t(ldc)*Cn;
+    T* A    = new T[ size_A ];
+    T* B    = new T[ size_B ];
+    T* C    = new T[ size_C ];
+    T* Cref = new T[ size_C ];
+    T* As   = new T[ size_A*sab ];
+    T* Bs   = new T[ size_B*sab ];
+    T* Cs   = new T[ size_C*sc ];
+
+    int64_t idist = 1;
+    int iseed[4] = { 0, 0, 0, 1 };
+    lapack_larnv( idist, iseed, size_A, A );
+    lapack_larnv( idist, iseed, size_B, B );
+    lapack_larnv( idist, iseed, size_C, C );
+    lapack_lacpy( "g", Cm, Cn, C, ldc, Cref, ldc );
+
+    // spread out; gaps are nan, so reading them fails the check
+    T nan = std::numeric_limits< real_t >::quiet_NaN();
+    std::fill( As, As + size_A*sab, nan );
+    std::fill( Bs, Bs + size_B*sab, nan );
+    std::fill( Cs, Cs + size_C*sc,  nan );
+    for (size_t i = 0; i < size_A; ++i)
+        As[ i*sab ] = A[ i ];
+    for (size_t i = 0; i < size_B; ++i)
+        Bs[ i*sab ] = B[ i ];
+    for (size_t i = 0; i < size_C; ++i)
+        Cs[ i*sc ] = C[ i ];
+
+    // strides of op(A), op(B), C in the compact matrices
+    bool col_major = (layout == Layout::ColMajor);
+    int64_t rsa = ((transA == Op::NoTrans) == col_major ? 1 : lda);
+    int64_t csa = ((transA == Op::NoTrans) == col_major ? lda : 1);
+    int64_t rsb = ((transB == Op::NoTrans) == col_major ? 1 : ldb);
+    int64_t csb = ((transB == Op::NoTrans) == col_major ? ldb : 1);
+    int64_t rsc = (col_major ? 1 : ldc);
+    int64_t csc = (col_major ? ldc : 1);
+
+    // norms for error check
+    real_t work[1];
+    real_t Anorm = lapack_lange( "f", Am, An, A, lda, work );
+    real_t Bnorm = lapack_lange( "f", Bm, Bn, B, ldb, work );
+    real_t Cnorm = lapack_lange( "f", Cm, Cn, C, ldc, work );
+
+    // test error exits
+    assert_throw( blas::gemm( -1,  n,  k, alpha, As, rsa, csa, Bs, rsb, csb, beta, Cs, rsc, csc ), blas::Error );
+    assert_throw( blas::gemm(  m, -1,  k, alpha, As, rsa, csa, Bs, rsb, csb, beta, Cs, rsc, csc ), blas::Error );
+    assert_throw( blas::gemm(  m,  n, -1, alpha, As, rsa, csa, Bs, rsb, csb, beta, Cs, rsc, csc ), blas::Error );
+    assert_throw( blas::gemm(  2,  n,  k, alpha, As, rsa, csa, Bs, rsb, csb, beta, Cs,   0, csc ), blas::Error );
+    assert_throw( blas::gemm(  m,  2,  k, alpha, As, rsa, csa, Bs, rsb, csb, beta, Cs, rsc,   0 ), blas::Error );
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A rs=%5lld, cs=%5lld, size=%10lld, norm %.2e\n"
+                "B rs=%5lld, cs=%5lld, size=%10lld, norm %.2e\n"
+                "C rs=%5lld, cs=%5lld, size=%10lld, norm %.2e\n",
+                (lld) (rsa*sab), (lld) (csa*sab), (lld) (size_A*sab), Anorm,
+                (lld) (rsb*sab), (lld) (csb*sab), (lld) (size_B*sab), Bnorm,
+                (lld) (rsc*sc),  (lld) (csc*sc),  (lld) (size_C*sc),  Cnorm );
+    }
+    if (verbose >= 2) {
+        printf( "alpha = %.4e + %.4ei; beta = %.4e + %.4ei;\n",
+                real(alpha), imag(alpha),
+                real(beta),  imag(beta) );
+        printf( "A = "    ); print_matrix( Am, An, A, lda );
+        printf( "B = "    ); print_matrix( Bm, Bn, B, ldb );
+        printf( "C = "    ); print_matrix( Cm, Cn, C, ldc );
+    }
+
+    // run test
+    testsweeper::flush_cache( params.cache() );
+    double time = get_wtime();
+    blas::gemm( m, n, k,
+                alpha, As, rsa*sab, csa*sab,
+                       Bs, rsb*sab, csb*sab,
+                beta,  Cs, rsc*sc,  csc*sc );
+    time = get_wtime() - time;
+
+    double gflop = Gflop < T >::gemm( m, n, k );
+    params.time()   = time;
+    params.gflops() = gflop / time;
+
+    // gather result
+    for (size_t i = 0; i < size_C; ++i)
+        C[ i ] = Cs[ i*sc ];
+
+    if (verbose >= 2) {
+        printf( "C2 = " ); print_matrix( Cm, Cn, C, ldc );
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // run reference
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        cblas_gemm( cblas_layout_const(layout),
+                    cblas_trans_const(transA),
+                    cblas_trans_const(transB),
+                    m, n, k, alpha, A, lda, B, ldb, beta, Cref, ldc );
+        time = get_wtime() - time;
+
+        params.ref_time()   = time;
+        params.ref_gflops() = gflop / time;
+
+        if (verbose >= 2) {
+            printf( "Cref = " ); print_matrix( Cm, Cn, Cref, ldc );
+        }
+
+        // check error compared to reference
+        real_t error;
+        bool okay;
+        check_gemm( Cm, Cn, k, alpha, beta, Anorm, Bnorm, Cnorm,
+                    Cref, ldc, C, ldc, verbose, &error, &okay );
+        params.error() = error;
+        params.okay() = okay;
+    }
+
+    delete[] A;
+    delete[] B;
+    delete[] C;
+    delete[] Cref;
+    delete[] As;
+    delete[] Bs;
+    delete[] Cs;
+}
+
+// -----------------------------------------------------------------------------
+void test_gemm_strided( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_gemm_strided_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_gemm_strided_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_gemm_strided_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_gemm_strided_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
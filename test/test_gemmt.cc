@@ -0,0 +1,215 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "cblas.hh"
+#include "lapack_wrappers.hh"
+#include "blas/flops.hh"
+#include "print_matrix.hh"
+#include "check_gemm.hh"
+
+// -----------------------------------------------------------------------------
+// Tests gemmt against cblas gemm, which computes all of C, so Ref. Gflop/s
+// is the effective rate for the triangle. Checks that the other triangle
+// of C is unchanged.
+template< typename T >
+void test_gemmt_work( Params& params, bool run )
+{
+    using namespace testsweeper;
+    using namespace blas;
+    typedef real_type<T> real_t;
+    typedef long long lld;
+
+    // get & mark input values
+    blas::Layout layout = params.layout();
+    blas::Uplo uplo = params.uplo();
+    blas::Op transA = params.transA();
+    blas::Op transB = params.transB();
+    T alpha         = params.alpha();
+    T beta          = params.beta();
+    int64_t n       = params.dim.n();
+    int64_t k       = params.dim.k();
+    int64_t align   = params.align();
+    int64_t verbose = params.verbose();
+
+    // mark non-standard output values
+    params.gflops();
+    params.gbytes();
+    params.ref_time();
+    params.ref_gflops();
+    params.ref_gbytes();
+
+    if (! run)
+        return;
+
+    // setup
+    int64_t Am = (transA == Op::NoTrans ? n : k);
+    int64_t An = (transA == Op::NoTrans ? k : n);
+    int64_t Bm = (transB == Op::NoTrans ? k : n);
+    int64_t Bn = (transB == Op::NoTrans ? n : k);
+    if (layout == Layout::RowMajor) {
+        std::swap( Am, An );
+        std::swap( Bm, Bn );
+    }
+    int64_t lda = roundup( Am, align );
+    int64_t ldb = roundup( Bm, align );
+    int64_t ldc = roundup(  n, align );
+    size_t size_A = size_t(lda)*An;
+    size_t size_B = size_t(ldb)*Bn;
+    size_t size_C = size_t(ldc)*n;
+    T* A    = new T[ size_A ];
+    T* B    = new T[ size_B ];
+    T* C    = new T[ size_C ];
+    T* Cref = new T[ size_C ];
+    T* C0   = new T[ size_C ];
+
+    int64_t idist = 1;
+    int iseed[4] = { 0, 0, 0, 1 };
+    lapack_larnv( idist, iseed, size_A, A );
+    lapack_larnv( idist, iseed, size_B, B );
+    lapack_larnv( idist, iseed, size_C, C );
+    lapack_lacpy( "g", n, n, C, ldc, Cref, ldc );
+    lapack_lacpy( "g", n, n, C, ldc, C0, ldc );
+
+    // triangle of C in column-major terms, for checks
+    blas::Uplo uplo_cm = uplo;
+    if (layout == Layout::RowMajor)
+        uplo_cm = (uplo == Uplo::Lower ? Uplo::Upper : Uplo::Lower);
+
+    // norms for error check
+    real_t work[1];
+    real_t Anorm = lapack_lange( "f", Am, An, A, lda, work );
+    real_t Bnorm = lapack_lange( "f", Bm, Bn, B, ldb, work );
+    real_t Cnorm = lapack_lansy( "f", uplo2str(uplo_cm), n, C, ldc, work );
+
+    // test error exits
+    assert_throw( blas::gemmt( Layout(0), uplo,    transA, transB,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( blas::gemmt( layout,    Uplo(0), transA, transB,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( blas::gemmt( layout,    uplo,    Op(0),  transB,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( blas::gemmt( layout,    uplo,    transA, Op(0),   n,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( blas::gemmt( layout,    uplo,    transA, transB, -1,  k, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( blas::gemmt( layout,    uplo,    transA, transB,  n, -1, alpha, A, lda, B, ldb, beta, C, ldc ), blas::Error );
+
+    assert_throw( blas::gemmt( Layout::ColMajor, uplo, Op::NoTrans, Op::NoTrans, n, k, alpha, A, n-1, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( blas::gemmt( Layout::ColMajor, uplo, Op::Trans,   Op::NoTrans, n, k, alpha, A, k-1, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( blas::gemmt( Layout::RowMajor, uplo, Op::NoTrans, Op::NoTrans, n, k, alpha, A, k-1, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( blas::gemmt( Layout::RowMajor, uplo, Op::Trans,   Op::NoTrans, n, k, alpha, A, n-1, B, ldb, beta, C, ldc ), blas::Error );
+
+    assert_throw( blas::gemmt( Layout::ColMajor, uplo, Op::NoTrans, Op::NoTrans, n, k, alpha, A, lda, B, k-1, beta, C, ldc ), blas::Error );
+    assert_throw( blas::gemmt( Layout::ColMajor, uplo, Op::NoTrans, Op::Trans,   n, k, alpha, A, lda, B, n-1, beta, C, ldc ), blas::Error );
+    assert_throw( blas::gemmt( Layout::RowMajor, uplo, Op::NoTrans, Op::NoTrans, n, k, alpha, A, lda, B, n-1, beta, C, ldc ), blas::Error );
+    assert_throw( blas::gemmt( Layout::RowMajor, uplo, Op::NoTrans, Op::Trans,   n, k, alpha, A, lda, B, k-1, beta, C, ldc ), blas::Error );
+
+    assert_throw( blas::gemmt( layout,    uplo,    transA, transB,  n,  k, alpha, A, lda, B, ldb, beta, C, n-1 ), blas::Error );
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "layout %c, uplo %c, transA %c, transB %c\n"
+                "A Am=%5lld, An=%5lld, lda=%5lld, size=%10lld, norm %.2e\n"
+                "B Bm=%5lld, Bn=%5lld, ldb=%5lld, size=%10lld, norm %.2e\n"
+                "C  n=%5lld,  n=%5lld, ldc=%5lld, size=%10lld, norm %.2e\n",
+                layout2char(layout), uplo2char(uplo),
+                op2char(transA), op2char(transB),
+                (lld) Am, (lld) An, (lld) lda, (lld) size_A, Anorm,
+                (lld) Bm, (lld) Bn, (lld) ldb, (lld) size_B, Bnorm,
+                (lld)  n, (lld)  n, (lld) ldc, (lld) size_C, Cnorm );
+    }
+    if (verbose >= 2) {
+        printf( "alpha = %.4e + %.4ei; beta = %.4e + %.4ei;\n",
+                real(alpha), imag(alpha),
+                real(beta),  imag(beta) );
+        printf( "A = "    ); print_matrix( Am, An, A, lda );
+        printf( "B = "    ); print_matrix( Bm, Bn, B, ldb );
+        printf( "C = "    ); print_matrix(  n,  n, C, ldc );
+    }
+
+    // run test
+    testsweeper::flush_cache( params.cache() );
+    double time = get_wtime();
+    blas::gemmt( layout, uplo, transA, transB, n, k,
+                 alpha, A, lda, B, ldb, beta, C, ldc );
+    time = get_wtime() - time;
+
+    double gflop = Gflop < T >::gemmt( n, k );
+    double gbyte = Gbyte < T >::gemmt( n, k );
+    params.time()   = time;
+    params.gflops() = gflop / time;
+    params.gbytes() = gbyte / time;
+
+    if (verbose >= 2) {
+        printf( "C2 = " ); print_matrix( n, n, C, ldc );
+    }
+
+    // other triangle must be unchanged
+    bool untouched = true;
+    for (int64_t j = 0; j < n; ++j) {
+        int64_t i0 = (uplo_cm == Uplo::Lower ? 0 : j + 1);
+        int64_t i1 = (uplo_cm == Uplo::Lower ? j : n);
+        for (int64_t i = i0; i < i1; ++i)
+            untouched &= (C[ i + j*ldc ] == C0[ i + j*ldc ]);
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // run reference
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        cblas_gemm( cblas_layout_const(layout),
+                    cblas_trans_const(transA),
+                    cblas_trans_const(transB),
+                    n, n, k, alpha, A, lda, B, ldb, beta, Cref, ldc );
+        time = get_wtime() - time;
+
+        params.ref_time()   = time;
+        params.ref_gflops() = gflop / time;
+        params.ref_gbytes() = Gbyte < T >::gemm( n, n, k ) / time;
+
+        if (verbose >= 2) {
+            printf( "Cref = " ); print_matrix( n, n, Cref, ldc );
+        }
+
+        // check error compared to reference
+        real_t error;
+        bool okay;
+        check_herk( uplo_cm, n, k, alpha, beta, Anorm, Bnorm, Cnorm,
+                    Cref, ldc, C, ldc, verbose, &error, &okay );
+        params.error() = error;
+        params.okay() = okay && untouched;
+    }
+    else {
+        params.okay() = untouched;
+    }
+
+    delete[] A;
+    delete[] B;
+    delete[] C;
+    delete[] Cref;
+    delete[] C0;
+}
+
+// -----------------------------------------------------------------------------
+void test_gemmt( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_gemmt_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_gemmt_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_gemmt_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_gemmt_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
@@ -0,0 +1,202 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "cblas.hh"
+#include "lapack_wrappers.hh"
+#include "blas/flops.hh"
+#include "print_matrix.hh"
+#include "check_gemm.hh"
+
+// -----------------------------------------------------------------------------
+// Tests gemv with half precision A, x, accumulating in float, for both
+// half precision y and float y. The reference is sgemv on the same inputs,
+// converted exactly to float. See test_gemm_half.cc.
+// Ignores --type.
+template< typename T >
+void test_gemv_half_work( Params& params, bool run )
+{
+    using namespace testsweeper;
+    using namespace blas;
+    typedef long long lld;
+
+    // get & mark input values
+    blas::Layout layout = params.layout();
+    blas::Op trans  = params.trans();
+    float alpha     = params.alpha();
+    float beta      = params.beta();
+    int64_t m       = params.dim.m();
+    int64_t n       = params.dim.n();
+    int64_t incx    = params.incx();
+    int64_t incy    = params.incy();
+    int64_t align   = params.align();
+    int64_t verbose = params.verbose();
+
+    // mark non-standard output values
+    params.gflops();
+    params.gbytes();
+    params.ref_time();
+    params.ref_gflops();
+    params.ref_gbytes();
+
+    // adjust header to msec
+    params.time.name( "BLAS++\ntime (ms)" );
+    params.ref_time.name( "Ref.\ntime (ms)" );
+
+    if (! run)
+        return;
+
+    // setup
+    int64_t Am = (layout == Layout::ColMajor ? m : n);
+    int64_t An = (layout == Layout::ColMajor ? n : m);
+    int64_t lda = roundup( Am, align );
+    int64_t Xm = (trans == Op::NoTrans ? n : m);
+    int64_t Ym = (trans == Op::NoTrans ? m : n);
+    size_t size_A = size_t(lda)*An;
+    size_t size_x = (Xm - 1) * std::abs(incx) + 1;
+    size_t size_y = (Ym - 1) * std::abs(incy) + 1;
+    T* A        = new T[ size_A ];
+    T* x        = new T[ size_x ];
+    T* y        = new T[ size_y ];
+    float* Af   = new float[ size_A ];
+    float* xf   = new float[ size_x ];
+    float* yf   = new float[ size_y ];
+    float* yref = new float[ size_y ];
+    float* yout = new float[ size_y ];
+
+    // generate in float, round to T, then convert back so reference
+    // has exactly the same inputs
+    int64_t idist = 1;
+    int iseed[4] = { 0, 0, 0, 1 };
+    lapack_larnv( idist, iseed, size_A, Af );
+    lapack_larnv( idist, iseed, size_x, xf );
+    lapack_larnv( idist, iseed, size_y, yf );
+    for (size_t i = 0; i < size_A; ++i) {
+        A[ i ] = Af[ i ];
+        Af[ i ] = A[ i ];
+    }
+    for (size_t i = 0; i < size_x; ++i) {
+        x[ i ] = xf[ i ];
+        xf[ i ] = x[ i ];
+    }
+    for (size_t i = 0; i < size_y; ++i) {
+        y[ i ] = yf[ i ];
+        yf[ i ] = y[ i ];
+    }
+    cblas_copy( Ym, yf, incy, yref, incy );
+
+    // norms for error check
+    float work[1];
+    float Anorm = lapack_lange( "f", Am, An, Af, lda, work );
+    float Xnorm = cblas_nrm2( Xm, xf, std::abs(incx) );
+    float Ynorm = cblas_nrm2( Ym, yf, std::abs(incy) );
+
+    // test error exits
+    assert_throw( blas::gemv( Layout(0), trans,  m,  n, alpha, A, lda, x, incx, beta, y, incy ), blas::Error );
+    assert_throw( blas::gemv( layout,    Op(0),  m,  n, alpha, A, lda, x, incx, beta, y, incy ), blas::Error );
+    assert_throw( blas::gemv( layout,    trans, -1,  n, alpha, A, lda, x, incx, beta, y, incy ), blas::Error );
+    assert_throw( blas::gemv( layout,    trans,  m, -1, alpha, A, lda, x, incx, beta, y, incy ), blas::Error );
+
+    assert_throw( blas::gemv( Layout::ColMajor, trans,  m,  n, alpha, A, m-1, x, incx, beta, y, incy ), blas::Error );
+    assert_throw( blas::gemv( Layout::RowMajor, trans,  m,  n, alpha, A, n-1, x, incx, beta, y, incy ), blas::Error );
+
+    assert_throw( blas::gemv( layout,    trans,  m,  n, alpha, A, lda, x, 0,    beta, y, incy ), blas::Error );
+    assert_throw( blas::gemv( layout,    trans,  m,  n, alpha, A, lda, x, incx, beta, y, 0    ), blas::Error );
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A Am=%5lld, An=%5lld, lda=%5lld, size=%10lld, norm=%.2e\n"
+                "x Xm=%5lld, inc=%5lld,           size=%10lld, norm=%.2e\n"
+                "y Ym=%5lld, inc=%5lld,           size=%10lld, norm=%.2e\n",
+                (lld) Am, (lld) An, (lld) lda, (lld) size_A, Anorm,
+                (lld) Xm, (lld) incx,          (lld) size_x, Xnorm,
+                (lld) Ym, (lld) incy,          (lld) size_y, Ynorm );
+    }
+    if (verbose >= 2) {
+        printf( "alpha = %.4e; beta = %.4e;\n", alpha, beta );
+        printf( "A = "    ); print_matrix( m, n, Af, lda );
+        printf( "x    = " ); print_vector( Xm, xf, incx );
+        printf( "y    = " ); print_vector( Ym, yf, incy );
+    }
+
+    // run test
+    testsweeper::flush_cache( params.cache() );
+    double time = get_wtime();
+    blas::gemv( layout, trans, m, n, alpha, A, lda, x, incx, beta, y, incy );
+    time = get_wtime() - time;
+
+    double gflop = Gflop< T >::gemv( m, n );
+    double gbyte = Gbyte< T >::gemv( m, n );
+    params.time()   = time * 1000;  // msec
+    params.gflops() = gflop / time;
+    params.gbytes() = gbyte / time;
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // half A, x with float y, in yf
+        blas::gemv( layout, trans, m, n, alpha, A, lda, x, incx, beta, yf, incy );
+
+        // run reference
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        cblas_gemv( cblas_layout_const(layout), cblas_trans_const(trans), m, n,
+                    alpha, Af, lda, xf, incx, beta, yref, incy );
+        time = get_wtime() - time;
+
+        params.ref_time()   = time * 1000;  // msec
+        params.ref_gflops() = gflop / time;
+        params.ref_gbytes() = gbyte / time;
+
+        if (verbose >= 2) {
+            printf( "yref = " ); print_vector( Ym, yref, incy );
+        }
+
+        // check error compared to reference
+        // treat y as 1 x Ym matrix with ld = incy; k = Xm is reduction dimension
+        // half y: rounded once to T
+        for (size_t i = 0; i < size_y; ++i)
+            yout[ i ] = y[ i ];
+        float error_half, error_float;
+        bool okay;
+        check_gemm( 1, Ym, Xm, alpha, beta, Anorm, Xnorm, Ynorm,
+                    yref, std::abs(incy), yout, std::abs(incy), verbose,
+                    &error_half, &okay );
+        float u_half = 0.5f * float( std::numeric_limits< T >::epsilon() );
+        bool okay_half = (error_half < u_half);
+
+        // float y
+        check_gemm( 1, Ym, Xm, alpha, beta, Anorm, Xnorm, Ynorm,
+                    yref, std::abs(incy), yf, std::abs(incy), verbose,
+                    &error_float, &okay );
+        bool okay_float = okay;
+
+        if (verbose >= 1) {
+            printf( "error half y %.2e (u %.2e), float y %.2e\n",
+                    error_half, u_half, error_float );
+        }
+        params.error() = error_half;
+        params.okay() = okay_half && okay_float;
+    }
+
+    delete[] A;
+    delete[] x;
+    delete[] y;
+    delete[] Af;
+    delete[] xf;
+    delete[] yf;
+    delete[] yref;
+    delete[] yout;
+}
+
+// -----------------------------------------------------------------------------
+void test_gemv_fp16( Params& params, bool run )
+{
+    test_gemv_half_work< blas::float16 >( params, run );
+}
+
+// -----------------------------------------------------------------------------
+void test_gemv_bf16( Params& params, bool run )
+{
+    test_gemv_half_work< blas::bfloat16 >( params, run );
+}
@@ -0,0 +1,198 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "cblas.hh"
+#include "lapack_wrappers.hh"
+#include "blas/flops.hh"
+#include "print_matrix.hh"
+
+#include <limits>
+
+// -----------------------------------------------------------------------------
+// Tests gemv with 8-bit integer A, x, accumulating in int32, for both
+// int32 y and dequantized float y with a scale per entry.
+// The reference is dgemv on the same inputs converted to double; see
+// test_gemm_int8.cc.
+// TX is int8_t or uint8_t; A is int8_t. Ignores --type.
+template< typename TX >
+void test_gemv_int8_work( Params& params, bool run )
+{
+    using namespace testsweeper;
+    using namespace blas;
+    typedef long long lld;
+
+    // get & mark input values
+    blas::Layout layout = params.layout();
+    blas::Op trans  = params.trans();
+    int32_t alpha   = int32_t( params.alpha() );
+    int32_t beta    = int32_t( params.beta() );
+    int64_t m       = params.dim.m();
+    int64_t n       = params.dim.n();
+    int64_t incx    = params.incx();
+    int64_t incy    = params.incy();
+    int64_t align   = params.align();
+    int64_t verbose = params.verbose();
+
+    // mark non-standard output values
+    params.gflops();
+    params.ref_time();
+    params.ref_gflops();
+
+    // adjust header to msec
+    params.time.name( "BLAS++\ntime (ms)" );
+    params.ref_time.name( "Ref.\ntime (ms)" );
+
+    if (! run)
+        return;
+
+    // setup
+    int64_t Am = (layout == Layout::ColMajor ? m : n);
+    int64_t An = (layout == Layout::ColMajor ? n : m);
+    int64_t lda = roundup( Am, align );
+    int64_t Xm = (trans == Op::NoTrans ? n : m);
+    int64_t Ym = (trans == Op::NoTrans ? m : n);
+    size_t size_A = size_t(lda)*An;
+    size_t size_x = (Xm - 1) * std::abs(incx) + 1;
+    size_t size_y = (Ym - 1) * std::abs(incy) + 1;
+    int8_t*  A     = new int8_t[ size_A ];
+    TX*      x     = new TX[ size_x ];
+    int32_t* y     = new int32_t[ size_y ];
+    float*   yf    = new float[ size_y ];
+    double*  Ad    = new double[ size_A ];
+    double*  xd    = new double[ size_x ];
+    double*  yref  = new double[ size_y ];
+    double*  yin   = new double[ size_y ];
+    float*   scale = new float[ Ym ];
+
+    // generate uniform integers in the range of each type
+    int64_t idist = 1;
+    int iseed[4] = { 0, 0, 0, 1 };
+    double xmin = std::numeric_limits< TX >::min();
+    double xrange = std::numeric_limits< TX >::max() - xmin + 1;
+    lapack_larnv( idist, iseed, size_A, Ad );
+    lapack_larnv( idist, iseed, size_x, xd );
+    lapack_larnv( idist, iseed, size_y, yin );
+    for (size_t i = 0; i < size_A; ++i) {
+        A[ i ] = int8_t( std::floor( -128 + 256 * Ad[ i ] ) );
+        Ad[ i ] = A[ i ];
+    }
+    for (size_t i = 0; i < size_x; ++i) {
+        x[ i ] = TX( std::floor( xmin + xrange * xd[ i ] ) );
+        xd[ i ] = x[ i ];
+    }
+    for (size_t i = 0; i < size_y; ++i) {
+        y[ i ] = int32_t( std::floor( -1000 + 2000 * yin[ i ] ) );
+        yf[ i ] = y[ i ];
+        yin[ i ] = y[ i ];
+    }
+    for (int64_t i = 0; i < Ym; ++i)
+        scale[ i ] = 0.5f + float( i % 7 ) / 8;
+
+    // test error exits
+    assert_throw( blas::gemv( Layout(0), trans,  m,  n, alpha, A, lda, x, incx, beta, y, incy ), blas::Error );
+    assert_throw( blas::gemv( layout,    Op(0),  m,  n, alpha, A, lda, x, incx, beta, y, incy ), blas::Error );
+    assert_throw( blas::gemv( layout,    trans, -1,  n, alpha, A, lda, x, incx, beta, y, incy ), blas::Error );
+    assert_throw( blas::gemv( layout,    trans,  m, -1, alpha, A, lda, x, incx, beta, y, incy ), blas::Error );
+
+    assert_throw( blas::gemv( Layout::ColMajor, trans,  m,  n, alpha, A, m-1, x, incx, beta, y, incy ), blas::Error );
+    assert_throw( blas::gemv( Layout::RowMajor, trans,  m,  n, alpha, A, n-1, x, incx, beta, y, incy ), blas::Error );
+
+    assert_throw( blas::gemv( layout,    trans,  m,  n, alpha, A, lda, x, 0,    beta, y, incy ), blas::Error );
+    assert_throw( blas::gemv( layout,    trans,  m,  n, alpha, A, lda, x, incx, beta, y, 0    ), blas::Error );
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A Am=%5lld, An=%5lld, lda=%5lld, size=%10lld\n"
+                "x Xm=%5lld, inc=%5lld,           size=%10lld\n"
+                "y Ym=%5lld, inc=%5lld,           size=%10lld\n",
+                (lld) Am, (lld) An, (lld) lda, (lld) size_A,
+                (lld) Xm, (lld) incx,          (lld) size_x,
+                (lld) Ym, (lld) incy,          (lld) size_y );
+    }
+    if (verbose >= 2) {
+        printf( "alpha = %d; beta = %d;\n", alpha, beta );
+        printf( "A = "    ); print_matrix( Am, An, Ad, lda );
+        printf( "x    = " ); print_vector( Xm, xd, incx );
+        printf( "y    = " ); print_vector( Ym, yin, incy );
+    }
+
+    // run test
+    testsweeper::flush_cache( params.cache() );
+    double time = get_wtime();
+    blas::gemv( layout, trans, m, n, alpha, A, lda, x, incx, beta, y, incy );
+    time = get_wtime() - time;
+
+    double gflop = Gflop< int8_t >::gemv( m, n );
+    params.time()   = time * 1000;  // msec
+    params.gflops() = gflop / time;
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // dequantized float y, in yf
+        float falpha = params.alpha();
+        float fbeta  = params.beta();
+        blas::gemv( layout, trans, m, n, falpha, A, lda, x, incx,
+                    fbeta, yf, incy, scale );
+
+        // run reference, yref = A x
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        cblas_gemv( cblas_layout_const(layout), cblas_trans_const(trans), m, n,
+                    1.0, Ad, lda, xd, incx, 0.0, yref, incy );
+        time = get_wtime() - time;
+
+        params.ref_time()   = time * 1000;  // msec
+        params.ref_gflops() = gflop / time;
+
+        // int32 y must be exact; float y is compared entry-wise,
+        // relative to the magnitude of its terms.
+        double error_int = 0, error_float = 0;
+        int64_t ky = (incy > 0 ? 0 : (-Ym + 1)*incy);
+        for (int64_t i = 0; i < Ym; ++i) {
+            int64_t ii = ky + i*incy;
+            double ax = yref[ ii ];
+            double yint = alpha*ax + beta*yin[ ii ];
+            error_int = std::max( error_int, std::abs( y[ ii ] - yint ) );
+
+            double s = double( falpha ) * scale[ i ];
+            double yflt = s*ax + fbeta*yin[ ii ];
+            double ymag = std::abs( s*ax ) + std::abs( fbeta*yin[ ii ] );
+            if (ymag > 0) {
+                error_float = std::max( error_float,
+                                        std::abs( yf[ ii ] - yflt ) / ymag );
+            }
+        }
+
+        if (verbose >= 1) {
+            printf( "error int32 y %.2e, float y %.2e\n",
+                    error_int, error_float );
+        }
+        double eps = std::numeric_limits< float >::epsilon();
+        params.error() = error_float;
+        params.okay() = (error_int == 0 && error_float < 4*eps);
+    }
+
+    delete[] A;
+    delete[] x;
+    delete[] y;
+    delete[] yf;
+    delete[] Ad;
+    delete[] xd;
+    delete[] yref;
+    delete[] yin;
+    delete[] scale;
+}
+
+// -----------------------------------------------------------------------------
+void test_gemv_s8( Params& params, bool run )
+{
+    test_gemv_int8_work< int8_t >( params, run );
+}
+
+// -----------------------------------------------------------------------------
+void test_gemv_u8( Params& params, bool run )
+{
+    test_gemv_int8_work< uint8_t >( params, run );
+}
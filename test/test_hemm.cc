@@ -33,8 +33,10 @@ void test_hemm_work( Params& params, bool run )
 
     // mark non-standard output values
     params.gflops();
+    params.gbytes();
     params.ref_time();
     params.ref_gflops();
+    params.ref_gbytes();
 
     if (! run)
         return;
@@ -113,8 +115,10 @@ void test_hemm_work( Params& params, bool run )
     time = get_wtime() - time;
 
     double gflop = Gflop < scalar_t >::hemm( side, m, n );
+    double gbyte = Gbyte < scalar_t >::hemm( side, m, n );
     params.time()   = time;
     params.gflops() = gflop / time;
+    params.gbytes() = gbyte / time;
 
     if (verbose >= 2) {
         printf( "C2 = " ); print_matrix( Cm, Cn, C, ldc );
@@ -132,6 +136,7 @@ void test_hemm_work( Params& params, bool run )
 
         params.ref_time()   = time;
         params.ref_gflops() = gflop / time;
+        params.ref_gbytes() = gbyte / time;
 
         if (verbose >= 2) {
             printf( "Cref = " ); print_matrix( Cm, Cn, Cref, ldc );
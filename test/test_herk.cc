@@ -33,8 +33,10 @@ void test_herk_work( Params& params, bool run )
 
     // mark non-standard output values
     params.gflops();
+    params.gbytes();
     params.ref_time();
     params.ref_gflops();
+    params.ref_gbytes();
 
     if (! run)
         return;
@@ -103,8 +105,10 @@ void test_herk_work( Params& params, bool run )
     time = get_wtime() - time;
 
     double gflop = Gflop < scalar_t >::herk( n, k );
+    double gbyte = Gbyte < scalar_t >::herk( n, k );
     params.time()   = time;
     params.gflops() = gflop / time;
+    params.gbytes() = gbyte / time;
 
     if (verbose >= 2) {
         printf( "C2 = " ); print_matrix( n, n, C, ldc );
@@ -122,6 +126,7 @@ void test_herk_work( Params& params, bool run )
 
         params.ref_time()   = time;
         params.ref_gflops() = gflop / time;
+        params.ref_gbytes() = gbyte / time;
 
         if (verbose >= 2) {
             printf( "Cref = " ); print_matrix( n, n, Cref, ldc );
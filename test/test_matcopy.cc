@@ -0,0 +1,200 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "cblas.hh"
+#include "lapack_wrappers.hh"
+#include "blas/flops.hh"
+#include "print_matrix.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Reference B = alpha op(A), column-major, one entry at a time;
+// for RowMajor, the caller swaps m and n.
+template< typename T >
+void matcopy_ref(
+    blas::Op trans, int64_t m, int64_t n, T alpha,
+    T const* A, int64_t lda, T* B, int64_t ldb )
+{
+    using blas::conj;
+    for (int64_t j = 0; j < n; ++j) {
+        for (int64_t i = 0; i < m; ++i) {
+            T a = A[ i + j*lda ];
+            if (trans == blas::Op::NoTrans)
+                B[ i + j*ldb ] = alpha * a;
+            else if (trans == blas::Op::Trans)
+                B[ j + i*ldb ] = alpha * a;
+            else
+                B[ j + i*ldb ] = alpha * conj( a );
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Tests omatcopy (inplace = false) or imatcopy (inplace = true) against
+// matcopy_ref. Results should be exact; error is max | B - Bref | relative
+// to | alpha | max | A |.
+template< typename T >
+void test_matcopy_work( Params& params, bool run, bool inplace )
+{
+    using namespace testsweeper;
+    using namespace blas;
+    typedef real_type<T> real_t;
+    typedef long long lld;
+
+    // get & mark input values
+    blas::Layout layout = params.layout();
+    blas::Op trans  = params.trans();
+    T alpha         = params.alpha();
+    int64_t m       = params.dim.m();
+    int64_t n       = params.dim.n();
+    int64_t align   = params.align();
+    int64_t verbose = params.verbose();
+
+    // mark non-standard output values
+    params.gbytes();
+    params.ref_time();
+    params.ref_gbytes();
+
+    if (! run)
+        return;
+
+    // setup: A is m-by-n, B = op(A) is Bm-by-Bn, in layout;
+    // column-major dimensions, swapped for RowMajor
+    int64_t Bm = (trans == Op::NoTrans ? m : n);
+    int64_t Bn = (trans == Op::NoTrans ? n : m);
+    int64_t Am_ = m, An_ = n, Bm_ = Bm, Bn_ = Bn;
+    if (layout == Layout::RowMajor) {
+        std::swap( Am_, An_ );
+        std::swap( Bm_, Bn_ );
+    }
+    int64_t lda = roundup( Am_, align );
+    int64_t ldb = roundup( Bm_, align );
+    size_t size_A = size_t(lda)*An_;
+    size_t size_B = size_t(ldb)*Bn_;
+    size_t size   = (inplace ? std::max( size_A, size_B ) : size_B);
+    T* A    = new T[ size_A ];
+    T* B    = new T[ size ];
+    T* Bref = new T[ size_B ];
+
+    int64_t idist = 1;
+    int iseed[4] = { 0, 0, 0, 1 };
+    lapack_larnv( idist, iseed, size_A, A );
+    lapack_larnv( idist, iseed, size, B );
+    lapack_lacpy( "g", Bm_, Bn_, B, ldb, Bref, ldb );
+    if (inplace)
+        lapack_lacpy( "g", Am_, An_, A, lda, B, lda );
+
+    // norms for error check
+    real_t work[1];
+    real_t Anorm = lapack_lange( "m", Am_, An_, A, lda, work );
+
+    // test error exits
+    assert_throw( blas::omatcopy( Layout(0), trans,  m,  n, alpha, A, lda, Bref, ldb ), blas::Error );
+    assert_throw( blas::omatcopy( layout,    Op(0),  m,  n, alpha, A, lda, Bref, ldb ), blas::Error );
+    assert_throw( blas::omatcopy( layout,    trans, -1,  n, alpha, A, lda, Bref, ldb ), blas::Error );
+    assert_throw( blas::omatcopy( layout,    trans,  m, -1, alpha, A, lda, Bref, ldb ), blas::Error );
+    assert_throw( blas::omatcopy( layout,    trans,  m,  n, alpha, A, Am_-1, Bref, ldb ), blas::Error );
+    assert_throw( blas::omatcopy( layout,    trans,  m,  n, alpha, A, lda, Bref, Bm_-1 ), blas::Error );
+    assert_throw( blas::imatcopy( layout,    trans,  m,  n, alpha, A, Am_-1, ldb ), blas::Error );
+    assert_throw( blas::imatcopy( layout,    trans,  m,  n, alpha, A, lda, Bm_-1 ), blas::Error );
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A Am=%5lld, An=%5lld, lda=%5lld, size=%10lld, norm %.2e\n"
+                "B Bm=%5lld, Bn=%5lld, ldb=%5lld, size=%10lld\n",
+                (lld) Am_, (lld) An_, (lld) lda, (lld) size_A, Anorm,
+                (lld) Bm_, (lld) Bn_, (lld) ldb, (lld) size_B );
+    }
+    if (verbose >= 2) {
+        printf( "A = " ); print_matrix( Am_, An_, A, lda );
+    }
+
+    // run test
+    testsweeper::flush_cache( params.cache() );
+    double time = get_wtime();
+    if (inplace)
+        blas::imatcopy( layout, trans, m, n, alpha, B, lda, ldb );
+    else
+        blas::omatcopy( layout, trans, m, n, alpha, A, lda, B, ldb );
+    time = get_wtime() - time;
+
+    double gbyte = Gbyte< T >::omatcopy( m, n );
+    params.time()   = time;
+    params.gbytes() = gbyte / time;
+
+    if (verbose >= 2) {
+        printf( "B = " ); print_matrix( Bm_, Bn_, B, ldb );
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // run reference
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        matcopy_ref( trans, Am_, An_, alpha, A, lda, Bref, ldb );
+        time = get_wtime() - time;
+
+        params.ref_time()   = time;
+        params.ref_gbytes() = gbyte / time;
+
+        if (verbose >= 2) {
+            printf( "Bref = " ); print_matrix( Bm_, Bn_, Bref, ldb );
+        }
+
+        // check error compared to reference
+        real_t error = 0;
+        for (int64_t j = 0; j < Bn_; ++j) {
+            for (int64_t i = 0; i < Bm_; ++i)
+                error = std::max( error, std::abs( B[ i + j*ldb ] - Bref[ i + j*ldb ] ) );
+        }
+        if (Anorm != 0 && alpha != T( 0 ))
+            error /= std::abs( alpha ) * Anorm;
+        params.error() = error;
+        params.okay() = (error == 0);
+    }
+
+    delete[] A;
+    delete[] B;
+    delete[] Bref;
+}
+
+// -----------------------------------------------------------------------------
+void test_matcopy( Params& params, bool run, bool inplace )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_matcopy_work< float >( params, run, inplace );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_matcopy_work< double >( params, run, inplace );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_matcopy_work< std::complex<float> >( params, run, inplace );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_matcopy_work< std::complex<double> >( params, run, inplace );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_omatcopy( Params& params, bool run )
+{
+    test_matcopy( params, run, false );
+}
+
+// -----------------------------------------------------------------------------
+void test_imatcopy( Params& params, bool run )
+{
+    test_matcopy( params, run, true );
+}
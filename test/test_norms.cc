@@ -0,0 +1,371 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "cblas.hh"
+#include "lapack_wrappers.hh"
+#include "blas/flops.hh"
+#include "print_matrix.hh"
+
+#include <limits>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Reference norm of one vector x, one call per vector, as in a loop over
+// columns calling blas::nrm2. The 1-norm and max-norm use |x_i|, unlike
+// cblas asum, which uses |Re(x_i)| + |Im(x_i)|.
+template< typename T >
+blas::real_type<T> norm_ref(
+    blas::Norm norm, int64_t len, T const* x, int64_t incx )
+{
+    using blas::real_type;
+    real_type<T> result = 0;
+    if (norm == blas::Norm::Two)
+        return cblas_nrm2( len, x, incx );
+    for (int64_t i = 0; i < len; ++i) {
+        real_type<T> a = std::abs( x[ i*incx ] );
+        if (norm == blas::Norm::One)
+            result += a;
+        else
+            result = std::max( result, a );
+    }
+    return result;
+}
+
+// -----------------------------------------------------------------------------
+// Tests col_norms (cols = true) or row_norms (cols = false) against norm_ref
+// for each column or row. A is scaled by alpha, e.g., --alpha 1e300 to
+// check scaling. Error is max | v - vref | / | vref |, relative to
+// sqrt( len + 2 ), where each vector has len entries.
+template< typename T >
+void test_norms_work( Params& params, bool run, bool cols )
+{
+    using namespace testsweeper;
+    using namespace blas;
+    typedef real_type<T> real_t;
+    typedef long long lld;
+
+    // get & mark input values
+    blas::Layout layout = params.layout();
+    blas::Norm norm = params.norm();
+    real_t alpha    = params.alpha();
+    int64_t m       = params.dim.m();
+    int64_t n       = params.dim.n();
+    int64_t align   = params.align();
+    int64_t verbose = params.verbose();
+
+    // mark non-standard output values
+    params.gbytes();
+    params.ref_time();
+    params.ref_gbytes();
+
+    if (! run)
+        return;
+
+    // setup: A is m-by-n in layout; Am_-by-An_ column-major.
+    // Output vector v is over columns (length m) or rows (length n).
+    int64_t Am_ = m, An_ = n;
+    if (layout == Layout::RowMajor)
+        std::swap( Am_, An_ );
+    int64_t lda = roundup( Am_, align );
+    size_t size_A = size_t(lda)*An_;
+    int64_t nv  = (cols ? n : m);
+    int64_t len = (cols ? m : n);
+    // stride between vectors, and between entries in a vector
+    bool contig = (cols == (layout == Layout::ColMajor));
+    int64_t vinc = (contig ? lda : 1);
+    int64_t inc  = (contig ? 1 : lda);
+    T* A = new T[ size_A ];
+    std::vector<real_t> values( nv ), values_ref( nv );
+
+    int64_t idist = 1;
+    int iseed[4] = { 0, 0, 0, 1 };
+    lapack_larnv( idist, iseed, size_A, A );
+    for (size_t i = 0; i < size_A; ++i)
+        A[ i ] *= alpha;
+
+    // test error exits
+    if (cols) {
+        assert_throw( blas::col_norms( Layout(0), norm,     m,  n, A, lda, values.data() ), blas::Error );
+        assert_throw( blas::col_norms( layout,    Norm(0),  m,  n, A, lda, values.data() ), blas::Error );
+        assert_throw( blas::col_norms( layout,    norm,    -1,  n, A, lda, values.data() ), blas::Error );
+        assert_throw( blas::col_norms( layout,    norm,     m, -1, A, lda, values.data() ), blas::Error );
+        assert_throw( blas::col_norms( layout,    norm,     m,  n, A, Am_-1, values.data() ), blas::Error );
+    }
+    else {
+        assert_throw( blas::row_norms( Layout(0), norm,     m,  n, A, lda, values.data() ), blas::Error );
+        assert_throw( blas::row_norms( layout,    Norm(0),  m,  n, A, lda, values.data() ), blas::Error );
+        assert_throw( blas::row_norms( layout,    norm,    -1,  n, A, lda, values.data() ), blas::Error );
+        assert_throw( blas::row_norms( layout,    norm,     m, -1, A, lda, values.data() ), blas::Error );
+        assert_throw( blas::row_norms( layout,    norm,     m,  n, A, Am_-1, values.data() ), blas::Error );
+    }
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A Am=%5lld, An=%5lld, lda=%5lld, size=%10lld\n",
+                (lld) Am_, (lld) An_, (lld) lda, (lld) size_A );
+    }
+    if (verbose >= 2) {
+        printf( "A = " ); print_matrix( Am_, An_, A, lda );
+    }
+
+    // run test
+    testsweeper::flush_cache( params.cache() );
+    double time = get_wtime();
+    if (cols)
+        blas::col_norms( layout, norm, m, n, A, lda, values.data() );
+    else
+        blas::row_norms( layout, norm, m, n, A, lda, values.data() );
+    time = get_wtime() - time;
+
+    double gbyte = Gbyte< T >::nrm2( double( m )*n );
+    params.time()   = time;
+    params.gbytes() = gbyte / time;
+
+    if (verbose >= 2) {
+        printf( "values = " ); print_vector( nv, values.data(), 1 );
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // run reference, one call per column or row
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        for (int64_t j = 0; j < nv; ++j)
+            values_ref[ j ] = norm_ref( norm, len, &A[ j*vinc ], inc );
+        time = get_wtime() - time;
+
+        params.ref_time()   = time;
+        params.ref_gbytes() = gbyte / time;
+
+        if (verbose >= 2) {
+            printf( "values_ref = " ); print_vector( nv, values_ref.data(), 1 );
+        }
+
+        // check error compared to reference; subnormal norms have
+        // fewer digits, so are compared absolutely
+        const real_t safe_min = std::numeric_limits< real_t >::min();
+        real_t error = 0;
+        for (int64_t j = 0; j < nv; ++j) {
+            real_t err = std::abs( values[ j ] - values_ref[ j ] )
+                       / std::max( values_ref[ j ], safe_min );
+            error = std::max( error, err );
+        }
+        error /= std::sqrt( real_t( len + 2 ) );
+        params.error() = error;
+        real_t eps = std::numeric_limits< real_t >::epsilon();
+        params.okay() = (error < 3*eps);
+    }
+
+    delete[] A;
+}
+
+// -----------------------------------------------------------------------------
+// Tests col_iamax (cols = true) or row_iamax (cols = false) against
+// cblas_iamax for each column or row, then with NaN columns or rows against
+// the first NaN, as in the reference i?amax. Indices must be exact.
+template< typename T >
+void test_norms_iamax_work( Params& params, bool run, bool cols )
+{
+    using namespace testsweeper;
+    using namespace blas;
+    typedef long long lld;
+
+    // get & mark input values
+    blas::Layout layout = params.layout();
+    int64_t m       = params.dim.m();
+    int64_t n       = params.dim.n();
+    int64_t align   = params.align();
+    int64_t verbose = params.verbose();
+
+    // mark non-standard output values
+    params.gbytes();
+    params.ref_time();
+    params.ref_gbytes();
+
+    if (! run)
+        return;
+
+    // setup; see test_norms_work
+    int64_t Am_ = m, An_ = n;
+    if (layout == Layout::RowMajor)
+        std::swap( Am_, An_ );
+    int64_t lda = roundup( Am_, align );
+    size_t size_A = size_t(lda)*An_;
+    int64_t nv  = (cols ? n : m);
+    int64_t len = (cols ? m : n);
+    bool contig = (cols == (layout == Layout::ColMajor));
+    int64_t vinc = (contig ? lda : 1);
+    int64_t inc  = (contig ? 1 : lda);
+    T* A = new T[ size_A ];
+    std::vector<int64_t> indices( nv ), indices_ref( nv );
+
+    int64_t idist = 1;
+    int iseed[4] = { 0, 0, 0, 1 };
+    lapack_larnv( idist, iseed, size_A, A );
+
+    // test error exits
+    if (cols) {
+        assert_throw( blas::col_iamax( Layout(0),  m,  n, A, lda, indices.data() ), blas::Error );
+        assert_throw( blas::col_iamax( layout,    -1,  n, A, lda, indices.data() ), blas::Error );
+        assert_throw( blas::col_iamax( layout,     m, -1, A, lda, indices.data() ), blas::Error );
+        assert_throw( blas::col_iamax( layout,     m,  n, A, Am_-1, indices.data() ), blas::Error );
+    }
+    else {
+        assert_throw( blas::row_iamax( Layout(0),  m,  n, A, lda, indices.data() ), blas::Error );
+        assert_throw( blas::row_iamax( layout,    -1,  n, A, lda, indices.data() ), blas::Error );
+        assert_throw( blas::row_iamax( layout,     m, -1, A, lda, indices.data() ), blas::Error );
+        assert_throw( blas::row_iamax( layout,     m,  n, A, Am_-1, indices.data() ), blas::Error );
+    }
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A Am=%5lld, An=%5lld, lda=%5lld, size=%10lld\n",
+                (lld) Am_, (lld) An_, (lld) lda, (lld) size_A );
+    }
+    if (verbose >= 2) {
+        printf( "A = " ); print_matrix( Am_, An_, A, lda );
+    }
+
+    // run test
+    testsweeper::flush_cache( params.cache() );
+    double time = get_wtime();
+    if (cols)
+        blas::col_iamax( layout, m, n, A, lda, indices.data() );
+    else
+        blas::row_iamax( layout, m, n, A, lda, indices.data() );
+    time = get_wtime() - time;
+
+    double gbyte = Gbyte< T >::iamax( double( m )*n );
+    params.time()   = time;
+    params.gbytes() = gbyte / time;
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // run reference, one call per column or row
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        for (int64_t j = 0; j < nv; ++j)
+            indices_ref[ j ] = (len > 0 ? cblas_iamax( len, &A[ j*vinc ], inc ) : -1);
+        time = get_wtime() - time;
+
+        params.ref_time()   = time;
+        params.ref_gbytes() = gbyte / time;
+
+        // count of mismatched indices; iamax must be exact!
+        int64_t error = 0;
+        for (int64_t j = 0; j < nv; ++j) {
+            if (indices[ j ] != indices_ref[ j ]) {
+                ++error;
+                if (verbose >= 1) {
+                    printf( "vector %lld: index %lld, ref %lld\n",
+                            (lld) j, (lld) indices[ j ], (lld) indices_ref[ j ] );
+                }
+            }
+        }
+
+        // NaN vectors: every third vector is all NaN, so iamax is 0;
+        // the next has NaNs at p and p + 1, so iamax is p, the first NaN,
+        // even if a larger entry precedes it
+        if (len > 0) {
+            typedef real_type<T> real_t;
+            const T nan = std::numeric_limits<real_t>::quiet_NaN();
+            for (int64_t j = 0; j < nv; ++j) {
+                T* x = &A[ j*vinc ];
+                if (j % 3 == 1) {
+                    for (int64_t k = 0; k < len; ++k)
+                        x[ k*inc ] = nan;
+                    indices_ref[ j ] = 0;
+                }
+                else if (j % 3 == 2) {
+                    int64_t p = (j / 3) % len;
+                    x[ 0 ] = 10;
+                    x[ p*inc ] = nan;
+                    if (p + 1 < len)
+                        x[ (p + 1)*inc ] = nan;
+                    indices_ref[ j ] = p;
+                }
+            }
+            if (cols)
+                blas::col_iamax( layout, m, n, A, lda, indices.data() );
+            else
+                blas::row_iamax( layout, m, n, A, lda, indices.data() );
+
+            for (int64_t j = 0; j < nv; ++j) {
+                if (indices[ j ] != indices_ref[ j ]) {
+                    ++error;
+                    if (verbose >= 1) {
+                        printf( "NaN vector %lld: index %lld, ref %lld\n",
+                                (lld) j, (lld) indices[ j ], (lld) indices_ref[ j ] );
+                    }
+                }
+            }
+        }
+        params.error() = error;
+        params.okay() = (error == 0);
+    }
+
+    delete[] A;
+}
+
+// -----------------------------------------------------------------------------
+void test_norms( Params& params, bool run, bool cols, bool iamax )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            if (iamax)
+                test_norms_iamax_work< float >( params, run, cols );
+            else
+                test_norms_work< float >( params, run, cols );
+            break;
+
+        case testsweeper::DataType::Double:
+            if (iamax)
+                test_norms_iamax_work< double >( params, run, cols );
+            else
+                test_norms_work< double >( params, run, cols );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            if (iamax)
+                test_norms_iamax_work< std::complex<float> >( params, run, cols );
+            else
+                test_norms_work< std::complex<float> >( params, run, cols );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            if (iamax)
+                test_norms_iamax_work< std::complex<double> >( params, run, cols );
+            else
+                test_norms_work< std::complex<double> >( params, run, cols );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_col_norms( Params& params, bool run )
+{
+    test_norms( params, run, true, false );
+}
+
+// -----------------------------------------------------------------------------
+void test_row_norms( Params& params, bool run )
+{
+    test_norms( params, run, false, false );
+}
+
+// -----------------------------------------------------------------------------
+void test_col_iamax( Params& params, bool run )
+{
+    test_norms( params, run, true, true );
+}
+
+// -----------------------------------------------------------------------------
+void test_row_iamax( Params& params, bool run )
+{
+    test_norms( params, run, false, true );
+}
@@ -0,0 +1,194 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "cblas.hh"
+#include "lapack_wrappers.hh"
+#include "blas/flops.hh"
+#include "print_matrix.hh"
+#include "check_gemm.hh"
+
+// -----------------------------------------------------------------------------
+// Tests batch gemm on matrices from blas::numa::allocate with the --policy
+// placement, against cblas gemm, and checks that the topology queries
+// are consistent.
+template< typename T >
+void test_numa_work( Params& params, bool run )
+{
+    using namespace testsweeper;
+    using namespace blas;
+    typedef real_type<T> real_t;
+
+    // get & mark input values
+    blas::Layout layout = params.layout();
+    blas::Op transA = params.transA();
+    blas::Op transB = params.transB();
+    T alpha         = params.alpha();
+    T beta          = params.beta();
+    int64_t m       = params.dim.m();
+    int64_t n       = params.dim.n();
+    int64_t k       = params.dim.k();
+    size_t  batch   = params.batch();
+    char policy_    = params.policy();
+    int64_t align   = params.align();
+    int64_t verbose = params.verbose();
+
+    // mark non-standard output values
+    params.gflops();
+    params.ref_time();
+    params.ref_gflops();
+
+    if (! run)
+        return;
+
+    numa::Policy policy = (policy_ == 'i' ? numa::Policy::Interleave
+                                          : numa::Policy::FirstTouch);
+
+    // topology: every CPU of each node maps back to that node
+    int64_t nodes = numa::num_nodes();
+    bool topo_okay = (nodes >= 1);
+    for (int64_t node = 0; node < nodes; ++node) {
+        for (int64_t cpu : numa::node_cpus( node ))
+            topo_okay &= (numa::cpu_node( cpu ) == node);
+    }
+    int64_t home = numa::current_node();
+    topo_okay &= (home >= -1 && home < nodes);
+    assert_throw( numa::node_cpus( -1 ), blas::Error );
+    assert_throw( numa::node_cpus( nodes ), blas::Error );
+    if (verbose >= 1) {
+        printf( "\nnodes %lld, current node %lld\n",
+                (long long) nodes, (long long) home );
+    }
+
+    // setup
+    int64_t Am = (transA == Op::NoTrans ? m : k);
+    int64_t An = (transA == Op::NoTrans ? k : m);
+    int64_t Bm = (transB == Op::NoTrans ? k : n);
+    int64_t Bn = (transB == Op::NoTrans ? n : k);
+    int64_t Cm = m;
+    int64_t Cn = n;
+    if (layout == Layout::RowMajor) {
+        std::swap( Am, An );
+        std::swap( Bm, Bn );
+        std::swap( Cm, Cn );
+    }
+    int64_t lda = roundup( Am, align );
+    int64_t ldb = roundup( Bm, align );
+    int64_t ldc = roundup( Cm, align );
+    size_t size_A = size_t(lda)*An;
+    size_t size_B = size_t(ldb)*Bn;
+    size_t size_C = size_t(ldc)*Cn;
+    numa::Allocator<T> alloc( policy );
+    T* A    = alloc.allocate( batch * size_A );
+    T* B    = alloc.allocate( batch * size_B );
+    T* C    = alloc.allocate( batch * size_C );
+    T* Cref = new T[ batch * size_C ];
+
+    std::vector<T*> Aarray( batch );
+    std::vector<T*> Barray( batch );
+    std::vector<T*> Carray( batch );
+    for (size_t i = 0; i < batch; ++i) {
+        Aarray[ i ] = A + i * size_A;
+        Barray[ i ] = B + i * size_B;
+        Carray[ i ] = C + i * size_C;
+    }
+
+    int64_t idist = 1;
+    int iseed[4] = { 0, 0, 0, 1 };
+    lapack_larnv( idist, iseed, batch * size_A, A );
+    lapack_larnv( idist, iseed, batch * size_B, B );
+    lapack_larnv( idist, iseed, batch * size_C, C );
+    lapack_lacpy( "g", Cm, batch * Cn, C, ldc, Cref, ldc );
+
+    // touched pages are on a known node, if the system reports it
+    if (batch > 0 && size_C > 0) {
+        int64_t node = numa::node_of( C );
+        topo_okay &= (node >= -1 && node < nodes);
+    }
+
+    // norms for error check
+    real_t work[1];
+    std::vector<real_t> Anorm( batch ), Bnorm( batch ), Cnorm( batch );
+    for (size_t i = 0; i < batch; ++i) {
+        Anorm[ i ] = lapack_lange( "f", Am, An, Aarray[ i ], lda, work );
+        Bnorm[ i ] = lapack_lange( "f", Bm, Bn, Barray[ i ], ldb, work );
+        Cnorm[ i ] = lapack_lange( "f", Cm, Cn, Carray[ i ], ldc, work );
+    }
+
+    std::vector<int64_t> info;
+
+    // run test
+    testsweeper::flush_cache( params.cache() );
+    double time = get_wtime();
+    blas::batch::gemm( layout, { transA }, { transB }, { m }, { n }, { k },
+                       { alpha }, Aarray, { lda }, Barray, { ldb },
+                       { beta }, Carray, { ldc }, batch, info );
+    time = get_wtime() - time;
+
+    double gflop = batch * Gflop < T >::gemm( m, n, k );
+    params.time()   = time;
+    params.gflops() = gflop / time;
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // run reference
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        for (size_t i = 0; i < batch; ++i) {
+            cblas_gemm( cblas_layout_const(layout),
+                        cblas_trans_const(transA),
+                        cblas_trans_const(transB),
+                        m, n, k, alpha, Aarray[ i ], lda, Barray[ i ], ldb,
+                        beta, Cref + i * size_C, ldc );
+        }
+        time = get_wtime() - time;
+
+        params.ref_time()   = time;
+        params.ref_gflops() = gflop / time;
+
+        // check error compared to reference
+        real_t err, error = 0;
+        bool ok, okay = true;
+        for (size_t i = 0; i < batch; ++i) {
+            check_gemm( Cm, Cn, k, alpha, beta, Anorm[ i ], Bnorm[ i ], Cnorm[ i ],
+                        Cref + i * size_C, ldc, Carray[ i ], ldc,
+                        verbose, &err, &ok );
+            error = max( error, err );
+            okay &= ok;
+        }
+        params.error() = error;
+        params.okay() = okay && topo_okay;
+    }
+
+    alloc.deallocate( A, batch * size_A );
+    alloc.deallocate( B, batch * size_B );
+    alloc.deallocate( C, batch * size_C );
+    delete[] Cref;
+}
+
+// -----------------------------------------------------------------------------
+void test_numa( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_numa_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_numa_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_numa_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_numa_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
@@ -0,0 +1,353 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "cblas.hh"
+#include "lapack_wrappers.hh"
+#include "blas/flops.hh"
+#include "print_matrix.hh"
+#include "check_gemm.hh"
+
+#include <cstring>
+#include <vector>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+// -----------------------------------------------------------------------------
+// Tests the reproducible reductions in blas::repro. Each is checked to be
+// bitwise identical
+//  - with 1, 2, 3, and 5 threads,
+//  - with the entries of x and y permuted,
+//  - via blas::dot, etc., in reproducible mode,
+// and compared for accuracy to the vendor BLAS. Entries of x are scaled by
+// powers of two over a range of 2^40 so there is substantial rounding.
+
+namespace {
+
+//------------------------------------------------------------------------------
+// @return true if f() gives bitwise identical results for several thread
+// counts. Without OpenMP, trivially true.
+template <typename F>
+bool same_across_threads( F f )
+{
+    auto r0 = f();
+    bool same = true;
+    #ifdef _OPENMP
+        int save = omp_get_max_threads();
+        for (int nt : { 1, 2, 3, 5 }) {
+            omp_set_num_threads( nt );
+            auto r = f();
+            same = same && (memcmp( &r, &r0, sizeof(r) ) == 0);
+        }
+        omp_set_num_threads( save );
+    #endif
+    return same;
+}
+
+//------------------------------------------------------------------------------
+// @return true if a and b are bitwise identical.
+template <typename T>
+bool same_bits( T a, T b )
+{
+    return memcmp( &a, &b, sizeof(T) ) == 0;
+}
+
+//------------------------------------------------------------------------------
+// Sets perm to a pseudo-random permutation of 0, ..., n-1.
+void random_permutation( int64_t n, std::vector<int64_t>& perm )
+{
+    perm.resize( n );
+    for (int64_t i = 0; i < n; ++i)
+        perm[ i ] = i;
+    uint64_t state = 12345;
+    for (int64_t i = n - 1; i > 0; --i) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        int64_t j = int64_t( (state >> 33) % uint64_t( i + 1 ) );
+        std::swap( perm[ i ], perm[ j ] );
+    }
+}
+
+//------------------------------------------------------------------------------
+// Generates x with entries scaled over a range of 2^40.
+template <typename T>
+void generate( int64_t n, T* x, int64_t incx, int iseed[4] )
+{
+    size_t size_x = (n - 1) * std::abs(incx) + 1;
+    int64_t idist = 2;
+    lapack_larnv( idist, iseed, size_x, x );
+    for (int64_t i = 0; i < n; ++i)
+        x[ i*std::abs(incx) ] *= std::ldexp( 1.0, int( i % 41 ) - 20 );
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+template< typename T >
+void test_dot_repro_work( Params& params, bool run )
+{
+    using namespace testsweeper;
+    using namespace blas;
+    typedef real_type<T> real_t;
+
+    // get & mark input values
+    int64_t n       = params.dim.n();
+    int64_t incx    = params.incx();
+    int64_t incy    = params.incy();
+    int64_t verbose = params.verbose();
+
+    // mark non-standard output values
+    params.gflops();
+    params.ref_time();
+    params.ref_gflops();
+
+    // adjust header to msec
+    params.time.name( "BLAS++\ntime (ms)" );
+    params.ref_time.name( "Ref.\ntime (ms)" );
+
+    if (! run)
+        return;
+
+    // setup
+    size_t size_x = (n - 1) * std::abs(incx) + 1;
+    size_t size_y = (n - 1) * std::abs(incy) + 1;
+    std::vector<T> x( size_x ), y( size_y ), xp( n ), yp( n );
+    int iseed[4] = { 0, 0, 0, 1 };
+    generate( n, x.data(), incx, iseed );
+    generate( n, y.data(), incy, iseed );
+
+    // logical entries permuted, unit stride
+    std::vector<int64_t> perm;
+    random_permutation( n, perm );
+    int64_t kx = (incx > 0 ? 0 : (-n + 1)*incx);
+    int64_t ky = (incy > 0 ? 0 : (-n + 1)*incy);
+    for (int64_t i = 0; i < n; ++i) {
+        xp[ i ] = x[ kx + perm[ i ]*incx ];
+        yp[ i ] = y[ ky + perm[ i ]*incy ];
+    }
+
+    real_t Xnorm = cblas_nrm2( n, x.data(), std::abs(incx) );
+    real_t Ynorm = cblas_nrm2( n, y.data(), std::abs(incy) );
+
+    // test error exits
+    assert_throw( blas::repro::dot( -1, x.data(), incx, y.data(), incy ), blas::Error );
+    assert_throw( blas::repro::dot(  n, x.data(),    0, y.data(), incy ), blas::Error );
+    assert_throw( blas::repro::dot(  n, x.data(), incx, y.data(),    0 ), blas::Error );
+
+    // run test
+    testsweeper::flush_cache( params.cache() );
+    double time = get_wtime();
+    T result = blas::repro::dot( n, x.data(), incx, y.data(), incy );
+    time = get_wtime() - time;
+
+    double gflop = Gflop < T >::dot( n );
+    params.time()   = time * 1000;  // msec
+    params.gflops() = gflop / time;
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        bool same_threads = same_across_threads( [&]() {
+            return blas::repro::dot( n, x.data(), incx, y.data(), incy );
+        });
+        bool same_perm = same_bits(
+            result, blas::repro::dot( n, xp.data(), 1, yp.data(), 1 ) );
+
+        bool save = blas::repro::enabled();
+        blas::repro::enable();
+        bool same_mode = same_bits(
+            result, blas::dot( n, x.data(), incx, y.data(), incy ) );
+        blas::repro::enable( save );
+
+        // run reference
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        T ref = cblas_dot( n, x.data(), incx, y.data(), incy );
+        time = get_wtime() - time;
+
+        params.ref_time()   = time * 1000;  // msec
+        params.ref_gflops() = gflop / time;
+
+        if (verbose >= 1) {
+            printf( "\ndot = %.16e + %.16ei, ref = %.16e + %.16ei\n"
+                    "same threads %d, permuted %d, mode %d\n",
+                    real(result), imag(result), real(ref), imag(ref),
+                    same_threads, same_perm, same_mode );
+        }
+
+        // check error compared to reference
+        real_t error;
+        bool okay;
+        check_gemm( 1, 1, n, T(1), T(0), Xnorm, Ynorm, real_t(0),
+                    &ref, 1, &result, 1, verbose, &error, &okay );
+        params.error() = error;
+        params.okay() = okay && same_threads && same_perm && same_mode;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Tests both asum and nrm2, which have the same arguments.
+template< typename T >
+void test_norm_repro_work( Params& params, bool run, bool two_norm )
+{
+    using namespace testsweeper;
+    using namespace blas;
+    typedef real_type<T> real_t;
+
+    // get & mark input values
+    int64_t n       = params.dim.n();
+    int64_t incx    = params.incx();
+    int64_t verbose = params.verbose();
+
+    // mark non-standard output values
+    params.gflops();
+    params.ref_time();
+    params.ref_gflops();
+
+    // adjust header to msec
+    params.time.name( "BLAS++\ntime (ms)" );
+    params.ref_time.name( "Ref.\ntime (ms)" );
+
+    if (! run)
+        return;
+
+    // both require incx > 0
+    incx = std::abs( incx );
+
+    // setup
+    size_t size_x = (n - 1) * incx + 1;
+    std::vector<T> x( size_x ), xp( n );
+    int iseed[4] = { 0, 0, 0, 1 };
+    generate( n, x.data(), incx, iseed );
+
+    std::vector<int64_t> perm;
+    random_permutation( n, perm );
+    for (int64_t i = 0; i < n; ++i)
+        xp[ i ] = x[ perm[ i ]*incx ];
+
+    auto norm = [&]( T const* xx, int64_t inc ) {
+        return two_norm ? blas::repro::nrm2( n, xx, inc )
+                        : blas::repro::asum( n, xx, inc );
+    };
+
+    // test error exits
+    assert_throw( blas::repro::asum( -1, x.data(), incx ), blas::Error );
+    assert_throw( blas::repro::asum(  n, x.data(),    0 ), blas::Error );
+    assert_throw( blas::repro::nrm2( -1, x.data(), incx ), blas::Error );
+    assert_throw( blas::repro::nrm2(  n, x.data(),    0 ), blas::Error );
+
+    // run test
+    testsweeper::flush_cache( params.cache() );
+    double time = get_wtime();
+    real_t result = norm( x.data(), incx );
+    time = get_wtime() - time;
+
+    double gflop = (two_norm ? Gflop < T >::nrm2( n ) : Gflop < T >::asum( n ));
+    params.time()   = time * 1000;  // msec
+    params.gflops() = gflop / time;
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        bool same_threads = same_across_threads( [&]() {
+            return norm( x.data(), incx );
+        });
+        bool same_perm = same_bits( result, norm( xp.data(), 1 ) );
+
+        bool save = blas::repro::enabled();
+        blas::repro::enable();
+        real_t r_mode = two_norm ? blas::nrm2( n, x.data(), incx )
+                                 : blas::asum( n, x.data(), incx );
+        bool same_mode = same_bits( result, r_mode );
+        blas::repro::enable( save );
+
+        // run reference
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        real_t ref = two_norm ? cblas_nrm2( n, x.data(), incx )
+                              : cblas_asum( n, x.data(), incx );
+        time = get_wtime() - time;
+
+        params.ref_time()   = time * 1000;  // msec
+        params.ref_gflops() = gflop / time;
+
+        if (verbose >= 1) {
+            printf( "\nresult = %.16e, ref = %.16e\n"
+                    "same threads %d, permuted %d, mode %d\n",
+                    result, ref, same_threads, same_perm, same_mode );
+        }
+
+        // relative forward error, as in test_asum and test_nrm2
+        real_t error = std::abs( ref - result );
+        if (ref != 0)
+            error /= (two_norm ? sqrt( n+1 ) : n) * ref;
+        if (blas::is_complex<T>::value)
+            error /= 2*sqrt(2);
+        real_t u = 0.5 * std::numeric_limits< real_t >::epsilon();
+        params.error() = error;
+        params.okay() = error < u && same_threads && same_perm && same_mode;
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_dot_repro( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_dot_repro_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_dot_repro_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_dot_repro_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_dot_repro_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_norm_repro( Params& params, bool run, bool two_norm )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_norm_repro_work< float >( params, run, two_norm );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_norm_repro_work< double >( params, run, two_norm );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_norm_repro_work< std::complex<float> >( params, run, two_norm );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_norm_repro_work< std::complex<double> >( params, run, two_norm );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_asum_repro( Params& params, bool run )
+{
+    test_norm_repro( params, run, false );
+}
+
+// -----------------------------------------------------------------------------
+void test_nrm2_repro( Params& params, bool run )
+{
+    test_norm_repro( params, run, true );
+}
@@ -0,0 +1,447 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "cblas.hh"
+#include "lapack_wrappers.hh"
+#include "blas/flops.hh"
+#include "print_matrix.hh"
+#include "check_gemm.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Zeros the Am-by-An dense matrix A, with entry (i, j) at A[ i*rs + j*cs ],
+// outside a random set of bs-by-bs blocks, each kept with probability
+// density, then compresses A in the given format.
+template< typename T >
+void sparse_generate(
+    blas::sparse::Format format, int64_t Am, int64_t An, int64_t bs,
+    double density, int iseed[4], T* A, int64_t rs, int64_t cs,
+    std::vector<int64_t>& ptr, std::vector<int64_t>& ind,
+    std::vector<T>& values )
+{
+    using blas::sparse::Format;
+
+    int64_t mt = Am / bs;
+    int64_t nt = An / bs;
+    std::vector<double> mask( mt*nt );
+    if (mt*nt > 0)
+        lapack_larnv( 1, iseed, mt*nt, mask.data() );
+    auto keep = [&]( int64_t I, int64_t J ) {
+        return mask[ I + J*mt ] < density;
+    };
+    for (int64_t j = 0; j < An; ++j) {
+        for (int64_t i = 0; i < Am; ++i) {
+            if (! keep( i / bs, j / bs ))
+                A[ i*rs + j*cs ] = 0;
+        }
+    }
+
+    ptr.assign( 1, 0 );
+    ind.clear();
+    values.clear();
+    if (format == Format::CSC) {
+        for (int64_t j = 0; j < An; ++j) {
+            for (int64_t i = 0; i < Am; ++i) {
+                if (keep( i, j )) {
+                    ind.push_back( i );
+                    values.push_back( A[ i*rs + j*cs ] );
+                }
+            }
+            ptr.push_back( ind.size() );
+        }
+    }
+    else {
+        // CSR is BSR with bs = 1
+        for (int64_t I = 0; I < mt; ++I) {
+            for (int64_t J = 0; J < nt; ++J) {
+                if (keep( I, J )) {
+                    ind.push_back( J );
+                    for (int64_t bj = 0; bj < bs; ++bj)
+                        for (int64_t bi = 0; bi < bs; ++bi)
+                            values.push_back( A[ (I*bs + bi)*rs
+                                                 + (J*bs + bj)*cs ] );
+                }
+            }
+            ptr.push_back( ind.size() );
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Bytes moved by sparse gemm with n columns: the sparse matrix once, B once,
+// and C read and written.
+template< typename T >
+double sparse_gbyte(
+    blas::sparse::Matrix<T> const& A, int64_t mi, int64_t mo, int64_t n )
+{
+    double sparse = A.nnz() * sizeof(T)
+                  + (A.ptr()[ A.compressed() ] + A.compressed() + 1)
+                    * sizeof(int64_t);
+    double dense = (mi + 2*mo) * n * sizeof(T);
+    return 1e-9 * (sparse + dense);
+}
+
+// -----------------------------------------------------------------------------
+// Tests sparse gemv against cblas gemv on the same matrix stored dense.
+// The m-by-n matrix has blocks of --bs (for BSR) or entries kept with
+// probability --density; for BSR, m and n are rounded up to multiples of bs.
+template< typename T >
+void test_sparse_gemv_work( Params& params, bool run )
+{
+    using namespace testsweeper;
+    using namespace blas;
+    using blas::sparse::Format;
+    typedef real_type<T> real_t;
+    typedef long long lld;
+
+    // get & mark input values
+    Format format   = sparse::char2format( params.format() );
+    blas::Op trans  = params.trans();
+    T alpha         = params.alpha();
+    T beta          = params.beta();
+    int64_t m       = params.dim.m();
+    int64_t n       = params.dim.n();
+    int64_t bs      = params.bs();  // mark always; used only for BSR
+    double density  = params.density();
+    int64_t incx    = params.incx();
+    int64_t incy    = params.incy();
+    int64_t verbose = params.verbose();
+
+    // mark non-standard output values
+    params.gflops();
+    params.gbytes();
+    params.ref_time();
+    params.ref_gflops();
+    params.ref_gbytes();
+
+    // adjust header to msec
+    params.time.name( "BLAS++\ntime (ms)" );
+    params.ref_time.name( "Ref.\ntime (ms)" );
+
+    if (! run)
+        return;
+
+    // setup
+    if (format != Format::BSR)
+        bs = 1;
+    m = roundup( m, bs );
+    n = roundup( n, bs );
+    int64_t lda = std::max( m, int64_t( 1 ) );
+    int64_t Xm = (trans == Op::NoTrans ? n : m);
+    int64_t Ym = (trans == Op::NoTrans ? m : n);
+    size_t size_A = size_t(lda)*n;
+    size_t size_x = (Xm - 1) * std::abs(incx) + 1;
+    size_t size_y = (Ym - 1) * std::abs(incy) + 1;
+    T* A    = new T[ size_A ];
+    T* x    = new T[ size_x ];
+    T* y    = new T[ size_y ];
+    T* yref = new T[ size_y ];
+
+    int64_t idist = 1;
+    int iseed[4] = { 0, 0, 0, 1 };
+    lapack_larnv( idist, iseed, size_A, A );
+    lapack_larnv( idist, iseed, size_x, x );
+    lapack_larnv( idist, iseed, size_y, y );
+    cblas_copy( Ym, y, incy, yref, incy );
+
+    std::vector<int64_t> ptr, ind;
+    std::vector<T> values;
+    sparse_generate( format, m, n, bs, density, iseed, A, 1, lda,
+                     ptr, ind, values );
+    sparse::Matrix<T> As( format, m, n, ptr.data(), ind.data(),
+                          values.data(), bs );
+
+    // norms for error check
+    real_t work[1];
+    real_t Anorm = lapack_lange( "f", m, n, A, lda, work );
+    real_t Xnorm = cblas_nrm2( Xm, x, std::abs(incx) );
+    real_t Ynorm = cblas_nrm2( Ym, y, std::abs(incy) );
+
+    // test error exits
+    assert_throw( sparse::gemv( Op(0), alpha, As, x, incx, beta, y, incy ), blas::Error );
+    assert_throw( sparse::gemv( trans, alpha, As, x, 0,    beta, y, incy ), blas::Error );
+    assert_throw( sparse::gemv( trans, alpha, As, x, incx, beta, y, 0    ), blas::Error );
+    assert_throw( sparse::Matrix<T>( Format(0), m, n, ptr.data(), ind.data(), values.data() ), blas::Error );
+    assert_throw( sparse::Matrix<T>( format,   -1, n, ptr.data(), ind.data(), values.data() ), blas::Error );
+    assert_throw( sparse::Matrix<T>( format,    m, -1, ptr.data(), ind.data(), values.data() ), blas::Error );
+    assert_throw( sparse::Matrix<T>( Format::BSR, m, n, ptr.data(), ind.data(), values.data(), 0 ), blas::Error );
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A m=%5lld, n=%5lld, %s, bs=%lld, nnz=%10lld, norm=%.2e\n",
+                (lld) m, (lld) n, sparse::format2str( format ),
+                (lld) bs, (lld) As.nnz(), Anorm );
+    }
+    if (verbose >= 2) {
+        printf( "A = "    ); print_matrix( m, n, A, lda );
+        printf( "x    = " ); print_vector( Xm, x, incx );
+        printf( "y    = " ); print_vector( Ym, y, incy );
+    }
+
+    // run test
+    testsweeper::flush_cache( params.cache() );
+    double time = get_wtime();
+    sparse::gemv( trans, alpha, As, x, incx, beta, y, incy );
+    time = get_wtime() - time;
+
+    double gflop = 1e-9 * (is_complex<T>::value ? 8 : 2) * As.nnz();
+    double gbyte = sparse_gbyte( As, Xm, Ym, 1 );
+    params.time()   = time * 1000;  // msec
+    params.gflops() = gflop / time;
+    params.gbytes() = gbyte / time;
+
+    if (verbose >= 2) {
+        printf( "y2   = " ); print_vector( Ym, y, incy );
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // run reference on the dense matrix
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        cblas_gemv( CblasColMajor, cblas_trans_const(trans), m, n,
+                    alpha, A, lda, x, incx, beta, yref, incy );
+        time = get_wtime() - time;
+
+        params.ref_time()   = time * 1000;  // msec
+        params.ref_gflops() = gflop / time;
+        params.ref_gbytes() = Gbyte<T>::gemv( m, n ) / time;
+
+        if (verbose >= 2) {
+            printf( "yref = " ); print_vector( Ym, yref, incy );
+        }
+
+        // check error compared to reference
+        // treat y as 1 x Ym matrix with ld = incy; k = Xm is reduction dimension
+        real_t error;
+        bool okay;
+        check_gemm( 1, Ym, Xm, alpha, beta, Anorm, Xnorm, Ynorm,
+                    yref, std::abs(incy), y, std::abs(incy), verbose, &error, &okay );
+        params.error() = error;
+        params.okay() = okay;
+    }
+
+    delete[] A;
+    delete[] x;
+    delete[] y;
+    delete[] yref;
+}
+
+// -----------------------------------------------------------------------------
+// Tests sparse gemm, C = alpha op(A) B + beta C with op(A) m-by-k sparse and
+// B, C dense in the given layout, against cblas gemm on A stored dense.
+// For BSR, m and k are rounded up to multiples of bs.
+template< typename T >
+void test_sparse_gemm_work( Params& params, bool run )
+{
+    using namespace testsweeper;
+    using namespace blas;
+    using blas::sparse::Format;
+    typedef real_type<T> real_t;
+    typedef long long lld;
+
+    // get & mark input values
+    blas::Layout layout = params.layout();
+    Format format   = sparse::char2format( params.format() );
+    blas::Op transA = params.transA();
+    T alpha         = params.alpha();
+    T beta          = params.beta();
+    int64_t m       = params.dim.m();
+    int64_t n       = params.dim.n();
+    int64_t k       = params.dim.k();
+    int64_t bs      = params.bs();  // mark always; used only for BSR
+    double density  = params.density();
+    int64_t align   = params.align();
+    int64_t verbose = params.verbose();
+
+    // mark non-standard output values
+    params.gflops();
+    params.gbytes();
+    params.ref_time();
+    params.ref_gflops();
+    params.ref_gbytes();
+
+    if (! run)
+        return;
+
+    // setup
+    if (format != Format::BSR)
+        bs = 1;
+    m = roundup( m, bs );
+    k = roundup( k, bs );
+    int64_t Am = (transA == Op::NoTrans ? m : k);
+    int64_t An = (transA == Op::NoTrans ? k : m);
+    int64_t Bm = k;
+    int64_t Bn = n;
+    int64_t Cm = m;
+    int64_t Cn = n;
+    if (layout == Layout::RowMajor) {
+        std::swap( Am, An );
+        std::swap( Bm, Bn );
+        std::swap( Cm, Cn );
+    }
+    int64_t lda = roundup( std::max( Am, int64_t( 1 ) ), align );
+    int64_t ldb = roundup( std::max( Bm, int64_t( 1 ) ), align );
+    int64_t ldc = roundup( std::max( Cm, int64_t( 1 ) ), align );
+    size_t size_A = size_t(lda)*An;
+    size_t size_B = size_t(ldb)*Bn;
+    size_t size_C = size_t(ldc)*Cn;
+    T* A    = new T[ size_A ];
+    T* B    = new T[ size_B ];
+    T* C    = new T[ size_C ];
+    T* Cref = new T[ size_C ];
+
+    int64_t idist = 1;
+    int iseed[4] = { 0, 0, 0, 1 };
+    lapack_larnv( idist, iseed, size_A, A );
+    lapack_larnv( idist, iseed, size_B, B );
+    lapack_larnv( idist, iseed, size_C, C );
+    lapack_lacpy( "g", Cm, Cn, C, ldc, Cref, ldc );
+
+    // A is stored dense in the layout, for the reference, and compressed
+    int64_t Asm = (transA == Op::NoTrans ? m : k);
+    int64_t Asn = (transA == Op::NoTrans ? k : m);
+    int64_t rs = (layout == Layout::ColMajor ? 1 : lda);
+    int64_t cs = (layout == Layout::ColMajor ? lda : 1);
+    std::vector<int64_t> ptr, ind;
+    std::vector<T> values;
+    sparse_generate( format, Asm, Asn, bs, density, iseed, A, rs, cs,
+                     ptr, ind, values );
+    sparse::Matrix<T> As( format, Asm, Asn, ptr.data(), ind.data(),
+                          values.data(), bs );
+
+    // norms for error check
+    real_t work[1];
+    real_t Anorm = lapack_lange( "f", Am, An, A, lda, work );
+    real_t Bnorm = lapack_lange( "f", Bm, Bn, B, ldb, work );
+    real_t Cnorm = lapack_lange( "f", Cm, Cn, C, ldc, work );
+
+    // test error exits
+    assert_throw( sparse::gemm( Layout(0), transA,  n, alpha, As, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( sparse::gemm( layout,    Op(0),   n, alpha, As, B, ldb, beta, C, ldc ), blas::Error );
+    assert_throw( sparse::gemm( layout,    transA, -1, alpha, As, B, ldb, beta, C, ldc ), blas::Error );
+
+    assert_throw( sparse::gemm( Layout::ColMajor, transA, n, alpha, As, B, k-1, beta, C, ldc ), blas::Error );
+    assert_throw( sparse::gemm( Layout::ColMajor, transA, n, alpha, As, B, ldb, beta, C, m-1 ), blas::Error );
+    assert_throw( sparse::gemm( Layout::RowMajor, transA, n, alpha, As, B, n-1, beta, C, ldc ), blas::Error );
+    assert_throw( sparse::gemm( Layout::RowMajor, transA, n, alpha, As, B, ldb, beta, C, n-1 ), blas::Error );
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A Am=%5lld, An=%5lld, %s, bs=%lld, nnz=%10lld, norm=%.2e\n"
+                "B Bm=%5lld, Bn=%5lld, ldb=%5lld, size=%10lld, norm=%.2e\n"
+                "C Cm=%5lld, Cn=%5lld, ldc=%5lld, size=%10lld, norm=%.2e\n",
+                (lld) Asm, (lld) Asn, sparse::format2str( format ),
+                (lld) bs, (lld) As.nnz(), Anorm,
+                (lld) Bm, (lld) Bn, (lld) ldb, (lld) size_B, Bnorm,
+                (lld) Cm, (lld) Cn, (lld) ldc, (lld) size_C, Cnorm );
+    }
+    if (verbose >= 2) {
+        printf( "A = "    ); print_matrix( Am, An, A, lda );
+        printf( "B = "    ); print_matrix( Bm, Bn, B, ldb );
+        printf( "C = "    ); print_matrix( Cm, Cn, C, ldc );
+    }
+
+    // run test
+    testsweeper::flush_cache( params.cache() );
+    double time = get_wtime();
+    sparse::gemm( layout, transA, n, alpha, As, B, ldb, beta, C, ldc );
+    time = get_wtime() - time;
+
+    double gflop = 1e-9 * (is_complex<T>::value ? 8 : 2) * As.nnz() * n;
+    double gbyte = sparse_gbyte( As, k, m, n );
+    params.time()   = time;
+    params.gflops() = gflop / time;
+    params.gbytes() = gbyte / time;
+
+    if (verbose >= 2) {
+        printf( "C2 = " ); print_matrix( Cm, Cn, C, ldc );
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // run reference on the dense matrix
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        cblas_gemm( cblas_layout_const(layout),
+                    cblas_trans_const(transA),
+                    CblasNoTrans,
+                    m, n, k, alpha, A, lda, B, ldb, beta, Cref, ldc );
+        time = get_wtime() - time;
+
+        params.ref_time()   = time;
+        params.ref_gflops() = gflop / time;
+        params.ref_gbytes() = Gbyte<T>::gemm( m, n, k ) / time;
+
+        if (verbose >= 2) {
+            printf( "Cref = " ); print_matrix( Cm, Cn, Cref, ldc );
+        }
+
+        // check error compared to reference
+        real_t error;
+        bool okay;
+        check_gemm( Cm, Cn, k, alpha, beta, Anorm, Bnorm, Cnorm,
+                    Cref, ldc, C, ldc, verbose, &error, &okay );
+        params.error() = error;
+        params.okay() = okay;
+    }
+
+    delete[] A;
+    delete[] B;
+    delete[] C;
+    delete[] Cref;
+}
+
+// -----------------------------------------------------------------------------
+void test_sparse_gemv( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_sparse_gemv_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_sparse_gemv_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_sparse_gemv_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_sparse_gemv_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_sparse_gemm( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_sparse_gemm_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_sparse_gemm_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_sparse_gemm_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_sparse_gemm_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
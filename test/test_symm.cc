@@ -33,8 +33,10 @@ void test_symm_work( Params& params, bool run )
 
     // mark non-standard output values
     params.gflops();
+    params.gbytes();
     params.ref_time();
     params.ref_gflops();
+    params.ref_gbytes();
 
     // adjust header to msec
     params.time.name( "BLAS++\ntime (ms)" );
@@ -117,8 +119,10 @@ void test_symm_work( Params& params, bool run )
     time = get_wtime() - time;
 
     double gflop = Gflop < scalar_t >::symm( side, m, n );
+    double gbyte = Gbyte < scalar_t >::symm( side, m, n );
     params.time()   = time * 1000;  // msec
     params.gflops() = gflop / time;
+    params.gbytes() = gbyte / time;
 
     if (verbose >= 2) {
         printf( "C2 = " ); print_matrix( Cm, Cn, C, ldc );
@@ -136,6 +140,7 @@ void test_symm_work( Params& params, bool run )
 
         params.ref_time()   = time * 1000;  // msec
         params.ref_gflops() = gflop / time;
+        params.ref_gbytes() = gbyte / time;
 
         if (verbose >= 2) {
             printf( "Cref = " ); print_matrix( Cm, Cn, Cref, ldc );
@@ -0,0 +1,468 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "cblas.hh"
+#include "lapack_wrappers.hh"
+#include "blas/flops.hh"
+#include "print_matrix.hh"
+#include "check_gemm.hh"
+
+// -----------------------------------------------------------------------------
+// Tests tiled gemm with --nb tile size, against cblas gemm.
+// The check also runs two tiled gemms on the same C in one parallel region,
+// so the second call's tasks depend on the first call's:
+// C = alpha A B + beta C, then C = A B + C, i.e., (alpha + 1) A B + beta C.
+template< typename T >
+void test_tiled_gemm_work( Params& params, bool run )
+{
+    using namespace testsweeper;
+    using namespace blas;
+    typedef real_type<T> real_t;
+
+    // get & mark input values
+    blas::Layout layout = params.layout();
+    blas::Op transA = params.transA();
+    blas::Op transB = params.transB();
+    T alpha         = params.alpha();
+    T beta          = params.beta();
+    int64_t m       = params.dim.m();
+    int64_t n       = params.dim.n();
+    int64_t k       = params.dim.k();
+    int64_t nb      = params.nb();
+    int64_t align   = params.align();
+    int64_t verbose = params.verbose();
+
+    // mark non-standard output values
+    params.gflops();
+    params.ref_time();
+    params.ref_gflops();
+
+    if (! run)
+        return;
+
+    // setup
+    int64_t Am = (transA == Op::NoTrans ? m : k);
+    int64_t An = (transA == Op::NoTrans ? k : m);
+    int64_t Bm = (transB == Op::NoTrans ? k : n);
+    int64_t Bn = (transB == Op::NoTrans ? n : k);
+    int64_t Cm = m;
+    int64_t Cn = n;
+    if (layout == Layout::RowMajor) {
+        std::swap( Am, An );
+        std::swap( Bm, Bn );
+        std::swap( Cm, Cn );
+    }
+    int64_t lda = roundup( Am, align );
+    int64_t ldb = roundup( Bm, align );
+    int64_t ldc = roundup( Cm, align );
+    size_t size_A = size_t(lda)*An;
+    size_t size_B = size_t(ldb)*Bn;
+    size_t size_C = size_t(ldc)*Cn;
+    T* A    = new T[ size_A ];
+    T* B    = new T[ size_B ];
+    T* C    = new T[ size_C ];
+    T* Cin  = new T[ size_C ];
+    T* Cref = new T[ size_C ];
+
+    int64_t idist = 1;
+    int iseed[4] = { 0, 0, 0, 1 };
+    lapack_larnv( idist, iseed, size_A, A );
+    lapack_larnv( idist, iseed, size_B, B );
+    lapack_larnv( idist, iseed, size_C, C );
+    lapack_lacpy( "g", Cm, Cn, C, ldc, Cin,  ldc );
+    lapack_lacpy( "g", Cm, Cn, C, ldc, Cref, ldc );
+
+    // norms for error check
+    real_t work[1];
+    real_t Anorm = lapack_lange( "f", Am, An, A, lda, work );
+    real_t Bnorm = lapack_lange( "f", Bm, Bn, B, ldb, work );
+    real_t Cnorm = lapack_lange( "f", Cm, Cn, C, ldc, work );
+
+    // test error exits
+    assert_throw( blas::tiled::gemm( Layout(0), transA, transB,  m,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc, nb ), blas::Error );
+    assert_throw( blas::tiled::gemm( layout,    Op(0),  transB,  m,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc, nb ), blas::Error );
+    assert_throw( blas::tiled::gemm( layout,    transA, Op(0),   m,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc, nb ), blas::Error );
+    assert_throw( blas::tiled::gemm( layout,    transA, transB, -1,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc, nb ), blas::Error );
+    assert_throw( blas::tiled::gemm( layout,    transA, transB,  m, -1,  k, alpha, A, lda, B, ldb, beta, C, ldc, nb ), blas::Error );
+    assert_throw( blas::tiled::gemm( layout,    transA, transB,  m,  n, -1, alpha, A, lda, B, ldb, beta, C, ldc, nb ), blas::Error );
+    assert_throw( blas::tiled::gemm( layout,    transA, transB,  m,  n,  k, alpha, A, lda, B, ldb, beta, C, ldc,  0 ), blas::Error );
+
+    // run test
+    testsweeper::flush_cache( params.cache() );
+    double time = get_wtime();
+    blas::tiled::gemm( layout, transA, transB, m, n, k,
+                       alpha, A, lda, B, ldb, beta, C, ldc, nb );
+    time = get_wtime() - time;
+
+    double gflop = Gflop < T >::gemm( m, n, k );
+    params.time()   = time;
+    params.gflops() = gflop / time;
+
+    if (verbose >= 2) {
+        printf( "C2 = " ); print_matrix( Cm, Cn, C, ldc );
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // run reference
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        cblas_gemm( cblas_layout_const(layout),
+                    cblas_trans_const(transA),
+                    cblas_trans_const(transB),
+                    m, n, k, alpha, A, lda, B, ldb, beta, Cref, ldc );
+        time = get_wtime() - time;
+
+        params.ref_time()   = time;
+        params.ref_gflops() = gflop / time;
+
+        // check error compared to reference
+        real_t error, error2;
+        bool okay, okay2;
+        check_gemm( Cm, Cn, k, alpha, beta, Anorm, Bnorm, Cnorm,
+                    Cref, ldc, C, ldc, verbose, &error, &okay );
+
+        // two calls overlapping in one region
+        T one = 1;
+        lapack_lacpy( "g", Cm, Cn, Cin, ldc, C,    ldc );
+        lapack_lacpy( "g", Cm, Cn, Cin, ldc, Cref, ldc );
+        #pragma omp parallel
+        #pragma omp master
+        {
+            blas::tiled::gemm( layout, transA, transB, m, n, k,
+                               alpha, A, lda, B, ldb, beta, C, ldc, nb );
+            blas::tiled::gemm( layout, transA, transB, m, n, k,
+                               one, A, lda, B, ldb, one, C, ldc, nb );
+            blas::tiled::wait();
+        }
+        cblas_gemm( cblas_layout_const(layout),
+                    cblas_trans_const(transA),
+                    cblas_trans_const(transB),
+                    m, n, k, alpha + one, A, lda, B, ldb, beta, Cref, ldc );
+        check_gemm( Cm, Cn, k, alpha + one, beta, Anorm, Bnorm, Cnorm,
+                    Cref, ldc, C, ldc, verbose, &error2, &okay2 );
+
+        params.error() = std::max( error, error2 );
+        params.okay() = okay && okay2;
+    }
+
+    delete[] A;
+    delete[] B;
+    delete[] C;
+    delete[] Cin;
+    delete[] Cref;
+}
+
+// -----------------------------------------------------------------------------
+// Tests tiled syrk with --nb tile size, against cblas syrk.
+template< typename T >
+void test_tiled_syrk_work( Params& params, bool run )
+{
+    using namespace testsweeper;
+    using namespace blas;
+    typedef real_type<T> real_t;
+
+    // get & mark input values
+    blas::Layout layout = params.layout();
+    blas::Op trans  = params.trans();
+    blas::Uplo uplo = params.uplo();
+    T alpha         = params.alpha();
+    T beta          = params.beta();
+    int64_t n       = params.dim.n();
+    int64_t k       = params.dim.k();
+    int64_t nb      = params.nb();
+    int64_t align   = params.align();
+    int64_t verbose = params.verbose();
+
+    // mark non-standard output values
+    params.gflops();
+    params.ref_time();
+    params.ref_gflops();
+
+    if (! run)
+        return;
+
+    // setup
+    int64_t Am = (trans == Op::NoTrans ? n : k);
+    int64_t An = (trans == Op::NoTrans ? k : n);
+    if (layout == Layout::RowMajor)
+        std::swap( Am, An );
+    int64_t lda = roundup( Am, align );
+    int64_t ldc = roundup(  n, align );
+    size_t size_A = size_t(lda)*An;
+    size_t size_C = size_t(ldc)*n;
+    T* A    = new T[ size_A ];
+    T* C    = new T[ size_C ];
+    T* Cref = new T[ size_C ];
+
+    int64_t idist = 1;
+    int iseed[4] = { 0, 0, 0, 1 };
+    lapack_larnv( idist, iseed, size_A, A );
+    lapack_larnv( idist, iseed, size_C, C );
+    lapack_lacpy( "g", n, n, C, ldc, Cref, ldc );
+
+    // norms for error check
+    real_t work[1];
+    real_t Anorm = lapack_lange( "f", Am, An, A, lda, work );
+    real_t Cnorm = lapack_lansy( "f", uplo2str(uplo), n, C, ldc, work );
+
+    // test error exits
+    assert_throw( blas::tiled::syrk( Layout(0), uplo,    trans,  n,  k, alpha, A, lda, beta, C, ldc, nb ), blas::Error );
+    assert_throw( blas::tiled::syrk( layout,    Uplo(0), trans,  n,  k, alpha, A, lda, beta, C, ldc, nb ), blas::Error );
+    assert_throw( blas::tiled::syrk( layout,    uplo,    Op(0),  n,  k, alpha, A, lda, beta, C, ldc, nb ), blas::Error );
+    assert_throw( blas::tiled::syrk( layout,    uplo,    trans, -1,  k, alpha, A, lda, beta, C, ldc, nb ), blas::Error );
+    assert_throw( blas::tiled::syrk( layout,    uplo,    trans,  n, -1, alpha, A, lda, beta, C, ldc, nb ), blas::Error );
+    assert_throw( blas::tiled::syrk( layout,    uplo,    trans,  n,  k, alpha, A, lda, beta, C, n-1, nb ), blas::Error );
+    assert_throw( blas::tiled::syrk( layout,    uplo,    trans,  n,  k, alpha, A, lda, beta, C, ldc,  0 ), blas::Error );
+
+    // run test
+    testsweeper::flush_cache( params.cache() );
+    double time = get_wtime();
+    blas::tiled::syrk( layout, uplo, trans, n, k,
+                       alpha, A, lda, beta, C, ldc, nb );
+    time = get_wtime() - time;
+
+    double gflop = Gflop < T >::syrk( n, k );
+    params.time()   = time;
+    params.gflops() = gflop / time;
+
+    if (verbose >= 2) {
+        printf( "C2 = " ); print_matrix( n, n, C, ldc );
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // run reference
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        cblas_syrk( cblas_layout_const(layout),
+                    cblas_uplo_const(uplo),
+                    cblas_trans_const(trans),
+                    n, k, alpha, A, lda, beta, Cref, ldc );
+        time = get_wtime() - time;
+
+        params.ref_time()   = time;
+        params.ref_gflops() = gflop / time;
+
+        // check error compared to reference
+        real_t error;
+        bool okay;
+        check_herk( uplo, n, k, alpha, beta, Anorm, Anorm, Cnorm,
+                    Cref, ldc, C, ldc, verbose, &error, &okay );
+        params.error() = error;
+        params.okay() = okay;
+    }
+
+    delete[] A;
+    delete[] C;
+    delete[] Cref;
+}
+
+// -----------------------------------------------------------------------------
+// Tests tiled trsm with --nb tile size, against cblas trsm.
+template< typename T >
+void test_tiled_trsm_work( Params& params, bool run )
+{
+    using namespace testsweeper;
+    using namespace blas;
+    typedef real_type<T> real_t;
+
+    // get & mark input values
+    blas::Layout layout = params.layout();
+    blas::Side side = params.side();
+    blas::Uplo uplo = params.uplo();
+    blas::Op trans  = params.trans();
+    blas::Diag diag = params.diag();
+    T alpha         = params.alpha();
+    int64_t m       = params.dim.m();
+    int64_t n       = params.dim.n();
+    int64_t nb      = params.nb();
+    int64_t align   = params.align();
+    int64_t verbose = params.verbose();
+
+    // mark non-standard output values
+    params.gflops();
+    params.ref_time();
+    params.ref_gflops();
+
+    if (! run)
+        return;
+
+    // setup
+    int64_t Am = (side == Side::Left ? m : n);
+    int64_t Bm = m;
+    int64_t Bn = n;
+    if (layout == Layout::RowMajor)
+        std::swap( Bm, Bn );
+    int64_t lda = roundup( Am, align );
+    int64_t ldb = roundup( Bm, align );
+    size_t size_A = size_t(lda)*Am;
+    size_t size_B = size_t(ldb)*Bn;
+    T* A    = new T[ size_A ];
+    T* B    = new T[ size_B ];
+    T* Bref = new T[ size_B ];
+
+    int64_t idist = 1;
+    int iseed[4] = { 0, 0, 0, 1 };
+    lapack_larnv( idist, iseed, size_A, A );
+    lapack_larnv( idist, iseed, size_B, B );
+    lapack_lacpy( "g", Bm, Bn, B, ldb, Bref, ldb );
+
+    // Factor A into L L^H or U U^H to get a well-conditioned triangular
+    // matrix, as in test_trsm.
+    for (int64_t i = 0; i < Am; ++i) {
+        A[ i + i*lda ] += Am;
+    }
+    int64_t info = 0;
+    lapack_potrf( uplo2str(uplo), Am, A, lda, &info );
+    assert( info == 0 );
+
+    // norms for error check
+    real_t work[1];
+    real_t Anorm = lapack_lantr( "f", uplo2str(uplo), diag2str(diag),
+                                 Am, Am, A, lda, work );
+    real_t Bnorm = lapack_lange( "f", Bm, Bn, B, ldb, work );
+
+    // if row-major, transpose A
+    if (layout == Layout::RowMajor) {
+        for (int64_t j = 0; j < Am; ++j) {
+            for (int64_t i = 0; i < j; ++i) {
+                std::swap( A[ i + j*lda ], A[ j + i*lda ] );
+            }
+        }
+    }
+
+    // test error exits
+    assert_throw( blas::tiled::trsm( Layout(0), side,    uplo,    trans, diag,     m,  n, alpha, A, lda, B, ldb, nb ), blas::Error );
+    assert_throw( blas::tiled::trsm( layout,    Side(0), uplo,    trans, diag,     m,  n, alpha, A, lda, B, ldb, nb ), blas::Error );
+    assert_throw( blas::tiled::trsm( layout,    side,    Uplo(0), trans, diag,     m,  n, alpha, A, lda, B, ldb, nb ), blas::Error );
+    assert_throw( blas::tiled::trsm( layout,    side,    uplo,    Op(0), diag,     m,  n, alpha, A, lda, B, ldb, nb ), blas::Error );
+    assert_throw( blas::tiled::trsm( layout,    side,    uplo,    trans, Diag(0),  m,  n, alpha, A, lda, B, ldb, nb ), blas::Error );
+    assert_throw( blas::tiled::trsm( layout,    side,    uplo,    trans, diag,    -1,  n, alpha, A, lda, B, ldb, nb ), blas::Error );
+    assert_throw( blas::tiled::trsm( layout,    side,    uplo,    trans, diag,     m, -1, alpha, A, lda, B, ldb, nb ), blas::Error );
+    assert_throw( blas::tiled::trsm( layout,    side,    uplo,    trans, diag,     m,  n, alpha, A, lda, B, ldb,  0 ), blas::Error );
+
+    // run test
+    testsweeper::flush_cache( params.cache() );
+    double time = get_wtime();
+    blas::tiled::trsm( layout, side, uplo, trans, diag, m, n,
+                       alpha, A, lda, B, ldb, nb );
+    time = get_wtime() - time;
+
+    double gflop = Gflop < T >::trsm( side, m, n );
+    params.time()   = time;
+    params.gflops() = gflop / time;
+
+    if (verbose >= 2) {
+        printf( "X = " ); print_matrix( Bm, Bn, B, ldb );
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // run reference
+        testsweeper::flush_cache( params.cache() );
+        time = get_wtime();
+        cblas_trsm( cblas_layout_const(layout),
+                    cblas_side_const(side),
+                    cblas_uplo_const(uplo),
+                    cblas_trans_const(trans),
+                    cblas_diag_const(diag),
+                    m, n, alpha, A, lda, Bref, ldb );
+        time = get_wtime() - time;
+
+        params.ref_time()   = time;
+        params.ref_gflops() = gflop / time;
+
+        // check error compared to reference
+        // Am is reduction dimension
+        // beta = 0, Cnorm = 0 (initial).
+        real_t error;
+        bool okay;
+        check_gemm( Bm, Bn, Am, alpha, T(0), Anorm, Bnorm, real_t(0),
+                    Bref, ldb, B, ldb, verbose, &error, &okay );
+        params.error() = error;
+        params.okay() = okay;
+    }
+
+    delete[] A;
+    delete[] B;
+    delete[] Bref;
+}
+
+// -----------------------------------------------------------------------------
+void test_tiled_gemm( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_tiled_gemm_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_tiled_gemm_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_tiled_gemm_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_tiled_gemm_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_tiled_syrk( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_tiled_syrk_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_tiled_syrk_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_tiled_syrk_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_tiled_syrk_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_tiled_trsm( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_tiled_trsm_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_tiled_trsm_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_tiled_trsm_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_tiled_trsm_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
@@ -34,8 +34,10 @@ void test_trmm_work( Params& params, bool run )
 
     // mark non-standard output values
     params.gflops();
+    params.gbytes();
     params.ref_time();
     params.ref_gflops();
+    params.ref_gbytes();
 
     if (! run)
         return;
@@ -101,8 +103,10 @@ void test_trmm_work( Params& params, bool run )
     time = get_wtime() - time;
 
     double gflop = Gflop < scalar_t >::trmm( side, m, n );
+    double gbyte = Gbyte < scalar_t >::trmm( side, m, n );
     params.time()   = time;
     params.gflops() = gflop / time;
+    params.gbytes() = gbyte / time;
 
     if (verbose >= 2) {
         printf( "X = " ); print_matrix( Bm, Bn, B, ldb );
@@ -122,6 +126,7 @@ void test_trmm_work( Params& params, bool run )
 
         params.ref_time()   = time;
         params.ref_gflops() = gflop / time;
+        params.ref_gbytes() = gbyte / time;
 
         if (verbose >= 2) {
             printf( "Xref = " ); print_matrix( Bm, Bn, Bref, ldb );
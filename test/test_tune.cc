@@ -0,0 +1,495 @@
+// Copyright (c) 2017-2020, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "cblas.hh"
+#include "lapack_wrappers.hh"
+#include "blas/flops.hh"
+#include "print_matrix.hh"
+#include "check_gemm.hh"
+
+#include <cstdio>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Round trip of the tuning file: sets distinct crossovers for every routine,
+// precision, and op, saves them, resets, checks that all are 0, loads them,
+// and checks that all match. The original table is saved and loaded back.
+// @return number of mismatched entries.
+int64_t test_tune_file( int64_t verbose )
+{
+    using blas::Op;
+    using blas::tune::Routine;
+    typedef long long lld;
+
+    const char* orig_file = "blaspp_tune_orig.txt";
+    const char* test_file = "blaspp_tune_test.txt";
+    const char precisions[] = { 's', 'd', 'c', 'z' };
+    const Op ops[] = { Op::NoTrans, Op::Trans, Op::ConjTrans };
+    const int num_routines = int( Routine::num_routines );
+
+    blas::tune::save( orig_file );
+
+    // set distinct values; gemv ignores opB and dot ignores both, so later
+    // values overwrite earlier ones
+    int64_t value = 1;
+    for (int r = 0; r < num_routines; ++r)
+        for (char precision : precisions)
+            for (Op opA : ops)
+                for (Op opB : ops)
+                    blas::tune::set_crossover( Routine( r ), precision,
+                                               opA, opB, value++ );
+
+    std::vector<int64_t> expect;
+    for (int r = 0; r < num_routines; ++r)
+        for (char precision : precisions)
+            for (Op opA : ops)
+                for (Op opB : ops)
+                    expect.push_back( blas::tune::crossover(
+                        Routine( r ), precision, opA, opB ) );
+
+    blas::tune::save( test_file );
+    blas::tune::reset();
+
+    // after reset, all must be 0; after load, all must match
+    int64_t error = 0;
+    for (int pass = 0; pass < 2; ++pass) {
+        if (pass == 1)
+            blas::tune::load( test_file );
+        size_t i = 0;
+        for (int r = 0; r < num_routines; ++r) {
+            for (char precision : precisions) {
+                for (Op opA : ops) {
+                    for (Op opB : ops) {
+                        int64_t ref = (pass == 0 ? 0 : expect[ i ]);
+                        int64_t size = blas::tune::crossover(
+                            Routine( r ), precision, opA, opB );
+                        if (size != ref) {
+                            ++error;
+                            if (verbose >= 1) {
+                                printf( "%s %c %c%c: crossover %lld, expected %lld\n",
+                                        blas::tune::routine2str( Routine( r ) ),
+                                        precision, op2char( opA ), op2char( opB ),
+                                        (lld) size, (lld) ref );
+                            }
+                        }
+                        ++i;
+                    }
+                }
+            }
+        }
+    }
+
+    blas::tune::load( orig_file );
+    std::remove( orig_file );
+    std::remove( test_file );
+    return error;
+}
+
+// -----------------------------------------------------------------------------
+// Compares the in-library gemm kernel, forced by setting a large crossover,
+// with the vendor BLAS, forced by setting crossover 0. Running this with
+// several sizes shows where the crossover should be; see blas::tune.
+// Also checks a round trip of the tuning file; see test_tune_file.
+template< typename T >
+void test_tune_work( Params& params, bool run )
+{
+    using namespace testsweeper;
+    using namespace blas;
+    typedef real_type<T> real_t;
+    typedef long long lld;
+
+    // get & mark input values
+    blas::Layout layout = params.layout();
+    blas::Op transA = params.transA();
+    blas::Op transB = params.transB();
+    T alpha         = params.alpha();
+    T beta          = params.beta();
+    int64_t m       = params.dim.m();
+    int64_t n       = params.dim.n();
+    int64_t k       = params.dim.k();
+    int64_t align   = params.align();
+    int64_t verbose = params.verbose();
+
+    // mark non-standard output values
+    params.gflops();
+    params.ref_time();
+    params.ref_gflops();
+    params.time.name( "kernel\ntime (ms)" );
+    params.gflops.name( "kernel\nGflop/s" );
+    params.ref_time.name( "vendor\ntime (ms)" );
+    params.ref_gflops.name( "vendor\nGflop/s" );
+
+    if (! run)
+        return;
+
+    char precision = datatype2char( params.datatype() );
+
+    // setup
+    int64_t Am = (transA == Op::NoTrans ? m : k);
+    int64_t An = (transA == Op::NoTrans ? k : m);
+    int64_t Bm = (transB == Op::NoTrans ? k : n);
+    int64_t Bn = (transB == Op::NoTrans ? n : k);
+    int64_t Cm = m;
+    int64_t Cn = n;
+    if (layout == Layout::RowMajor) {
+        std::swap( Am, An );
+        std::swap( Bm, Bn );
+        std::swap( Cm, Cn );
+    }
+    int64_t lda = roundup( Am, align );
+    int64_t ldb = roundup( Bm, align );
+    int64_t ldc = roundup( Cm, align );
+    size_t size_A = size_t(lda)*An;
+    size_t size_B = size_t(ldb)*Bn;
+    size_t size_C = size_t(ldc)*Cn;
+    T* A    = new T[ size_A ];
+    T* B    = new T[ size_B ];
+    T* C    = new T[ size_C ];
+    T* Cref = new T[ size_C ];
+
+    int64_t idist = 1;
+    int iseed[4] = { 0, 0, 0, 1 };
+    lapack_larnv( idist, iseed, size_A, A );
+    lapack_larnv( idist, iseed, size_B, B );
+    lapack_larnv( idist, iseed, size_C, C );
+    lapack_lacpy( "g", Cm, Cn, C, ldc, Cref, ldc );
+
+    // norms for error check
+    real_t work[1];
+    real_t Anorm = lapack_lange( "f", Am, An, A, lda, work );
+    real_t Bnorm = lapack_lange( "f", Bm, Bn, B, ldb, work );
+    real_t Cnorm = lapack_lange( "f", Cm, Cn, C, ldc, work );
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A Am=%5lld, An=%5lld, lda=%5lld, size=%10lld, norm %.2e\n"
+                "B Bm=%5lld, Bn=%5lld, ldb=%5lld, size=%10lld, norm %.2e\n"
+                "C Cm=%5lld, Cn=%5lld, ldc=%5lld, size=%10lld, norm %.2e\n",
+                (lld) Am, (lld) An, (lld) lda, (lld) size_A, Anorm,
+                (lld) Bm, (lld) Bn, (lld) ldb, (lld) size_B, Bnorm,
+                (lld) Cm, (lld) Cn, (lld) ldc, (lld) size_C, Cnorm );
+    }
+
+    // save crossover to restore afterwards
+    int64_t save = tune::crossover( tune::Routine::gemm, precision,
+                                    transA, transB );
+    int64_t size = max( m, n, k );
+    double gflop = Gflop< T >::gemm( m, n, k );
+
+    // run test: in-library kernel
+    tune::set_crossover( tune::Routine::gemm, precision, transA, transB,
+                         size + 1 );
+    testsweeper::flush_cache( params.cache() );
+    double time = get_wtime();
+    blas::gemm( layout, transA, transB, m, n, k,
+                alpha, A, lda, B, ldb, beta, C, ldc );
+    time = get_wtime() - time;
+
+    params.time()   = time * 1000;  // msec
+    params.gflops() = gflop / time;
+
+    // run reference: vendor BLAS
+    tune::set_crossover( tune::Routine::gemm, precision, transA, transB, 0 );
+    testsweeper::flush_cache( params.cache() );
+    time = get_wtime();
+    blas::gemm( layout, transA, transB, m, n, k,
+                alpha, A, lda, B, ldb, beta, Cref, ldc );
+    time = get_wtime() - time;
+
+    params.ref_time()   = time * 1000;  // msec
+    params.ref_gflops() = gflop / time;
+
+    tune::set_crossover( tune::Routine::gemm, precision, transA, transB, save );
+
+    if (params.check() == 'y') {
+        // check error compared to reference
+        real_t error;
+        bool okay;
+        check_gemm( Cm, Cn, k, alpha, beta, Anorm, Bnorm, Cnorm,
+                    Cref, ldc, C, ldc, verbose, &error, &okay );
+        int64_t file_error = test_tune_file( verbose );
+        params.error() = error;
+        params.okay() = okay && file_error == 0;
+    }
+
+    delete[] A;
+    delete[] B;
+    delete[] C;
+    delete[] Cref;
+}
+
+// -----------------------------------------------------------------------------
+// As test_tune_work, for the generic gemv.
+template< typename T >
+void test_tune_gemv_work( Params& params, bool run )
+{
+    using namespace testsweeper;
+    using namespace blas;
+    typedef real_type<T> real_t;
+
+    // get & mark input values
+    blas::Layout layout = params.layout();
+    blas::Op trans  = params.trans();
+    T alpha         = params.alpha();
+    T beta          = params.beta();
+    int64_t m       = params.dim.m();
+    int64_t n       = params.dim.n();
+    int64_t incx    = params.incx();
+    int64_t incy    = params.incy();
+    int64_t align   = params.align();
+    int64_t verbose = params.verbose();
+
+    // mark non-standard output values
+    params.gflops();
+    params.ref_time();
+    params.ref_gflops();
+    params.time.name( "kernel\ntime (ms)" );
+    params.gflops.name( "kernel\nGflop/s" );
+    params.ref_time.name( "vendor\ntime (ms)" );
+    params.ref_gflops.name( "vendor\nGflop/s" );
+
+    if (! run)
+        return;
+
+    char precision = datatype2char( params.datatype() );
+
+    // setup
+    int64_t Am = (layout == Layout::ColMajor ? m : n);
+    int64_t An = (layout == Layout::ColMajor ? n : m);
+    int64_t lda = roundup( Am, align );
+    int64_t Xm = (trans == Op::NoTrans ? n : m);
+    int64_t Ym = (trans == Op::NoTrans ? m : n);
+    size_t size_A = size_t(lda)*An;
+    size_t size_x = (Xm - 1) * std::abs(incx) + 1;
+    size_t size_y = (Ym - 1) * std::abs(incy) + 1;
+    std::vector<T> A( size_A ), x( size_x ), y( size_y ), yref( size_y );
+
+    int64_t idist = 1;
+    int iseed[4] = { 0, 0, 0, 1 };
+    lapack_larnv( idist, iseed, size_A, A.data() );
+    lapack_larnv( idist, iseed, size_x, x.data() );
+    lapack_larnv( idist, iseed, size_y, y.data() );
+    yref = y;
+
+    // norms for error check
+    real_t work[1];
+    real_t Anorm = lapack_lange( "f", Am, An, A.data(), lda, work );
+    real_t Xnorm = cblas_nrm2( Xm, x.data(), std::abs(incx) );
+    real_t Ynorm = cblas_nrm2( Ym, y.data(), std::abs(incy) );
+
+    // save crossover to restore afterwards
+    int64_t save = tune::crossover( tune::Routine::gemv, precision,
+                                    trans, Op::NoTrans );
+    int64_t size = max( m, n );
+    double gflop = Gflop< T >::gemv( m, n );
+
+    // run test: in-library kernel
+    tune::set_crossover( tune::Routine::gemv, precision, trans, Op::NoTrans,
+                         size + 1 );
+    testsweeper::flush_cache( params.cache() );
+    double time = get_wtime();
+    blas::gemv( layout, trans, m, n, alpha, A.data(), lda,
+                x.data(), incx, beta, y.data(), incy );
+    time = get_wtime() - time;
+
+    params.time()   = time * 1000;  // msec
+    params.gflops() = gflop / time;
+
+    // run reference: vendor BLAS
+    tune::set_crossover( tune::Routine::gemv, precision, trans, Op::NoTrans, 0 );
+    testsweeper::flush_cache( params.cache() );
+    time = get_wtime();
+    blas::gemv( layout, trans, m, n, alpha, A.data(), lda,
+                x.data(), incx, beta, yref.data(), incy );
+    time = get_wtime() - time;
+
+    params.ref_time()   = time * 1000;  // msec
+    params.ref_gflops() = gflop / time;
+
+    tune::set_crossover( tune::Routine::gemv, precision, trans, Op::NoTrans,
+                         save );
+
+    if (params.check() == 'y') {
+        // check error compared to reference
+        // treat y as 1 x Ym matrix with ld = incy; k = Xm is reduction dimension
+        real_t error;
+        bool okay;
+        check_gemm( 1, Ym, Xm, alpha, beta, Anorm, Xnorm, Ynorm,
+                    yref.data(), std::abs(incy), y.data(), std::abs(incy),
+                    verbose, &error, &okay );
+        params.error() = error;
+        params.okay() = okay;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// As test_tune_work, for the generic dot, which is conjugated for complex.
+template< typename T >
+void test_tune_dot_work( Params& params, bool run )
+{
+    using namespace testsweeper;
+    using namespace blas;
+    typedef real_type<T> real_t;
+
+    // get & mark input values
+    int64_t n       = params.dim.n();
+    int64_t incx    = params.incx();
+    int64_t incy    = params.incy();
+    int64_t verbose = params.verbose();
+
+    // mark non-standard output values
+    params.gflops();
+    params.ref_time();
+    params.ref_gflops();
+    params.time.name( "kernel\ntime (ms)" );
+    params.gflops.name( "kernel\nGflop/s" );
+    params.ref_time.name( "vendor\ntime (ms)" );
+    params.ref_gflops.name( "vendor\nGflop/s" );
+
+    if (! run)
+        return;
+
+    char precision = datatype2char( params.datatype() );
+
+    // setup
+    size_t size_x = (n - 1) * std::abs(incx) + 1;
+    size_t size_y = (n - 1) * std::abs(incy) + 1;
+    std::vector<T> x( size_x ), y( size_y );
+
+    int64_t idist = 1;
+    int iseed[4] = { 0, 0, 0, 1 };
+    lapack_larnv( idist, iseed, size_x, x.data() );
+    lapack_larnv( idist, iseed, size_y, y.data() );
+
+    // norms for error check
+    real_t Xnorm = cblas_nrm2( n, x.data(), std::abs(incx) );
+    real_t Ynorm = cblas_nrm2( n, y.data(), std::abs(incy) );
+
+    // save crossover to restore afterwards
+    int64_t save = tune::crossover( tune::Routine::dot, precision,
+                                    Op::NoTrans, Op::NoTrans );
+    double gflop = Gflop< T >::dot( n );
+
+    // run test: in-library kernel
+    tune::set_crossover( tune::Routine::dot, precision, Op::NoTrans,
+                         Op::NoTrans, n + 1 );
+    testsweeper::flush_cache( params.cache() );
+    double time = get_wtime();
+    T result = blas::dot( n, x.data(), incx, y.data(), incy );
+    time = get_wtime() - time;
+
+    params.time()   = time * 1000;  // msec
+    params.gflops() = gflop / time;
+
+    // run reference: vendor BLAS
+    tune::set_crossover( tune::Routine::dot, precision, Op::NoTrans,
+                         Op::NoTrans, 0 );
+    testsweeper::flush_cache( params.cache() );
+    time = get_wtime();
+    T ref = blas::dot( n, x.data(), incx, y.data(), incy );
+    time = get_wtime() - time;
+
+    params.ref_time()   = time * 1000;  // msec
+    params.ref_gflops() = gflop / time;
+
+    tune::set_crossover( tune::Routine::dot, precision, Op::NoTrans,
+                         Op::NoTrans, save );
+
+    if (verbose >= 1) {
+        printf( "result = %.4e + %.4ei, ref = %.4e + %.4ei\n",
+                real(result), imag(result), real(ref), imag(ref) );
+    }
+
+    if (params.check() == 'y') {
+        // check error compared to reference
+        // treat result as 1 x 1 matrix; k = n is reduction dimension
+        // alpha=1, beta=0, Cnorm=0
+        real_t error;
+        bool okay;
+        check_gemm( 1, 1, n, T(1), T(0), Xnorm, Ynorm, real_t(0),
+                    &ref, 1, &result, 1, verbose, &error, &okay );
+        params.error() = error;
+        params.okay() = okay;
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_tune( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_tune_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_tune_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_tune_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_tune_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_tune_gemv( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_tune_gemv_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_tune_gemv_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_tune_gemv_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_tune_gemv_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_tune_dot( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_tune_dot_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_tune_dot_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_tune_dot_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_tune_dot_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
@@ -5,7 +5,12 @@
 
 #include "test.hh"
 
+#include <algorithm>
 #include <string>
+#include <cmath>
+
+#include <stdio.h>
+#include <string.h>
 
 // -----------------------------------------------------------------------------
 void test_enums()
@@ -324,6 +329,51 @@ void test_scalar_type()
     assert( ok );
 }
 
+// -----------------------------------------------------------------------------
+void test_half()
+{
+    bool ok = true;
+    ok = ok && std::is_same< blas::scalar_type< blas::float16  >, float >::value;
+    ok = ok && std::is_same< blas::real_type< blas::bfloat16 >, float >::value;
+    ok = ok && std::is_same< blas::scalar_type< blas::float16, double >, double >::value;
+    assert( ok );
+
+    // every float16 round trips exactly through float; nan stays quiet nan
+    for (uint32_t bits = 0; bits < 0x10000; ++bits) {
+        blas::float16 h = blas::float16::from_bits( uint16_t( bits ) );
+        float x = h;
+        if (x == x)
+            assert( blas::float16( x ).bits() == bits );
+        else
+            assert( (blas::float16( x ).bits() & 0x7e00) == 0x7e00 );
+    }
+    for (uint32_t bits = 0; bits < 0x10000; ++bits) {
+        blas::bfloat16 b = blas::bfloat16::from_bits( uint16_t( bits ) );
+        float x = b;
+        if (x == x)
+            assert( blas::bfloat16( x ).bits() == bits );
+    }
+
+    // round to nearest even at ties, overflow, subnormals
+    assert( blas::float16( 1.0f + std::ldexp( 1.0f, -11 ) ).bits() == 0x3c00 );
+    assert( blas::float16( 1.0f + 3*std::ldexp( 1.0f, -11 ) ).bits() == 0x3c02 );
+    assert( blas::float16( 65519.0f ).bits() == 0x7bff );
+    assert( blas::float16( 65520.0f ).bits() == 0x7c00 );
+    assert( blas::float16( std::ldexp( 1.0f, -24 ) ).bits() == 0x0001 );
+    assert( blas::float16( std::ldexp( 1.0f, -25 ) ).bits() == 0x0000 );
+    assert( blas::bfloat16( 1.0f + std::ldexp( 1.0f, -8 ) ).bits() == 0x3f80 );
+    assert( blas::bfloat16( 1.0f + 3*std::ldexp( 1.0f, -8 ) ).bits() == 0x3f82 );
+
+    // bulk conversion matches scalar
+    blas::float16 h[ 19 ];
+    float y[ 19 ];
+    for (int i = 0; i < 19; ++i)
+        h[ i ] = i * 0.3f - 2;
+    blas::convert( 19, h, y );
+    for (int i = 0; i < 19; ++i)
+        assert( y[ i ] == float( h[ i ] ) );
+}
+
 // -----------------------------------------------------------------------------
 void test_make_scalar()
 {
@@ -343,6 +393,127 @@ void test_make_scalar()
     assert( zx == std::complex<double>( dxr, dxi ) );
 }
 
+// -----------------------------------------------------------------------------
+void test_profile()
+{
+    bool save = blas::profile::enabled();
+    blas::profile::enable();
+    blas::profile::reset();
+
+    double A[ 4 ] = { 1, 2, 3, 4 };
+    double B[ 4 ] = { 1, 0, 0, 1 };
+    double C[ 4 ] = { 0, 0, 0, 0 };
+    for (int i = 0; i < 3; ++i) {
+        blas::gemm( blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::Trans,
+                    2, 2, 2, 1.0, A, 2, B, 2, 0.0, C, 2 );
+    }
+    blas::axpy( 4, 1.0, A, 1, C, 1 );
+
+    // disabled calls are not recorded
+    blas::profile::enable( false );
+    blas::axpy( 4, 1.0, A, 1, C, 1 );
+
+    FILE* file = tmpfile();
+    assert( file != nullptr );
+    blas::profile::write_csv( file );
+    rewind( file );
+    char line[ 1024 ];
+    int  lines = 0;
+    bool found_gemm = false, found_axpy = false;
+    while (fgets( line, sizeof(line), file ) != nullptr) {
+        ++lines;
+        if (strncmp( line, "gemm,d,CNT,2,2,2,1,3,", 21 ) == 0)
+            found_gemm = true;
+        if (strncmp( line, "axpy,d,,4,0,0,1,1,", 18 ) == 0)
+            found_axpy = true;
+    }
+    fclose( file );
+    assert( lines == 3 );  // header, gemm, axpy
+    assert( found_gemm );
+    assert( found_axpy );
+
+    blas::profile::reset();
+    blas::profile::enable( save );
+}
+
+// -----------------------------------------------------------------------------
+void test_trace()
+{
+    bool save = blas::profile::tracing();
+    blas::profile::enable_trace();
+    blas::profile::reset_trace();
+
+    double x[ 4 ] = { 1, 2, 3, 4 };
+    double y[ 4 ] = { 0, 0, 0, 0 };
+    blas::axpy( 4, 1.0, x, 1, y, 1 );
+    blas::profile::mark( "test_trace", "value", 42 );
+    blas::profile::enable_trace( false );
+
+    FILE* file = tmpfile();
+    assert( file != nullptr );
+    blas::profile::write_trace( file );
+    rewind( file );
+    char line[ 1024 ];
+    bool found_axpy = false, found_mark = false;
+    while (fgets( line, sizeof(line), file ) != nullptr) {
+        if (strstr( line, "\"name\": \"axpy\"" ) != nullptr
+            && strstr( line, "\"ph\": \"X\"" ) != nullptr)
+            found_axpy = true;
+        if (strstr( line, "\"name\": \"test_trace\"" ) != nullptr
+            && strstr( line, "\"value\": 42" ) != nullptr)
+            found_mark = true;
+    }
+    fclose( file );
+    assert( found_axpy );
+    assert( found_mark );
+
+    blas::profile::reset_trace();
+    blas::profile::enable_trace( save );
+}
+
+// -----------------------------------------------------------------------------
+void test_thread_scope()
+{
+    int64_t nthreads = blas::get_num_threads();
+    assert( nthreads >= 1 );
+    {
+        blas::ThreadScope scope( 1 );
+        assert( blas::get_num_threads() == 1 );
+        #ifdef _OPENMP
+            {
+                // scopes nest
+                blas::ThreadScope inner( 3 );
+                assert( blas::get_num_threads() == 3 );
+            }
+            assert( blas::get_num_threads() == 1 );
+
+            // per thread inside a parallel region
+            #pragma omp parallel num_threads( 2 )
+            {
+                blas::ThreadScope inner( 2 );
+                assert( blas::get_num_threads() == 2 );
+            }
+            assert( blas::get_num_threads() == 1 );
+        #endif
+    }
+    assert( blas::get_num_threads() == nthreads );
+
+    try {
+        blas::ThreadScope scope( 0 );
+        assert( false );
+    }
+    catch (blas::Error const& ex) {
+    }
+
+    // batch problems times threads per problem fit in nthreads
+    assert( blas::batch_threads( 0 ) == nthreads );
+    assert( blas::batch_threads( 1 ) == nthreads );
+    assert( blas::batch_threads( nthreads + 1 ) == 1 );
+    for (size_t batch = 1; batch <= 10; ++batch)
+        assert( int64_t( std::min( batch, size_t( nthreads ) ) )
+                * blas::batch_threads( batch ) <= nthreads );
+}
+
 // -----------------------------------------------------------------------------
 void test_util( Params& params, bool run )
 {
@@ -361,7 +532,11 @@ void test_util( Params& params, bool run )
     test_complex_type();
     test_scalar_type();
     test_scalar_type();
+    test_half();
     test_make_scalar();
+    test_profile();
+    test_trace();
+    test_thread_scope();
 
     params.okay() = true;
 }